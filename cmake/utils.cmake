@@ -202,6 +202,78 @@ function(mayaUsd_promoteHeaderList)
     endforeach()
 endfunction()
 
+#
+# mayaUsd_add_simd_sources( <target>
+#                           [AVX2   <list of files>]
+#                           [AVX512 <list of files>])
+#
+#   AVX2     - sources compiled for AVX2, FMA and F16C.
+#   AVX512   - sources compiled for AVX-512 F, BW, DQ and VL.
+#
+#   The sources are only added to the target when building for x86-64 with a
+#   compiler accepting these instruction set flags, and MAYAUSD_SIMD_HAS_AVX2 /
+#   MAYAUSD_SIMD_HAS_AVX512 are defined to 1 or 0 on the target accordingly.
+#   The rest of the target keeps the default flags: code from these sources
+#   must only be called after checking the CPU, see SIMDDispatch.h.
+#
+function(mayaUsd_add_simd_sources target)
+    cmake_parse_arguments(PREFIX
+        ""              # options
+        ""              # one_value keywords
+        "AVX2;AVX512"   # multi_value keywords
+        ${ARGN}
+    )
+
+    include(CheckCXXCompilerFlag)
+
+    # SIMD.h relies on the instruction set macros defined by gcc and clang.
+    set(avx2Flags "")
+    set(avx512Flags "")
+    if(CMAKE_SYSTEM_PROCESSOR MATCHES "^(x86_64|AMD64|amd64)$" AND
+       CMAKE_CXX_COMPILER_ID MATCHES "GNU|Clang")
+        set(avx2Flags -mavx2 -mfma -mf16c)
+        set(avx512Flags ${avx2Flags} -mavx512f -mavx512bw -mavx512dq -mavx512vl)
+
+        string(REPLACE ";" " " avx2FlagsString "${avx2Flags}")
+        check_cxx_compiler_flag("${avx2FlagsString}" MAYAUSD_COMPILER_SUPPORTS_AVX2)
+        if(NOT MAYAUSD_COMPILER_SUPPORTS_AVX2)
+            set(avx2Flags "")
+        endif()
+
+        string(REPLACE ";" " " avx512FlagsString "${avx512Flags}")
+        check_cxx_compiler_flag("${avx512FlagsString}" MAYAUSD_COMPILER_SUPPORTS_AVX512)
+        if(NOT MAYAUSD_COMPILER_SUPPORTS_AVX512)
+            set(avx512Flags "")
+        endif()
+    endif()
+
+    set(hasAvx2 0)
+    if(PREFIX_AVX2 AND avx2Flags)
+        target_sources(${target} PRIVATE ${PREFIX_AVX2})
+        set_source_files_properties(${PREFIX_AVX2}
+            PROPERTIES
+                COMPILE_OPTIONS "${avx2Flags}"
+        )
+        set(hasAvx2 1)
+    endif()
+
+    set(hasAvx512 0)
+    if(PREFIX_AVX512 AND avx512Flags)
+        target_sources(${target} PRIVATE ${PREFIX_AVX512})
+        set_source_files_properties(${PREFIX_AVX512}
+            PROPERTIES
+                COMPILE_OPTIONS "${avx512Flags}"
+        )
+        set(hasAvx512 1)
+    endif()
+
+    target_compile_definitions(${target}
+        PRIVATE
+            MAYAUSD_SIMD_HAS_AVX2=${hasAvx2}
+            MAYAUSD_SIMD_HAS_AVX512=${hasAvx512}
+    )
+endfunction()
+
 #
 # mayaUsd_copyFiles( <target>
 #                    [DESTINATION <destination>]
@@ -34,6 +34,7 @@
 #include <maya/MNodeClass.h>
 #include <maya/MTypeId.h>
 
+#include <algorithm>
 #include <ostream>
 #include <string>
 
@@ -77,6 +78,18 @@ _Boolean(const VtDictionary& userArgs, const TfToken& key)
     return VtDictionaryGet<bool>(userArgs, key);
 }
 
+/// Extracts an int at \p key from \p userArgs, or 0 if it can't extract.
+static int
+_Integer(const VtDictionary& userArgs, const TfToken& key)
+{
+    if (!VtDictionaryIsHolding<int>(userArgs, key)) {
+        TF_CODING_ERROR("Dictionary is missing required key '%s' or key is "
+                "not int type", key.GetText());
+        return 0;
+    }
+    return VtDictionaryGet<int>(userArgs, key);
+}
+
 /// Extracts a string at \p key from \p userArgs, or "" if it can't extract.
 static std::string
 _String(const VtDictionary& userArgs, const TfToken& key)
@@ -236,6 +249,9 @@ UsdMayaJobExportArgs::UsdMayaJobExportArgs(
     const VtDictionary& userArgs,
     const UsdMayaUtil::MDagPathSet& dagPaths,
     const std::vector<double>& timeSamples) :
+        clipFrameCount(
+            std::max(0,
+                _Integer(userArgs, UsdMayaJobExportArgsTokens->clipFrameCount))),
         compatibility(
             _Token(userArgs,
                 UsdMayaJobExportArgsTokens->compatibility,
@@ -330,6 +346,9 @@ UsdMayaJobExportArgs::UsdMayaJobExportArgs(
                 UsdMayaJobExportArgsTokens->shadingMode,
                 UsdMayaShadingModeTokens->none,
                 UsdMayaShadingModeRegistry::ListExporters())),
+        shareShadingNetworks(
+            _Boolean(userArgs,
+                UsdMayaJobExportArgsTokens->shareShadingNetworks)),
         verbose(
             _Boolean(userArgs, UsdMayaJobExportArgsTokens->verbose)),
 
@@ -356,7 +375,8 @@ UsdMayaJobExportArgs::UsdMayaJobExportArgs(
 std::ostream&
 operator <<(std::ostream& out, const UsdMayaJobExportArgs& exportArgs)
 {
-    out << "compatibility: " << exportArgs.compatibility << std::endl
+    out << "clipFrameCount: " << exportArgs.clipFrameCount << std::endl
+        << "compatibility: " << exportArgs.compatibility << std::endl
         << "defaultMeshScheme: " << exportArgs.defaultMeshScheme << std::endl
         << "eulerFilter: " << TfStringify(exportArgs.eulerFilter) << std::endl
         << "excludeInvisible: " << TfStringify(exportArgs.excludeInvisible) << std::endl
@@ -380,6 +400,7 @@ operator <<(std::ostream& out, const UsdMayaJobExportArgs& exportArgs)
         << "renderLayerMode: " << exportArgs.renderLayerMode << std::endl
         << "rootKind: " << exportArgs.rootKind << std::endl
         << "shadingMode: " << exportArgs.shadingMode << std::endl
+        << "shareShadingNetworks: " << TfStringify(exportArgs.shareShadingNetworks) << std::endl
         << "stripNamespaces: " << TfStringify(exportArgs.stripNamespaces) << std::endl
         << "timeSamples: " << exportArgs.timeSamples.size() << " sample(s)" << std::endl
         << "usdModelRootOverridePath: " << exportArgs.usdModelRootOverridePath << std::endl;
@@ -441,6 +462,7 @@ UsdMayaJobExportArgs::GetDefaultDictionary()
         // Base defaults.
         d[UsdMayaJobExportArgsTokens->chaser] = std::vector<VtValue>();
         d[UsdMayaJobExportArgsTokens->chaserArgs] = std::vector<VtValue>();
+        d[UsdMayaJobExportArgsTokens->clipFrameCount] = 0;
         d[UsdMayaJobExportArgsTokens->compatibility] =
                 UsdMayaJobExportArgsTokens->none.GetString();
         d[UsdMayaJobExportArgsTokens->defaultCameras] = false;
@@ -476,6 +498,7 @@ UsdMayaJobExportArgs::GetDefaultDictionary()
                 UsdMayaJobExportArgsTokens->defaultLayer.GetString();
         d[UsdMayaJobExportArgsTokens->shadingMode] =
                 UsdMayaShadingModeTokens->displayColor.GetString();
+        d[UsdMayaJobExportArgsTokens->shareShadingNetworks] = true;
         d[UsdMayaJobExportArgsTokens->stripNamespaces] = false;
         d[UsdMayaJobExportArgsTokens->verbose] = false;
 
@@ -57,6 +57,7 @@ TF_DECLARE_PUBLIC_TOKENS(
     /* Dictionary keys */ \
     (chaser) \
     (chaserArgs) \
+    (clipFrameCount) \
     (compatibility) \
     (defaultCameras) \
     (defaultMeshScheme) \
@@ -85,6 +86,7 @@ TF_DECLARE_PUBLIC_TOKENS(
     (renderableOnly) \
     (renderLayerMode) \
     (shadingMode) \
+    (shareShadingNetworks) \
     (stripNamespaces) \
     (verbose) \
     /* Special "none" token */ \
@@ -126,6 +128,11 @@ TF_DECLARE_PUBLIC_TOKENS(
 
 struct UsdMayaJobExportArgs
 {
+    /// If greater than zero, animated exports are streamed into value clips
+    /// of this many frames each, written next to the output file as soon as
+    /// they are complete, rather than holding every time sample in memory
+    /// until the stage is saved.
+    const int clipFrameCount;
     const TfToken compatibility;
     const TfToken defaultMeshScheme;
     const bool eulerFilter;
@@ -171,6 +178,12 @@ struct UsdMayaJobExportArgs
     const TfToken renderLayerMode;
     const TfToken rootKind;
     const TfToken shadingMode;
+
+    /// Whether shading engines with identical upstream shading networks
+    /// should share a single authored network. The first material exported
+    /// for a network holds its shaders, and the materials of the other
+    /// shading engines reference it.
+    const bool shareShadingNetworks;
     const bool verbose;
 
     typedef std::map<std::string, std::string> ChaserArgs;
@@ -28,14 +28,19 @@
 #include "../chaser/chaser.h"
 #include "../chaser/chaserRegistry.h"
 
+#include "pxr/base/gf/vec2d.h"
 #include "pxr/base/tf/fileUtils.h"
 #include "pxr/base/tf/hash.h"
 #include "pxr/base/tf/hashset.h"
 #include "pxr/base/tf/pathUtils.h"
 #include "pxr/base/tf/stl.h"
 #include "pxr/base/tf/stringUtils.h"
+#include "pxr/base/vt/types.h"
 #include "pxr/usd/ar/resolver.h"
 #include "pxr/usd/kind/registry.h"
+#include "pxr/usd/sdf/assetPath.h"
+#include "pxr/usd/sdf/attributeSpec.h"
+#include "pxr/usd/sdf/changeBlock.h"
 #include "pxr/usd/sdf/layer.h"
 #include "pxr/usd/sdf/primSpec.h"
 // Needed for directly removing a UsdVariant via Sdf
@@ -43,6 +48,7 @@
 //   XXX [bug 75864]
 #include "pxr/usd/sdf/variantSetSpec.h"
 #include "pxr/usd/sdf/variantSpec.h"
+#include "pxr/usd/usd/clipsAPI.h"
 #include "pxr/usd/usd/modelAPI.h"
 #include "pxr/usd/usd/variantSets.h"
 #include "pxr/usd/usd/editContext.h"
@@ -68,6 +74,7 @@
 #include <limits>
 #include <map>
 #include <unordered_set>
+#include <vector>
 
 PXR_NAMESPACE_OPEN_SCOPE
 
@@ -101,6 +108,53 @@ _MakeTmpStageName(const std::string& dir)
     return TfStringCatPaths(dir, fileName);
 }
 
+/// Gets the asset path, relative to \p fileName, of a crate file written next
+/// to it for streamed value clips, e.g. "./anim.clip0003.usdc".
+static
+std::string
+_GetClipAssetPath(const std::string& fileName, const std::string& suffix)
+{
+    return TfStringPrintf(
+            "./%s.%s.%s",
+            TfStringGetBeforeSuffix(TfGetBaseName(fileName)).c_str(),
+            suffix.c_str(),
+            UsdMayaTranslatorTokens->UsdFileExtensionCrate.GetText());
+}
+
+/// Gets the file name of the clip at \p assetPath, relative to \p fileName.
+static
+std::string
+_GetClipFileName(const std::string& fileName, const std::string& assetPath)
+{
+    const std::string dirName = TfGetPathName(fileName);
+    return dirName.empty() ? assetPath : TfStringCatPaths(dirName, assetPath);
+}
+
+/// Declares the attribute at \p path on \p layer in \p clipLayer, with overs
+/// for its ancestors, if it isn't there already.
+static
+bool
+_DeclareClipAttribute(
+        const SdfLayerHandle& layer,
+        const SdfLayerHandle& clipLayer,
+        const SdfPath& path)
+{
+    if (clipLayer->HasSpec(path)) {
+        return true;
+    }
+
+    const SdfAttributeSpecHandle attrSpec = layer->GetAttributeAtPath(path);
+    if (!attrSpec) {
+        return false;
+    }
+    return SdfJustCreatePrimAttributeInLayer(
+            clipLayer,
+            path,
+            attrSpec->GetTypeName(),
+            attrSpec->GetVariability(),
+            attrSpec->IsCustom());
+}
+
 /// Chooses the fallback extension based on the compatibility profile, e.g.
 /// ARKit-compatible files should be usdz's by default.
 static
@@ -259,6 +313,18 @@ UsdMaya_WriteJob::_BeginWriting(const std::string& fileName, bool append)
         return false;
     }
 
+    // Value clips are written next to the output file, which must be a new
+    // file on disk that the clips can be made relative to.
+    mJobCtx.mStreamClips = mJobCtx.mArgs.clipFrameCount > 0 &&
+            !mJobCtx.mArgs.timeSamples.empty();
+    if (mJobCtx.mStreamClips && (append || !_packageName.empty() ||
+            SdfLayer::IsAnonymousLayerIdentifier(_fileName))) {
+        TF_WARN("Ignoring %s: value clips can only be streamed when "
+                "exporting to a new usd file.",
+                UsdMayaJobExportArgsTokens->clipFrameCount.GetText());
+        mJobCtx.mStreamClips = false;
+    }
+
     // Set time range for the USD file if we're exporting animation.
     if (!mJobCtx.mArgs.timeSamples.empty()) {
         mJobCtx.mStage->SetStartTimeCode(mJobCtx.mArgs.timeSamples.front());
@@ -459,6 +525,17 @@ UsdMaya_WriteJob::_WriteFrame(double iFrame)
 
     _PerFrameCallback(iFrame);
 
+    // Flush the frames into a value clip once enough of them have been
+    // written, so that the time samples do not accumulate in memory.
+    if (mJobCtx.mStreamClips) {
+        if (_clipFrames++ == 0) {
+            _clipStartTimes.push_back(iFrame);
+        }
+        if (_clipFrames == mJobCtx.mArgs.clipFrameCount) {
+            return _WriteClip();
+        }
+    }
+
     return true;
 }
 
@@ -526,6 +603,20 @@ UsdMaya_WriteJob::_FinishWriting()
         mJobCtx.mStage->GetRootLayer()->SetDefaultPrim(defaultPrim);
     }
 
+    // Write out the remaining frames, and hook the clips up before the post
+    // export functions so that they see all of the time samples.
+    if (mJobCtx.mStreamClips) {
+        if (_clipFrames > 0 && !_WriteClip()) {
+            return false;
+        }
+        if (!_PostExportClips()) {
+            return false;
+        }
+        if (!_AuthorClips()) {
+            return false;
+        }
+    }
+
     // Running post export function on all the prim writers.
     for (auto& primWriter: mJobCtx.mMayaPrimWriterList) {
         primWriter->PostExport();
@@ -768,6 +859,189 @@ UsdMaya_WriteJob::_CreatePackage() const
     }
 }
 
+bool
+UsdMaya_WriteJob::_WriteClip()
+{
+    const SdfLayerHandle layer = mJobCtx.mStage->GetRootLayer();
+    const double startTime = _clipStartTimes.back();
+    _clipFrames = 0;
+
+    if (!_clipManifest) {
+        const std::string manifestFileName = _GetClipFileName(
+                _fileName, _GetClipAssetPath(_fileName, "manifest"));
+        _clipManifest = SdfLayer::CreateNew(manifestFileName);
+        if (!_clipManifest) {
+            TF_RUNTIME_ERROR(
+                    "Could not create value clip manifest '%s'",
+                    manifestFileName.c_str());
+            return false;
+        }
+    }
+
+    const std::string assetPath = _GetClipAssetPath(
+            _fileName,
+            TfStringPrintf("clip%04zu", _clipAssetPaths.size()));
+    const std::string clipFileName = _GetClipFileName(_fileName, assetPath);
+    SdfLayerRefPtr clipLayer = SdfLayer::CreateNew(clipFileName);
+    if (!clipLayer) {
+        TF_RUNTIME_ERROR(
+                "Could not create value clip '%s'", clipFileName.c_str());
+        return false;
+    }
+
+    SdfPathVector sampledPaths;
+    layer->Traverse(
+        SdfPath::AbsoluteRootPath(),
+        [&layer, &sampledPaths](const SdfPath& path) {
+            if (path.IsPropertyPath() &&
+                    layer->HasField(path, SdfFieldKeys->TimeSamples)) {
+                sampledPaths.push_back(path);
+            }
+        });
+
+    {
+        SdfChangeBlock changeBlock;
+
+        for (const SdfPath& path : sampledPaths) {
+            SdfTimeSampleMap samples = layer->GetFieldAs<SdfTimeSampleMap>(
+                    path, SdfFieldKeys->TimeSamples);
+            if (!_DeclareClipAttribute(layer, clipLayer, path)) {
+                continue;
+            }
+            layer->EraseField(path, SdfFieldKeys->TimeSamples);
+
+            const auto held = _clipHeldValues.find(path);
+            if (held == _clipHeldValues.end() && samples.empty()) {
+                continue;
+            }
+            if (held != _clipHeldValues.end()) {
+                // The sparse value writers skip samples that repeat the
+                // previous value, so the clip must start from the value held
+                // over from the previous clip.
+                samples.emplace(startTime, held->second);
+                held->second = samples.rbegin()->second;
+            }
+            else {
+                // First samples for this attribute: the manifest declares it,
+                // and its default covers the clips written before now.
+                _DeclareClipAttribute(layer, _clipManifest, path);
+                const SdfAttributeSpecHandle attrSpec =
+                        layer->GetAttributeAtPath(path);
+                if (attrSpec->HasDefaultValue()) {
+                    _clipManifest->SetField(
+                            path,
+                            SdfFieldKeys->Default,
+                            attrSpec->GetDefaultValue());
+                }
+                _clipRootPaths.insert(path.GetPrefixes().front());
+                _clipHeldValues.emplace(path, samples.rbegin()->second);
+            }
+
+            clipLayer->SetField(
+                    path, SdfFieldKeys->TimeSamples, VtValue::Take(samples));
+        }
+
+        // Attributes that didn't change during this clip still need to hold
+        // their value in it.
+        for (const auto& held : _clipHeldValues) {
+            if (clipLayer->HasField(held.first, SdfFieldKeys->TimeSamples) ||
+                    !_DeclareClipAttribute(layer, clipLayer, held.first)) {
+                continue;
+            }
+            SdfTimeSampleMap samples;
+            samples.emplace(startTime, held.second);
+            clipLayer->SetField(
+                    held.first,
+                    SdfFieldKeys->TimeSamples,
+                    VtValue::Take(samples));
+        }
+    }
+
+    if (!clipLayer->Save()) {
+        TF_RUNTIME_ERROR(
+                "Could not save value clip '%s'", clipFileName.c_str());
+        return false;
+    }
+
+    _clipAssetPaths.push_back(assetPath);
+    return true;
+}
+
+bool
+UsdMaya_WriteJob::_PostExportClips()
+{
+    for (const std::string& assetPath : _clipAssetPaths) {
+        const std::string clipFileName =
+                _GetClipFileName(_fileName, assetPath);
+        const SdfLayerRefPtr clipLayer = SdfLayer::FindOrOpen(clipFileName);
+        if (!clipLayer) {
+            TF_RUNTIME_ERROR(
+                    "Could not open value clip '%s'", clipFileName.c_str());
+            return false;
+        }
+
+        for (const UsdMayaPrimWriterSharedPtr& primWriter :
+                mJobCtx.mMayaPrimWriterList) {
+            primWriter->PostExportClip(clipLayer);
+        }
+
+        if (clipLayer->IsDirty() && !clipLayer->Save()) {
+            TF_RUNTIME_ERROR(
+                    "Could not save value clip '%s'", clipFileName.c_str());
+            return false;
+        }
+    }
+    return true;
+}
+
+bool
+UsdMaya_WriteJob::_AuthorClips()
+{
+    if (_clipAssetPaths.empty() || _clipRootPaths.empty()) {
+        return true;
+    }
+
+    if (!_clipManifest->Save()) {
+        TF_RUNTIME_ERROR(
+                "Could not save value clip manifest '%s'",
+                _clipManifest->GetIdentifier().c_str());
+        return false;
+    }
+
+    // Each clip is active from its first frame on, and the clips use the
+    // stage times as they are.
+    VtArray<SdfAssetPath> assetPaths;
+    VtVec2dArray active;
+    VtVec2dArray times;
+    for (size_t i = 0; i < _clipAssetPaths.size(); ++i) {
+        assetPaths.push_back(SdfAssetPath(_clipAssetPaths[i]));
+        active.push_back(GfVec2d(_clipStartTimes[i], double(i)));
+        times.push_back(GfVec2d(_clipStartTimes[i], _clipStartTimes[i]));
+    }
+    const double endTime = mJobCtx.mStage->GetEndTimeCode();
+    if (endTime > _clipStartTimes.back()) {
+        times.push_back(GfVec2d(endTime, endTime));
+    }
+    const SdfAssetPath manifestAssetPath(
+            _GetClipAssetPath(_fileName, "manifest"));
+
+    for (const SdfPath& rootPath : _clipRootPaths) {
+        const UsdPrim rootPrim = mJobCtx.mStage->GetPrimAtPath(rootPath);
+        if (!rootPrim) {
+            continue;
+        }
+        UsdClipsAPI clipsAPI(rootPrim);
+        clipsAPI.SetClipPrimPath(rootPath.GetString());
+        clipsAPI.SetClipAssetPaths(assetPaths);
+        clipsAPI.SetClipActive(active);
+        clipsAPI.SetClipTimes(times);
+        clipsAPI.SetClipManifestAssetPath(manifestAssetPath);
+    }
+
+    _clipManifest = SdfLayerRefPtr();
+    return true;
+}
+
 void UsdMaya_WriteJob::_PerFrameCallback(double  /*iFrame*/)
 {
     // XXX Should we be passing the frame number into the callback?
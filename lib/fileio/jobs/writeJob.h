@@ -27,10 +27,14 @@
 #include "pxr/pxr.h"
 
 #include "pxr/base/tf/hashmap.h"
+#include "pxr/base/vt/value.h"
+#include "pxr/usd/sdf/declareHandles.h"
+#include "pxr/usd/sdf/path.h"
 
 #include <maya/MObjectHandle.h>
 
 #include <string>
+#include <vector>
 
 PXR_NAMESPACE_OPEN_SCOPE
 
@@ -68,6 +72,18 @@ private:
     /// to disk.
     bool _FinishWriting();
 
+    /// Moves the time samples written since the previous clip out of the
+    /// export layer into a new value clip file, and saves it.
+    bool _WriteClip();
+
+    /// Runs UsdMayaPrimWriter::PostExportClip() on each of the clips written
+    /// by _WriteClip(), one clip at a time, and saves the clips it edits.
+    bool _PostExportClips();
+
+    /// Saves the clip manifest and authors the value clip metadata for all of
+    /// the clips written by _WriteClip() on the root prims that use them.
+    bool _AuthorClips();
+
     /// Writes the root prim variants based on the Maya render layers.
     TfToken _WriteVariants(const UsdPrim &usdRootPrim);
 
@@ -98,6 +114,19 @@ private:
 
     UsdMayaChaserRefPtrVector mChasers;
 
+    // State of a streamed export (see UsdMayaJobExportArgs::clipFrameCount
+    // and UsdMayaWriteJobContext::IsStreamingClips()): the number of frames
+    // written since the previous clip, the asset path and start time of every
+    // clip, the root prims whose descendants have samples in the clips, and
+    // the last time sample of each clip attribute, which is carried over into
+    // the next clip.
+    int _clipFrames = 0;
+    std::vector<std::string> _clipAssetPaths;
+    std::vector<double> _clipStartTimes;
+    SdfPathSet _clipRootPaths;
+    TfHashMap<SdfPath, VtValue, SdfPath::Hash> _clipHeldValues;
+    SdfLayerRefPtr _clipManifest;
+
     UsdMayaWriteJobContext mJobCtx;
 
     std::unique_ptr<UsdMaya_ModelKindProcessor> _modelKindProcessor;
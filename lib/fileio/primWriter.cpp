@@ -27,6 +27,7 @@
 #include "pxr/base/tf/staticTokens.h"
 #include "pxr/base/tf/token.h"
 #include "pxr/base/vt/value.h"
+#include "pxr/usd/sdf/layer.h"
 #include "pxr/usd/sdf/path.h"
 #include "pxr/usd/usd/prim.h"
 #include "pxr/usd/usd/stage.h"
@@ -294,6 +295,12 @@ UsdMayaPrimWriter::PostExport()
 {
 }
 
+/* virtual */
+void
+UsdMayaPrimWriter::PostExportClip(const SdfLayerHandle& /*clipLayer*/)
+{
+}
+
 void
 UsdMayaPrimWriter::SetExportVisibility(const bool exportVis)
 {
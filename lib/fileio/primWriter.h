@@ -25,6 +25,7 @@
 #include "../utils/util.h"
 
 #include "pxr/base/vt/value.h"
+#include "pxr/usd/sdf/declareHandles.h"
 #include "pxr/usd/sdf/path.h"
 #include "pxr/usd/usd/attribute.h"
 #include "pxr/usd/usd/prim.h"
@@ -86,6 +87,18 @@ public:
     MAYAUSD_CORE_PUBLIC
     virtual void PostExport();
 
+    /// Post export function that runs on each value clip of a streamed export
+    /// (see UsdMayaWriteJobContext::IsStreamingClips()), once all of the
+    /// clips are written and before PostExport().
+    ///
+    /// The time samples of a streamed export live in the clip layers rather
+    /// than in the stage, so writers that rewrite their time samples at the
+    /// end of the export must edit them in \p clipLayer instead.
+    ///
+    /// Base implementation does nothing.
+    MAYAUSD_CORE_PUBLIC
+    virtual void PostExportClip(const SdfLayerHandle& clipLayer);
+
     /// Whether this prim writer directly create one or more gprims on the
     /// current model on the USD stage. (Excludes cases where the prim writer
     /// introduces gprims via a reference or by adding a sub-model, such as in
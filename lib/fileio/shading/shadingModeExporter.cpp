@@ -22,7 +22,9 @@
 
 #include "pxr/base/tf/diagnostic.h"
 #include "pxr/base/tf/staticTokens.h"
+#include "pxr/base/tf/stringUtils.h"
 #include "pxr/base/tf/token.h"
+#include "pxr/base/work/loops.h"
 #include "pxr/usd/sdf/path.h"
 #include "pxr/usd/usd/collectionAPI.h"
 #include "pxr/usd/usd/prim.h"
@@ -31,10 +33,21 @@
 #include "pxr/usd/usdShade/materialBindingAPI.h"
 #include "pxr/usd/usdUtils/authoring.h"
 
+#include <maya/MFnAttribute.h>
+#include <maya/MFnDependencyNode.h>
+#include <maya/MItDependencyGraph.h>
 #include <maya/MItDependencyNodes.h>
 #include <maya/MObject.h>
-
+#include <maya/MObjectHandle.h>
+#include <maya/MPlug.h>
+#include <maya/MPlugArray.h>
+#include <maya/MStatus.h>
+#include <maya/MString.h>
+#include <maya/MStringArray.h>
+
+#include <functional>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -87,6 +100,243 @@ _GetRootPaths(const SdfPathSet& paths)
     return result;
 }
 
+namespace {
+
+/// A description of the shading network upstream of a shading engine that
+/// does not depend on the names of the Maya nodes in it. Two shading engines
+/// with equal fingerprints can share a single authored network.
+///
+/// An empty description means that the network should not be shared.
+struct _NetworkFingerprint
+{
+    std::string description;
+    size_t hash = 0u;
+
+    bool operator==(const _NetworkFingerprint& other) const {
+        return hash == other.hash && description == other.description;
+    }
+};
+
+struct _NetworkFingerprintHash
+{
+    size_t operator()(const _NetworkFingerprint& fingerprint) const {
+        return fingerprint.hash;
+    }
+};
+
+/// The nodes and connections of a shading network, as gathered from Maya.
+/// The nodes are indices into the table of node descriptions shared by all
+/// of the networks, in the order in which they were first visited, and the
+/// connections refer to nodes by their position in that list.
+struct _NetworkData
+{
+    std::vector<size_t> nodes;
+    std::vector<std::string> connections;
+};
+
+/// Descriptions of every node visited while gathering the networks, so that
+/// nodes shared by several networks are only described once.
+struct _NodeDescriptionTable
+{
+    UsdMayaUtil::MObjectHandleUnorderedMap<size_t> indices;
+    std::vector<std::string> descriptions;
+};
+
+} // anonymous namespace
+
+// Describes a shading node by its type and the values of its stored,
+// writable attributes that differ from their defaults.
+static
+std::string
+_DescribeShadingNode(const MObject& node)
+{
+    MStatus status;
+    const MFnDependencyNode depNodeFn(node, &status);
+    if (status != MS::kSuccess) {
+        return std::string();
+    }
+
+    std::string description = depNodeFn.typeName().asChar();
+
+    // The shading engine is authored as the material itself, so only its
+    // connections are part of the network.
+    if (node.hasFn(MFn::kShadingEngine)) {
+        return description;
+    }
+
+    MStringArray setAttrCmds;
+    const unsigned int numAttrs = depNodeFn.attributeCount();
+    for (unsigned int i = 0u; i < numAttrs; ++i) {
+        const MObject attrObj = depNodeFn.attribute(i);
+        const MFnAttribute attrFn(attrObj);
+        if (!attrFn.parent().isNull() ||
+                !attrFn.isStorable() ||
+                !attrFn.isWritable()) {
+            continue;
+        }
+
+        // MPlug::getSetAttrCmds() is not declared const.
+        MPlug plug = depNodeFn.findPlug(attrObj, true, &status);
+        if (status != MS::kSuccess) {
+            continue;
+        }
+
+        setAttrCmds.clear();
+        plug.getSetAttrCmds(setAttrCmds, MPlug::kChanged);
+        for (unsigned int j = 0u; j < setAttrCmds.length(); ++j) {
+            description += '\n';
+            description += setAttrCmds[j].asChar();
+        }
+    }
+
+    return description;
+}
+
+// Returns the position of \p node in \p network, adding it (and describing
+// it in \p nodeTable if no other network has visited it yet) if needed.
+static
+size_t
+_GetNetworkNodeIndex(
+        const MObject& node,
+        _NodeDescriptionTable& nodeTable,
+        _NetworkData& network)
+{
+    const MObjectHandle nodeHandle(node);
+    auto iter = nodeTable.indices.find(nodeHandle);
+    if (iter == nodeTable.indices.end()) {
+        iter = nodeTable.indices.emplace(
+            nodeHandle, nodeTable.descriptions.size()).first;
+        nodeTable.descriptions.push_back(_DescribeShadingNode(node));
+    }
+
+    const size_t tableIndex = iter->second;
+    for (size_t i = 0u; i < network.nodes.size(); ++i) {
+        if (network.nodes[i] == tableIndex) {
+            return i;
+        }
+    }
+
+    network.nodes.push_back(tableIndex);
+    return network.nodes.size() - 1u;
+}
+
+// Gathers the connections in the Maya dependency graph upstream of
+// \p rootPlug into \p network. This visits the graph the same way that the
+// shading mode exporters do when they author the network.
+static
+void
+_GatherShadingNetwork(
+        const MPlug& rootPlug,
+        _NodeDescriptionTable& nodeTable,
+        _NetworkData& network)
+{
+    if (rootPlug.isNull()) {
+        return;
+    }
+
+    // MItDependencyGraph takes a non-const MPlug as a constructor parameter,
+    // so we have to make a copy of rootPlug here.
+    MPlug rootPlugCopy(rootPlug);
+
+    MStatus status;
+    MItDependencyGraph iterDepGraph(
+        rootPlugCopy,
+        MFn::kInvalid,
+        MItDependencyGraph::Direction::kUpstream,
+        MItDependencyGraph::Traversal::kDepthFirst,
+        MItDependencyGraph::Level::kPlugLevel,
+        &status);
+    if (status != MS::kSuccess) {
+        return;
+    }
+
+    for (; !iterDepGraph.isDone(); iterDepGraph.next()) {
+        const MPlug dstPlug = iterDepGraph.thisPlug(&status);
+        if (status != MS::kSuccess || !dstPlug.isDestination()) {
+            continue;
+        }
+
+        MPlugArray srcPlugs;
+        dstPlug.connectedTo(
+            srcPlugs,
+            /* asDst = */ true,
+            /* asSrc = */ false,
+            &status);
+        if (status != MS::kSuccess || srcPlugs.length() == 0u) {
+            continue;
+        }
+        const MPlug srcPlug = srcPlugs[0u];
+
+        const size_t srcIndex =
+            _GetNetworkNodeIndex(srcPlug.node(), nodeTable, network);
+        const size_t dstIndex =
+            _GetNetworkNodeIndex(dstPlug.node(), nodeTable, network);
+
+        network.connections.push_back(TfStringPrintf(
+            "%zu.%s -> %zu.%s",
+            srcIndex,
+            srcPlug.partialName(
+                false, true, true, false, true, true).asChar(),
+            dstIndex,
+            dstPlug.partialName(
+                false, true, true, false, true, true).asChar()));
+    }
+}
+
+// Computes the fingerprint of the network of every shading engine in
+// \p shadingEngines.
+//
+// The Maya dependency graph can only be read from the main thread, so the
+// networks are first gathered serially, and then their fingerprints are
+// built and hashed in parallel.
+static
+std::vector<_NetworkFingerprint>
+_ComputeNetworkFingerprints(
+        UsdMayaShadingModeExportContext& context,
+        const std::vector<MObject>& shadingEngines)
+{
+    _NodeDescriptionTable nodeTable;
+    std::vector<_NetworkData> networks(shadingEngines.size());
+    for (size_t i = 0u; i < shadingEngines.size(); ++i) {
+        context.SetShadingEngine(shadingEngines[i]);
+        _GatherShadingNetwork(
+            context.GetSurfaceShaderPlug(), nodeTable, networks[i]);
+        _GatherShadingNetwork(
+            context.GetVolumeShaderPlug(), nodeTable, networks[i]);
+        _GatherShadingNetwork(
+            context.GetDisplacementShaderPlug(), nodeTable, networks[i]);
+    }
+    context.SetShadingEngine(MObject());
+
+    std::vector<_NetworkFingerprint> fingerprints(shadingEngines.size());
+    WorkParallelForN(
+        networks.size(),
+        [&networks, &nodeTable, &fingerprints](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                const _NetworkData& network = networks[i];
+
+                // Shading engines with nothing connected have nothing to
+                // share.
+                if (network.connections.empty()) {
+                    continue;
+                }
+
+                std::string& description = fingerprints[i].description;
+                for (const size_t tableIndex : network.nodes) {
+                    description += nodeTable.descriptions[tableIndex];
+                    description += "\n;\n";
+                }
+                for (const std::string& connection : network.connections) {
+                    description += connection;
+                    description += '\n';
+                }
+                fingerprints[i].hash = std::hash<std::string>()(description);
+            }
+        });
+
+    return fingerprints;
+}
+
 void
 UsdMayaShadingModeExporter::DoExport(
         UsdMayaWriteJobContext& writeJobContext,
@@ -95,8 +345,6 @@ UsdMayaShadingModeExporter::DoExport(
     const UsdMayaJobExportArgs& exportArgs = writeJobContext.GetArgs();
     const UsdStageRefPtr& stage = writeJobContext.GetUsdStage();
 
-    MItDependencyNodes shadingEngineIter(MFn::kShadingEngine);
-
     const SdfPath& materialCollectionsPath =
         exportArgs.exportMaterialCollections ?
             exportArgs.materialCollectionsPath :
@@ -125,15 +373,52 @@ UsdMayaShadingModeExporter::DoExport(
         SdfPathSet>>;
     MaterialAssignments matAssignments;
 
+    std::vector<MObject> shadingEngines;
+    for (MItDependencyNodes shadingEngineIter(MFn::kShadingEngine);
+            !shadingEngineIter.isDone(); shadingEngineIter.next()) {
+        shadingEngines.push_back(shadingEngineIter.thisNode());
+    }
+
+    // The fingerprints are computed after PreExport() since it may change
+    // which plugs of the shading engines the networks are found on.
+    std::vector<_NetworkFingerprint> fingerprints;
+    if (exportArgs.shareShadingNetworks && CanShareNetworks()) {
+        fingerprints = _ComputeNetworkFingerprints(context, shadingEngines);
+    }
+
+    // The first material exported for each network, which the materials of
+    // the shading engines with identical networks reference.
+    std::unordered_map<
+        _NetworkFingerprint,
+        UsdShadeMaterial,
+        _NetworkFingerprintHash> sharedMaterials;
+
     std::vector<UsdShadeMaterial> exportedMaterials;
-    for (; !shadingEngineIter.isDone(); shadingEngineIter.next()) {
-        MObject shadingEngine(shadingEngineIter.thisNode());
-        context.SetShadingEngine(shadingEngine);
+    for (size_t i = 0u; i < shadingEngines.size(); ++i) {
+        context.SetShadingEngine(shadingEngines[i]);
+
+        const _NetworkFingerprint* fingerprint =
+            (i < fingerprints.size() && !fingerprints[i].description.empty()) ?
+                &fingerprints[i] :
+                nullptr;
+
+        UsdShadeMaterial sharedMaterial;
+        if (fingerprint) {
+            const auto iter = sharedMaterials.find(*fingerprint);
+            if (iter != sharedMaterials.end()) {
+                sharedMaterial = iter->second;
+            }
+        }
+        context.SetSharedMaterial(sharedMaterial);
 
         UsdShadeMaterial mat;
         SdfPathSet boundPrimPaths;
         Export(context, &mat, &boundPrimPaths);
 
+        if (mat && fingerprint && !sharedMaterial) {
+            sharedMaterials.emplace(*fingerprint, mat);
+        }
+
         if (mat && !boundPrimPaths.empty()) {
             exportedMaterials.push_back(mat);
             matAssignments.push_back(std::make_pair(
@@ -142,6 +427,7 @@ UsdMayaShadingModeExporter::DoExport(
     }
 
     context.SetShadingEngine(MObject());
+    context.SetSharedMaterial(UsdShadeMaterial());
     PostExport(context);
 
     if ((materialCollectionsPrim || exportArgs.exportCollectionBasedBindings)
@@ -62,6 +62,16 @@ public:
             UsdShadeMaterial* const mat,
             SdfPathSet* const boundPrimPaths) = 0;
 
+    /// Whether Export authors the upstream shading network of the shading
+    /// engine, and can reference an identical network that was exported for
+    /// another shading engine instead (see
+    /// UsdMayaShadingModeExportContext::GetSharedMaterial()).
+    ///
+    /// Exporters that author data that depends on the bound prims, rather
+    /// than on the network alone, should not share networks.
+    MAYAUSD_CORE_PUBLIC
+    virtual bool CanShareNetworks() const { return false; }
+
     /// Called once, after Export is called for all shading engines.
     ///
     /// Because it is called after the per-shading-engine loop, the
@@ -27,6 +27,7 @@
 #include "pxr/base/vt/types.h"
 #include "pxr/usd/sdf/path.h"
 #include "pxr/usd/usd/prim.h"
+#include "pxr/usd/usd/references.h"
 #include "pxr/usd/usd/stage.h"
 #include "pxr/usd/usdGeom/scope.h"
 #include "pxr/usd/usdGeom/subset.h"
@@ -35,7 +36,6 @@
 #include "pxr/usd/usdShade/shader.h"
 
 #include <maya/MDagPath.h>
-#include <maya/MDagPathArray.h>
 #include <maya/MDGContext.h>
 #include <maya/MFnDagNode.h>
 #include <maya/MFnDependencyNode.h>
@@ -43,10 +43,12 @@
 #include <maya/MNamespace.h>
 #include <maya/MObject.h>
 #include <maya/MObjectArray.h>
+#include <maya/MObjectHandle.h>
 #include <maya/MPlug.h>
 #include <maya/MStatus.h>
 #include <maya/MString.h>
 
+#include <memory>
 #include <string>
 #include <utility>
 
@@ -224,68 +226,52 @@ UsdMayaShadingModeExportContext::GetDisplacementShader() const
         _displacementShaderPlugName);
 }
 
-UsdMayaShadingModeExportContext::AssignmentVector
-UsdMayaShadingModeExportContext::GetAssignments() const
+bool
+UsdMayaShadingModeExportContext::ReferenceSharedMaterial(
+        const UsdShadeMaterial& material) const
 {
-    AssignmentVector ret;
+    if (!_sharedMaterial || !material) {
+        return false;
+    }
 
-    MStatus status;
-    MFnDependencyNode seDepNode(_shadingEngine, &status);
-    if (!status) {
-        return ret;
+    // Shading engines in different namespaces can end up with the same
+    // material prim, which must not reference itself.
+    const SdfPath& sharedMaterialPath = _sharedMaterial.GetPath();
+    if (sharedMaterialPath == material.GetPath()) {
+        return false;
     }
 
-    MPlug dsmPlug = seDepNode.findPlug("dagSetMembers", true, &status);
-    if (!status) {
-        return ret;
+    return material.GetPrim().GetReferences().AddInternalReference(
+        sharedMaterialPath);
+}
+
+UsdMayaShadingModeExportContext::AssignmentVector
+UsdMayaShadingModeExportContext::GetAssignments() const
+{
+    if (!_assignmentTable) {
+        _BuildAssignmentTable();
     }
 
-    SdfPathSet seenBoundPrimPaths;
-    for (unsigned int i = 0; i < dsmPlug.numConnectedElements(); i++) {
-        MPlug dsmElemPlug(dsmPlug.connectionByPhysicalIndex(i));
-        MStatus status = MS::kFailure;
-        MPlug connectedPlug = UsdMayaUtil::GetConnected(dsmElemPlug);
-
-        // Maya connects shader bindings for instances based on element indices
-        // of the instObjGroups[x] or instObjGroups[x].objectGroups[y] plugs.
-        // The instance number is the index of instObjGroups[x]; the face set
-        // (if any) is the index of objectGroups[y].
-        if (connectedPlug.isElement() && connectedPlug.array().isChild()) {
-            // connectedPlug is instObjGroups[x].objectGroups[y] (or its
-            // equivalent), so go up two levels to get to instObjGroups[x].
-            MPlug objectGroups = connectedPlug.array();
-            MPlug instObjGroupsElem = objectGroups.parent();
-            connectedPlug = instObjGroupsElem;
-        }
-        // connectedPlug should be instObjGroups[x] here. Get the index.
-        unsigned int instanceNumber = connectedPlug.logicalIndex();
-
-        // Get the correct DAG path for this instance number.
-        MDagPathArray allDagPaths;
-        MDagPath::getAllPathsTo(connectedPlug.node(), allDagPaths);
-        if (instanceNumber >= allDagPaths.length()) {
-            TF_RUNTIME_ERROR(
-                    "Instance number is %d (from plug '%s') but node only has "
-                    "%d paths",
-                    instanceNumber,
-                    connectedPlug.name().asChar(),
-                    allDagPaths.length());
-            continue;
-        }
+    const auto iter = _assignmentTable->find(MObjectHandle(_shadingEngine));
+    if (iter == _assignmentTable->end()) {
+        return AssignmentVector();
+    }
+    return iter->second;
+}
 
-        MDagPath dagPath = allDagPaths[instanceNumber];
-        TF_VERIFY(dagPath.instanceNumber() == instanceNumber);
-        MFnDagNode dagNode(dagPath, &status);
-        if (!status) {
-            continue;
-        }
+void
+UsdMayaShadingModeExportContext::_BuildAssignmentTable() const
+{
+    auto table = std::make_shared<_AssignmentTable>();
 
-        auto iter = _dagPathToUsdMap.find(dagPath);
-        if (iter == _dagPathToUsdMap.end()) {
-            // Geometry w/ this material bound doesn't seem to exist in USD.
-            continue;
-        }
-        SdfPath usdPath = iter->second;
+    // Rather than walking the dagSetMembers of each shading engine in turn
+    // (and looking up every path to each member, and then every set that
+    // member belongs to), each exported DAG path is visited once, and its
+    // set memberships are distributed to all of its shading engines.
+    UsdMayaUtil::MObjectHandleUnorderedMap<SdfPathSet> seenBoundPrimPaths;
+    for (const auto& dagPathAndUsdPath : _dagPathToUsdMap) {
+        const MDagPath& dagPath = dagPathAndUsdPath.first;
+        SdfPath usdPath = dagPathAndUsdPath.second;
 
         // If usdModelRootOverridePath is not empty, replace the
         // root namespace with it.
@@ -295,11 +281,6 @@ UsdMayaShadingModeExportContext::GetAssignments() const
                 GetExportArgs().usdModelRootOverridePath);
         }
 
-        // If this path has already been processed, skip it.
-        if (!seenBoundPrimPaths.insert(usdPath).second) {
-            continue;
-        }
-
         // If the bound prim's path is not below a bindable root, skip it.
         if (SdfPathFindLongestPrefix(
 #if USD_VERSION_NUM >= 1911
@@ -312,9 +293,15 @@ UsdMayaShadingModeExportContext::GetAssignments() const
             continue;
         }
 
+        MStatus status;
+        MFnDagNode dagNode(dagPath, &status);
+        if (!status) {
+            continue;
+        }
+
         MObjectArray sgObjs, compObjs;
         status = dagNode.getConnectedSetsAndMembers(
-            instanceNumber,
+            dagPath.instanceNumber(),
             sgObjs,
             compObjs,
             true);
@@ -323,8 +310,11 @@ UsdMayaShadingModeExportContext::GetAssignments() const
         }
 
         for (unsigned int j = 0u; j < sgObjs.length(); ++j) {
-            // If the shading group isn't the one we're interested in, skip it.
-            if (sgObjs[j] != _shadingEngine) {
+            const MObjectHandle shadingEngine(sgObjs[j]);
+
+            // If this path has already been processed for the shading
+            // engine, skip it.
+            if (!seenBoundPrimPaths[shadingEngine].insert(usdPath).second) {
                 continue;
             }
 
@@ -336,10 +326,12 @@ UsdMayaShadingModeExportContext::GetAssignments() const
                     faceIndices.push_back(faceIt.index());
                 }
             }
-            ret.push_back(std::make_pair(usdPath, faceIndices));
+            (*table)[shadingEngine].push_back(
+                std::make_pair(usdPath, faceIndices));
         }
     }
-    return ret;
+
+    _assignmentTable = table;
 }
 
 static
@@ -29,10 +29,12 @@
 #include "pxr/usd/sdf/path.h"
 #include "pxr/usd/usd/prim.h"
 #include "pxr/usd/usd/stage.h"
+#include "pxr/usd/usdShade/material.h"
 
 #include <maya/MObject.h>
 #include <maya/MPlug.h>
 
+#include <memory>
 #include <string>
 #include <utility>
 #include <vector>
@@ -49,6 +51,25 @@ public:
     }
     MObject GetShadingEngine() const { return _shadingEngine; }
 
+    /// When shading networks are shared, this is the material that was
+    /// exported for an earlier shading engine whose upstream network is
+    /// identical to the current one's. Otherwise it is an invalid material.
+    void SetSharedMaterial(const UsdShadeMaterial& sharedMaterial) {
+        _sharedMaterial = sharedMaterial;
+    }
+    const UsdShadeMaterial& GetSharedMaterial() const {
+        return _sharedMaterial;
+    }
+
+    /// Authors an internal reference on \p material to the shared material,
+    /// so that it picks up the network that was already exported instead of
+    /// authoring it again.
+    ///
+    /// Returns false if there is no shared material, in which case the
+    /// exporter should author the network itself.
+    MAYAUSD_CORE_PUBLIC
+    bool ReferenceSharedMaterial(const UsdShadeMaterial& material) const;
+
     const UsdStageRefPtr& GetUsdStage() const { return _stage; }
 
     UsdMayaWriteJobContext& GetWriteJobContext() const {
@@ -105,6 +126,11 @@ public:
 
     /// Returns a vector of binding assignments associated with the shading
     /// engine.
+    ///
+    /// The assignments of every shading engine in the scene are gathered in
+    /// a single pass over the exported DAG paths the first time this is
+    /// called, and every later call (for this or any other shading engine
+    /// exported with this context) is a lookup into that table.
     MAYAUSD_CORE_PUBLIC
     AssignmentVector GetAssignments() const;
 
@@ -143,6 +169,7 @@ public:
 
 private:
     MObject _shadingEngine;
+    UsdShadeMaterial _sharedMaterial;
     const UsdStageRefPtr& _stage;
     const UsdMayaUtil::MDagPathMap<SdfPath>& _dagPathToUsdMap;
     UsdMayaWriteJobContext& _writeJobContext;
@@ -153,6 +180,14 @@ private:
     /// Shaders that are bound to prims under \p _bindableRoot paths will get
     /// exported. If \p bindableRoots is empty, it will export all.
     SdfPathSet _bindableRoots;
+
+    /// The assignments of every shading engine, built on demand by
+    /// GetAssignments().
+    using _AssignmentTable =
+        UsdMayaUtil::MObjectHandleUnorderedMap<AssignmentVector>;
+    mutable std::shared_ptr<const _AssignmentTable> _assignmentTable;
+
+    void _BuildAssignmentTable() const;
 };
 
 
@@ -106,6 +106,9 @@ _GetShadingPlugs()
 class PxrRisShadingModeExporter : public UsdMayaShadingModeExporter {
 public:
     PxrRisShadingModeExporter() {}
+
+    bool CanShareNetworks() const override { return true; }
+
 private:
 
     void
@@ -314,6 +317,12 @@ private:
             *mat = material;
         }
 
+        // An identical network was already authored for another shading
+        // engine, so this material only needs to reference it.
+        if (context.ReferenceSharedMaterial(material)) {
+            return;
+        }
+
         UsdRiMaterialAPI riMaterialAPI(materialPrim);
 
         MStatus status;
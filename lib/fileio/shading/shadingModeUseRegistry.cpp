@@ -63,6 +63,8 @@ class UseRegistryShadingModeExporter : public UsdMayaShadingModeExporter
 
         UseRegistryShadingModeExporter() {}
 
+        bool CanShareNetworks() const override { return true; }
+
     private:
 
         /// Gets a shader writer for \p depNode that authors its prim(s) under
@@ -368,6 +370,12 @@ class UseRegistryShadingModeExporter : public UsdMayaShadingModeExporter
                 *mat = material;
             }
 
+            // An identical network was already authored for another shading
+            // engine, so this material only needs to reference it.
+            if (context.ReferenceSharedMaterial(material)) {
+                return;
+            }
+
             UsdShadeShader surfaceShaderSchema =
                 _ExportShadingDepGraph(
                     material,
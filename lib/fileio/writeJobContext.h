@@ -68,6 +68,15 @@ public:
         return mStage;
     }
 
+    /// Whether the animated values of this export are streamed into value
+    /// clips (see UsdMayaJobExportArgs::clipFrameCount). This is only known
+    /// once the output file is opened, since the job falls back to writing
+    /// time samples into the output layer when clips can't be streamed.
+    bool IsStreamingClips() const
+    {
+        return mStreamClips;
+    }
+
     /// Whether we will merge the transform at \p path with its single
     /// exportable child shape, given its hierarchy and the current path
     /// translation rules. (This always returns false if the export args
@@ -161,6 +170,8 @@ protected:
     std::vector<UsdMayaPrimWriterSharedPtr> mMayaPrimWriterList;
     // Stage used to write out USD file
     UsdStageRefPtr mStage;
+    // Whether animated values are streamed into value clips
+    bool mStreamClips = false;
 
 private:
     /// A pair of paths, the first being the "export path", or where the
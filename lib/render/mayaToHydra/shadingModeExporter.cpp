@@ -40,6 +40,8 @@ public:
     MtohShadingModeExporter() = default;
     ~MtohShadingModeExporter() = default;
 
+    bool CanShareNetworks() const override { return true; }
+
 protected:
     bool _ExportNode(UsdStagePtr& stage, HdMaterialNode& hdNode) {
         UsdShadeShader shaderSchema =
@@ -140,6 +142,10 @@ public:
 
         if (mat != nullptr) { *mat = material; }
 
+        // An identical network was already authored for another shading
+        // engine, so this material only needs to reference it.
+        if (context.ReferenceSharedMaterial(material)) { return; }
+
         HdMaterialNetwork materialNetwork;
         HdMayaMaterialNetworkConverter converter(
             materialNetwork, materialPrim.GetPath());
@@ -20,6 +20,7 @@
 #include "pxr/pxr.h"
 #include "pxr/base/gf/vec3f.h"
 #include "pxr/base/vt/array.h"
+#include "pxr/base/vt/types.h"
 #include "pxr/imaging/hd/drawItem.h"
 #include "pxr/imaging/hd/mesh.h"
 #include "pxr/usd/usd/timeCode.h"
@@ -77,6 +78,13 @@ public:
 
         //! Whether or not the render item is using GPU instanced draw.
         bool                                        _usingInstancedDraw{ false };
+
+        //! Instance transforms last sent to the render item, before the world matrix is applied.
+        VtMatrix4dArray                             _instanceTransforms;
+        //! World matrix applied to the instance transforms last sent to the render item.
+        MMatrix                                     _instanceWorldMatrix;
+        //! Per-instance display colors last sent to the render item.
+        VtVec4fArray                                _instanceColors;
     };
 
     //! Bit fields indicating what the render item is created for. A render item
@@ -21,6 +21,7 @@
 #include "sampler.h"
 
 #include "pxr/imaging/hd/sceneDelegate.h"
+#include "pxr/imaging/hd/tokens.h"
 
 #include "pxr/base/gf/vec3f.h"
 #include "pxr/base/gf/vec4f.h"
@@ -28,6 +29,11 @@
 #include "pxr/base/gf/rotation.h"
 #include "pxr/base/gf/quaternion.h"
 #include "pxr/base/tf/staticTokens.h"
+#include "pxr/base/work/loops.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
 
 PXR_NAMESPACE_OPEN_SCOPE
 
@@ -42,6 +48,121 @@ TF_DEFINE_PRIVATE_TOKENS(
     (translate)
 );
 
+namespace {
+
+//! Arrays smaller than this are processed serially.
+constexpr size_t _kParallelThreshold = 1024;
+
+//! Runs the callback over [0, count), in parallel for large counts.
+template <typename Fn>
+void _ForN(size_t count, const Fn& fn)
+{
+    if (count < _kParallelThreshold) {
+        fn(0, count);
+    }
+    else {
+        WorkParallelForN(count, fn);
+    }
+}
+
+/*! \brief  Returns a contiguous array of T for the primvar buffer, converting
+            the elements only if the buffer doesn't store T already.
+*/
+template <typename T>
+const T* _GetPrimvarData(
+    const HdVtBufferSource* buffer,
+    std::vector<T>& storage,
+    size_t& count)
+{
+    count = 0;
+    if (!buffer) {
+        return nullptr;
+    }
+
+    const size_t numElements = buffer->GetNumElements();
+    if (buffer->GetTupleType() == HdVP2TypeHelper::GetTupleType<T>()) {
+        count = numElements;
+        return static_cast<const T*>(buffer->GetData());
+    }
+
+    HdVP2BufferSampler sampler(*buffer);
+    storage.resize(numElements);
+    for (; count < numElements; count++) {
+        if (!sampler.Sample(static_cast<int>(count), &storage[count])) {
+            break;
+        }
+    }
+
+    return storage.data();
+}
+
+/*! \brief  Composes scale * rotate * translate for each element in [begin, end),
+            followed by the optional instance transform.
+
+    The 3x3 part is built in closed form from the normalized quaternion with
+    single precision maths, avoiding three 4x4 double multiplications per
+    instance. The rotation matches GfMatrix4d::SetRotate() of the same quaternion.
+*/
+void _ComposeTransforms(
+    size_t begin, size_t end,
+    const GfVec3f* translates, size_t numTranslates,
+    const GfVec4f* rotates, size_t numRotates,
+    const GfVec3f* scales, size_t numScales,
+    const GfMatrix4d* instanceTransforms, size_t numInstanceTransforms,
+    GfMatrix4d* result)
+{
+    for (size_t i = begin; i < end; ++i) {
+        float m[3][3] = { { 1.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f }, { 0.0f, 0.0f, 1.0f } };
+
+        if (i < numRotates) {
+            // <real, i, j, k>
+            const GfVec4f& q = rotates[i];
+            const float lengthSq = q[0]*q[0] + q[1]*q[1] + q[2]*q[2] + q[3]*q[3];
+            if (lengthSq > 0.0f) {
+                const float invLength = 1.0f / std::sqrt(lengthSq);
+                const float r = q[0] * invLength;
+                const float x = q[1] * invLength;
+                const float y = q[2] * invLength;
+                const float z = q[3] * invLength;
+
+                m[0][0] = 1.0f - 2.0f * (y * y + z * z);
+                m[0][1] =        2.0f * (x * y + z * r);
+                m[0][2] =        2.0f * (z * x - y * r);
+                m[1][0] =        2.0f * (x * y - z * r);
+                m[1][1] = 1.0f - 2.0f * (z * z + x * x);
+                m[1][2] =        2.0f * (y * z + x * r);
+                m[2][0] =        2.0f * (z * x + y * r);
+                m[2][1] =        2.0f * (y * z - x * r);
+                m[2][2] = 1.0f - 2.0f * (y * y + x * x);
+            }
+        }
+
+        if (i < numScales) {
+            const GfVec3f& scale = scales[i];
+            for (int row = 0; row < 3; ++row) {
+                m[row][0] *= scale[row];
+                m[row][1] *= scale[row];
+                m[row][2] *= scale[row];
+            }
+        }
+
+        const GfVec3f translate = (i < numTranslates) ? translates[i] : GfVec3f(0.0f);
+
+        GfMatrix4d& xform = result[i];
+        xform.Set(
+            m[0][0], m[0][1], m[0][2], 0.0,
+            m[1][0], m[1][1], m[1][2], 0.0,
+            m[2][0], m[2][1], m[2][2], 0.0,
+            translate[0], translate[1], translate[2], 1.0);
+
+        if (i < numInstanceTransforms) {
+            xform = instanceTransforms[i] * xform;
+        }
+    }
+}
+
+} // anonymous namespace
+
 /*! \brief  Constructor.
 
     \param delegate     The scene delegate backing this instancer's data.
@@ -114,18 +235,124 @@ void HdVP2Instancer::_SyncPrimvars()
                 }
             }
 
+            // Cached transforms are computed again on next request
+            _localTransformsDirty = true;
+
             // Mark the instancer as clean
             changeTracker.MarkInstancerClean(id);
         }
     }
 }
 
+/*! \brief  Computes transforms for each element of the instance primvars,
+            without the instancer transform. Must be called with _transformsLock held.
+
+    The transforms for this level of instancer are computed by:
+    foreach(index : primvar elements) {
+        translate(index) * rotate(index) * scale(index) * instanceTransform(index)
+    }
+    If any transform isn't provided, it's assumed to be the identity.
+*/
+void HdVP2Instancer::_ComputeLocalTransforms()
+{
+    HD_TRACE_FUNCTION();
+
+    auto findPrimvar = [this](const TfToken& name) -> const HdVtBufferSource* {
+        auto it = _primvarMap.find(name);
+        return it != _primvarMap.end() ? it->second : nullptr;
+    };
+
+    std::vector<GfVec3f> translateStorage, scaleStorage;
+    std::vector<GfVec4f> rotateStorage;
+    std::vector<GfMatrix4d> instanceTransformStorage;
+
+    size_t numTranslates, numRotates, numScales, numInstanceTransforms;
+
+    // "translate" holds a translation vector for each index.
+    const GfVec3f* translates = _GetPrimvarData(
+        findPrimvar(_tokens->translate), translateStorage, numTranslates);
+    // "rotate" holds a quaternion in <real, i, j, k> format for each index.
+    const GfVec4f* rotates = _GetPrimvarData(
+        findPrimvar(_tokens->rotate), rotateStorage, numRotates);
+    // "scale" holds an axis-aligned scale vector for each index.
+    const GfVec3f* scales = _GetPrimvarData(
+        findPrimvar(_tokens->scale), scaleStorage, numScales);
+    // "instanceTransform" holds a 4x4 transform matrix for each index.
+    const GfMatrix4d* instanceTransforms = _GetPrimvarData(
+        findPrimvar(_tokens->instanceTransform), instanceTransformStorage,
+        numInstanceTransforms);
+
+    const size_t numElements = std::max(
+        std::max(numTranslates, numRotates),
+        std::max(numScales, numInstanceTransforms));
+
+    _localTransforms.resize(numElements);
+    GfMatrix4d* result = _localTransforms.data();
+
+    _ForN(numElements, [&](size_t begin, size_t end) {
+        _ComposeTransforms(begin, end,
+            translates, numTranslates,
+            rotates, numRotates,
+            scales, numScales,
+            instanceTransforms, numInstanceTransforms,
+            result);
+    });
+}
+
+/*! \brief  Returns transforms for each element of the instance primvars,
+            including the instancer transform.
+
+    The transforms are computed once per dirty state of the instancer and
+    shared by all prototypes. Call is thread safe.
+*/
+VtMatrix4dArray HdVP2Instancer::_GetInstancerTransforms(GfMatrix4d& instancerTransform)
+{
+    _SyncPrimvars();
+
+    instancerTransform = GetDelegate()->GetInstancerTransform(GetId());
+
+    std::lock_guard<std::mutex> lock(_transformsLock);
+
+    if (_localTransformsDirty.exchange(false)) {
+        _ComputeLocalTransforms();
+        _instancerTransformsDirty = true;
+    }
+
+    if (_instancerTransformsDirty || _cachedInstancerTransform != instancerTransform) {
+        _cachedInstancerTransform = instancerTransform;
+        _instancerTransformsDirty = false;
+
+        if (instancerTransform == GfMatrix4d(1.0)) {
+            _instancerTransforms = _localTransforms;
+        }
+        else {
+            const size_t numElements = _localTransforms.size();
+            const GfMatrix4d* local = _localTransforms.cdata();
+
+            _instancerTransforms.resize(numElements);
+            GfMatrix4d* result = _instancerTransforms.data();
+
+            _ForN(numElements, [&](size_t begin, size_t end) {
+                for (size_t i = begin; i < end; ++i) {
+                    result[i] = local[i] * instancerTransform;
+                }
+            });
+        }
+    }
+
+    return _instancerTransforms;
+}
+
 /*! \brief  Computes all instance transforms for the provided prototype id.
 
     Taking into account the scene delegate's instancerTransform and the
     instance primvars "instanceTransform", "translate", "rotate", "scale".
     Computes and flattens nested transforms, if necessary.
 
+    Transforms of the instancer are computed once and sliced by the instance
+    indices of each prototype, so prototypes sharing the instancer don't
+    multiply the work.
+
     \param prototypeId The prototype to compute transforms for.
         
     \return One transform per instance, to apply when drawing.
@@ -135,75 +362,28 @@ VtMatrix4dArray HdVP2Instancer::ComputeInstanceTransforms(SdfPath const &prototy
     HD_TRACE_FUNCTION();
     HF_MALLOC_TAG_FUNCTION();
 
-    _SyncPrimvars();
+    GfMatrix4d instancerTransform;
+    const VtMatrix4dArray instancerTransforms =
+        _GetInstancerTransforms(instancerTransform);
 
-    // The transforms for this level of instancer are computed by:
-    // foreach(index : indices) {
-    //     instancerTransform * translate(index) * rotate(index) *
-    //     scale(index) * instanceTransform(index)
-    // }
-    // If any transform isn't provided, it's assumed to be the identity.
-
-    GfMatrix4d instancerTransform =
-        GetDelegate()->GetInstancerTransform(GetId());
-    VtIntArray instanceIndices =
+    const VtIntArray instanceIndices =
         GetDelegate()->GetInstanceIndices(GetId(), prototypeId);
 
-    VtMatrix4dArray transforms(instanceIndices.size());
-    for (size_t i = 0; i < instanceIndices.size(); ++i) {
-        transforms[i] = instancerTransform;
-    }
-
-    // "translate" holds a translation vector for each index.
-    if (_primvarMap.count(_tokens->translate) > 0) {
-        HdVP2BufferSampler sampler(*_primvarMap[_tokens->translate]);
-        for (size_t i = 0; i < instanceIndices.size(); ++i) {
-            GfVec3f translate;
-            if (sampler.Sample(instanceIndices[i], &translate)) {
-                GfMatrix4d translateMat(1);
-                translateMat.SetTranslate(GfVec3d(translate));
-                transforms[i] = translateMat * transforms[i];
-            }
-        }
-    }
+    const size_t numInstances = instanceIndices.size();
+    const size_t numElements = instancerTransforms.size();
+    const int* indices = instanceIndices.cdata();
+    const GfMatrix4d* source = instancerTransforms.cdata();
 
-    // "rotate" holds a quaternion in <real, i, j, k> format for each index.
-    if (_primvarMap.count(_tokens->rotate) > 0) {
-        HdVP2BufferSampler sampler(*_primvarMap[_tokens->rotate]);
-        for (size_t i = 0; i < instanceIndices.size(); ++i) {
-            GfVec4f quat;
-            if (sampler.Sample(instanceIndices[i], &quat)) {
-                GfMatrix4d rotateMat(1);
-                rotateMat.SetRotate(GfRotation(GfQuaternion(
-                    quat[0], GfVec3d(quat[1], quat[2], quat[3]))));
-                transforms[i] = rotateMat * transforms[i];
-            }
-        }
-    }
+    VtMatrix4dArray transforms(numInstances);
+    GfMatrix4d* result = transforms.data();
 
-    // "scale" holds an axis-aligned scale vector for each index.
-    if (_primvarMap.count(_tokens->scale) > 0) {
-        HdVP2BufferSampler sampler(*_primvarMap[_tokens->scale]);
-        for (size_t i = 0; i < instanceIndices.size(); ++i) {
-            GfVec3f scale;
-            if (sampler.Sample(instanceIndices[i], &scale)) {
-                GfMatrix4d scaleMat(1);
-                scaleMat.SetScale(GfVec3d(scale));
-                transforms[i] = scaleMat * transforms[i];
-            }
-        }
-    }
-
-    // "instanceTransform" holds a 4x4 transform matrix for each index.
-    if (_primvarMap.count(_tokens->instanceTransform) > 0) {
-        HdVP2BufferSampler sampler(*_primvarMap[_tokens->instanceTransform]);
-        for (size_t i = 0; i < instanceIndices.size(); ++i) {
-            GfMatrix4d instanceTransform;
-            if (sampler.Sample(instanceIndices[i], &instanceTransform)) {
-                transforms[i] = instanceTransform * transforms[i];
-            }
+    _ForN(numInstances, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            const int index = indices[i];
+            result[i] = (index >= 0 && size_t(index) < numElements) ?
+                source[index] : instancerTransform;
         }
-    }
+    });
 
     if (GetParentId().IsEmpty()) {
         return transforms;
@@ -224,15 +404,75 @@ VtMatrix4dArray HdVP2Instancer::ComputeInstanceTransforms(SdfPath const &prototy
         static_cast<HdVP2Instancer*>(parentInstancer)->
             ComputeInstanceTransforms(GetId());
 
-    VtMatrix4dArray final(parentTransforms.size() * transforms.size());
-    for (size_t i = 0; i < parentTransforms.size(); ++i) {
-        for (size_t j = 0; j < transforms.size(); ++j) {
-            final[i * transforms.size() + j] = transforms[j] *
-                                               parentTransforms[i];
+    const size_t numParents = parentTransforms.size();
+    const GfMatrix4d* parents = parentTransforms.cdata();
+    const GfMatrix4d* children = transforms.cdata();
+
+    VtMatrix4dArray final(numParents * numInstances);
+    GfMatrix4d* flattened = final.data();
+
+    _ForN(numParents * numInstances, [&](size_t begin, size_t end) {
+        for (size_t k = begin; k < end; ++k) {
+            flattened[k] = children[k % numInstances] * parents[k / numInstances];
         }
-    }
+    });
     return final;
 }
 
+/*! \brief  Computes per-instance display colors for the provided prototype id.
+
+    Colors are read from the "displayColor" and "displayOpacity" instance
+    primvars of this level of instancer only.
+
+    \param prototypeId The prototype to compute colors for.
+
+    \return One color per instance, or an empty array if the instancer has no
+            display color.
+*/
+VtVec4fArray HdVP2Instancer::ComputeInstanceColors(SdfPath const &prototypeId)
+{
+    HD_TRACE_FUNCTION();
+    HF_MALLOC_TAG_FUNCTION();
+
+    _SyncPrimvars();
+
+    auto itColor = _primvarMap.find(HdTokens->displayColor);
+    if (itColor == _primvarMap.end()) {
+        return VtVec4fArray();
+    }
+
+    auto itOpacity = _primvarMap.find(HdTokens->displayOpacity);
+    const HdVtBufferSource* opacityBuffer =
+        itOpacity != _primvarMap.end() ? itOpacity->second : nullptr;
+
+    const VtIntArray instanceIndices =
+        GetDelegate()->GetInstanceIndices(GetId(), prototypeId);
+
+    const size_t numInstances = instanceIndices.size();
+    const int* indices = instanceIndices.cdata();
+
+    VtVec4fArray colors(numInstances);
+    GfVec4f* result = colors.data();
+
+    HdVP2BufferSampler colorSampler(*itColor->second);
+
+    _ForN(numInstances, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            // Match the 18% gray used by the fallback shader.
+            GfVec3f color(0.18f);
+            colorSampler.Sample(indices[i], &color);
+
+            float opacity = 1.0f;
+            if (opacityBuffer) {
+                HdVP2BufferSampler(*opacityBuffer).Sample(indices[i], &opacity);
+            }
+
+            result[i].Set(color[0], color[1], color[2], opacity);
+        }
+    });
+
+    return colors;
+}
+
 PXR_NAMESPACE_CLOSE_SCOPE
 
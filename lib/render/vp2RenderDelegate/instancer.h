@@ -23,9 +23,12 @@
 #include "pxr/imaging/hd/instancer.h"
 #include "pxr/imaging/hd/vtBufferSource.h"
 
+#include "pxr/base/gf/matrix4d.h"
 #include "pxr/base/tf/hashmap.h"
 #include "pxr/base/tf/token.h"
+#include "pxr/base/vt/types.h"
 
+#include <atomic>
 #include <mutex>
 
 PXR_NAMESPACE_OPEN_SCOPE
@@ -47,12 +50,37 @@ public:
 
     VtMatrix4dArray ComputeInstanceTransforms(SdfPath const &prototypeId);
 
+    VtVec4fArray ComputeInstanceColors(SdfPath const &prototypeId);
+
 private:
     void _SyncPrimvars();
+    VtMatrix4dArray _GetInstancerTransforms(GfMatrix4d& instancerTransform);
+    void _ComputeLocalTransforms();
 
     //! Mutex guard for _SyncPrimvars().
     std::mutex _instanceLock;
 
+    //! Mutex guard for the cached transforms.
+    std::mutex _transformsLock;
+
+    /*! Transforms for each element of the instance primvars, including the
+        instancer transform. They are computed once per dirty state and sliced
+        for each prototype by its instance indices.
+    */
+    VtMatrix4dArray _instancerTransforms;
+
+    //! Transforms for each element of the instance primvars, without the instancer transform.
+    VtMatrix4dArray _localTransforms;
+
+    //! Instancer transform used to compute _instancerTransforms.
+    GfMatrix4d _cachedInstancerTransform{ 1.0 };
+
+    //! Whether instance primvars changed since _localTransforms was computed.
+    std::atomic<bool> _localTransformsDirty{ true };
+
+    //! Whether _instancerTransforms needs to be recomputed.
+    bool _instancerTransformsDirty{ true };
+
     /*! Map of the latest primvar data for this instancer, keyed by
         primvar name. Primvar values are VtValue, an any-type; they are
         interpreted at consumption time (here, in ComputeInstanceTransforms).
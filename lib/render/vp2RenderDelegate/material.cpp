@@ -18,7 +18,6 @@
 #include "material.h"
 #include "render_delegate.h"
 
-#include "pxr/imaging/glf/image.h"
 #include "pxr/imaging/hd/sceneDelegate.h"
 #include "pxr/usd/ar/packageUtils.h"
 #include "pxr/usd/sdf/assetPath.h"
@@ -55,6 +54,7 @@ namespace {
 TF_DEFINE_PRIVATE_TOKENS(
     _tokens,
 
+    (fallback)
     (file)
     (opacity)
     (st)
@@ -293,107 +293,15 @@ MHWRender::MSamplerStateDesc _GetSamplerStateDesc(const HdMaterialNode& node)
     return desc;
 }
 
-//! Load texture from the specified path
-MHWRender::MTexture* _LoadTexture(
-    const std::string& path,
-    bool& isColorSpaceSRGB)
+//! Get fallback color of a UsdUVTexture, used until its texture is resident.
+GfVec4f _GetTextureFallbackColor(const HdMaterialNode& node)
 {
-    isColorSpaceSRGB = false;
-
-    MHWRender::MRenderer* const renderer = MHWRender::MRenderer::theRenderer();
-    MHWRender::MTextureManager* const textureMgr =
-        renderer ? renderer->getTextureManager() : nullptr;
-    if (!TF_VERIFY(textureMgr)) {
-        return nullptr;
-    }
-
-    GlfImageSharedPtr image = GlfImage::OpenForReading(path);
-    if (!TF_VERIFY(image)) {
-        return nullptr;
-    }
-
-    // GlfImage is used for loading pixel data from usdz only and should
-    // not trigger any OpenGL call. VP2RenderDelegate will transfer the
-    // texels to GPU memory with VP2 API which is 3D API agnostic.
-    GlfImage::StorageSpec spec;
-    spec.width = image->GetWidth();
-    spec.height = image->GetHeight();
-    spec.depth = 1;
-    spec.format = image->GetFormat();
-    spec.type = image->GetType();
-    spec.flipped = false;
-
-    const int bpp = image->GetBytesPerPixel();
-    const int bytesPerRow = spec.width * bpp;
-    const int bytesPerSlice = bytesPerRow * spec.height;
-
-    std::vector<unsigned char> storage(bytesPerSlice);
-    spec.data = storage.data();
-
-    if (!image->Read(spec)) {
-        return nullptr;
-    }
-
-    MHWRender::MTexture* texture = nullptr;
-
-    MHWRender::MTextureDescription desc;
-    desc.setToDefault2DTexture();
-    desc.fWidth = spec.width;
-    desc.fHeight = spec.height;
-    desc.fBytesPerRow = bytesPerRow;
-    desc.fBytesPerSlice = bytesPerSlice;
-
-    switch (spec.format)
-    {
-    case GL_RED:
-        desc.fFormat = (spec.type == GL_FLOAT ?
-            MHWRender::kR32_FLOAT : MHWRender::kR8_UNORM);
-        texture = textureMgr->acquireTexture(path.c_str(), desc, spec.data);
-        break;
-    case GL_RGB:
-        if (spec.type == GL_FLOAT) {
-            desc.fFormat = MHWRender::kR32G32B32_FLOAT;
-            texture = textureMgr->acquireTexture(path.c_str(), desc, spec.data);
-        }
-        else {
-            // R8G8B8 is not supported by VP2. Converted to R8G8B8A8.
-            constexpr int bpp_4 = 4;
-
-            desc.fFormat = MHWRender::kR8G8B8A8_UNORM;
-            desc.fBytesPerRow = spec.width * bpp_4;
-            desc.fBytesPerSlice = desc.fBytesPerRow * spec.height;
-
-            std::vector<unsigned char> texels(desc.fBytesPerSlice);
-
-            for (int y = 0; y < spec.height; y++) {
-                for (int x = 0; x < spec.width; x++) {
-                    const int t = spec.width * y + x;
-                    texels[t*bpp_4]     = storage[t*bpp];
-                    texels[t*bpp_4 + 1] = storage[t*bpp + 1];
-                    texels[t*bpp_4 + 2] = storage[t*bpp + 2];
-                    texels[t*bpp_4 + 3] = 255;
-                }
-            }
-
-            texture = textureMgr->acquireTexture(path.c_str(), desc, texels.data());
-            isColorSpaceSRGB = image->IsColorSpaceSRGB();
-        }
-        break;
-    case GL_RGBA:
-        if (spec.type == GL_FLOAT) {
-            desc.fFormat = MHWRender::kR32G32B32A32_FLOAT;
-        }
-        else {
-            desc.fFormat = MHWRender::kR8G8B8A8_UNORM;
-            isColorSpaceSRGB = image->IsColorSpaceSRGB();
-        }
-        texture = textureMgr->acquireTexture(path.c_str(), desc, spec.data);
-        break;
-    default:
-        break;
+    auto it = node.parameters.find(_tokens->fallback);
+    if (it != node.parameters.end() && it->second.IsHolding<GfVec4f>()) {
+        return it->second.UncheckedGet<GfVec4f>();
     }
 
-    return texture;
+    return GfVec4f(0.0f, 0.0f, 0.0f, 1.0f);
 }
 
 } //anonymous namespace
@@ -411,19 +319,6 @@ HdVP2ShaderDeleter::operator()(MHWRender::MShaderInstance* shader)
     }
 }
 
-/*! \brief  Releases the reference to the texture owned by a smart pointer.
-*/
-void
-HdVP2TextureDeleter::operator()(MHWRender::MTexture* texture)
-{
-    MRenderer* const renderer = MRenderer::theRenderer();
-    MHWRender::MTextureManager* const textureMgr =
-        renderer ? renderer->getTextureManager() : nullptr;
-    if (TF_VERIFY(textureMgr)) {
-        textureMgr->releaseTexture(texture);
-    }
-}
-
 /*! \brief  Constructor
 */
 HdVP2Material::HdVP2Material(HdVP2RenderDelegate* renderDelegate, const SdfPath& id)
@@ -432,6 +327,13 @@ HdVP2Material::HdVP2Material(HdVP2RenderDelegate* renderDelegate, const SdfPath&
 {
 }
 
+/*! \brief  Destructor, stops waiting for textures to become resident.
+*/
+HdVP2Material::~HdVP2Material()
+{
+    _renderDelegate->RemovePendingMaterial(GetId());
+}
+
 /*! \brief  Synchronize VP2 state with scene delegate state based on dirty bits
 */
 void HdVP2Material::Sync(
@@ -712,6 +614,11 @@ void HdVP2Material::_UpdateShaderInstance(const HdMaterialNetwork& mat)
         return;
     }
 
+    // Textures still referenced by the network are moved to the new map, so
+    // that the registry can release textures which are no longer used.
+    HdVP2TextureMap textureMap;
+    std::vector<HdVP2TextureHandle> pendingTextures;
+
     for (const HdMaterialNode& node : mat.nodes) {
         const MString nodeName =
             node.path != _surfaceShaderId ? node.path.GetName().c_str() : "";
@@ -773,17 +680,32 @@ void HdVP2Material::_UpdateShaderInstance(const HdMaterialNetwork& mat)
                 const std::string& resolvedPath = val.GetResolvedPath();
                 const std::string& assetPath = val.GetAssetPath();
                 if (_IsUsdUVTexture(node) && token == _tokens->file) {
-                    const HdVP2TextureInfo& info = _AcquireTexture(
-                        !resolvedPath.empty() ? resolvedPath : assetPath);
+                    const HdVP2TextureHandle& texture = _AcquireTexture(
+                        !resolvedPath.empty() ? resolvedPath : assetPath,
+                        textureMap);
 
+                    // Bind the fallback color until the texture is resident.
                     MHWRender::MTextureAssignment assignment;
-                    assignment.texture = info._texture.get();
+                    bool isColorSpaceSRGB = false;
+                    if (texture->IsResident()) {
+                        const HdVP2TextureInfo& info = texture->GetInfo();
+                        assignment.texture = info._texture.get();
+                        isColorSpaceSRGB = info._isColorSpaceSRGB;
+                    }
+                    else {
+                        assignment.texture = _renderDelegate->GetTextureRegistry()
+                            .GetFallbackTexture(_GetTextureFallbackColor(node));
+                        if (!texture->IsSettled()) {
+                            pendingTextures.push_back(texture);
+                        }
+                    }
+
                     status = _surfaceShader->setParameter(paramName, assignment);
 
                     if (status) {
                         paramName = nodeName + "isColorSpaceSRGB";
                         status = _surfaceShader->setParameter(paramName,
-                            info._isColorSpaceSRGB);
+                            isColorSpaceSRGB);
                     }
                 }
             }
@@ -812,25 +734,39 @@ void HdVP2Material::_UpdateShaderInstance(const HdMaterialNetwork& mat)
             }
         }
     }
+
+    _textureMap.swap(textureMap);
+
+    // Ask to be synchronized again once all textures are resident.
+    if (!pendingTextures.empty() && !GetId().IsEmpty()) {
+        _renderDelegate->AddPendingMaterial(GetId(), std::move(pendingTextures));
+    }
 }
 
-/*! \brief  Acquires a texture for the given image path.
+/*! \brief  Acquires a shared texture for the given image path and stores
+            it in the given texture map.
 */
-const HdVP2TextureInfo&
-HdVP2Material::_AcquireTexture(const std::string& path)
+const HdVP2TextureHandle&
+HdVP2Material::_AcquireTexture(
+    const std::string& path,
+    HdVP2TextureMap& textureMap)
 {
-    const auto it = _textureMap.find(path);
-    if (it != _textureMap.end()) {
+    auto it = textureMap.find(path);
+    if (it != textureMap.end()) {
         return it->second;
     }
 
-    bool isSRGB = false;
-    MHWRender::MTexture* texture = _LoadTexture(path, isSRGB);
+    HdVP2TextureHandle& texture = textureMap[path];
 
-    HdVP2TextureInfo& info = _textureMap[path];
-    info._texture.reset(texture);
-    info._isColorSpaceSRGB = isSRGB;
-    return info;
+    it = _textureMap.find(path);
+    if (it != _textureMap.end()) {
+        texture = it->second;
+    }
+    else {
+        texture = _renderDelegate->GetTextureRegistry().Acquire(path);
+    }
+
+    return texture;
 }
 
 PXR_NAMESPACE_CLOSE_SCOPE
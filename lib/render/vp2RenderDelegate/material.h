@@ -20,6 +20,8 @@
 #include "pxr/pxr.h"
 #include "pxr/imaging/hd/material.h"
 
+#include "textureRegistry.h"
+
 #include <maya/MShaderManager.h>
 
 #include <unordered_map>
@@ -43,31 +45,9 @@ using HdVP2ShaderUniquePtr = std::unique_ptr<
     HdVP2ShaderDeleter
 >;
 
-/*! \brief  A deleter for MTexture, for use with smart pointers.
-*/
-struct HdVP2TextureDeleter
-{
-    void operator () (MHWRender::MTexture*);
-};
-
-/*! \brief  A MTexture owned by a std unique pointer.
-*/
-using HdVP2TextureUniquePtr = std::unique_ptr<
-    MHWRender::MTexture,
-    HdVP2TextureDeleter
->;
-
-/*! \brief  Information about the texture.
-*/
-struct HdVP2TextureInfo
-{
-    HdVP2TextureUniquePtr  _texture;          //!< Unique pointer of the texture
-    bool                   _isColorSpaceSRGB; //!< Whether sRGB linearization is needed
-};
-
-/*! \brief  An unordered string-indexed map to cache texture information.
+/*! \brief  An unordered string-indexed map of shared textures used by a material.
 */
-using HdVP2TextureMap = std::unordered_map<std::string, HdVP2TextureInfo>;
+using HdVP2TextureMap = std::unordered_map<std::string, HdVP2TextureHandle>;
 
 /*! \brief  A VP2-specific implementation for a Hydra material prim.
     \class  HdVP2Material
@@ -79,7 +59,7 @@ public:
     HdVP2Material(HdVP2RenderDelegate*, const SdfPath&);
 
     //! Destructor.
-    ~HdVP2Material() override = default;
+    ~HdVP2Material() override;
 
     void Sync(HdSceneDelegate*, HdRenderParam*, HdDirtyBits*) override;
 
@@ -99,13 +79,14 @@ public:
 private:
     MHWRender::MShaderInstance* _CreateShaderInstance(const HdMaterialNetwork& mat);
     void _UpdateShaderInstance(const HdMaterialNetwork& mat);
-    const HdVP2TextureInfo& _AcquireTexture(const std::string& path);
+    const HdVP2TextureHandle& _AcquireTexture(
+        const std::string& path, HdVP2TextureMap& textureMap);
 
     HdVP2RenderDelegate* const _renderDelegate; //!< VP2 render delegate for which this material was created
 
     HdVP2ShaderUniquePtr  _surfaceShader;       //!< VP2 surface shader instance
     SdfPath               _surfaceShaderId;     //!< Path of the surface shader
-    HdVP2TextureMap       _textureMap;          //!< Textures used by this material
+    HdVP2TextureMap       _textureMap;          //!< Shared textures used by this material
     TfTokenVector         _requiredPrimvars;    //!< primvars required by this material
 };
 
@@ -35,6 +35,7 @@
 #include <maya/MSelectionMask.h>
 
 #include <numeric>
+#include <vector>
 
 PXR_NAMESPACE_OPEN_SCOPE
 
@@ -90,9 +91,19 @@ namespace {
         //! Instancing doesn't have dirty bits, every time we do update, we must update instance transforms
         MMatrixArray _instanceTransforms;
 
+        //! If true, _instanceTransforms only holds the transforms of the
+        //! instances listed in _dirtyInstanceIndices, in the same order.
+        bool _instanceTransformsPartial{ false };
+
+        //! Zero-based ids of the instances whose transform changed.
+        std::vector<unsigned int> _dirtyInstanceIndices;
+
         //! Color array to support per-instance color and selection highlight.
         MFloatArray _instanceColors;
 
+        //! Shader parameter receiving _instanceColors.
+        MString _instanceColorParameter{ kSolidColorStr };
+
         //! If valid, new shader instance to set
         MHWRender::MShaderInstance* _shader{ nullptr };
 
@@ -1234,13 +1245,54 @@ void HdVP2Mesh::_UpdateDrawItem(
         }
         else {
             const unsigned int instanceCount = transforms.size();
-            stateToCommit._instanceTransforms.setLength(instanceCount);
-            for (size_t i = 0; i < instanceCount; ++i) {
-                transforms[i].Get(instanceMatrix.matrix);
-                instanceMatrix = worldMatrix * instanceMatrix;
-                stateToCommit._instanceTransforms[i] = instanceMatrix;
+
+            // Once GPU instancing is in use with the same number of instances,
+            // only the transforms which changed since last commit are sent.
+            bool partialUpdate = drawItemData._usingInstancedDraw &&
+                drawItemData._instanceCount == instanceCount &&
+                drawItemData._instanceTransforms.size() == instanceCount &&
+                drawItemData._instanceWorldMatrix == worldMatrix;
+
+            if (partialUpdate) {
+                const GfMatrix4d* newTransforms = transforms.cdata();
+                const GfMatrix4d* oldTransforms = drawItemData._instanceTransforms.cdata();
+
+                // ComputeInstanceTransforms always returns a new array, so the
+                // contents have to be compared to find the changed instances.
+                auto& dirtyIndices = stateToCommit._dirtyInstanceIndices;
+                for (unsigned int i = 0; i < instanceCount; ++i) {
+                    if (newTransforms[i] != oldTransforms[i]) {
+                        dirtyIndices.push_back(i);
+                    }
+                }
+
+                // Uploading the whole array is cheaper than many single updates.
+                partialUpdate = stateToCommit._dirtyInstanceIndices.size() <= instanceCount / 2;
+            }
+
+            if (partialUpdate) {
+                const auto& dirtyIndices = stateToCommit._dirtyInstanceIndices;
+                stateToCommit._instanceTransforms.setLength(dirtyIndices.size());
+                for (size_t i = 0; i < dirtyIndices.size(); ++i) {
+                    transforms[dirtyIndices[i]].Get(instanceMatrix.matrix);
+                    instanceMatrix = worldMatrix * instanceMatrix;
+                    stateToCommit._instanceTransforms[i] = instanceMatrix;
+                }
+            }
+            else {
+                stateToCommit._dirtyInstanceIndices.clear();
+                stateToCommit._instanceTransforms.setLength(instanceCount);
+                for (size_t i = 0; i < instanceCount; ++i) {
+                    transforms[i].Get(instanceMatrix.matrix);
+                    instanceMatrix = worldMatrix * instanceMatrix;
+                    stateToCommit._instanceTransforms[i] = instanceMatrix;
+                }
             }
 
+            stateToCommit._instanceTransformsPartial = partialUpdate;
+            drawItemData._instanceTransforms = transforms;
+            drawItemData._instanceWorldMatrix = worldMatrix;
+
             // If the item is used for both regular draw and selection highlight,
             // it needs to display both wireframe color and selection highlight
             // with one color vertex buffer.
@@ -1266,6 +1318,37 @@ void HdVP2Mesh::_UpdateDrawItem(
                     }
                 }
             }
+            // Per-instance display colors drive the fallback shader when there
+            // is no material. They are sent only when they change.
+            else if (drawItem->ContainsUsage(HdVP2DrawItem::kRegular)) {
+                const HdVP2Material* material = static_cast<const HdVP2Material*>(
+                    renderIndex.GetSprim(HdPrimTypeTokens->material, GetMaterialId())
+                );
+
+                VtVec4fArray colors;
+                if (!material || !material->GetSurfaceShader()) {
+                    colors = static_cast<HdVP2Instancer*>(instancer)->
+                        ComputeInstanceColors(id);
+                }
+
+                // Nested instancing flattens parent-major, repeat the colors
+                // of this level for each parent instance.
+                const size_t numColors = colors.size();
+                if (numColors > 0 && instanceCount % numColors == 0 &&
+                    (!partialUpdate || colors != drawItemData._instanceColors)) {
+                    unsigned int offset = 0;
+                    stateToCommit._instanceColors.setLength(instanceCount * kNumColorChannels);
+                    for (unsigned int i = 0; i < instanceCount; ++i) {
+                        const GfVec4f& color = colors[i % numColors];
+                        for (unsigned int j = 0; j < kNumColorChannels; j++) {
+                            stateToCommit._instanceColors[offset++] = color[j];
+                        }
+                    }
+                    stateToCommit._instanceColorParameter = kDiffuseColorStr;
+                }
+
+                drawItemData._instanceColors = colors;
+            }
         }
     }
     else {
@@ -1419,12 +1502,20 @@ void HdVP2Mesh::_UpdateDrawItem(
 
         // Important, update instance transforms after setting geometry on render items!
         auto& oldInstanceCount = stateToCommit._drawItemData._instanceCount;
-        auto newInstanceCount = stateToCommit._instanceTransforms.length();
+        auto newInstanceCount = stateToCommit._instanceTransformsPartial ?
+            oldInstanceCount : stateToCommit._instanceTransforms.length();
 
         // GPU instancing has been enabled. We cannot switch to consolidation
         // without recreating render item, so we keep using GPU instancing.
         if (stateToCommit._drawItemData._usingInstancedDraw) {
-            if (oldInstanceCount == newInstanceCount) {
+            if (stateToCommit._instanceTransformsPartial) {
+                const auto& dirtyIndices = stateToCommit._dirtyInstanceIndices;
+                for (size_t i = 0; i < dirtyIndices.size(); i++) {
+                    // VP2 defines instance ID of the first instance to be 1.
+                    drawScene.updateInstanceTransform(*renderItem,
+                        dirtyIndices[i]+1, stateToCommit._instanceTransforms[i]);
+                }
+            } else if (oldInstanceCount == newInstanceCount) {
                 for (unsigned int i = 0; i < newInstanceCount; i++) {
                     // VP2 defines instance ID of the first instance to be 1.
                     drawScene.updateInstanceTransform(*renderItem,
@@ -1438,7 +1529,7 @@ void HdVP2Mesh::_UpdateDrawItem(
             if (stateToCommit._instanceColors.length() ==
                 newInstanceCount * kNumColorChannels) {
                 drawScene.setExtraInstanceData(*renderItem,
-                    kSolidColorStr, stateToCommit._instanceColors);
+                    stateToCommit._instanceColorParameter, stateToCommit._instanceColors);
             }
         }
         else if (newInstanceCount > 1) {
@@ -1451,7 +1542,7 @@ void HdVP2Mesh::_UpdateDrawItem(
             if (stateToCommit._instanceColors.length() ==
                 newInstanceCount * kNumColorChannels) {
                 drawScene.setExtraInstanceData(*renderItem,
-                    kSolidColorStr, stateToCommit._instanceColors);
+                    stateToCommit._instanceColorParameter, stateToCommit._instanceColors);
             }
 
             stateToCommit._drawItemData._usingInstancedDraw = true;
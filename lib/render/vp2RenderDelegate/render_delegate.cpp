@@ -26,13 +26,16 @@
 
 #include "pxr/imaging/hd/bprim.h"
 #include "pxr/imaging/hd/camera.h"
+#include "pxr/imaging/hd/changeTracker.h"
 #include "pxr/imaging/hd/instancer.h"
 #include "pxr/imaging/hd/resourceRegistry.h"
 #include "pxr/imaging/hd/rprim.h"
 #include "pxr/imaging/hd/tokens.h"
 
+#include <maya/MGlobal.h>
 #include <maya/MProfiler.h>
 
+#include <algorithm>
 #include <unordered_map>
 
 #include "tbb/spin_rw_mutex.h"
@@ -364,6 +367,8 @@ namespace
 
     const HdVP2BBoxGeom* sSharedBBoxGeom = nullptr; //!< Shared geometry for all Rprims to display bounding box
 
+    HdVP2TextureRegistry* sTextureRegistry = nullptr; //!< Textures shared by materials of all render delegates
+
 } // namespace
 
 const int HdVP2RenderDelegate::sProfilerCategory = MProfiler::addCategory(
@@ -394,6 +399,10 @@ HdVP2RenderDelegate::HdVP2RenderDelegate(ProxyRenderDelegate& drawScene) {
         if (TF_VERIFY(sSharedBBoxGeom == nullptr)) {
             sSharedBBoxGeom = new HdVP2BBoxGeom();
         }
+
+        if (TF_VERIFY(sTextureRegistry == nullptr)) {
+            sTextureRegistry = new HdVP2TextureRegistry();
+        }
     }
 
     _renderParam.reset(new HdVP2RenderParam(drawScene));
@@ -413,6 +422,11 @@ HdVP2RenderDelegate::~HdVP2RenderDelegate() {
             delete sSharedBBoxGeom;
             sSharedBBoxGeom = nullptr;
         }
+
+        if (TF_VERIFY(sTextureRegistry)) {
+            delete sTextureRegistry;
+            sTextureRegistry = nullptr;
+        }
     }
 }
 
@@ -447,6 +461,38 @@ void HdVP2RenderDelegate::CommitResources(HdChangeTracker* tracker) {
     //     3) Update any scene-level acceleration structures.
 
     _resourceRegistryVP2.Commit();
+
+    // Upload textures read by worker threads and release unused ones.
+    sTextureRegistry->Commit();
+
+    // Materials whose textures became resident are synchronized again to bind
+    // them in place of the fallback textures.
+    bool materialsDirtied = false;
+    {
+        std::lock_guard<std::mutex> guard(_pendingMaterialsMutex);
+
+        for (auto it = _pendingMaterials.begin(); it != _pendingMaterials.end(); ) {
+            const auto& textures = it->second;
+            const bool settled = std::all_of(textures.begin(), textures.end(),
+                [](const HdVP2TextureHandle& texture) { return texture->IsSettled(); });
+
+            if (settled) {
+                if (tracker) {
+                    tracker->MarkSprimDirty(it->first, HdMaterial::DirtyParams);
+                    materialsDirtied = true;
+                }
+                it = _pendingMaterials.erase(it);
+            }
+            else {
+                ++it;
+            }
+        }
+    }
+
+    // Dirty materials are synchronized during the next update only.
+    if (materialsDirtied) {
+        MGlobal::executeCommandOnIdle("refresh");
+    }
 }
 
 /*! \brief  Return a list of which Rprim types can be created by this class's.
@@ -794,6 +840,34 @@ const MHWRender::MSamplerState* HdVP2RenderDelegate::GetSamplerState(
     return samplerState;
 }
 
+/*! \brief  Returns the texture registry shared by all render delegates.
+*/
+HdVP2TextureRegistry& HdVP2RenderDelegate::GetTextureRegistry() const
+{
+    return *sTextureRegistry;
+}
+
+/*! \brief  Registers a material waiting for textures to become resident.
+
+    The material will be marked dirty during commit of resources once all the
+    given textures are resident or failed to load. Call is thread safe.
+*/
+void HdVP2RenderDelegate::AddPendingMaterial(
+    const SdfPath& materialId,
+    std::vector<HdVP2TextureHandle>&& textures)
+{
+    std::lock_guard<std::mutex> guard(_pendingMaterialsMutex);
+    _pendingMaterials[materialId] = std::move(textures);
+}
+
+/*! \brief  Unregisters a material waiting for textures, e.g. when destroyed.
+*/
+void HdVP2RenderDelegate::RemovePendingMaterial(const SdfPath& materialId)
+{
+    std::lock_guard<std::mutex> guard(_pendingMaterialsMutex);
+    _pendingMaterials.erase(materialId);
+}
+
 /*! \brief  Returns the shared bbox geometry.
 */
 const HdVP2BBoxGeom& HdVP2RenderDelegate::GetSharedBBoxGeom() const
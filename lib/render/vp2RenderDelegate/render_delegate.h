@@ -23,12 +23,15 @@
 
 #include "render_param.h"
 #include "resource_registry.h"
+#include "textureRegistry.h"
 
 #include <maya/MString.h>
 #include <maya/MShaderManager.h>
 
 #include <mutex>
 #include <atomic>
+#include <unordered_map>
+#include <vector>
 
 PXR_NAMESPACE_OPEN_SCOPE
 
@@ -120,6 +123,12 @@ public:
 
     const HdVP2BBoxGeom& GetSharedBBoxGeom() const;
 
+    HdVP2TextureRegistry& GetTextureRegistry() const;
+
+    void AddPendingMaterial(const SdfPath& materialId,
+        std::vector<HdVP2TextureHandle>&& textures);
+    void RemovePendingMaterial(const SdfPath& materialId);
+
     static const int sProfilerCategory;                             //!< Profiler category
 
 private:
@@ -133,6 +142,10 @@ private:
     std::unique_ptr<HdVP2RenderParam>     _renderParam;             //!< Render param used to provided access to VP2 during prim synchronization
     SdfPath                               _id;                      //!< Render delegate IDs
     HdVP2ResourceRegistry                 _resourceRegistryVP2;     //!< VP2 resource registry used for enqueue and execution of commits
+
+    //! Materials waiting for their textures to become resident, indexed by material id
+    std::unordered_map<SdfPath, std::vector<HdVP2TextureHandle>, SdfPath::Hash> _pendingMaterials;
+    std::mutex                            _pendingMaterialsMutex;   //!< Mutex protecting pending materials from concurrent material sync
 };
 
 PXR_NAMESPACE_CLOSE_SCOPE
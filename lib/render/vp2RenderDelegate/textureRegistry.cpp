@@ -0,0 +1,437 @@
+//
+// Copyright 2020 Autodesk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "textureRegistry.h"
+#include "debugCodes.h"
+
+#include "pxr/imaging/glf/image.h"
+#include "pxr/base/tf/diagnostic.h"
+#include "pxr/base/tf/envSetting.h"
+#include "pxr/base/tf/stringUtils.h"
+
+#include <maya/MGlobal.h>
+#include <maya/MProfiler.h>
+#include <maya/MViewport2Renderer.h>
+
+#include <boost/functional/hash.hpp>
+
+#include <algorithm>
+
+PXR_NAMESPACE_OPEN_SCOPE
+
+TF_DEFINE_ENV_SETTING(HDVP2_TEXTURE_MEMORY_BUDGET_MB, 0,
+    "GPU memory budget in megabytes for textures of VP2 materials. Textures "
+    "loaded once the budget is exceeded are down-sampled until they fit. "
+    "0 means no budget.");
+
+namespace {
+
+//! Textures are never down-sampled below this size to fit the budget.
+constexpr int _kMinDownsampledSize = 32;
+
+//! Helper utility function to return the texture manager.
+MHWRender::MTextureManager* _GetTextureManager()
+{
+    MHWRender::MRenderer* const renderer = MHWRender::MRenderer::theRenderer();
+    return renderer ? renderer->getTextureManager() : nullptr;
+}
+
+//! Halve the texels with a 2x2 box filter. Odd trailing rows and columns are dropped.
+template <typename T>
+void _Downsample(
+    std::vector<unsigned char>& storage,
+    int& width,
+    int& height,
+    int channels)
+{
+    const int newWidth = width / 2;
+    const int newHeight = height / 2;
+
+    const T* src = reinterpret_cast<const T*>(storage.data());
+    std::vector<unsigned char> result(sizeof(T) * newWidth * newHeight * channels);
+    T* dst = reinterpret_cast<T*>(result.data());
+
+    for (int y = 0; y < newHeight; y++) {
+        const T* row0 = src + (2 * y) * width * channels;
+        const T* row1 = row0 + width * channels;
+
+        for (int x = 0; x < newWidth; x++) {
+            for (int c = 0; c < channels; c++) {
+                const int i0 = (2 * x) * channels + c;
+                const int i1 = i0 + channels;
+                const float sum = float(row0[i0]) + float(row0[i1]) +
+                                  float(row1[i0]) + float(row1[i1]);
+                dst[(y * newWidth + x) * channels + c] = T(sum * 0.25f);
+            }
+        }
+    }
+
+    storage.swap(result);
+    width = newWidth;
+    height = newHeight;
+}
+
+} // anonymous namespace
+
+/*! \brief  Releases the reference to the texture owned by a smart pointer.
+*/
+void
+HdVP2TextureDeleter::operator()(MHWRender::MTexture* texture)
+{
+    MHWRender::MTextureManager* const textureMgr = _GetTextureManager();
+    if (TF_VERIFY(textureMgr)) {
+        textureMgr->releaseTexture(texture);
+    }
+}
+
+/*! \brief  Hash of a fallback color.
+*/
+size_t
+HdVP2TextureRegistry::_ColorHash::operator()(const GfVec4f& color) const
+{
+    std::size_t seed = 0;
+    boost::hash_combine(seed, color[0]);
+    boost::hash_combine(seed, color[1]);
+    boost::hash_combine(seed, color[2]);
+    boost::hash_combine(seed, color[3]);
+    return seed;
+}
+
+/*! \brief  Constructor.
+*/
+HdVP2TextureRegistry::HdVP2TextureRegistry()
+    : _budgetBytes(size_t(std::max(0, TfGetEnvSetting(HDVP2_TEXTURE_MEMORY_BUDGET_MB))) << 20)
+    , _dispatcher(new WorkDispatcher)
+{
+}
+
+/*! \brief  Destructor.
+*/
+HdVP2TextureRegistry::~HdVP2TextureRegistry()
+{
+    Clear();
+}
+
+/*! \brief  Returns a shared texture for the given path.
+
+    The first request for a path schedules reading of the file on a worker
+    thread, following requests share the same entry. Call is thread safe.
+*/
+HdVP2TextureHandle
+HdVP2TextureRegistry::Acquire(const std::string& path)
+{
+    // Look for it first with reader lock
+    tbb::spin_rw_mutex::scoped_lock lock(_texturesMutex, false/*write*/);
+    auto it = _textures.find(path);
+    if (it != _textures.end()) {
+        return it->second;
+    }
+
+    // Upgrade to writer lock.
+    lock.upgrade_to_writer();
+
+    // Double check that it wasn't inserted by another thread
+    it = _textures.find(path);
+    if (it != _textures.end()) {
+        return it->second;
+    }
+
+    HdVP2TextureHandle entry = std::make_shared<HdVP2TextureEntry>(path);
+    _textures[path] = entry;
+    lock.release();
+
+    _dispatcher->Run([this, entry]() { _Decode(entry); });
+
+    return entry;
+}
+
+/*! \brief  Returns a 1x1 texture of the given color, used until a texture is resident.
+*/
+MHWRender::MTexture*
+HdVP2TextureRegistry::GetFallbackTexture(const GfVec4f& color)
+{
+    // Look for it first with reader lock
+    tbb::spin_rw_mutex::scoped_lock lock(_fallbackMutex, false/*write*/);
+    auto it = _fallbackTextures.find(color);
+    if (it != _fallbackTextures.end()) {
+        return it->second.get();
+    }
+
+    // Upgrade to writer lock.
+    lock.upgrade_to_writer();
+
+    // Double check that it wasn't inserted by another thread
+    it = _fallbackTextures.find(color);
+    if (it != _fallbackTextures.end()) {
+        return it->second.get();
+    }
+
+    MHWRender::MTextureManager* const textureMgr = _GetTextureManager();
+    if (!TF_VERIFY(textureMgr)) {
+        return nullptr;
+    }
+
+    unsigned char texel[4];
+    for (int i = 0; i < 4; i++) {
+        texel[i] = static_cast<unsigned char>(
+            std::min(std::max(color[i], 0.0f), 1.0f) * 255.0f + 0.5f);
+    }
+
+    MHWRender::MTextureDescription desc;
+    desc.setToDefault2DTexture();
+    desc.fWidth = 1;
+    desc.fHeight = 1;
+    desc.fBytesPerRow = sizeof(texel);
+    desc.fBytesPerSlice = sizeof(texel);
+    desc.fFormat = MHWRender::kR8G8B8A8_UNORM;
+
+    const std::string name = TfStringPrintf("HdVP2FallbackTexture_%02x%02x%02x%02x",
+        texel[0], texel[1], texel[2], texel[3]);
+
+    MHWRender::MTexture* texture =
+        textureMgr->acquireTexture(name.c_str(), desc, texel);
+    _fallbackTextures[color].reset(texture);
+    return texture;
+}
+
+/*! \brief  Reads and decodes texels of the entry. Executed on a worker thread.
+*/
+void
+HdVP2TextureRegistry::_Decode(const HdVP2TextureHandle& entry)
+{
+    auto fail = [&entry]() {
+        TF_DEBUG(HDVP2_DEBUG_MATERIAL).Msg(
+            "Failed to load texture %s\n", entry->GetPath().c_str());
+        entry->_state = HdVP2TextureState::kFailed;
+    };
+
+    GlfImageSharedPtr image = GlfImage::OpenForReading(entry->GetPath());
+    if (!image) {
+        TF_WARN("Failed to open texture %s", entry->GetPath().c_str());
+        fail();
+        return;
+    }
+
+    // GlfImage is used for loading pixel data from usdz only and should
+    // not trigger any OpenGL call. VP2RenderDelegate will transfer the
+    // texels to GPU memory with VP2 API which is 3D API agnostic.
+    GlfImage::StorageSpec spec;
+    spec.width = image->GetWidth();
+    spec.height = image->GetHeight();
+    spec.depth = 1;
+    spec.format = image->GetFormat();
+    spec.type = image->GetType();
+    spec.flipped = false;
+
+    const int bpp = image->GetBytesPerPixel();
+    const int bytesPerRow = spec.width * bpp;
+    const int bytesPerSlice = bytesPerRow * spec.height;
+
+    std::vector<unsigned char> storage(bytesPerSlice);
+    spec.data = storage.data();
+
+    if (!image->Read(spec)) {
+        fail();
+        return;
+    }
+
+    const bool isFloat = (spec.type == GL_FLOAT);
+    int channels = 0;
+    bool isColorSpaceSRGB = false;
+
+    MHWRender::MTextureDescription& desc = entry->_desc;
+    desc.setToDefault2DTexture();
+
+    switch (spec.format)
+    {
+    case GL_RED:
+        channels = 1;
+        desc.fFormat = (isFloat ? MHWRender::kR32_FLOAT : MHWRender::kR8_UNORM);
+        break;
+    case GL_RGB:
+        if (isFloat) {
+            channels = 3;
+            desc.fFormat = MHWRender::kR32G32B32_FLOAT;
+        }
+        else {
+            // R8G8B8 is not supported by VP2. Converted to R8G8B8A8.
+            constexpr int bpp_4 = 4;
+
+            std::vector<unsigned char> texels(spec.width * spec.height * bpp_4);
+
+            for (int y = 0; y < spec.height; y++) {
+                for (int x = 0; x < spec.width; x++) {
+                    const int t = spec.width * y + x;
+                    texels[t*bpp_4]     = storage[t*bpp];
+                    texels[t*bpp_4 + 1] = storage[t*bpp + 1];
+                    texels[t*bpp_4 + 2] = storage[t*bpp + 2];
+                    texels[t*bpp_4 + 3] = 255;
+                }
+            }
+
+            storage.swap(texels);
+            channels = bpp_4;
+            desc.fFormat = MHWRender::kR8G8B8A8_UNORM;
+            isColorSpaceSRGB = image->IsColorSpaceSRGB();
+        }
+        break;
+    case GL_RGBA:
+        channels = 4;
+        if (isFloat) {
+            desc.fFormat = MHWRender::kR32G32B32A32_FLOAT;
+        }
+        else {
+            desc.fFormat = MHWRender::kR8G8B8A8_UNORM;
+            isColorSpaceSRGB = image->IsColorSpaceSRGB();
+        }
+        break;
+    default:
+        fail();
+        return;
+    }
+
+    const size_t bytesPerTexel = channels * (isFloat ? sizeof(float) : sizeof(unsigned char));
+
+    // Halve the texture until it fits in the remaining budget. Textures which
+    // are already resident keep their resolution.
+    int width = spec.width;
+    int height = spec.height;
+    if (_budgetBytes > 0) {
+        while (width > _kMinDownsampledSize && height > _kMinDownsampledSize &&
+            _residentBytes + _pendingBytes + bytesPerTexel * width * height > _budgetBytes)
+        {
+            if (isFloat) {
+                _Downsample<float>(storage, width, height, channels);
+            }
+            else {
+                _Downsample<unsigned char>(storage, width, height, channels);
+            }
+            entry->_mipLevel++;
+        }
+
+        if (entry->_mipLevel > 0) {
+            TF_DEBUG(HDVP2_DEBUG_MATERIAL).Msg(
+                "Texture %s down-sampled %u time(s) to fit the memory budget\n",
+                entry->GetPath().c_str(), entry->_mipLevel);
+        }
+    }
+
+    desc.fWidth = width;
+    desc.fHeight = height;
+    desc.fBytesPerRow = static_cast<unsigned int>(bytesPerTexel * width);
+    desc.fBytesPerSlice = desc.fBytesPerRow * height;
+
+    entry->_gpuBytes = desc.fBytesPerSlice;
+    entry->_texels.swap(storage);
+    entry->_info._isColorSpaceSRGB = isColorSpaceSRGB;
+
+    _pendingBytes += entry->_gpuBytes;
+    entry->_state = HdVP2TextureState::kDecoded;
+    _decodedQueue.push(entry);
+
+    _ScheduleRefresh();
+}
+
+/*! \brief  Uploads decoded texels of the entry to GPU. Executed on main thread.
+*/
+void
+HdVP2TextureRegistry::_Upload(HdVP2TextureEntry& entry)
+{
+    _pendingBytes -= entry._gpuBytes;
+
+    MHWRender::MTextureManager* const textureMgr = _GetTextureManager();
+    MHWRender::MTexture* texture = textureMgr ? textureMgr->acquireTexture(
+        entry.GetPath().c_str(), entry._desc, entry._texels.data()) : nullptr;
+
+    std::vector<unsigned char>().swap(entry._texels);
+
+    if (texture) {
+        entry._info._texture.reset(texture);
+        _residentBytes += entry._gpuBytes;
+        entry._state = HdVP2TextureState::kResident;
+    }
+    else {
+        entry._state = HdVP2TextureState::kFailed;
+    }
+}
+
+/*! \brief  Releases textures which are no longer referenced by any material.
+*/
+void
+HdVP2TextureRegistry::_CollectGarbage()
+{
+    tbb::spin_rw_mutex::scoped_lock lock(_texturesMutex, true/*write*/);
+
+    for (auto it = _textures.begin(); it != _textures.end(); ) {
+        const HdVP2TextureHandle& entry = it->second;
+
+        // Entries in flight are referenced by the worker or the decoded queue.
+        if (entry.use_count() == 1 && entry->IsSettled()) {
+            if (entry->IsResident()) {
+                _residentBytes -= entry->_gpuBytes;
+            }
+            it = _textures.erase(it);
+        }
+        else {
+            ++it;
+        }
+    }
+}
+
+/*! \brief  Asks Maya to redraw once texels are ready, so that they are uploaded
+            even if nothing else changed in the viewport.
+*/
+void
+HdVP2TextureRegistry::_ScheduleRefresh()
+{
+    if (!_refreshScheduled.exchange(true)) {
+        MGlobal::executeCommandOnIdle("refresh");
+    }
+}
+
+/*! \brief  Uploads decoded textures and releases unused ones. Must be called
+            from main thread, during commit of resources.
+*/
+void
+HdVP2TextureRegistry::Commit()
+{
+    _refreshScheduled = false;
+
+    HdVP2TextureHandle entry;
+    while (_decodedQueue.try_pop(entry)) {
+        _Upload(*entry);
+    }
+
+    _CollectGarbage();
+}
+
+/*! \brief  Waits for pending reads and releases all textures. Must be called
+            from main thread while VP2 renderer is still available.
+*/
+void
+HdVP2TextureRegistry::Clear()
+{
+    _dispatcher->Wait();
+
+    _decodedQueue.clear();
+    _textures.clear();
+    _fallbackTextures.clear();
+
+    _pendingBytes = 0;
+    _residentBytes = 0;
+}
+
+PXR_NAMESPACE_CLOSE_SCOPE
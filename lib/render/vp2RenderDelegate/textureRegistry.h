@@ -0,0 +1,187 @@
+//
+// Copyright 2020 Autodesk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef HD_VP2_TEXTURE_REGISTRY
+#define HD_VP2_TEXTURE_REGISTRY
+
+#include "pxr/pxr.h"
+#include "pxr/base/gf/vec4f.h"
+#include "pxr/base/work/dispatcher.h"
+
+#include <maya/MTextureManager.h>
+
+#include <tbb/concurrent_queue.h>
+#include <tbb/spin_rw_mutex.h>
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+PXR_NAMESPACE_OPEN_SCOPE
+
+/*! \brief  A deleter for MTexture, for use with smart pointers.
+*/
+struct HdVP2TextureDeleter
+{
+    void operator () (MHWRender::MTexture*);
+};
+
+/*! \brief  A MTexture owned by a std unique pointer.
+*/
+using HdVP2TextureUniquePtr = std::unique_ptr<
+    MHWRender::MTexture,
+    HdVP2TextureDeleter
+>;
+
+/*! \brief  Information about the texture.
+*/
+struct HdVP2TextureInfo
+{
+    HdVP2TextureUniquePtr  _texture;          //!< Unique pointer of the texture
+    bool                   _isColorSpaceSRGB; //!< Whether sRGB linearization is needed
+};
+
+/*! \brief  Residency state of a texture in the texture registry.
+*/
+enum class HdVP2TextureState
+{
+    kLoading,   //!< Texels are being read on a worker thread
+    kDecoded,   //!< Texels are in CPU memory, waiting for GPU upload on main thread
+    kResident,  //!< Texture is uploaded and can be bound
+    kFailed     //!< Texture could not be read, fallback is used permanently
+};
+
+/*! \brief  A texture shared by all materials referencing the same file.
+    \class  HdVP2TextureEntry
+
+    Entries are reference counted through HdVP2TextureHandle. The registry
+    releases the GPU texture of an entry once no material holds a handle to it.
+*/
+class HdVP2TextureEntry
+{
+public:
+    //! Constructor
+    HdVP2TextureEntry(const std::string& path) : _path(path) {}
+
+    //! Returns the file path of the texture
+    const std::string& GetPath() const { return _path; }
+
+    //! Returns the residency state of the texture. Call is thread safe.
+    HdVP2TextureState GetState() const { return _state.load(); }
+
+    //! Returns true when the texture can be bound. Call is thread safe.
+    bool IsResident() const { return GetState() == HdVP2TextureState::kResident; }
+
+    //! Returns true when the texture won't change state anymore. Call is thread safe.
+    bool IsSettled() const {
+        const HdVP2TextureState state = GetState();
+        return (state == HdVP2TextureState::kResident ||
+                state == HdVP2TextureState::kFailed);
+    }
+
+    //! Returns texture information, only valid when the texture is resident.
+    const HdVP2TextureInfo& GetInfo() const { return _info; }
+
+private:
+    friend class HdVP2TextureRegistry;
+
+    const std::string              _path;                //!< File path of the texture
+    std::atomic<HdVP2TextureState> _state { HdVP2TextureState::kLoading }; //!< Residency state
+
+    HdVP2TextureInfo               _info {};             //!< GPU texture, valid when resident
+    MHWRender::MTextureDescription _desc;                //!< Description of decoded texels
+    std::vector<unsigned char>     _texels;              //!< Decoded texels, released after upload
+    size_t                         _gpuBytes { 0 };      //!< Size of GPU texture, used for budget accounting
+    unsigned int                   _mipLevel { 0 };      //!< Number of times the texture was halved to fit the budget
+};
+
+/*! \brief  A reference counted handle to a shared texture.
+*/
+using HdVP2TextureHandle = std::shared_ptr<HdVP2TextureEntry>;
+
+/*! \brief  Render-delegate-wide registry of textures used by VP2 materials.
+    \class  HdVP2TextureRegistry
+
+    Each file is read once no matter how many materials reference it. Reading
+    and decoding of texels is executed on worker threads, while the GPU upload
+    is done on main thread during commit of resources. Until a texture is
+    resident, materials bind a 1x1 fallback texture of the fallback color.
+
+    When a GPU memory budget is set with HDVP2_TEXTURE_MEMORY_BUDGET_MB,
+    textures loaded after the budget is exceeded are halved until they fit,
+    which is equivalent to binding a lower mip level.
+*/
+class HdVP2TextureRegistry final
+{
+public:
+    HdVP2TextureRegistry();
+    ~HdVP2TextureRegistry();
+
+    HdVP2TextureHandle Acquire(const std::string& path);
+
+    MHWRender::MTexture* GetFallbackTexture(const GfVec4f& color);
+
+    void Commit();
+
+    void Clear();
+
+    //! Returns GPU memory used by resident textures, in bytes.
+    size_t GetResidentBytes() const { return _residentBytes.load(); }
+
+    //! Returns GPU memory budget for textures in bytes, or 0 when unlimited.
+    size_t GetBudgetBytes() const { return _budgetBytes; }
+
+private:
+    HdVP2TextureRegistry(const HdVP2TextureRegistry&) = delete;
+    HdVP2TextureRegistry& operator=(const HdVP2TextureRegistry&) = delete;
+
+    void _Decode(const HdVP2TextureHandle& entry);
+    void _Upload(HdVP2TextureEntry& entry);
+    void _CollectGarbage();
+    void _ScheduleRefresh();
+
+    //! Hash helper for fallback color map
+    struct _ColorHash {
+        size_t operator()(const GfVec4f& color) const;
+    };
+
+    using _TextureMap = std::unordered_map<std::string, HdVP2TextureHandle>;
+    using _FallbackMap = std::unordered_map<GfVec4f, HdVP2TextureUniquePtr, _ColorHash>;
+
+    _TextureMap            _textures;           //!< Shared textures indexed by file path
+    tbb::spin_rw_mutex     _texturesMutex;      //!< Synchronization used to protect concurrent read from serial writes
+
+    _FallbackMap           _fallbackTextures;   //!< 1x1 fallback textures indexed by color
+    tbb::spin_rw_mutex     _fallbackMutex;      //!< Synchronization used to protect concurrent read from serial writes
+
+    //! Entries decoded by worker threads, waiting for upload on main thread
+    tbb::concurrent_queue<HdVP2TextureHandle> _decodedQueue;
+
+    std::atomic<size_t>    _residentBytes { 0 };     //!< GPU memory used by resident textures
+    std::atomic<size_t>    _pendingBytes { 0 };      //!< GPU memory reserved by textures in flight
+    std::atomic<bool>      _refreshScheduled { false }; //!< Whether a viewport refresh is already queued
+    const size_t           _budgetBytes;             //!< GPU memory budget, 0 when unlimited
+
+    //! Worker pool reading texels. Must be the last member so that it is
+    //! destroyed (and waits for pending work) before any other state.
+    std::unique_ptr<WorkDispatcher> _dispatcher;
+};
+
+PXR_NAMESPACE_CLOSE_SCOPE
+
+#endif
@@ -24,6 +24,7 @@
 #include "../../fileio/utils/writeUtil.h"
 #include "../../fileio/writeJobContext.h"
 
+#include "pxr/base/arch/hash.h"
 #include "pxr/base/gf/vec2f.h"
 #include "pxr/base/gf/vec3f.h"
 #include "pxr/base/gf/vec4f.h"
@@ -37,6 +38,7 @@
 #include "pxr/usd/usdGeom/primvar.h"
 #include "pxr/usd/usdUtils/pipeline.h"
 
+#include <maya/MDoubleArray.h>
 #include <maya/MFnDependencyNode.h>
 #include <maya/MFnMesh.h>
 #include <maya/MIntArray.h>
@@ -46,6 +48,10 @@
 #include <maya/MStringArray.h>
 #include <maya/MUintArray.h>
 
+#include <boost/functional/hash.hpp>
+
+#include <algorithm>
+#include <cstring>
 #include <set>
 #include <string>
 #include <vector>
@@ -112,6 +118,95 @@ _exportReferenceMesh(UsdGeomMesh& primSchema, MObject obj)
     primVar.GetAttr().Set(VtValue(points));
 }
 
+/// Copies Maya raw points into \p points and computes their \p extent in a
+/// single pass over the data.
+void
+_CopyPointsAndComputeExtent(
+        const float* mayaRawPoints,
+        const unsigned int numVertices,
+        VtArray<GfVec3f>* points,
+        VtArray<GfVec3f>* extent)
+{
+    points->resize(numVertices);
+    extent->resize(2);
+
+    if (numVertices == 0 || !mayaRawPoints) {
+        (*extent)[0].Set(0.0f, 0.0f, 0.0f);
+        (*extent)[1].Set(0.0f, 0.0f, 0.0f);
+        return;
+    }
+
+    // GfVec3f is laid out as three contiguous floats, like Maya raw points.
+    static_assert(sizeof(GfVec3f) == 3 * sizeof(float),
+        "GfVec3f must match the layout of Maya raw points");
+    std::memcpy(points->data(), mayaRawPoints, numVertices * sizeof(GfVec3f));
+
+    float minX = mayaRawPoints[0], minY = mayaRawPoints[1], minZ = mayaRawPoints[2];
+    float maxX = minX, maxY = minY, maxZ = minZ;
+    for (unsigned int i = 1; i < numVertices; ++i) {
+        const float* p = mayaRawPoints + i * 3;
+        minX = std::min(minX, p[0]); maxX = std::max(maxX, p[0]);
+        minY = std::min(minY, p[1]); maxY = std::max(maxY, p[1]);
+        minZ = std::min(minZ, p[2]); maxZ = std::max(maxZ, p[2]);
+    }
+
+    (*extent)[0].Set(minX, minY, minZ);
+    (*extent)[1].Set(maxX, maxY, maxZ);
+}
+
+/// Copies a Maya int array into a VtArray<int>.
+void
+_CopyIntArray(const MIntArray& mayaArray, VtArray<int>* array)
+{
+    array->resize(mayaArray.length());
+    if (!array->empty()) {
+        mayaArray.get(array->data());
+    }
+}
+
+/// Returns a cheap hash of the topology that is only written again on
+/// animated frames when it changes: face vertex counts and indices, holes,
+/// and vertex and edge creases.
+size_t
+_ComputeTopologyHash(
+        MFnMesh& finalMesh,
+        const VtArray<int>& faceVertexCounts,
+        const VtArray<int>& faceVertexIndices)
+{
+    size_t hash = ArchHash64(
+        reinterpret_cast<const char*>(faceVertexCounts.cdata()),
+        faceVertexCounts.size() * sizeof(int));
+    hash = ArchHash64(
+        reinterpret_cast<const char*>(faceVertexIndices.cdata()),
+        faceVertexIndices.size() * sizeof(int),
+        hash);
+
+    const MUintArray invisibleFaces = finalMesh.getInvisibleFaces();
+    for (unsigned int i = 0; i < invisibleFaces.length(); ++i) {
+        boost::hash_combine(hash, invisibleFaces[i]);
+    }
+
+    MUintArray creaseIds;
+    MDoubleArray creaseValues;
+    finalMesh.getCreaseVertices(creaseIds, creaseValues);
+    for (unsigned int i = 0; i < creaseIds.length(); ++i) {
+        boost::hash_combine(hash, creaseIds[i]);
+    }
+    for (unsigned int i = 0; i < creaseValues.length(); ++i) {
+        boost::hash_combine(hash, creaseValues[i]);
+    }
+
+    finalMesh.getCreaseEdges(creaseIds, creaseValues);
+    for (unsigned int i = 0; i < creaseIds.length(); ++i) {
+        boost::hash_combine(hash, creaseIds[i]);
+    }
+    for (unsigned int i = 0; i < creaseValues.length(); ++i) {
+        boost::hash_combine(hash, creaseValues[i]);
+    }
+
+    return hash;
+}
+
 } // anonymous namespace
 
 const GfVec2f PxrUsdTranslators_MeshWriter::_DefaultUV = GfVec2f(0.f);
@@ -163,9 +258,21 @@ PxrUsdTranslators_MeshWriter::PxrUsdTranslators_MeshWriter(
 void
 PxrUsdTranslators_MeshWriter::PostExport()
 {
+    // The time samples of a streamed export were moved into the clips, which
+    // PostExportClip() has already cleaned up.
+    if (_writeJobCtx.IsStreamingClips()) {
+        return;
+    }
     _CleanupPrimvars();
 }
 
+/* virtual */
+void
+PxrUsdTranslators_MeshWriter::PostExportClip(const SdfLayerHandle& clipLayer)
+{
+    _CleanupPrimvars(clipLayer);
+}
+
 /* virtual */
 void
 PxrUsdTranslators_MeshWriter::Write(const UsdTimeCode& usdTime)
@@ -231,106 +338,103 @@ PxrUsdTranslators_MeshWriter::writeMeshAttrs(
     }
 
     unsigned int numVertices = geomMesh.numVertices();
-    unsigned int numPolygons = geomMesh.numPolygons();
 
     // Set mesh attrs ==========
-    // Get points
-    // TODO: Use memcpy()
+    // Get points and extent
     const float* mayaRawPoints = geomMesh.getRawPoints(&status);
-    VtArray<GfVec3f> points(numVertices);
-    for (unsigned int i = 0; i < numVertices; i++) {
-        unsigned int floatIndex = i*3;
-        points[i].Set(mayaRawPoints[floatIndex],
-                      mayaRawPoints[floatIndex+1],
-                      mayaRawPoints[floatIndex+2]);
-    }
-
-    VtArray<GfVec3f> extent(2);
-    // Compute the extent using the raw points
-    UsdGeomPointBased::ComputeExtent(points, &extent);
+    VtArray<GfVec3f> points;
+    VtArray<GfVec3f> extent;
+    _CopyPointsAndComputeExtent(mayaRawPoints, numVertices, &points, &extent);
 
     _SetAttribute(primSchema.GetPointsAttr(), &points, usdTime);
     _SetAttribute(primSchema.CreateExtentAttr(), &extent, usdTime);
 
-    // Get faceVertexIndices
-    unsigned int numFaceVertices = geomMesh.numFaceVertices(&status);
-    VtArray<int>     faceVertexCounts(numPolygons);
-    VtArray<int>     faceVertexIndices(numFaceVertices);
-    MIntArray mayaFaceVertexIndices; // used in loop below
-    unsigned int curFaceVertexIndex = 0;
-    for (unsigned int i = 0; i < numPolygons; i++) {
-        geomMesh.getPolygonVertices(i, mayaFaceVertexIndices);
-        faceVertexCounts[i] = mayaFaceVertexIndices.length();
-        for (unsigned int j=0; j < mayaFaceVertexIndices.length(); j++) {
-            faceVertexIndices[ curFaceVertexIndex ] = mayaFaceVertexIndices[j]; // push_back
-            curFaceVertexIndex++;
-        }
+    // Get faceVertexCounts and faceVertexIndices in bulk
+    MIntArray mayaFaceVertexCounts;
+    MIntArray mayaFaceVertexIndices;
+    geomMesh.getVertices(mayaFaceVertexCounts, mayaFaceVertexIndices);
+
+    VtArray<int> faceVertexCounts;
+    VtArray<int> faceVertexIndices;
+    _CopyIntArray(mayaFaceVertexCounts, &faceVertexCounts);
+    _CopyIntArray(mayaFaceVertexIndices, &faceVertexIndices);
+
+    MStringArray uvSetNames;
+    if (_GetExportArgs().exportMeshUVs) {
+        status = finalMesh.getUVSetNames(uvSetNames);
     }
-    _SetAttribute(primSchema.GetFaceVertexCountsAttr(), &faceVertexCounts, usdTime);
-    _SetAttribute(primSchema.GetFaceVertexIndicesAttr(), &faceVertexIndices, usdTime);
-
-    // Read subdiv scheme tagging. If not set, we default to defaultMeshScheme
-    // flag (this is specified by the job args but defaults to catmullClark).
-    TfToken sdScheme = UsdMayaMeshUtil::GetSubdivScheme(finalMesh);
-    if (sdScheme.IsEmpty()) {
-        sdScheme = _GetExportArgs().defaultMeshScheme;
-    }
-    primSchema.CreateSubdivisionSchemeAttr(VtValue(sdScheme), true);
-
-    if (sdScheme == UsdGeomTokens->none) {
-        // Polygonal mesh - export normals.
-        bool emitNormals = true; // Default to emitting normals if no tagging.
-        UsdMayaMeshUtil::GetEmitNormalsTag(finalMesh, &emitNormals);
-        if (emitNormals) {
-            VtArray<GfVec3f> meshNormals;
-            TfToken normalInterp;
-
-            if (UsdMayaMeshUtil::GetMeshNormals(
-                    geomMeshObj,
-                    &meshNormals,
-                    &normalInterp)) {
-                _SetAttribute(
-                    primSchema.GetNormalsAttr(),
-                    &meshNormals,
-                    usdTime);
-                primSchema.SetNormalsInterpolation(normalInterp);
-            }
-        }
-    } else {
-        // Subdivision surface - export subdiv-specific attributes.
-        TfToken sdInterpBound = UsdMayaMeshUtil::GetSubdivInterpBoundary(
-            finalMesh);
-        if (!sdInterpBound.IsEmpty()) {
-            _SetAttribute(primSchema.CreateInterpolateBoundaryAttr(),
-                          sdInterpBound);
+
+    MStringArray mayaColorSetNames;
+    if (_GetExportArgs().exportColorSets) {
+        status = finalMesh.getColorSetNames(mayaColorSetNames);
+    }
+
+    // On animated frames, the topology is only written again when its hash
+    // changes. Points, extent, normals, UVs and color sets are written on
+    // every frame.
+    const size_t topologyHash = _ComputeTopologyHash(
+        finalMesh,
+        faceVertexCounts,
+        faceVertexIndices);
+
+    if (usdTime.IsDefault() ||
+            !_hasTopologyHash || topologyHash != _topologyHash) {
+        _topologyHash = topologyHash;
+        _hasTopologyHash = true;
+
+        _SetAttribute(primSchema.GetFaceVertexCountsAttr(), &faceVertexCounts, usdTime);
+        _SetAttribute(primSchema.GetFaceVertexIndicesAttr(), &faceVertexIndices, usdTime);
+
+        // Read subdiv scheme tagging. If not set, we default to
+        // defaultMeshScheme flag (this is specified by the job args but
+        // defaults to catmullClark).
+        TfToken sdScheme = UsdMayaMeshUtil::GetSubdivScheme(finalMesh);
+        if (sdScheme.IsEmpty()) {
+            sdScheme = _GetExportArgs().defaultMeshScheme;
         }
+        primSchema.CreateSubdivisionSchemeAttr(VtValue(sdScheme), true);
+        _subdivScheme = sdScheme;
+
+        if (sdScheme == UsdGeomTokens->none) {
+            // Polygonal mesh - export normals.
+            _emitNormals = true; // Default to emitting normals if no tagging.
+            UsdMayaMeshUtil::GetEmitNormalsTag(finalMesh, &_emitNormals);
+        } else {
+            // Subdivision surface - export subdiv-specific attributes.
+            TfToken sdInterpBound = UsdMayaMeshUtil::GetSubdivInterpBoundary(
+                finalMesh);
+            if (!sdInterpBound.IsEmpty()) {
+                _SetAttribute(primSchema.CreateInterpolateBoundaryAttr(),
+                              sdInterpBound);
+            }
+
+            TfToken sdFVLinearInterpolation =
+                UsdMayaMeshUtil::GetSubdivFVLinearInterpolation(finalMesh);
+            if (!sdFVLinearInterpolation.IsEmpty()) {
+                _SetAttribute(primSchema.CreateFaceVaryingLinearInterpolationAttr(),
+                              sdFVLinearInterpolation);
+            }
 
-        TfToken sdFVLinearInterpolation =
-            UsdMayaMeshUtil::GetSubdivFVLinearInterpolation(finalMesh);
-        if (!sdFVLinearInterpolation.IsEmpty()) {
-            _SetAttribute(primSchema.CreateFaceVaryingLinearInterpolationAttr(),
-                          sdFVLinearInterpolation);
+            assignSubDivTagsToUSDPrim(finalMesh, primSchema);
         }
 
-        assignSubDivTagsToUSDPrim(finalMesh, primSchema);
+        // Holes - we treat InvisibleFaces as holes
+        MUintArray mayaHoles = finalMesh.getInvisibleFaces();
+        if (mayaHoles.length() > 0) {
+            VtArray<int> subdHoles(mayaHoles.length());
+            for (unsigned int i=0; i < mayaHoles.length(); i++) {
+                subdHoles[i] = mayaHoles[i];
+            }
+            // not animatable in Maya, so we'll set default only
+            _SetAttribute(primSchema.GetHoleIndicesAttr(), &subdHoles);
+        }
     }
 
-    // Holes - we treat InvisibleFaces as holes
-    MUintArray mayaHoles = finalMesh.getInvisibleFaces();
-    if (mayaHoles.length() > 0) {
-        VtArray<int> subdHoles(mayaHoles.length());
-        for (unsigned int i=0; i < mayaHoles.length(); i++) {
-            subdHoles[i] = mayaHoles[i];
-        }
-        // not animatable in Maya, so we'll set default only
-        _SetAttribute(primSchema.GetHoleIndicesAttr(), &subdHoles);
+    if (_subdivScheme == UsdGeomTokens->none && _emitNormals) {
+        _writeMeshNormals(usdTime, geomMeshObj, primSchema);
     }
 
     // == Write UVSets as Vec2f Primvars
-    MStringArray uvSetNames;
-    if (_GetExportArgs().exportMeshUVs) {
-        status = finalMesh.getUVSetNames(uvSetNames);
-    }
     for (unsigned int i = 0; i < uvSetNames.length(); ++i) {
         VtArray<GfVec2f> uvValues;
         TfToken interpolation;
@@ -364,13 +468,9 @@ PxrUsdTranslators_MeshWriter::writeMeshAttrs(
 
     // == Gather ColorSets
     std::vector<std::string> colorSetNames;
-    if (_GetExportArgs().exportColorSets) {
-        MStringArray mayaColorSetNames;
-        status = finalMesh.getColorSetNames(mayaColorSetNames);
-        colorSetNames.reserve(mayaColorSetNames.length());
-        for (unsigned int i = 0; i < mayaColorSetNames.length(); i++) {
-            colorSetNames.emplace_back(mayaColorSetNames[i].asChar());
-        }
+    colorSetNames.reserve(mayaColorSetNames.length());
+    for (unsigned int i = 0; i < mayaColorSetNames.length(); i++) {
+        colorSetNames.emplace_back(mayaColorSetNames[i].asChar());
     }
 
     std::set<std::string> colorSetNamesSet(colorSetNames.begin(), colorSetNames.end());
@@ -524,6 +624,27 @@ PxrUsdTranslators_MeshWriter::writeMeshAttrs(
     return true;
 }
 
+void
+PxrUsdTranslators_MeshWriter::_writeMeshNormals(
+        const UsdTimeCode& usdTime,
+        const MObject& geomMeshObj,
+        UsdGeomMesh& primSchema)
+{
+    VtArray<GfVec3f> meshNormals;
+    TfToken normalInterp;
+
+    if (UsdMayaMeshUtil::GetMeshNormals(
+            geomMeshObj,
+            &meshNormals,
+            &normalInterp)) {
+        _SetAttribute(
+            primSchema.GetNormalsAttr(),
+            &meshNormals,
+            usdTime);
+        primSchema.SetNormalsInterpolation(normalInterp);
+    }
+}
+
 bool
 PxrUsdTranslators_MeshWriter::isMeshValid()
 {
@@ -28,6 +28,7 @@
 #include "pxr/base/gf/vec4f.h"
 #include "pxr/base/tf/token.h"
 #include "pxr/base/vt/array.h"
+#include "pxr/usd/sdf/declareHandles.h"
 #include "pxr/usd/sdf/path.h"
 #include "pxr/usd/usd/timeCode.h"
 #include "pxr/usd/usdGeom/gprim.h"
@@ -40,6 +41,7 @@
 
 #include <set>
 #include <string>
+#include <vector>
 
 
 PXR_NAMESPACE_OPEN_SCOPE
@@ -59,6 +61,7 @@ public:
     bool ExportsGprims() const override;
 
     void PostExport() override;
+    void PostExportClip(const SdfLayerHandle& clipLayer) override;
 
 protected:
     bool writeMeshAttrs(const UsdTimeCode& usdTime, UsdGeomMesh& primSchema);
@@ -67,6 +70,12 @@ private:
     bool isMeshValid();
     void assignSubDivTagsToUSDPrim(MFnMesh& meshFn, UsdGeomMesh& primSchema);
 
+    /// Writes the normals of \p geomMeshObj at \p usdTime.
+    void _writeMeshNormals(
+            const UsdTimeCode& usdTime,
+            const MObject& geomMeshObj,
+            UsdGeomMesh& primSchema);
+
     /// Writes skeleton skinning data for the mesh if it has skin clusters.
     /// This method will internally determine, based on the job export args,
     /// whether the prim has skinning data and whether it is eligible for
@@ -169,9 +178,17 @@ private:
             const VtValue& defaultValue,
             const UsdTimeCode& usdTime);
 
+    /// Returns the indexed primvars whose values _SetPrimvar() padded with
+    /// an unassigned value that none of the indices ended up using.
+    std::vector<UsdGeomPrimvar> _GetPrimvarsToCleanup() const;
+
     /// Cleans up any extra data authored by _SetPrimvar().
     void _CleanupPrimvars();
 
+    /// Cleans up any extra data authored by _SetPrimvar() in the time samples
+    /// that a streamed export moved into \p clipLayer.
+    void _CleanupPrimvars(const SdfLayerHandle& clipLayer);
+
     /// Whether the mesh is animated. For the time being, meshes on which
     /// skinning is being exported are considered to be non-animated.
     /// XXX In theory you could have an animated input mesh before the
@@ -196,6 +213,16 @@ private:
     /// Input mesh before any skeletal deformations, cached between iterations.
     MObject _skelInputMesh;
 
+    /// Hash of the topology, holes and creases written with the last full
+    /// sample. Animated frames with the same hash skip the topology
+    /// attributes, but still write points, normals, UVs and color sets.
+    size_t _topologyHash = 0;
+    bool _hasTopologyHash = false;
+
+    /// Subdivision scheme and normals tagging read with the last full sample.
+    TfToken _subdivScheme;
+    bool _emitNormals = true;
+
     /// Set of color sets that should be excluded.
     /// Intermediate processes may alter this set prior to writeMeshAttrs().
     std::set<std::string> _excludeColorSets;
@@ -24,6 +24,8 @@
 #include "pxr/base/gf/math.h"
 #include "pxr/base/gf/transform.h"
 #include "pxr/base/tf/staticTokens.h"
+#include "pxr/usd/sdf/layer.h"
+#include "pxr/usd/sdf/types.h"
 
 #include "pxr/usd/usdGeom/mesh.h"
 
@@ -747,13 +749,14 @@ PxrUsdTranslators_MeshWriter::_SetPrimvar(
     }
 }
 
-void
-PxrUsdTranslators_MeshWriter::_CleanupPrimvars()
+std::vector<UsdGeomPrimvar>
+PxrUsdTranslators_MeshWriter::_GetPrimvarsToCleanup() const
 {
+    std::vector<UsdGeomPrimvar> primvars;
     if (!_IsMeshAnimated()) {
         // Based on how _SetPrimvar() works, the cleanup phase doesn't apply to
         // non-animated meshes.
-        return;
+        return primvars;
     }
 
     // On animated meshes, we forced an extra value (the "unassigned" or
@@ -783,13 +786,22 @@ PxrUsdTranslators_MeshWriter::_CleanupPrimvars()
         // If the unauthoredValueIndex wasn't 0 above, it must be -1 (the
         // fallback value in USD).
         if (!TF_VERIFY(unauthoredValueIndex == -1)) {
-            return;
+            break;
         }
 
         // Since the unauthoredValueIndex is -1, we never explicitly set it,
         // meaning that none of the samples contain an unassigned value.
-        // Since we authored the unassigned value as index 0 in each primvar,
-        // we can eliminate it now from all time samples.
+        primvars.push_back(primvar);
+    }
+    return primvars;
+}
+
+void
+PxrUsdTranslators_MeshWriter::_CleanupPrimvars()
+{
+    // Since we authored the unassigned value as index 0 in each primvar,
+    // we can eliminate it now from all time samples.
+    for (const UsdGeomPrimvar& primvar : _GetPrimvarsToCleanup()) {
         if (const UsdAttribute attr = primvar.GetAttr()) {
             VtValue val;
             if (attr.Get(&val, UsdTimeCode::Default())) {
@@ -830,5 +842,51 @@ PxrUsdTranslators_MeshWriter::_CleanupPrimvars()
     }
 }
 
+void
+PxrUsdTranslators_MeshWriter::_CleanupPrimvars(const SdfLayerHandle& clipLayer)
+{
+    // Same as above, but on the time samples that a streamed export moved
+    // into the clip. The primvars themselves are still described by the
+    // stage, so the clips are cleaned up the same way that the stage would
+    // have been.
+    for (const UsdGeomPrimvar& primvar : _GetPrimvarsToCleanup()) {
+        const SdfPath valuesPath = primvar.GetAttr().GetPath();
+        if (clipLayer->HasField(valuesPath, SdfFieldKeys->TimeSamples)) {
+            SdfTimeSampleMap samples = clipLayer->GetFieldAs<SdfTimeSampleMap>(
+                    valuesPath, SdfFieldKeys->TimeSamples);
+            for (auto& sample : samples) {
+                const VtValue newVal = _PopFirstValue(sample.second);
+                if (!newVal.IsEmpty()) {
+                    sample.second = newVal;
+                }
+            }
+            clipLayer->SetField(
+                    valuesPath,
+                    SdfFieldKeys->TimeSamples,
+                    VtValue::Take(samples));
+        }
+
+        const UsdAttribute indicesAttr = primvar.GetIndicesAttr();
+        if (!indicesAttr) {
+            continue;
+        }
+        const SdfPath indicesPath = indicesAttr.GetPath();
+        if (clipLayer->HasField(indicesPath, SdfFieldKeys->TimeSamples)) {
+            SdfTimeSampleMap samples = clipLayer->GetFieldAs<SdfTimeSampleMap>(
+                    indicesPath, SdfFieldKeys->TimeSamples);
+            for (auto& sample : samples) {
+                if (sample.second.IsHolding<VtIntArray>()) {
+                    sample.second = _ShiftIndices(
+                            sample.second.UncheckedGet<VtIntArray>(), -1);
+                }
+            }
+            clipLayer->SetField(
+                    indicesPath,
+                    SdfFieldKeys->TimeSamples,
+                    VtValue::Take(samples));
+        }
+    }
+}
+
 PXR_NAMESPACE_CLOSE_SCOPE
 
@@ -27,6 +27,7 @@
 #if __F16C__
 #include <immintrin.h>
 #endif
+#include "SIMD.h"
 #include "pxr/base/gf/half.h"
 #include "pxr/base/gf/ilmbase_half.h"
 
@@ -34,6 +35,11 @@ PXR_NAMESPACE_USING_DIRECTIVE
 
 namespace MayaUsdUtils {
 
+// The DiffCore kernels include this file from sources compiled for AVX2 and AVX-512 (see mayaUsd_add_simd_sources),
+// which take the F16C branch below while the other sources may not. The conversions live in the namespace of the
+// instruction set, so that each of them gets its own copy of these inline functions.
+inline namespace MAYAUSD_SIMD_TARGET {
+
 #ifdef __F16C__
 
 /// converts 8xhalf to 8xfloat
@@ -254,5 +260,6 @@ inline GfHalf double2half_1f(const double f)
 }
 #endif
 
+} // MAYAUSD_SIMD_TARGET
 } // MayaUsdUtils
 
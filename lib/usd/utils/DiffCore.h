@@ -442,5 +442,17 @@ bool compareRGBAArray(
     const size_t count,
     const float eps = 1e-5f);
 
+//----------------------------------------------------------------------------------------------------------------------
+/// \brief  computes a 64bit fingerprint of a block of memory, used to cheaply detect whether an array has changed
+///         without comparing it against a previous copy. The result does not depend on the instruction set the
+///         hash is computed with, so fingerprints may be compared across machines.
+/// \param  data the data to hash
+/// \param  numBytes the size of the data in bytes
+/// \param  seed an optional seed value, e.g. the fingerprint of a previous block to chain hashes together
+/// \return the fingerprint of the data
+//----------------------------------------------------------------------------------------------------------------------
+MAYA_USD_UTILS_PUBLIC
+uint64_t hashArray(const void* const data, const size_t numBytes, const uint64_t seed = 0);
+
 //----------------------------------------------------------------------------------------------------------------------
 } // MayaUsdUtils
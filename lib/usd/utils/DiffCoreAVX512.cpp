@@ -0,0 +1,24 @@
+//
+// Copyright 2020 Autodesk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+// DiffCore kernels compiled for AVX-512, see mayaUsd_add_simd_sources.
+#include "SIMD.h"
+
+#if !ENABLE_AVX512_ROUTINES
+# error "DiffCoreAVX512.cpp must be compiled with AVX-512 F, BW, DQ and VL enabled"
+#endif
+
+#include "DiffCoreImpl.h"
@@ -0,0 +1,57 @@
+//
+// Copyright 2020 Autodesk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#pragma once
+
+#include "Api.h"
+#include "ALHalf.h"
+
+#include <cstddef>
+
+namespace MayaUsdUtils {
+
+//----------------------------------------------------------------------------------------------------------------------
+/// \brief  The DiffCore routines compiled for one instruction set. DiffCoreImpl.h is compiled once per instruction
+///         set (DiffCoreBaseline.cpp, DiffCoreAVX2.cpp, DiffCoreAVX512.cpp), each filling one of these tables, and
+///         DiffCore.cpp forwards the public functions to the table matching the active SIMD level.
+//----------------------------------------------------------------------------------------------------------------------
+struct DiffCoreKernels
+{
+  bool (*vec2AreAllTheSameUV)(const float*, const float*, size_t);
+  bool (*vec2fAreAllTheSame)(const float*, size_t);
+  bool (*vec3fAreAllTheSame)(const float*, size_t);
+  bool (*vec4fAreAllTheSame)(const float*, size_t);
+  bool (*vec2dAreAllTheSame)(const double*, size_t);
+  bool (*vec3dAreAllTheSame)(const double*, size_t);
+  bool (*vec4dAreAllTheSame)(const double*, size_t);
+  bool (*compareHalfFloat)(const GfHalf*, const float*, size_t, size_t, float);
+  bool (*compareHalfDouble)(const GfHalf*, const double*, size_t, size_t, double);
+  bool (*compareDouble)(const double*, const double*, size_t, size_t, double);
+  bool (*compareFloat)(const float*, const float*, size_t, size_t, float);
+  bool (*compareInt8)(const int8_t*, const int8_t*, size_t, size_t);
+  bool (*compareInt32)(const int32_t*, const int32_t*, size_t, size_t);
+  bool (*compareUvArray)(const float*, const float*, const float*, size_t, size_t, float);
+  bool (*compareUvArrayToConstant)(float, float, const float*, const float*, size_t, float);
+  bool (*compareArrayFloat3DtoDouble4D)(const float*, const double*, size_t, size_t, float);
+  bool (*compareRGBAArray)(float, float, float, float, const float*, size_t, float);
+  uint64_t (*hashArray)(const void*, size_t, uint64_t);
+};
+
+/// the kernel tables, only those enabled by MAYAUSD_SIMD_HAS_AVX2 / MAYAUSD_SIMD_HAS_AVX512 are compiled
+MAYA_USD_UTILS_LOCAL const DiffCoreKernels& baselineDiffCoreKernels();
+MAYA_USD_UTILS_LOCAL const DiffCoreKernels& avx2DiffCoreKernels();
+MAYA_USD_UTILS_LOCAL const DiffCoreKernels& avx512DiffCoreKernels();
+
+} // MayaUsdUtils
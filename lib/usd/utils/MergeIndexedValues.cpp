@@ -0,0 +1,276 @@
+//
+// Copyright 2020 Autodesk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "MergeIndexedValues.h"
+
+#include "pxr/base/gf/vec2f.h"
+#include "pxr/base/gf/vec3f.h"
+#include "pxr/base/gf/vec4f.h"
+#include "pxr/base/vt/array.h"
+#include "pxr/base/work/loops.h"
+
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+PXR_NAMESPACE_USING_DIRECTIVE
+
+namespace MayaUsdUtils {
+
+namespace {
+
+// Arrays with fewer values than this are deduplicated serially; above it,
+// hashing and equivalence classes are computed on worker threads.
+constexpr size_t kParallelMergeThreshold = 1u << 15;
+
+// Number of hash partitions used when merging in parallel. Each partition
+// owns a disjoint slice of the hash space and can be resolved independently.
+constexpr size_t kNumMergePartitions = 64u;
+
+//----------------------------------------------------------------------------------------------------------------------
+template <typename T>
+struct ValuesTraits
+{
+  static_assert(sizeof(T) % sizeof(float) == 0, "Merged values must be tightly packed floats");
+
+  static constexpr size_t NumComponents = sizeof(T) / sizeof(float);
+
+  static const float* components(const T& value)
+  {
+    return reinterpret_cast<const float*>(&value);
+  }
+
+  // Hash of the exact component values, with -0.0 and 0.0 hashing alike so
+  // that it stays consistent with operator== on floats.
+  static size_t hash(const T& value)
+  {
+    const float* c = components(value);
+    uint64_t h = 0xcbf29ce484222325ULL;
+    for(size_t i = 0; i < NumComponents; ++i)
+    {
+      const float f = (c[i] == 0.0f) ? 0.0f : c[i];
+      uint32_t bits;
+      std::memcpy(&bits, &f, sizeof(bits));
+      h = (h ^ bits) * 0x100000001b3ULL;
+    }
+    // Finalize so that both the low bits (table slot) and the high bits
+    // (partition) are well distributed.
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return size_t(h);
+  }
+
+  static bool equal(const T& a, const T& b)
+  {
+    const float* ca = components(a);
+    const float* cb = components(b);
+    for(size_t i = 0; i < NumComponents; ++i)
+    {
+      if(!(ca[i] == cb[i]))
+        return false;
+    }
+    return true;
+  }
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+/// runs fn(begin, end) over [0, n), in parallel when n is large enough.
+//----------------------------------------------------------------------------------------------------------------------
+template <typename Fn>
+void forRange(size_t n, Fn&& fn)
+{
+  if(n >= kParallelMergeThreshold)
+    WorkParallelForN(n, std::forward<Fn>(fn));
+  else
+    fn(0u, n);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+/// Resolves the values listed in order[begin, end) into equivalence classes using an open-addressing table with linear
+/// probing. canonical[i] is set to the lowest index of a value equal to values[i]. Indices in order must be ascending
+/// so that the first occurrence wins.
+//----------------------------------------------------------------------------------------------------------------------
+template <typename T>
+void resolveEquivalenceClasses(
+    const T* values,
+    const size_t* hashes,
+    const int* order,
+    size_t begin,
+    size_t end,
+    int* canonical)
+{
+  using Traits = ValuesTraits<T>;
+
+  const size_t count = end - begin;
+  if(count == 0u)
+    return;
+
+  // Keep the load factor at or below one half.
+  size_t capacity = 16u;
+  while(capacity < count * 2u)
+    capacity <<= 1u;
+  const size_t mask = capacity - 1u;
+  std::vector<int> slots(capacity, -1);
+
+  for(size_t i = begin; i < end; ++i)
+  {
+    const int valueIndex = order[i];
+    const T& value = values[valueIndex];
+    const size_t hash = hashes[valueIndex];
+
+    size_t slot = hash & mask;
+    while(true)
+    {
+      const int entry = slots[slot];
+      if(entry < 0)
+      {
+        slots[slot] = valueIndex;
+        canonical[valueIndex] = valueIndex;
+        break;
+      }
+      if(hashes[entry] == hash && Traits::equal(values[entry], value))
+      {
+        canonical[valueIndex] = entry;
+        break;
+      }
+      slot = (slot + 1u) & mask;
+    }
+  }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+template <typename T>
+void mergeIndexedValues(VtArray<T>* valueData, VtIntArray* assignmentIndices)
+{
+  if(!valueData || !assignmentIndices)
+    return;
+
+  const size_t numValues = valueData->size();
+  if(numValues == 0u)
+    return;
+
+  const T* values = valueData->cdata();
+
+  std::vector<size_t> hashes(numValues);
+  forRange(numValues, [values, &hashes](size_t begin, size_t end) {
+    for(size_t i = begin; i < end; ++i)
+      hashes[i] = ValuesTraits<T>::hash(values[i]);
+  });
+
+  // Bucket value indices by the high bits of their hash with a stable
+  // counting sort, so that each partition lists its values in ascending
+  // order and can be resolved without synchronization.
+  const size_t numPartitions = (numValues >= kParallelMergeThreshold) ? kNumMergePartitions : 1u;
+  const auto partitionOf = [numPartitions](size_t hash) {
+    return (hash >> 32u) % numPartitions;
+  };
+
+  std::vector<size_t> partitionOffsets(numPartitions + 1u, 0u);
+  for(size_t i = 0u; i < numValues; ++i)
+    ++partitionOffsets[partitionOf(hashes[i]) + 1u];
+  for(size_t p = 0u; p < numPartitions; ++p)
+    partitionOffsets[p + 1u] += partitionOffsets[p];
+
+  std::vector<int> order(numValues);
+  {
+    std::vector<size_t> cursor(partitionOffsets.begin(), partitionOffsets.end() - 1);
+    for(size_t i = 0u; i < numValues; ++i)
+      order[cursor[partitionOf(hashes[i])]++] = int(i);
+  }
+
+  std::vector<int> canonical(numValues);
+  const auto resolvePartitions = [&](size_t begin, size_t end) {
+    for(size_t p = begin; p < end; ++p)
+    {
+      resolveEquivalenceClasses(values, hashes.data(), order.data(),
+                                partitionOffsets[p], partitionOffsets[p + 1u], canonical.data());
+    }
+  };
+  if(numPartitions > 1u)
+    WorkParallelForN(numPartitions, resolvePartitions);
+  else
+    resolvePartitions(0u, numPartitions);
+
+  // Number the equivalence classes in order of first assignment, which is
+  // the order in which the unique values were previously discovered.
+  const size_t numAssignments = assignmentIndices->size();
+  const int* assignments = assignmentIndices->cdata();
+
+  std::vector<int> uniqueIndexOfClass(numValues, -1);
+  VtArray<T> uniqueValues;
+  uniqueValues.reserve(numValues);
+  VtIntArray uniqueIndices(numAssignments);
+  int* uniqueIndicesData = uniqueIndices.data();
+
+  for(size_t i = 0u; i < numAssignments; ++i)
+  {
+    const int index = assignments[i];
+    if(index < 0 || size_t(index) >= numValues)
+    {
+      // This is an unassigned or otherwise unknown index, so just keep it.
+      uniqueIndicesData[i] = index;
+      continue;
+    }
+
+    int& uniqueIndex = uniqueIndexOfClass[canonical[index]];
+    if(uniqueIndex < 0)
+    {
+      // This is a new value, so add it to the array.
+      uniqueIndex = int(uniqueValues.size());
+      uniqueValues.push_back(values[index]);
+    }
+
+    uniqueIndicesData[i] = uniqueIndex;
+  }
+
+  // If we reduced the number of values by merging, copy the results back.
+  if(uniqueValues.size() < numValues)
+  {
+    valueData->swap(uniqueValues);
+    assignmentIndices->swap(uniqueIndices);
+  }
+}
+
+} // anon
+
+//----------------------------------------------------------------------------------------------------------------------
+void mergeEquivalentIndexedValues(VtFloatArray* valueData, VtIntArray* assignmentIndices)
+{
+  mergeIndexedValues<float>(valueData, assignmentIndices);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void mergeEquivalentIndexedValues(VtVec2fArray* valueData, VtIntArray* assignmentIndices)
+{
+  mergeIndexedValues<GfVec2f>(valueData, assignmentIndices);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void mergeEquivalentIndexedValues(VtVec3fArray* valueData, VtIntArray* assignmentIndices)
+{
+  mergeIndexedValues<GfVec3f>(valueData, assignmentIndices);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void mergeEquivalentIndexedValues(VtVec4fArray* valueData, VtIntArray* assignmentIndices)
+{
+  mergeIndexedValues<GfVec4f>(valueData, assignmentIndices);
+}
+
+} // MayaUsdUtils
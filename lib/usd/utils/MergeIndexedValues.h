@@ -0,0 +1,48 @@
+//
+// Copyright 2020 Autodesk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#pragma once
+
+#include "Api.h"
+
+#include "pxr/pxr.h"
+#include "pxr/base/vt/types.h"
+
+namespace MayaUsdUtils {
+
+//----------------------------------------------------------------------------------------------------------------------
+/// \brief  Combines distinct indices that point to the same values so that they all point to the same index for that
+///         value, which will potentially shrink the value array. Unique values are numbered in order of their first
+///         assignment, values are compared exactly, and negative or out of range indices are kept as they are.
+///         Large arrays are hashed and deduplicated on worker threads.
+/// \param  valueData the indexed values, replaced by the unique values if any were merged
+/// \param  assignmentIndices the indices into valueData, remapped to the unique values if any were merged
+//----------------------------------------------------------------------------------------------------------------------
+MAYA_USD_UTILS_PUBLIC
+void mergeEquivalentIndexedValues(PXR_NS::VtFloatArray* valueData, PXR_NS::VtIntArray* assignmentIndices);
+
+/// \copydoc mergeEquivalentIndexedValues(PXR_NS::VtFloatArray*, PXR_NS::VtIntArray*)
+MAYA_USD_UTILS_PUBLIC
+void mergeEquivalentIndexedValues(PXR_NS::VtVec2fArray* valueData, PXR_NS::VtIntArray* assignmentIndices);
+
+/// \copydoc mergeEquivalentIndexedValues(PXR_NS::VtFloatArray*, PXR_NS::VtIntArray*)
+MAYA_USD_UTILS_PUBLIC
+void mergeEquivalentIndexedValues(PXR_NS::VtVec3fArray* valueData, PXR_NS::VtIntArray* assignmentIndices);
+
+/// \copydoc mergeEquivalentIndexedValues(PXR_NS::VtFloatArray*, PXR_NS::VtIntArray*)
+MAYA_USD_UTILS_PUBLIC
+void mergeEquivalentIndexedValues(PXR_NS::VtVec4fArray* valueData, PXR_NS::VtIntArray* assignmentIndices);
+
+} // MayaUsdUtils
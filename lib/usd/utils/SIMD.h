@@ -18,14 +18,16 @@
 #ifdef _WIN32
 # define ALIGN16(X) __declspec(align(16)) X
 # define ALIGN32(X) __declspec(align(32)) X
+# define ALIGN64(X) __declspec(align(64)) X
 #else
 # define ALIGN16(X) X __attribute__((aligned(16)))
 # define ALIGN32(X) X __attribute__((aligned(32)))
+# define ALIGN64(X) X __attribute__((aligned(64)))
 #endif
 
 #include <stdint.h>
 
-#ifdef __AVX2__
+#if defined(__AVX2__) || defined(__AVX512F__)
 # include <immintrin.h>
 #endif
 
@@ -59,7 +61,36 @@
 # define ENABLE_SOME_AVX_ROUTINES 1
 #endif
 
+// The AVX-512 routines need the foundation, byte/word, dword/qword and vector
+// length extensions, which are all present on Skylake-SP and later.
+#if defined(__AVX512F__) && defined(__AVX512BW__) && defined(__AVX512DQ__) && defined(__AVX512VL__)
+# define ENABLE_AVX512_ROUTINES 1
+#else
+# define ENABLE_AVX512_ROUTINES 0
+#endif
+
+// The same source may be compiled several times with different instruction set flags (see
+// mayaUsd_add_simd_sources), and the binaries dispatch between them at runtime (see SIMDDispatch.h).
+// Everything defined here lives in a namespace named after the instruction set, so that the inline
+// functions compiled for one instruction set can never be merged by the linker with those compiled
+// for another one.
+#if ENABLE_AVX512_ROUTINES
+# define MAYAUSD_SIMD_TARGET avx512
+#elif defined(__AVX2__)
+# define MAYAUSD_SIMD_TARGET avx2
+#else
+# define MAYAUSD_SIMD_TARGET baseline
+#endif
+
+#define MAYAUSD_SIMD_NAME_PASTE(target, name) target##name
+#define MAYAUSD_SIMD_NAME_EXPAND(target, name) MAYAUSD_SIMD_NAME_PASTE(target, name)
+
+/// \brief  prefixes name with the instruction set the file is compiled for, e.g. avx2DiffCoreKernels. This gives
+///         each compiled variant of a kernel table a distinct name that the dispatching code can refer to.
+#define MAYAUSD_SIMD_NAME(name) MAYAUSD_SIMD_NAME_EXPAND(MAYAUSD_SIMD_TARGET, name)
+
 namespace MayaUsdUtils {
+inline namespace MAYAUSD_SIMD_TARGET {
 
 #if defined(__SSE__)
 typedef __m128 f128;
@@ -415,5 +446,93 @@ inline f128 loadmask3f(const void* const ptr, size_t count)
 }
 #endif
 
+#if ENABLE_AVX512_ROUTINES
+typedef __m512 f512;
+typedef __m512i i512;
+typedef __m512d d512;
+typedef __mmask8 mask8;
+typedef __mmask16 mask16;
+typedef __mmask64 mask64;
+
+/// \brief  returns a mask with the lowest (count % N) bits set, used to process the tail of an array.
+AL_DLL_HIDDEN inline mask8 tailmask8(const size_t count) { return mask8((1U << (count & 0x7)) - 1); }
+AL_DLL_HIDDEN inline mask16 tailmask16(const size_t count) { return mask16((1U << (count & 0xF)) - 1); }
+AL_DLL_HIDDEN inline mask64 tailmask64(const size_t count) { return mask64((1ULL << (count & 0x3F)) - 1); }
+
+/// \brief  returns a mask with the lowest min(count, 16) bits set.
+AL_DLL_HIDDEN inline mask16 prefixmask16(const size_t count) { return count >= 16 ? mask16(0xFFFF) : mask16((1U << count) - 1); }
+
+AL_DLL_HIDDEN inline f512 zero16f() { return _mm512_setzero_ps(); }
+AL_DLL_HIDDEN inline d512 zero8d() { return _mm512_setzero_pd(); }
+
+AL_DLL_HIDDEN inline f512 splat16f(const float f) { return _mm512_set1_ps(f); }
+AL_DLL_HIDDEN inline d512 splat8d(const double f) { return _mm512_set1_pd(f); }
+
+/// \brief  repeats the 2, 4 values starting at ptr across the whole register.
+AL_DLL_HIDDEN inline f512 broadcast2f(const void* const ptr) { return _mm512_castpd_ps(_mm512_broadcastsd_pd(_mm_load_sd((const double*)ptr))); }
+AL_DLL_HIDDEN inline f512 broadcast4f(const f128 reg) { return _mm512_broadcast_f32x4(reg); }
+AL_DLL_HIDDEN inline d512 broadcast2d(const d128 reg) { return _mm512_broadcast_f64x2(reg); }
+AL_DLL_HIDDEN inline d512 broadcast4d(const d256 reg) { return _mm512_broadcast_f64x4(reg); }
+
+AL_DLL_HIDDEN inline f512 loadu16f(const void* const ptr) { return _mm512_loadu_ps(ptr); }
+AL_DLL_HIDDEN inline d512 loadu8d(const void* const ptr) { return _mm512_loadu_pd(ptr); }
+AL_DLL_HIDDEN inline i512 loadu16i(const void* const ptr) { return _mm512_loadu_si512(ptr); }
+
+/// \brief  loads the elements enabled in the mask, and sets the other elements to zero. Disabled elements are
+///         never read, so these can be used to read the tail of an array without reading past its end.
+AL_DLL_HIDDEN inline f512 loadu16f(const void* const ptr, const mask16 m) { return _mm512_maskz_loadu_ps(m, ptr); }
+AL_DLL_HIDDEN inline d512 loadu8d(const void* const ptr, const mask8 m) { return _mm512_maskz_loadu_pd(m, ptr); }
+AL_DLL_HIDDEN inline i512 loadu16i(const void* const ptr, const mask16 m) { return _mm512_maskz_loadu_epi32(m, ptr); }
+AL_DLL_HIDDEN inline i512 loadu64i8(const void* const ptr, const mask64 m) { return _mm512_maskz_loadu_epi8(m, ptr); }
+AL_DLL_HIDDEN inline i256 loadu16i16(const void* const ptr, const mask16 m) { return _mm256_maskz_loadu_epi16(m, ptr); }
+
+AL_DLL_HIDDEN inline void storeu16f(void* const ptr, const f512 reg) { _mm512_storeu_ps(ptr, reg); }
+AL_DLL_HIDDEN inline void storeu8d(void* const ptr, const d512 reg) { _mm512_storeu_pd(ptr, reg); }
+
+/// \brief  only stores the elements enabled in the mask, the memory of the disabled elements is left untouched.
+AL_DLL_HIDDEN inline void storeu16f(void* const ptr, const f512 reg, const mask16 m) { _mm512_mask_storeu_ps(ptr, m, reg); }
+AL_DLL_HIDDEN inline void storeu8d(void* const ptr, const d512 reg, const mask8 m) { _mm512_mask_storeu_pd(ptr, m, reg); }
+
+AL_DLL_HIDDEN inline f256 loadu8f(const void* const ptr, const mask8 m) { return _mm256_maskz_loadu_ps(m, ptr); }
+AL_DLL_HIDDEN inline d512 cvt8f_to_8d(const f256 reg) { return _mm512_cvtps_pd(reg); }
+
+AL_DLL_HIDDEN inline f512 i32gather16f(const float* const ptr, const i512 indices) { return _mm512_i32gather_ps(indices, ptr, 4); }
+AL_DLL_HIDDEN inline f512 i32gather16f(const float* const ptr, const i512 indices, const mask16 m)
+  { return _mm512_mask_i32gather_ps(_mm512_setzero_ps(), m, indices, ptr, 4); }
+
+AL_DLL_HIDDEN inline f512 sub16f(const f512 a, const f512 b) { return _mm512_sub_ps(a, b); }
+AL_DLL_HIDDEN inline d512 sub8d(const d512 a, const d512 b) { return _mm512_sub_pd(a, b); }
+
+AL_DLL_HIDDEN inline f512 abs16f(const f512 v) { return _mm512_abs_ps(v); }
+AL_DLL_HIDDEN inline d512 abs8d(const d512 v) { return _mm512_abs_pd(v); }
+
+AL_DLL_HIDDEN inline f512 cvtph16(const i256 a) { return _mm512_cvtph_ps(a); }
+
+/// \brief  interleaves the elements of a and b, returning the low and high 16 element halves.
+AL_DLL_HIDDEN inline f512 ziplo16f(const f512 a, const f512 b)
+{
+  return _mm512_permutex2var_ps(a, _mm512_setr_epi32(0, 16, 1, 17, 2, 18, 3, 19, 4, 20, 5, 21, 6, 22, 7, 23), b);
+}
+AL_DLL_HIDDEN inline f512 ziphi16f(const f512 a, const f512 b)
+{
+  return _mm512_permutex2var_ps(a, _mm512_setr_epi32(8, 24, 9, 25, 10, 26, 11, 27, 12, 28, 13, 29, 14, 30, 15, 31), b);
+}
+
+// Comparisons return a bit mask rather than a register. The not-equal comparisons are unordered so
+// that, like the SSE and scalar code paths, NaN never compares equal to anything.
+AL_DLL_HIDDEN inline mask16 cmpne16f(const f512 a, const f512 b) { return _mm512_cmp_ps_mask(a, b, _CMP_NEQ_UQ); }
+AL_DLL_HIDDEN inline mask8 cmpne8d(const d512 a, const d512 b) { return _mm512_cmp_pd_mask(a, b, _CMP_NEQ_UQ); }
+AL_DLL_HIDDEN inline mask16 cmpne16i(const i512 a, const i512 b) { return _mm512_cmpneq_epi32_mask(a, b); }
+AL_DLL_HIDDEN inline mask64 cmpne64i8(const i512 a, const i512 b) { return _mm512_cmpneq_epi8_mask(a, b); }
+AL_DLL_HIDDEN inline mask16 cmpgt16f(const f512 a, const f512 b) { return _mm512_cmp_ps_mask(a, b, _CMP_GT_OQ); }
+AL_DLL_HIDDEN inline mask8 cmpgt8d(const d512 a, const d512 b) { return _mm512_cmp_pd_mask(a, b, _CMP_GT_OQ); }
+
+/// \brief  only compares the elements enabled in the mask, the other bits of the result are zero.
+AL_DLL_HIDDEN inline mask16 cmpne16f(const mask16 m, const f512 a, const f512 b) { return _mm512_mask_cmp_ps_mask(m, a, b, _CMP_NEQ_UQ); }
+AL_DLL_HIDDEN inline mask8 cmpne8d(const mask8 m, const d512 a, const d512 b) { return _mm512_mask_cmp_pd_mask(m, a, b, _CMP_NEQ_UQ); }
+AL_DLL_HIDDEN inline mask16 cmpgt16f(const mask16 m, const f512 a, const f512 b) { return _mm512_mask_cmp_ps_mask(m, a, b, _CMP_GT_OQ); }
+#endif
+
+} // MAYAUSD_SIMD_TARGET
 } // MayaUsdUtils
 
@@ -0,0 +1,146 @@
+//
+// Copyright 2020 Autodesk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "SIMDDispatch.h"
+
+#include "pxr/pxr.h"
+#include "pxr/base/tf/diagnostic.h"
+#include "pxr/base/tf/getenv.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+# include <intrin.h>
+# define MAYAUSD_HAS_CPUID 1
+#elif defined(__x86_64__) || defined(__i386__)
+# include <cpuid.h>
+# define MAYAUSD_HAS_CPUID 1
+#else
+# define MAYAUSD_HAS_CPUID 0
+#endif
+
+PXR_NAMESPACE_USING_DIRECTIVE
+
+namespace MayaUsdUtils {
+
+namespace {
+
+#if MAYAUSD_HAS_CPUID
+
+//----------------------------------------------------------------------------------------------------------------------
+void cpuid(const uint32_t leaf, const uint32_t subleaf, uint32_t regs[4])
+{
+#if defined(_MSC_VER)
+  int r[4];
+  __cpuidex(r, int(leaf), int(subleaf));
+  for(int i = 0; i < 4; ++i)
+    regs[i] = uint32_t(r[i]);
+#else
+  __cpuid_count(leaf, subleaf, regs[0], regs[1], regs[2], regs[3]);
+#endif
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+uint64_t xgetbv0()
+{
+#if defined(_MSC_VER)
+  return _xgetbv(0);
+#else
+  uint32_t eax, edx;
+  __asm__ __volatile__("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+  return (uint64_t(edx) << 32) | eax;
+#endif
+}
+
+#endif
+
+//----------------------------------------------------------------------------------------------------------------------
+SimdLevel detectSimdLevel()
+{
+#if MAYAUSD_HAS_CPUID
+  uint32_t regs[4];
+  cpuid(0, 0, regs);
+  if(regs[0] < 7)
+    return SimdLevel::kBaseline;
+
+  // AVX2 kernels also make use of FMA and F16C, and the OS must have enabled the AVX state (OSXSAVE).
+  cpuid(1, 0, regs);
+  const uint32_t ecx1 = regs[2];
+  const bool fma = (ecx1 & (1U << 12)) != 0;
+  const bool osxsave = (ecx1 & (1U << 27)) != 0;
+  const bool avx = (ecx1 & (1U << 28)) != 0;
+  const bool f16c = (ecx1 & (1U << 29)) != 0;
+  if(!(fma && osxsave && avx && f16c))
+    return SimdLevel::kBaseline;
+
+  // the OS must save the XMM and YMM registers on context switches
+  const uint64_t xcr0 = xgetbv0();
+  if((xcr0 & 0x6) != 0x6)
+    return SimdLevel::kBaseline;
+
+  cpuid(7, 0, regs);
+  const uint32_t ebx7 = regs[1];
+  const bool avx2 = (ebx7 & (1U << 5)) != 0;
+  if(!avx2)
+    return SimdLevel::kBaseline;
+
+  const bool avx512f = (ebx7 & (1U << 16)) != 0;
+  const bool avx512dq = (ebx7 & (1U << 17)) != 0;
+  const bool avx512bw = (ebx7 & (1U << 30)) != 0;
+  const bool avx512vl = (ebx7 & (1U << 31)) != 0;
+
+  // ... and the opmask and ZMM registers for AVX-512
+  if(avx512f && avx512dq && avx512bw && avx512vl && (xcr0 & 0xE0) == 0xE0)
+    return SimdLevel::kAVX512;
+
+  return SimdLevel::kAVX2;
+#else
+  return SimdLevel::kBaseline;
+#endif
+}
+
+} // anon
+
+//----------------------------------------------------------------------------------------------------------------------
+SimdLevel hardwareSimdLevel()
+{
+  static const SimdLevel level = detectSimdLevel();
+  return level;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+SimdLevel activeSimdLevel()
+{
+  static const SimdLevel level = []()
+  {
+    const SimdLevel hardware = hardwareSimdLevel();
+    const std::string requested = TfGetenv("MAYAUSD_SIMD_LEVEL");
+    if(requested.empty() || requested == "avx512")
+      return hardware;
+    if(requested == "avx2")
+      return std::min(hardware, SimdLevel::kAVX2);
+    if(requested == "baseline")
+      return SimdLevel::kBaseline;
+
+    TF_WARN("Ignoring unknown MAYAUSD_SIMD_LEVEL '%s', expected 'baseline', 'avx2' or 'avx512'.",
+            requested.c_str());
+    return hardware;
+  }();
+  return level;
+}
+
+} // MayaUsdUtils
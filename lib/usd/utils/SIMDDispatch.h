@@ -0,0 +1,74 @@
+//
+// Copyright 2020 Autodesk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#pragma once
+
+#include "Api.h"
+
+namespace MayaUsdUtils {
+
+//----------------------------------------------------------------------------------------------------------------------
+/// \brief  The instruction sets for which SIMD kernels may be compiled, in increasing order of capability.
+//----------------------------------------------------------------------------------------------------------------------
+enum class SimdLevel : int
+{
+  kBaseline = 0, ///< the instruction set the library is compiled for (SSE2 on x86-64)
+  kAVX2,         ///< AVX2, FMA and F16C (Haswell and later)
+  kAVX512        ///< AVX-512 F, BW, DQ and VL (Skylake-SP and later)
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+/// \brief  returns the best instruction set supported by both the CPU and the operating system.
+//----------------------------------------------------------------------------------------------------------------------
+MAYA_USD_UTILS_PUBLIC
+SimdLevel hardwareSimdLevel();
+
+//----------------------------------------------------------------------------------------------------------------------
+/// \brief  returns the instruction set SIMD kernels should be selected for. This is the hardware level, optionally
+///         lowered by setting the MAYAUSD_SIMD_LEVEL environment variable to "baseline", "avx2" or "avx512" (which
+///         is useful to compare results, or to work around throttling of AVX-512 on some CPUs).
+//----------------------------------------------------------------------------------------------------------------------
+MAYA_USD_UTILS_PUBLIC
+SimdLevel activeSimdLevel();
+
+//----------------------------------------------------------------------------------------------------------------------
+/// \brief  selects the best kernel for the active SIMD level. Kernels that were not compiled into the binary (see
+///         mayaUsd_add_simd_sources and the MAYAUSD_SIMD_HAS_AVX2 / MAYAUSD_SIMD_HAS_AVX512 definitions) should be
+///         passed as nullptr, in which case the next best kernel is returned.
+/// \param  baseline the kernel compiled with the default compiler flags, must not be null
+/// \param  avx2 the kernel compiled for AVX2, or nullptr
+/// \param  avx512 the kernel compiled for AVX-512, or nullptr
+/// \return the kernel to call
+//----------------------------------------------------------------------------------------------------------------------
+template<typename Kernel>
+Kernel selectSimdKernel(Kernel baseline, Kernel avx2, Kernel avx512)
+{
+  switch(activeSimdLevel())
+  {
+  case SimdLevel::kAVX512:
+    if(avx512)
+      return avx512;
+    /* fall through */
+  case SimdLevel::kAVX2:
+    if(avx2)
+      return avx2;
+    /* fall through */
+  default:
+    break;
+  }
+  return baseline;
+}
+
+} // MayaUsdUtils
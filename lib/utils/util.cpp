@@ -18,6 +18,8 @@
 
 #include "colorSpace.h"
 
+#include <mayaUsdUtils/MergeIndexedValues.h>
+
 #include "pxr/base/gf/gamma.h"
 #include "pxr/base/gf/vec2f.h"
 #include "pxr/base/gf/vec3f.h"
@@ -52,9 +54,9 @@
 #include <maya/MFnSet.h>
 #include <maya/MFnTypedAttribute.h>
 #include <maya/MGlobal.h>
+#include <maya/MIntArray.h>
 #include <maya/MItDependencyGraph.h>
 #include <maya/MItDependencyNodes.h>
-#include <maya/MItMeshFaceVertex.h>
 #include <maya/MItMeshPolygon.h>
 #include <maya/MMatrix.h>
 #include <maya/MObject.h>
@@ -67,11 +69,8 @@
 #include <maya/MStringArray.h>
 #include <maya/MTime.h>
 
-#include <boost/functional/hash.hpp>
-
 #include <sstream>
 #include <string>
-#include <unordered_map>
 #include <vector>
 
 
@@ -959,116 +958,32 @@ UsdMayaUtil::GetLinearShaderColor(
                                  assignmentIndices);
 }
 
-namespace {
-
-template <typename T>
-struct _ValuesHash
-{
-    std::size_t operator() (const T& value) const {
-        return hash_value(value);
-    }
-};
-
-// There is no globally defined hash_value for numeric types
-// so we need an explicit opt-in here.
-template <>
-struct _ValuesHash<float>
-{
-    std::size_t operator() (const float& value) const {
-        return boost::hash_value(value);
-    }
-};
-
-template <typename T>
-struct _ValuesEqual
-{
-    bool operator() (const T& a, const T& b) const {
-        return GfIsClose(a, b, 1e-9);
-    }
-};
-
-} // anonymous namespace
-
-template <typename T>
-static
-void
-_MergeEquivalentIndexedValues(
-        VtArray<T>* valueData,
-        VtIntArray* assignmentIndices)
-{
-    if (!valueData || !assignmentIndices) {
-        return;
-    }
-
-    const size_t numValues = valueData->size();
-    if (numValues == 0u) {
-        return;
-    }
-
-    // We maintain a map of values to that value's index in our uniqueValues
-    // array.
-    std::unordered_map<T, size_t, _ValuesHash<T>, _ValuesEqual<T> > valuesMap;
-    VtArray<T> uniqueValues;
-    VtIntArray uniqueIndices;
-
-    for (int index : *assignmentIndices) {
-        if (index < 0 || static_cast<size_t>(index) >= numValues) {
-            // This is an unassigned or otherwise unknown index, so just keep it.
-            uniqueIndices.push_back(index);
-            continue;
-        }
-
-        const T value = (*valueData)[index];
-
-        int uniqueIndex = -1;
-
-        auto inserted = valuesMap.insert(
-            std::pair<T, size_t>(value, uniqueValues.size()));
-        if (inserted.second) {
-            // This is a new value, so add it to the array.
-            uniqueValues.push_back(value);
-            uniqueIndex = uniqueValues.size() - 1;
-        } else {
-            // This is an existing value, so re-use the original's index.
-            uniqueIndex = inserted.first->second;
-        }
-
-        uniqueIndices.push_back(uniqueIndex);
-    }
-
-    // If we reduced the number of values by merging, copy the results back.
-    if (uniqueValues.size() < numValues) {
-        (*valueData) = uniqueValues;
-        (*assignmentIndices) = uniqueIndices;
-    }
-}
-
 void
 UsdMayaUtil::MergeEquivalentIndexedValues(
         VtFloatArray* valueData,
         VtIntArray* assignmentIndices) {
-    return _MergeEquivalentIndexedValues<float>(valueData, assignmentIndices);
+    MayaUsdUtils::mergeEquivalentIndexedValues(valueData, assignmentIndices);
 }
 
 void
 UsdMayaUtil::MergeEquivalentIndexedValues(
         VtVec2fArray* valueData,
         VtIntArray* assignmentIndices) {
-    return _MergeEquivalentIndexedValues<GfVec2f>(valueData, assignmentIndices);
+    MayaUsdUtils::mergeEquivalentIndexedValues(valueData, assignmentIndices);
 }
 
 void
 UsdMayaUtil::MergeEquivalentIndexedValues(
         VtVec3fArray* valueData,
         VtIntArray* assignmentIndices) {
-    return _MergeEquivalentIndexedValues<GfVec3f>(valueData, assignmentIndices);
+    MayaUsdUtils::mergeEquivalentIndexedValues(valueData, assignmentIndices);
 }
 
 void
 UsdMayaUtil::MergeEquivalentIndexedValues(
         VtVec4fArray* valueData,
         VtIntArray* assignmentIndices) {
-    return _MergeEquivalentIndexedValues<GfVec4f>(valueData, assignmentIndices);
+    MayaUsdUtils::mergeEquivalentIndexedValues(valueData, assignmentIndices);
 }
 
 void
@@ -1099,40 +1014,60 @@ UsdMayaUtil::CompressFaceVaryingPrimvarIndices(
     bool isUniform = true;
     bool isVertex = true;
 
-    MItMeshFaceVertex itFV(mesh.object());
-    unsigned int fvi = 0;
-    for (itFV.reset(); !itFV.isDone(); itFV.next(), ++fvi) {
-        int faceIndex = itFV.faceId();
-        int vertexIndex = itFV.vertId();
+    // Walk the raw face-vertex arrays, which are in the same order as
+    // MItMeshFaceVertex but avoid an iterator call per face-vertex.
+    MIntArray faceVertexCounts;
+    MIntArray faceVertexIndices;
+    mesh.getVertices(faceVertexCounts, faceVertexIndices);
 
-        int assignedIndex = (*assignmentIndices)[fvi];
+    const int* assignments = assignmentIndices->cdata();
+    const unsigned int numAssignments =
+        static_cast<unsigned int>(assignmentIndices->size());
+    const int firstAssignment = assignments[0];
+    int* uniformData = uniformAssignments.data();
+    int* vertexData = vertexAssignments.data();
 
-        if (isConstant) {
-            if (assignedIndex != (*assignmentIndices)[0]) {
-                isConstant = false;
+    unsigned int fvi = 0;
+    const unsigned int numFaces = faceVertexCounts.length();
+    for (unsigned int faceIndex = 0;
+            faceIndex < numFaces && fvi < numAssignments; ++faceIndex) {
+        const int numFaceVertices = faceVertexCounts[faceIndex];
+        for (int v = 0; v < numFaceVertices && fvi < numAssignments;
+                ++v, ++fvi) {
+            const int vertexIndex = faceVertexIndices[fvi];
+            const int assignedIndex = assignments[fvi];
+
+            if (isConstant) {
+                if (assignedIndex != firstAssignment) {
+                    isConstant = false;
+                }
             }
-        }
 
-        if (isUniform) {
-            if (uniformAssignments[faceIndex] < -1) {
-                // No value for this face yet, so store one.
-                uniformAssignments[faceIndex] = assignedIndex;
-            } else if (assignedIndex != uniformAssignments[faceIndex]) {
-                isUniform = false;
+            if (isUniform) {
+                if (uniformData[faceIndex] < -1) {
+                    // No value for this face yet, so store one.
+                    uniformData[faceIndex] = assignedIndex;
+                } else if (assignedIndex != uniformData[faceIndex]) {
+                    isUniform = false;
+                }
+            }
+
+            if (isVertex) {
+                if (vertexData[vertexIndex] < -1) {
+                    // No value for this vertex yet, so store one.
+                    vertexData[vertexIndex] = assignedIndex;
+                } else if (assignedIndex != vertexData[vertexIndex]) {
+                    isVertex = false;
+                }
             }
-        }
 
-        if (isVertex) {
-            if (vertexAssignments[vertexIndex] < -1) {
-                // No value for this vertex yet, so store one.
-                vertexAssignments[vertexIndex] = assignedIndex;
-            } else if (assignedIndex != vertexAssignments[vertexIndex]) {
-                isVertex = false;
+            if (!isConstant && !isUniform && !isVertex) {
+                // No compression will be possible, so stop trying.
+                break;
             }
         }
 
         if (!isConstant && !isUniform && !isVertex) {
-            // No compression will be possible, so stop trying.
             break;
         }
     }
@@ -1822,11 +1757,12 @@ UsdMayaUtil::GetDictionaryFromArgDatabase(
         const MArgDatabase& argData,
         const VtDictionary& guideDict)
 {
-    // We handle three types of arguments:
+    // We handle four types of arguments:
     // 1 - bools: Some bools are actual boolean flags (t/f) in Maya, and others
     //     are false if omitted, true if present (simple flags).
-    // 2 - strings: Just strings!
-    // 3 - vectors (multi-use args): Try to mimic the way they're passed in the
+    // 2 - ints: Just ints!
+    // 3 - strings: Just strings!
+    // 4 - vectors (multi-use args): Try to mimic the way they're passed in the
     //     Python command API. If single arg per flag, make it a vector of
     //     strings. Multi arg per flag, vector of vector of strings.
     VtDictionary args;
@@ -1837,7 +1773,7 @@ UsdMayaUtil::GetDictionaryFromArgDatabase(
             continue;
         }
 
-        // The usdExport command must handle bools, strings, and vectors.
+        // The usdExport command must handle bools, ints, strings, and vectors.
         if (guideValue.IsHolding<bool>()) {
             // The flag should be either 0-arg or 1-arg. If 0-arg, it's true by
             // virtue of being present (getFlagArgument won't change val). If
@@ -1847,6 +1783,11 @@ UsdMayaUtil::GetDictionaryFromArgDatabase(
             argData.getFlagArgument(key.c_str(), 0, val);
             args[key] = val;
         }
+        else if (guideValue.IsHolding<int>()) {
+            int val = guideValue.UncheckedGet<int>();
+            argData.getFlagArgument(key.c_str(), 0, val);
+            args[key] = val;
+        }
         else if (guideValue.IsHolding<std::string>()) {
             const std::string val =
                     argData.flagArgumentString(key.c_str(), 0).asChar();
@@ -1901,18 +1842,22 @@ UsdMayaUtil::ParseArgumentValue(
         const std::string& value,
         const VtDictionary& guideDict)
 {
-    // We handle two types of arguments:
+    // We handle three types of arguments:
     // 1 - bools: Should be encoded by translator UI as a "1" or "0" string.
-    // 2 - strings: Just strings!
+    // 2 - ints: Encoded by the translator UI as decimal strings.
+    // 3 - strings: Just strings!
     // We don't handle any vectors because none of the translator UIs currently
     // pass around any of the vector flags.
     auto iter = guideDict.find(key);
     if (iter != guideDict.end()) {
         const VtValue& guideValue = iter->second;
-        // The export UI only has boolean and string parameters.
+        // The export UI only has boolean, integer and string parameters.
         if (guideValue.IsHolding<bool>()) {
             return VtValue(TfUnstringify<bool>(value));
         }
+        else if (guideValue.IsHolding<int>()) {
+            return VtValue(TfUnstringify<int>(value));
+        }
         else if (guideValue.IsHolding<std::string>()) {
             return VtValue(value);
         }
@@ -708,4 +708,35 @@ for($event in $childEventIds)
 \endcode
 
 
+\subsection batchedEventsC Compiled and batched script callbacks
+
+When a MEL or python callback is registered, the EventSystemBinding is given the chance to compile it (via
+EventSystemBinding::compileScript), so that the script does not need to be parsed each time the event is triggered. The
+Maya binding compiles python callbacks into code objects. MEL callbacks are executed from source at global scope, just as
+they are when they are not compiled. A binding that does not override compileScript falls back to executing the source
+code of the callback.
+
+Events that can be triggered many times in a row (e.g. once per prim when a large stage is loaded) can be marked as
+coalesced. Within an AL::event::EventBatch, the C++ callbacks of a coalesced event are still executed straight away, but
+its script callbacks are executed once when the outermost batch ends. The text payloads passed when the event was
+triggered are made available to python callbacks in the alEventPayloads variable (which is only defined while the
+callback runs), and to MEL callbacks in the global variable string $alEventPayloads[].
+
+The proxy shape coalesces its PostSelectionChanged, SelectionEnded, PostVariantChanged and PostPayloadLoaded events,
+and batches them when a selection, variant switch, resync or payload load affects many prims at once. The variant and
+payload events pass the path of the prim as their payload. The matching Pre and Started events are not coalesced, so
+their callbacks still run before each change is made.
+
+\code
+AL::event::EventScheduler& scheduler = AL::event::EventScheduler::getScheduler();
+scheduler.event(eventId)->setCoalesced(true);
+{
+  AL::event::EventBatch batch(scheduler);
+  for(auto& prim : prims)
+  {
+    scheduler.triggerEvent(eventId, binder, prim.GetPath().GetText());
+  }
+} // each script callback is executed once here, with alEventPayloads set to the path of every prim
+\endcode
+
 */
@@ -0,0 +1,408 @@
+//
+// Copyright 2020 Autodesk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "AL/usdmaya/BinaryArchive.h"
+
+#include "maya/MSelectionList.h"
+
+#include <cstring>
+
+namespace AL {
+namespace usdmaya {
+
+namespace {
+
+// layout of the int array: magic | version | byte count | bytes (string table, path table, node table, body)
+const uint32_t kHeaderInts = 3;
+
+// path index reserved for the absolute root, and the index used for the empty path (or for the parent of paths that
+// are stored as a whole)
+const uint32_t kAbsoluteRootIndex = 0;
+const uint32_t kEmptyPathIndex = 0xFFFFFFFF;
+
+//----------------------------------------------------------------------------------------------------------------------
+void appendU32(std::vector<uint8_t>& bytes, uint32_t value)
+{
+  const uint8_t* const ptr = reinterpret_cast<const uint8_t*>(&value);
+  bytes.insert(bytes.end(), ptr, ptr + sizeof(value));
+}
+
+} // anon
+
+//----------------------------------------------------------------------------------------------------------------------
+BinaryArchiveWriter::BinaryArchiveWriter(uint32_t magic, uint32_t version)
+  : m_magic(magic), m_version(version)
+{
+  m_paths.emplace_back(kEmptyPathIndex, 0);
+  m_pathIndices.emplace(SdfPath::AbsoluteRootPath(), kAbsoluteRootIndex);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void BinaryArchiveWriter::writeBytes(const void* data, size_t size)
+{
+  const uint8_t* const ptr = static_cast<const uint8_t*>(data);
+  m_body.insert(m_body.end(), ptr, ptr + size);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+uint32_t BinaryArchiveWriter::internString(const std::string& value)
+{
+  auto inserted = m_stringIndices.emplace(value, uint32_t(m_strings.size()));
+  if(inserted.second)
+    m_strings.push_back(value);
+  return inserted.first->second;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+uint32_t BinaryArchiveWriter::internPath(const SdfPath& path)
+{
+  if(path.IsEmpty())
+    return kEmptyPathIndex;
+
+  auto it = m_pathIndices.find(path);
+  if(it != m_pathIndices.end())
+    return it->second;
+
+  // parents are always interned first, so the reader can rebuild each path from an existing one. Relative paths are
+  // rare here and are simply stored as a whole.
+  uint32_t parent = kEmptyPathIndex;
+  uint32_t element;
+  if(path.IsAbsolutePath())
+  {
+    parent = internPath(path.GetParentPath());
+    element = internString(path.GetElementString());
+  }
+  else
+  {
+    element = internString(path.GetString());
+  }
+  const uint32_t index = uint32_t(m_paths.size());
+  m_paths.emplace_back(parent, element);
+  m_pathIndices.emplace(path, index);
+  return index;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+uint32_t BinaryArchiveWriter::internNode(const MString& nodeName)
+{
+  const uint32_t name = internString(nodeName.asChar());
+  auto inserted = m_nodeIndices.emplace(name, uint32_t(m_nodes.size()));
+  if(inserted.second)
+    m_nodes.push_back(name);
+  return inserted.first->second;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+MIntArray BinaryArchiveWriter::data() const
+{
+  std::vector<uint8_t> bytes;
+  appendU32(bytes, uint32_t(m_strings.size()));
+  for(const std::string& str : m_strings)
+  {
+    appendU32(bytes, uint32_t(str.size()));
+    bytes.insert(bytes.end(), str.begin(), str.end());
+  }
+  appendU32(bytes, uint32_t(m_paths.size()));
+  for(size_t i = kAbsoluteRootIndex + 1; i < m_paths.size(); ++i)
+  {
+    appendU32(bytes, m_paths[i].first);
+    appendU32(bytes, m_paths[i].second);
+  }
+  appendU32(bytes, uint32_t(m_nodes.size()));
+  for(uint32_t name : m_nodes)
+  {
+    appendU32(bytes, name);
+  }
+  bytes.insert(bytes.end(), m_body.begin(), m_body.end());
+
+  const size_t numInts = kHeaderInts + (bytes.size() + sizeof(int) - 1) / sizeof(int);
+  MIntArray result(numInts, 0);
+  result[0] = int(m_magic);
+  result[1] = int(m_version);
+  result[2] = int(bytes.size());
+  if(!bytes.empty())
+  {
+    std::vector<int> packed(numInts - kHeaderInts, 0);
+    std::memcpy(packed.data(), bytes.data(), bytes.size());
+    for(size_t i = 0; i < packed.size(); ++i)
+    {
+      result[kHeaderInts + i] = packed[i];
+    }
+  }
+  return result;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool isBinaryArchive(const MIntArray& data, uint32_t magic)
+{
+  return data.length() >= kHeaderInts && uint32_t(data[0]) == magic;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+BinaryArchiveReader::BinaryArchiveReader(const MIntArray& data, uint32_t magic)
+{
+  std::vector<int> ints(data.length());
+  if(!ints.empty())
+    data.get(ints.data());
+  parse(ints.data(), ints.size(), magic);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+BinaryArchiveReader::BinaryArchiveReader(const std::vector<int>& data, uint32_t magic)
+{
+  parse(data.data(), data.size(), magic);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void BinaryArchiveReader::parse(const int* const data, const size_t length, uint32_t magic)
+{
+  if(length < kHeaderInts || uint32_t(data[0]) != magic)
+    return;
+
+  const uint32_t numBytes = uint32_t(data[2]);
+  const size_t numInts = (size_t(numBytes) + sizeof(int) - 1) / sizeof(int);
+  if(length - kHeaderInts < numInts)
+    return;
+
+  m_bytes.resize(numBytes);
+  if(numBytes)
+    std::memcpy(m_bytes.data(), data + kHeaderInts, numBytes);
+  m_version = uint32_t(data[1]);
+  m_valid = true;
+
+  // string table
+  const uint32_t numStrings = readU32();
+  if(numStrings > m_bytes.size())
+  {
+    m_valid = false;
+    return;
+  }
+  m_strings.resize(numStrings);
+  for(uint32_t i = 0; i < numStrings && m_valid; ++i)
+  {
+    const uint32_t length = readU32();
+    if(length > m_bytes.size() - m_offset)
+    {
+      m_valid = false;
+      return;
+    }
+    m_strings[i].assign(reinterpret_cast<const char*>(m_bytes.data() + m_offset), length);
+    m_offset += length;
+  }
+
+  // path table, rebuilt from the parent of each path
+  const uint32_t numPaths = readU32();
+  if(numPaths < kAbsoluteRootIndex + 1 || numPaths > m_bytes.size())
+  {
+    m_valid = false;
+    return;
+  }
+  m_paths.resize(numPaths);
+  m_paths[kAbsoluteRootIndex] = SdfPath::AbsoluteRootPath();
+  for(uint32_t i = kAbsoluteRootIndex + 1; i < numPaths && m_valid; ++i)
+  {
+    const uint32_t parent = readU32();
+    uint32_t element;
+    if(!readIndex(element, m_strings.size()))
+      break;
+    if(parent == kEmptyPathIndex)
+      m_paths[i] = SdfPath(m_strings[element]);
+    else if(parent < i)
+      m_paths[i] = m_paths[parent].AppendElementString(m_strings[element]);
+    else
+      m_valid = false;
+  }
+
+  // node table, resolved on first use
+  const uint32_t numNodes = readU32();
+  if(numNodes > m_bytes.size())
+  {
+    m_valid = false;
+    return;
+  }
+  m_nodeNames.resize(numNodes);
+  for(uint32_t i = 0; i < numNodes && m_valid; ++i)
+  {
+    readIndex(m_nodeNames[i], m_strings.size());
+  }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool BinaryArchiveReader::readBytes(void* data, size_t size)
+{
+  if(!m_valid || size > m_bytes.size() - m_offset)
+  {
+    m_valid = false;
+    std::memset(data, 0, size);
+    return false;
+  }
+  std::memcpy(data, m_bytes.data() + m_offset, size);
+  m_offset += size;
+  return true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool BinaryArchiveReader::readIndex(uint32_t& index, size_t count)
+{
+  index = readU32();
+  if(m_valid && index < count)
+    return true;
+  index = 0;
+  m_valid = false;
+  return false;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+uint32_t BinaryArchiveReader::readU32()
+{
+  uint32_t value;
+  readBytes(&value, sizeof(value));
+  return value;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+uint64_t BinaryArchiveReader::readU64()
+{
+  uint64_t value;
+  readBytes(&value, sizeof(value));
+  return value;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+double BinaryArchiveReader::readDouble()
+{
+  double value;
+  readBytes(&value, sizeof(value));
+  return value;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+const std::string& BinaryArchiveReader::readString()
+{
+  static const std::string empty;
+  uint32_t index;
+  return readIndex(index, m_strings.size()) ? m_strings[index] : empty;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+const SdfPath& BinaryArchiveReader::readPath()
+{
+  const uint32_t index = readU32();
+  if(m_valid && index < m_paths.size())
+    return m_paths[index];
+  if(index != kEmptyPathIndex)
+    m_valid = false;
+  return SdfPath::EmptyPath();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+MObject BinaryArchiveReader::readNode()
+{
+  uint32_t index;
+  if(!readIndex(index, m_nodeNames.size()))
+    return MObject::kNullObj;
+  if(!m_nodesResolved)
+    resolveNodes();
+  return m_nodes[index];
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void BinaryArchiveReader::resolveNodes()
+{
+  std::vector<MString> names;
+  names.reserve(m_nodeNames.size());
+  for(uint32_t name : m_nodeNames)
+  {
+    names.emplace_back(m_strings[name].c_str());
+  }
+  m_nodes = resolveNodeNames(names);
+  m_nodesResolved = true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void BinaryArchiveReader::resolveNodes(const std::vector<BinaryArchiveReader*>& readers)
+{
+  std::vector<MString> names;
+  for(const BinaryArchiveReader* reader : readers)
+  {
+    if(reader->m_nodesResolved)
+      continue;
+    for(uint32_t name : reader->m_nodeNames)
+    {
+      names.emplace_back(reader->m_strings[name].c_str());
+    }
+  }
+
+  std::vector<MObject> nodes = resolveNodeNames(names);
+  auto first = nodes.begin();
+  for(BinaryArchiveReader* reader : readers)
+  {
+    if(reader->m_nodesResolved)
+      continue;
+    const auto last = first + reader->m_nodeNames.size();
+    reader->m_nodes.assign(first, last);
+    reader->m_nodesResolved = true;
+    first = last;
+  }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+std::vector<MObject> resolveNodeNames(const std::vector<MString>& names)
+{
+  std::vector<MObject> nodes(names.size());
+  std::vector<size_t> listIndices(names.size(), size_t(-1));
+
+  // A single selection list avoids building one list per name. A name only maps to an item of the list if it added
+  // exactly one item; names that match nothing, several nodes, or a node already in the list are resolved on their own.
+  MSelectionList sl;
+  std::vector<size_t> unresolved;
+  for(size_t i = 0; i < names.size(); ++i)
+  {
+    if(names[i].length() == 0)
+      continue;
+    const unsigned int before = sl.length();
+    const MStatus status = sl.add(names[i]);
+    const unsigned int after = sl.length();
+    if(status && after == before + 1)
+    {
+      listIndices[i] = before;
+    }
+    else
+    {
+      for(unsigned int j = after; j > before; --j)
+      {
+        sl.remove(j - 1);
+      }
+      unresolved.push_back(i);
+    }
+  }
+
+  for(size_t i = 0; i < names.size(); ++i)
+  {
+    if(listIndices[i] != size_t(-1))
+      sl.getDependNode(unsigned(listIndices[i]), nodes[i]);
+  }
+
+  for(size_t i : unresolved)
+  {
+    MSelectionList single;
+    if(single.add(names[i]))
+      single.getDependNode(0, nodes[i]);
+  }
+  return nodes;
+}
+
+} // usdmaya
+} // AL
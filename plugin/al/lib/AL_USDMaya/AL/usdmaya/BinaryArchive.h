@@ -0,0 +1,194 @@
+//
+// Copyright 2020 Autodesk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#pragma once
+
+#include "AL/usdmaya/Api.h"
+
+#include "maya/MIntArray.h"
+#include "maya/MObject.h"
+#include "maya/MString.h"
+
+#include "pxr/pxr.h"
+#include "pxr/usd/sdf/path.h"
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+PXR_NAMESPACE_USING_DIRECTIVE
+
+namespace AL {
+namespace usdmaya {
+
+//----------------------------------------------------------------------------------------------------------------------
+/// \brief  Writes a compact, versioned binary archive of node internals that is stored in an int array attribute
+///         (MFnData::kIntArray), which Maya saves as raw data in binary files.
+///
+///         Strings, prim paths and Maya node names are interned into tables written ahead of the body, so the body
+///         only holds small indices. Paths are stored as (parent index, element name) pairs, so the common prefixes of
+///         a hierarchy are only stored once.
+//----------------------------------------------------------------------------------------------------------------------
+class BinaryArchiveWriter
+{
+public:
+
+  /// \brief  ctor
+  /// \param  magic identifies the kind of archive, checked when reading it back
+  /// \param  version the version of the layout of the body
+  AL_USDMAYA_PUBLIC
+  BinaryArchiveWriter(uint32_t magic, uint32_t version);
+
+  /// \brief  appends a value to the body
+  void writeU32(uint32_t value)
+    { writeBytes(&value, sizeof(value)); }
+
+  /// \brief  appends a value to the body
+  void writeU64(uint64_t value)
+    { writeBytes(&value, sizeof(value)); }
+
+  /// \brief  appends a value to the body
+  void writeDouble(double value)
+    { writeBytes(&value, sizeof(value)); }
+
+  /// \brief  appends the index of an interned string to the body
+  void writeString(const std::string& value)
+    { writeU32(internString(value)); }
+
+  /// \brief  appends the index of an interned path to the body
+  void writePath(const SdfPath& path)
+    { writeU32(internPath(path)); }
+
+  /// \brief  appends the index of an interned node name to the body. Nodes are resolved in a single pass when read.
+  void writeNode(const MString& nodeName)
+    { writeU32(internNode(nodeName)); }
+
+  /// \brief  returns the archive: the tables followed by the body
+  AL_USDMAYA_PUBLIC
+  MIntArray data() const;
+
+private:
+  void writeBytes(const void* data, size_t size);
+  uint32_t internString(const std::string& value);
+  uint32_t internPath(const SdfPath& path);
+  uint32_t internNode(const MString& nodeName);
+
+  uint32_t m_magic;
+  uint32_t m_version;
+  std::vector<uint8_t> m_body;
+  std::vector<std::string> m_strings;
+  std::unordered_map<std::string, uint32_t> m_stringIndices;
+  std::vector<std::pair<uint32_t, uint32_t>> m_paths; ///< parent path and element string of each path
+  std::unordered_map<SdfPath, uint32_t, SdfPath::Hash> m_pathIndices;
+  std::vector<uint32_t> m_nodes; ///< the string of each node name
+  std::unordered_map<uint32_t, uint32_t> m_nodeIndices;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+/// \brief  Reads an archive written by BinaryArchiveWriter. The values must be read in the order they were written.
+///         Reading past the end of the archive, or an invalid index, marks the reader as invalid and returns default
+///         values, so callers only need to check isValid() once they are done.
+//----------------------------------------------------------------------------------------------------------------------
+class BinaryArchiveReader
+{
+public:
+
+  /// \brief  ctor, parses the tables of the archive
+  /// \param  data the archive
+  /// \param  magic the kind of archive expected
+  AL_USDMAYA_PUBLIC
+  BinaryArchiveReader(const MIntArray& data, uint32_t magic);
+
+  /// \brief  ctor, parses the tables of an archive that has already been copied out of its int array attribute. This
+  ///         does not touch any Maya objects, so archives can be parsed concurrently.
+  /// \param  data the archive
+  /// \param  magic the kind of archive expected
+  AL_USDMAYA_PUBLIC
+  BinaryArchiveReader(const std::vector<int>& data, uint32_t magic);
+
+  /// \brief  returns false if the data wasn't an archive of the expected kind, or if a read failed
+  bool isValid() const
+    { return m_valid; }
+
+  /// \brief  the version of the archive, to be checked by the caller
+  uint32_t version() const
+    { return m_version; }
+
+  /// \brief  reads a value from the body
+  AL_USDMAYA_PUBLIC
+  uint32_t readU32();
+
+  /// \brief  reads a value from the body
+  AL_USDMAYA_PUBLIC
+  uint64_t readU64();
+
+  /// \brief  reads a value from the body
+  AL_USDMAYA_PUBLIC
+  double readDouble();
+
+  /// \brief  reads an interned string
+  AL_USDMAYA_PUBLIC
+  const std::string& readString();
+
+  /// \brief  reads an interned path
+  AL_USDMAYA_PUBLIC
+  const SdfPath& readPath();
+
+  /// \brief  reads an interned node. All node names of the archive are resolved on the first call, through a single
+  ///         selection list. Nodes that don't exist anymore are returned as null objects.
+  AL_USDMAYA_PUBLIC
+  MObject readNode();
+
+  /// \brief  resolves the node names of several archives through a single selection list, so that a set of archives
+  ///         read together (e.g. one per proxy shape) doesn't resolve their nodes one archive at a time.
+  /// \param  readers the archives to resolve the nodes of
+  AL_USDMAYA_PUBLIC
+  static void resolveNodes(const std::vector<BinaryArchiveReader*>& readers);
+
+private:
+  void parse(const int* data, size_t length, uint32_t magic);
+  bool readBytes(void* data, size_t size);
+  bool readIndex(uint32_t& index, size_t count);
+  void resolveNodes();
+
+  std::vector<uint8_t> m_bytes;
+  size_t m_offset = 0;
+  uint32_t m_version = 0;
+  bool m_valid = false;
+  bool m_nodesResolved = false;
+  std::vector<std::string> m_strings;
+  std::vector<SdfPath> m_paths;
+  std::vector<uint32_t> m_nodeNames;
+  std::vector<MObject> m_nodes;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+/// \brief  returns true if the data of an int array attribute starts with the given archive magic number
+//----------------------------------------------------------------------------------------------------------------------
+AL_USDMAYA_PUBLIC
+bool isBinaryArchive(const MIntArray& data, uint32_t magic);
+
+//----------------------------------------------------------------------------------------------------------------------
+/// \brief  resolves node names (DAG paths or dependency node names) to nodes, by adding all of them to a single
+///         selection list.
+/// \param  names the names to resolve
+/// \return the nodes, in the same order as the names. Names that can't be resolved are returned as null objects.
+//----------------------------------------------------------------------------------------------------------------------
+AL_USDMAYA_PUBLIC
+std::vector<MObject> resolveNodeNames(const std::vector<MString>& names);
+
+} // usdmaya
+} // AL
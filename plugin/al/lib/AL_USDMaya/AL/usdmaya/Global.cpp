@@ -18,6 +18,7 @@
 #include "AL/usdmaya/StageCache.h"
 #include "AL/usdmaya/nodes/LayerManager.h"
 #include "AL/usdmaya/nodes/ProxyShape.h"
+#include "AL/usdmaya/nodes/PushToPrimQueue.h"
 #include "AL/usdmaya/nodes/Transform.h"
 #include "AL/usdmaya/nodes/Scope.h"
 #include "AL/usdmaya/nodes/TransformationMatrix.h"
@@ -222,6 +223,7 @@ AL::event::CallbackId Global::m_postRead;
 AL::event::CallbackId Global::m_fileNew;
 AL::event::CallbackId Global::m_preExport;
 AL::event::CallbackId Global::m_postExport;
+AL::event::CallbackId Global::m_postDuplicate;
 
 //----------------------------------------------------------------------------------------------------------------------
 
@@ -355,6 +357,8 @@ static void postFileRead(void*)
   {
     std::vector<MObjectHandle>& unloadedProxies = nodes::ProxyShape::GetUnloadedProxyShapes();
     unsigned int numUnloadedProxies = unloadedProxies.size();
+    std::vector<nodes::ProxyShape*> loadedProxies;
+    loadedProxies.reserve(numUnloadedProxies);
     for(unsigned int i = 0; i < numUnloadedProxies; ++i)
     {
       if(!(unloadedProxies[i].isValid() && unloadedProxies[i].isAlive()))
@@ -375,8 +379,12 @@ static void postFileRead(void*)
       proxy->deserialiseTranslatorContext();
       proxy->translatorManufacture().preparePythonTranslators(proxy->context());
       proxy->findPrimsWithMetaData();
-      proxy->deserialiseTransformRefs();
+      loadedProxies.push_back(proxy);
     }
+
+    // the transform refs of all of the proxy shapes are read together, so that their archives can be parsed in
+    // parallel, and their nodes resolved in one go
+    nodes::ProxyShape::deserialiseTransformRefs(loadedProxies);
     unloadedProxies.clear();
   }
   {
@@ -412,6 +420,7 @@ static void _preFileSave()
 
   MGlobal::clearSelectionList();
 
+  nodes::PushToPrimQueue::flush();
   nodes::ProxyShape::serializeAll();
 }
 
@@ -463,6 +472,7 @@ static void postFileSave(void*)
 static void preFileExport(void* p)
 {
   storeSelection();
+  nodes::PushToPrimQueue::flush();
   nodes::ProxyShape::serializeAll();
 }
 
@@ -472,6 +482,13 @@ static void postFileExport(void* p)
   postFileSave(p);
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+static void postDuplicate(void*)
+{
+  TF_DEBUG(ALUSDMAYA_EVENTS).Msg("postDuplicate\n");
+  nodes::ProxyShape::loadDuplicatedProxyShapes();
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 void Global::onPluginLoad()
 {
@@ -485,6 +502,8 @@ void Global::onPluginLoad()
   m_postRead = manager.registerCallback(postFileRead, "AfterFileRead", "usdmaya_postFileRead", 0x1000);
   m_preExport = manager.registerCallback(preFileExport, "BeforeExport", "usdmaya_preFileExport", 0x1000);
   m_postExport = manager.registerCallback(postFileExport, "AfterExport", "usdmaya_postFileExport", 0x1000);
+  m_postDuplicate = manager.registerCallback(postDuplicate, "AfterDuplicate", "usdmaya_postDuplicate", 0x1000);
+  nodes::PushToPrimQueue::addCallbacks();
 
   TF_DEBUG(ALUSDMAYA_EVENTS).Msg("Registering USD plugins\n");
   // Let USD know about the additional plugins
@@ -515,6 +534,9 @@ void Global::onPluginUnload()
   manager.unregisterCallback(m_postRead);
   manager.unregisterCallback(m_preExport);
   manager.unregisterCallback(m_postExport);
+  manager.unregisterCallback(m_postDuplicate);
+  nodes::ProxyShape::clearDuplicatedProxyShapes();
+  nodes::PushToPrimQueue::removeCallbacks();
   StageCache::removeCallbacks();
 
   AL::maya::event::MayaEventManager::freeInstance();
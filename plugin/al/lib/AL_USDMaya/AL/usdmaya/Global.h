@@ -70,6 +70,7 @@ private:
   static AL::event::CallbackId m_fileNew;  ///< callback used to flush the USD caches after a file new
   static AL::event::CallbackId m_preExport; ///< callback prior to exporting the scene (so we can store the session layer)
   static AL::event::CallbackId m_postExport; ///< callback after exporting
+  static AL::event::CallbackId m_postDuplicate; ///< callback after duplicating, used to load the stages of duplicated proxy shapes
 
 #if defined(WANT_UFE_BUILD)
   class UfeSelectionObserver;
@@ -207,6 +207,11 @@ MStatus registerPlugin(AFnPlugin& plugin)
     MGlobal::setOptionVarValue("AL_usdmaya_pushToPrim", true);
   }
 
+  if(!MGlobal::optionVarExists("AL_usdmaya_deferPushToPrim"))
+  {
+    MGlobal::setOptionVarValue("AL_usdmaya_deferPushToPrim", false);
+  }
+
   if(!MGlobal::optionVarExists("AL_usdmaya_ignoreLockPrims"))
   {
     MGlobal::setOptionVarValue("AL_usdmaya_ignoreLockPrims", false);
@@ -250,6 +255,8 @@ MStatus registerPlugin(AFnPlugin& plugin)
   AL_REGISTER_COMMAND(plugin, AL::usdmaya::cmds::ProxyShapeResync);
   AL_REGISTER_COMMAND(plugin, AL::usdmaya::cmds::ProxyShapeImportPrimPathAsMaya);
   AL_REGISTER_COMMAND(plugin, AL::usdmaya::cmds::ProxyShapePrintRefCountState);
+  AL_REGISTER_COMMAND(plugin, AL::usdmaya::cmds::ProxyShapeFlushPushToPrim);
+  AL_REGISTER_COMMAND(plugin, AL::usdmaya::cmds::ProxyShapeLoadPayloads);
   AL_REGISTER_COMMAND(plugin, AL::usdmaya::cmds::ChangeVariant);
   AL_REGISTER_COMMAND(plugin, AL::usdmaya::cmds::ActivatePrim);
   AL_REGISTER_COMMAND(plugin, AL::usdmaya::cmds::ProxyShapeSelect);
@@ -337,6 +344,7 @@ MStatus registerPlugin(AFnPlugin& plugin)
   AL::maya::utils::MenuBuilder::addEntry("USD/Animated Geometry/Connect selected meshes to USD (animated)", "AL_usdmaya_meshAnimImport");
   AL::maya::utils::MenuBuilder::addEntry("USD/Selection Enabled", "optionVar -iv \\\"AL_usdmaya_selectionEnabled\\\" #1", true, MGlobal::optionVarIntValue("AL_usdmaya_selectionEnabled"));
   AL::maya::utils::MenuBuilder::addEntry("USD/Enable pushToPrim", "optionVar -iv \\\"AL_usdmaya_pushToPrim\\\" #1", true, MGlobal::optionVarIntValue("AL_usdmaya_pushToPrim"));
+  AL::maya::utils::MenuBuilder::addEntry("USD/Defer pushToPrim", "optionVar -iv \\\"AL_usdmaya_deferPushToPrim\\\" #1", true, MGlobal::optionVarIntValue("AL_usdmaya_deferPushToPrim"));
   AL::maya::utils::MenuBuilder::addEntry("USD/Selection Ignore Lock Prims Enabled", "optionVar -iv \\\"AL_usdmaya_ignoreLockPrims\\\" #1", true, MGlobal::optionVarIntValue("AL_usdmaya_ignoreLockPrims"));
   CHECK_MSTATUS(AL::maya::utils::MenuBuilder::generatePluginUI(plugin, "AL_usdmaya"));
   AL::usdmaya::Global::onPluginLoad();
@@ -433,6 +441,8 @@ MStatus unregisterPlugin(AFnPlugin& plugin)
   AL_UNREGISTER_COMMAND(plugin, AL::usdmaya::cmds::ProxyShapeResync);
   AL_UNREGISTER_COMMAND(plugin, AL::usdmaya::cmds::ProxyShapeImportPrimPathAsMaya);
   AL_UNREGISTER_COMMAND(plugin, AL::usdmaya::cmds::ProxyShapePrintRefCountState);
+  AL_UNREGISTER_COMMAND(plugin, AL::usdmaya::cmds::ProxyShapeFlushPushToPrim);
+  AL_UNREGISTER_COMMAND(plugin, AL::usdmaya::cmds::ProxyShapeLoadPayloads);
   AL_UNREGISTER_COMMAND(plugin, AL::usdmaya::cmds::Callback);
   AL_UNREGISTER_COMMAND(plugin, AL::usdmaya::cmds::ListCallbacks);
   AL_UNREGISTER_COMMAND(plugin, AL::usdmaya::cmds::ListEvents);
@@ -15,6 +15,7 @@
 //
 #include "AL/usdmaya/cmds/ProxyShapeCommands.h"
 #include "AL/usdmaya/nodes/LayerManager.h"
+#include "AL/usdmaya/nodes/PushToPrimQueue.h"
 
 #include "AL/maya/utils/CommandGuiHelper.h"
 #include "AL/maya/utils/MenuBuilder.h"
@@ -24,8 +25,16 @@
 #include "maya/MArgList.h"
 #include "maya/MDagPathArray.h"
 #include "maya/MFnDagNode.h"
+#include "maya/MIntArray.h"
+#include "maya/MMatrix.h"
+#include "maya/MPoint.h"
+#include "maya/MStringArray.h"
 #include "maya/MSyntax.h"
 
+#include "pxr/usd/usdGeom/xformCache.h"
+
+#include <algorithm>
+
 namespace {
     typedef void (AL::usdmaya::nodes::SelectionList::*SelectionListModifierFunc)(SdfPath);
 }
@@ -1703,6 +1712,236 @@ MStatus ProxyShapePrintRefCountState::doIt(const MArgList& args)
   return MS::kSuccess;
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+AL_MAYA_DEFINE_COMMAND(ProxyShapeFlushPushToPrim, AL_usdmaya);
+
+//----------------------------------------------------------------------------------------------------------------------
+MSyntax ProxyShapeFlushPushToPrim::createSyntax()
+{
+  MSyntax syntax = setUpCommonSyntax();
+  syntax.useSelectionAsDefault(false);
+  syntax.addFlag("-h", "-help", MSyntax::kNoArg);
+  return syntax;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool ProxyShapeFlushPushToPrim::isUndoable() const
+{
+  return false;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+MStatus ProxyShapeFlushPushToPrim::doIt(const MArgList& args)
+{
+  TF_DEBUG(ALUSDMAYA_COMMANDS).Msg("ProxyShapeFlushPushToPrim::doIt\n");
+  try
+  {
+    MStatus status;
+    MArgDatabase db(syntax(), args, &status);
+    if(!status)
+    {
+      std::cout << status.errorString() << std::endl;
+      return status;
+    }
+
+    AL_MAYA_COMMAND_HELP(db, g_helpText);
+
+    MSelectionList sl;
+    db.getObjects(sl);
+    if(sl.length() || db.isFlagSet("-p"))
+    {
+      nodes::PushToPrimQueue::flush(getShapeNodeStage(db));
+    }
+    else
+    {
+      nodes::PushToPrimQueue::flush();
+    }
+  }
+  catch(const MStatus& status)
+  {
+    return status;
+  }
+  return MS::kSuccess;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+AL_MAYA_DEFINE_COMMAND(ProxyShapeLoadPayloads, AL_usdmaya);
+
+//----------------------------------------------------------------------------------------------------------------------
+MSyntax ProxyShapeLoadPayloads::createSyntax()
+{
+  MSyntax syntax = setUpCommonSyntax();
+  syntax.useSelectionAsDefault(false);
+  syntax.enableQuery(true);
+  syntax.addFlag("-h", "-help", MSyntax::kNoArg);
+  syntax.addFlag("-pp", "-primPath", MSyntax::kString);
+  syntax.addFlag("-ul", "-unload", MSyntax::kNoArg);
+  syntax.addFlag("-pr", "-priority", MSyntax::kDouble);
+  syntax.addFlag("-cam", "-camera", MSyntax::kString);
+  syntax.addFlag("-mc", "-maxConcurrent", MSyntax::kLong);
+  syntax.addFlag("-c", "-cancel", MSyntax::kNoArg);
+  syntax.addFlag("-w", "-wait", MSyntax::kNoArg);
+  syntax.addFlag("-pg", "-progress", MSyntax::kNoArg);
+  syntax.addFlag("-st", "-state", MSyntax::kNoArg);
+  syntax.addFlag("-cp", "-currentPath", MSyntax::kNoArg);
+  syntax.makeFlagMultiUse("-pp");
+  return syntax;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool ProxyShapeLoadPayloads::isUndoable() const
+{
+  return false;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+MStatus ProxyShapeLoadPayloads::doIt(const MArgList& args)
+{
+  TF_DEBUG(ALUSDMAYA_COMMANDS).Msg("ProxyShapeLoadPayloads::doIt\n");
+  try
+  {
+    MStatus status;
+    MArgDatabase db(syntax(), args, &status);
+    if(!status)
+    {
+      std::cout << status.errorString() << std::endl;
+      return status;
+    }
+
+    AL_MAYA_COMMAND_HELP(db, g_helpText);
+
+    nodes::ProxyShape* proxy = getShapeNode(db);
+    nodes::proxy::PayloadLoadQueue& queue = proxy->payloadQueue();
+
+    SdfPathVector paths;
+    for(uint32_t i = 0, n = db.numberOfFlagUses("-pp"); i < n; ++i)
+    {
+      MArgList pathArgs;
+      db.getFlagArgumentList("-pp", i, pathArgs);
+      MString pathString = pathArgs.asString(0);
+      SdfPath path(AL::maya::utils::convert(pathString));
+      if(!path.IsPrimPath())
+      {
+        MGlobal::displayError(MString("Invalid primPath: ") + pathString);
+        return MS::kFailure;
+      }
+      paths.push_back(path);
+    }
+
+    if(db.isQuery())
+    {
+      if(db.isFlagSet("-pg"))
+      {
+        size_t completed = 0, total = 0;
+        queue.progress(completed, total);
+        MIntArray result;
+        result.append(int(completed));
+        result.append(int(total));
+        setResult(result);
+      }
+      else
+      if(db.isFlagSet("-st"))
+      {
+        MStringArray result;
+        for(const SdfPath& path : paths)
+        {
+          result.append(nodes::proxy::PayloadLoadQueue::stateName(queue.state(path)));
+        }
+        setResult(result);
+      }
+      else
+      if(db.isFlagSet("-cp"))
+      {
+        setResult(AL::maya::utils::convert(queue.currentPath().GetString()));
+      }
+      else
+      if(db.isFlagSet("-mc"))
+      {
+        setResult(int(queue.maxConcurrent()));
+      }
+      return MS::kSuccess;
+    }
+
+    if(db.isFlagSet("-mc"))
+    {
+      int maxConcurrent = 1;
+      db.getFlagArgument("-mc", 0, maxConcurrent);
+      queue.setMaxConcurrent(uint32_t(std::max(maxConcurrent, 1)));
+    }
+
+    if(db.isFlagSet("-c"))
+    {
+      if(paths.empty())
+      {
+        queue.cancelAll();
+      }
+      for(const SdfPath& path : paths)
+      {
+        queue.cancel(path);
+      }
+      return MS::kSuccess;
+    }
+
+    UsdStageRefPtr stage = proxy->usdStage();
+    if(!stage)
+    {
+      MGlobal::displayError("ProxyShapeLoadPayloads: the proxy shape has no stage");
+      return MS::kFailure;
+    }
+
+    double priority = 0;
+    if(db.isFlagSet("-pr"))
+    {
+      db.getFlagArgument("-pr", 0, priority);
+    }
+
+    // when a camera is specified, the payloads closest to the camera are loaded first
+    bool useCamera = false;
+    GfVec3d cameraPosition;
+    UsdGeomXformCache xformCache(proxy->getTime());
+    if(db.isFlagSet("-cam"))
+    {
+      MString cameraName;
+      db.getFlagArgument("-cam", 0, cameraName);
+      MSelectionList sl;
+      MDagPath cameraPath;
+      if(!sl.add(cameraName) || !sl.getDagPath(0, cameraPath))
+      {
+        MGlobal::displayError(MString("ProxyShapeLoadPayloads: invalid camera ") + cameraName);
+        return MS::kFailure;
+      }
+      // bring the camera position into the space of the stage
+      MPoint position = MPoint::origin * cameraPath.inclusiveMatrix() * getShapePath(db).inclusiveMatrixInverse();
+      cameraPosition = GfVec3d(position.x, position.y, position.z);
+      useCamera = true;
+    }
+
+    const bool load = !db.isFlagSet("-ul");
+    for(const SdfPath& path : paths)
+    {
+      double primPriority = priority;
+      if(useCamera)
+      {
+        UsdPrim prim = stage->GetPrimAtPath(path);
+        if(prim)
+        {
+          primPriority += (xformCache.GetLocalToWorldTransform(prim).ExtractTranslation() - cameraPosition).GetLength();
+        }
+      }
+      queue.enqueue(stage, path, load, primPriority);
+    }
+
+    if(db.isFlagSet("-w"))
+    {
+      queue.flush(true);
+    }
+  }
+  catch(const MStatus& status)
+  {
+    return status;
+  }
+  return MS::kSuccess;
+}
 
 //----------------------------------------------------------------------------------------------------------------------
 // Documentation strings.
@@ -1840,6 +2079,65 @@ AL_usdmaya_ProxyShapeImportPrimPathAsMaya Overview:
 
 )";
 
+//----------------------------------------------------------------------------------------------------------------------
+const char* const ProxyShapeFlushPushToPrim::g_helpText = R"(
+AL_usdmaya_ProxyShapeFlushPushToPrim Overview:
+
+  When the AL_usdmaya_deferPushToPrim optionVar is enabled, changes made to AL_usdmaya_Transform nodes with pushToPrim
+  enabled are queued up, and written back to USD together when Maya next goes idle (or when a manipulator is released,
+  the time changes, or the scene is saved). If a script needs to read those changes back from the USD stage straight
+  away, this command will write all of the queued changes immediately:
+
+    AL_usdmaya_ProxyShapeFlushPushToPrim;
+
+  To only write the changes for the transforms of a specific proxy shape, specify the proxy shape:
+
+    AL_usdmaya_ProxyShapeFlushPushToPrim -p "AL_usdmaya_ProxyShape1";
+
+)";
+
+//----------------------------------------------------------------------------------------------------------------------
+const char* const ProxyShapeLoadPayloads::g_helpText = R"(
+AL_usdmaya_ProxyShapeLoadPayloads Overview:
+
+  Queues payload loads (or unloads) on a proxy shape, so that heavy payloads can be loaded without blocking Maya. The
+  layers of each payload are read from disk on worker threads, and each payload is then loaded into the stage when
+  Maya is idle. To load a couple of payloads:
+
+    AL_usdmaya_ProxyShapeLoadPayloads -p "AL_usdmaya_ProxyShape1" -pp "/root/a" -pp "/root/b";
+
+  To unload them again, add the -ul/-unload flag:
+
+    AL_usdmaya_ProxyShapeLoadPayloads -p "AL_usdmaya_ProxyShape1" -ul -pp "/root/a" -pp "/root/b";
+
+  Requests with a lower -pr/-priority value are processed first. Alternatively, the -cam/-camera flag will load the
+  payloads closest to the specified camera first:
+
+    AL_usdmaya_ProxyShapeLoadPayloads -p "AL_usdmaya_ProxyShape1" -cam "persp" -pp "/root/a" -pp "/root/b";
+
+  The -mc/-maxConcurrent flag sets how many payloads can be read at the same time (the default is 4). The -w/-wait
+  flag will block until all of the queued payloads have been loaded. Outstanding requests can be cancelled with the
+  -c/-cancel flag (if no prim paths are specified, all of the outstanding requests are cancelled):
+
+    AL_usdmaya_ProxyShapeLoadPayloads -p "AL_usdmaya_ProxyShape1" -c -pp "/root/b";
+
+  The progress of the queue can be queried, which returns the number of completed requests, and the total number of
+  requests made since the queue was last idle:
+
+    AL_usdmaya_ProxyShapeLoadPayloads -p "AL_usdmaya_ProxyShape1" -q -pg;
+
+  The state of individual requests ("queued", "fetching", "fetched", "loaded", "cancelled", "failed", or "none") can be
+  queried with:
+
+    AL_usdmaya_ProxyShapeLoadPayloads -p "AL_usdmaya_ProxyShape1" -q -st -pp "/root/a";
+
+  The proxy shape triggers the "PrePayloadLoaded" and "PostPayloadLoaded" events around each payload that is loaded
+  or unloaded. The prim path is passed to script callbacks in alEventPayloads, and can also be queried during the
+  "PrePayloadLoaded" event with the -cp/-currentPath flag. The script callbacks of "PostPayloadLoaded" are coalesced:
+  they are executed once all the ready payloads have been loaded, with the path of each of them in alEventPayloads.
+
+)";
+
 //----------------------------------------------------------------------------------------------------------------------
 const char* const ProxyShapePrintRefCountState::g_helpText = R"(
 AL_usdmaya_ProxyShapePrintRefCountState Overview:
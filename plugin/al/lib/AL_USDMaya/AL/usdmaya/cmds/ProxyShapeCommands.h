@@ -185,6 +185,34 @@ private:
   MStatus doIt(const MArgList& args) override;
 };
 
+//----------------------------------------------------------------------------------------------------------------------
+/// \brief  ProxyShapeFlushPushToPrim
+/// \ingroup commands
+//----------------------------------------------------------------------------------------------------------------------
+class ProxyShapeFlushPushToPrim
+  : public ProxyShapeCommandBase
+{
+public:
+  AL_MAYA_DECLARE_COMMAND();
+private:
+  bool isUndoable() const override;
+  MStatus doIt(const MArgList& args) override;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+/// \brief  ProxyShapeLoadPayloads
+/// \ingroup commands
+//----------------------------------------------------------------------------------------------------------------------
+class ProxyShapeLoadPayloads
+  : public ProxyShapeCommandBase
+{
+public:
+  AL_MAYA_DECLARE_COMMAND();
+private:
+  bool isUndoable() const override;
+  MStatus doIt(const MArgList& args) override;
+};
+
 //----------------------------------------------------------------------------------------------------------------------
 /// \brief  ProxyShapeResync
 /// \ingroup commands
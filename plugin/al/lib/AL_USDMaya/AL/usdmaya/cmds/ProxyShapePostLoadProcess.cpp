@@ -215,6 +215,8 @@ void ProxyShapePostLoadProcess::createSchemaPrims(
                                           " will read default values\n");
     }
 
+    context->reserveItems(objsToCreate.size());
+
     auto it = objsToCreate.begin();
     const auto end = objsToCreate.end();
     for(; it != end; ++it)
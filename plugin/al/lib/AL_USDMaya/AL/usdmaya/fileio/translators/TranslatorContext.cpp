@@ -16,9 +16,12 @@
 #include "AL/usdmaya/fileio/translators/TranslatorContext.h"
 #include "AL/usdmaya/nodes/ProxyShape.h"
 #include "AL/usdmaya/DebugCodes.h"
+#include "AL/usdmaya/BinaryArchive.h"
 #include "maya/MSelectionList.h"
 #include "maya/MFnDagNode.h"
+#include "maya/MDagModifier.h"
 
+#include <algorithm>
 #include <string>
 
 namespace AL {
@@ -26,6 +29,93 @@ namespace usdmaya {
 namespace fileio {
 namespace translators {
 
+//----------------------------------------------------------------------------------------------------------------------
+std::pair<TranslatorContext::PrimLookupTable::iterator, bool> TranslatorContext::PrimLookupTable::insert(PrimLookup lookup)
+{
+  const SdfPath path = lookup.path();
+  const bool wasIndexed = m_children.count(path) != 0;
+  auto inserted = m_lookups.emplace(path, std::move(lookup));
+  if(inserted.second && !wasIndexed)
+  {
+    link(path);
+  }
+  return std::make_pair(iterator(inserted.first), inserted.second);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+TranslatorContext::PrimLookupTable::iterator TranslatorContext::PrimLookupTable::erase(iterator it)
+{
+  const SdfPath path = it->path();
+  iterator next = m_lookups.erase(it.base());
+  unlink(path);
+  return next;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool TranslatorContext::PrimLookupTable::erase(const SdfPath& path)
+{
+  if(!m_lookups.erase(path))
+    return false;
+  unlink(path);
+  return true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void TranslatorContext::PrimLookupTable::link(const SdfPath& path)
+{
+  // add the path to the children of its parent, and keep going up until an ancestor that was already indexed
+  for(SdfPath child = path; child.IsAbsolutePath() && !child.IsAbsoluteRootPath(); )
+  {
+    const SdfPath parent = child.GetParentPath();
+    const bool parentIndexed = isIndexed(parent);
+    m_children[parent].insert(child);
+    if(parentIndexed)
+      break;
+    child = parent;
+  }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void TranslatorContext::PrimLookupTable::unlink(const SdfPath& path)
+{
+  // remove the path from the index once it has neither a mapping nor children, along with any ancestors that are left
+  // in the same state
+  for(SdfPath child = path; child.IsAbsolutePath() && !child.IsAbsoluteRootPath() && !isIndexed(child); )
+  {
+    const SdfPath parent = child.GetParentPath();
+    auto it = m_children.find(parent);
+    if(it == m_children.end())
+      break;
+    it->second.erase(child);
+    if(!it->second.empty())
+      break;
+    m_children.erase(it);
+    child = parent;
+  }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void TranslatorContext::PrimLookupTable::findSubtree(const SdfPath& path, SdfPathVector& paths) const
+{
+  const std::size_t first = paths.size();
+  std::vector<SdfPath> stack(1, path);
+  while(!stack.empty())
+  {
+    const SdfPath current = stack.back();
+    stack.pop_back();
+    if(m_lookups.count(current))
+    {
+      paths.push_back(current);
+    }
+    auto it = m_children.find(current);
+    if(it != m_children.end())
+    {
+      stack.insert(stack.end(), it->second.begin(), it->second.end());
+    }
+  }
+  std::sort(paths.begin() + first, paths.end());
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 TranslatorContext::~TranslatorContext()
 {
@@ -202,29 +292,49 @@ bool TranslatorContext::getMObjects(const SdfPath& path, MObjectHandleArray& ret
 }
 
 //----------------------------------------------------------------------------------------------------------------------
-void TranslatorContext::registerItem(const UsdPrim& prim, MObjectHandle object)
+TranslatorContext::PrimLookup& TranslatorContext::findOrInsert(const UsdPrim& prim)
 {
-  TF_DEBUG(ALUSDMAYA_TRANSLATORS).Msg("TranslatorContext::registerItem adding entry %s[%s]\n", prim.GetPath().GetText(), object.object().apiTypeStr());
-  auto iter = findLocation(prim.GetPath());
-  if(iter == m_primMapping.end() || iter->path() != prim.GetPath())
+  auto iter = find(prim.GetPath());
+  if(iter == m_primMapping.end())
   {
     //We keep around this legacy plugin identification by type only to allow tests which don't create a proxy shape to run..
     std::string translatorId = m_proxyShape ? m_proxyShape->translatorManufacture().generateTranslatorId(prim) : "schematype:" + prim.GetTypeName().GetString();
 
-    iter = m_primMapping.insert(iter, PrimLookup(prim.GetPath(), translatorId, object.object()));
+    iter = m_primMapping.insert(PrimLookup(prim.GetPath(), translatorId, MObject())).first;
+  }
+  return *iter;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void TranslatorContext::registerItem(const UsdPrim& prim, MObjectHandle object)
+{
+  TF_DEBUG(ALUSDMAYA_TRANSLATORS).Msg("TranslatorContext::registerItem adding entry %s[%s]\n", prim.GetPath().GetText(), object.object().apiTypeStr());
+  PrimLookup& lookup = findOrInsert(prim);
+  lookup.setNode(object.object());
+
+  if(object.object() == MObject::kNullObj)
+  {
+    TF_DEBUG(ALUSDMAYA_TRANSLATORS).Msg("TranslatorContext::registerItem primPath=%s translatorId=%s to null MObject\n", prim.GetPath().GetText(), lookup.translatorId().c_str());
   }
   else
   {
-    iter->setNode(object.object());
+    TF_DEBUG(ALUSDMAYA_TRANSLATORS).Msg("TranslatorContext::registerItem primPath=%s translatorId=%s to MObject type %s\n", prim.GetPath().GetText(), lookup.translatorId().c_str(), object.object().apiTypeStr());
   }
+}
 
-  if(object.object() == MObject::kNullObj)
+//----------------------------------------------------------------------------------------------------------------------
+void TranslatorContext::registerItems(const std::vector<UsdPrim>& prims, const MObjectHandleArray& objects)
+{
+  TF_DEBUG(ALUSDMAYA_TRANSLATORS).Msg("TranslatorContext::registerItems adding %zu entries\n", prims.size());
+  if(prims.size() != objects.size())
   {
-    TF_DEBUG(ALUSDMAYA_TRANSLATORS).Msg("TranslatorContext::registerItem primPath=%s translatorId=%s to null MObject\n", prim.GetPath().GetText(), iter->translatorId().c_str());
+    TF_CODING_ERROR("TranslatorContext::registerItems expects one object per prim");
+    return;
   }
-  else
+  reserveItems(prims.size());
+  for(std::size_t i = 0, n = prims.size(); i < n; ++i)
   {
-    TF_DEBUG(ALUSDMAYA_TRANSLATORS).Msg("TranslatorContext::registerItem primPath=%s translatorId=%s to MObject type %s\n", prim.GetPath().GetText(), iter->translatorId().c_str(), object.object().apiTypeStr());
+    findOrInsert(prims[i]).setNode(objects[i].object());
   }
 }
 
@@ -233,29 +343,30 @@ void TranslatorContext::insertItem(const UsdPrim& prim, MObjectHandle object)
 {
   TF_DEBUG(ALUSDMAYA_TRANSLATORS).Msg("TranslatorContext::insertItem adding entry %s[%s]\n", prim.GetPath().GetText(), object.object().apiTypeStr());
 
-  auto iter = findLocation(prim.GetPath());
-  if(iter == m_primMapping.end() || iter->path() != prim.GetPath())
-  {
-    //We keep around this legacy plugin identification by type only to allow tests which don't create a proxy shape to run..
-    std::string translatorId = m_proxyShape ? m_proxyShape->translatorManufacture().generateTranslatorId(prim) : "schematype:" + prim.GetTypeName().GetString();
-
-    iter = m_primMapping.insert(iter, PrimLookup(prim.GetPath(), translatorId, MObject()));
-  }
-  
+  PrimLookup& lookup = findOrInsert(prim);
   if(object.object() == MObject::kNullObj)
   {
     return;
   }
 
-  iter->createdNodes().push_back(object);
+  lookup.createdNodes().push_back(object);
+  TF_DEBUG(ALUSDMAYA_TRANSLATORS).Msg("TranslatorContext::insertItem primPath=%s translatorId=%s to MObject type %s\n", prim.GetPath().GetText(), lookup.translatorId().c_str(), object.object().apiTypeStr());
+}
 
-  if(object.object() == MObject::kNullObj)
-  {
-    TF_DEBUG(ALUSDMAYA_TRANSLATORS).Msg("TranslatorContext::insertItem primPath=%s translatorId=%s to null MObject\n", prim.GetPath().GetText(), iter->translatorId().c_str());
-  }
-  else
+//----------------------------------------------------------------------------------------------------------------------
+void TranslatorContext::insertItems(const UsdPrim& prim, const MObjectHandleArray& objects)
+{
+  TF_DEBUG(ALUSDMAYA_TRANSLATORS).Msg("TranslatorContext::insertItems adding %zu nodes to entry %s\n", objects.size(), prim.GetPath().GetText());
+
+  PrimLookup& lookup = findOrInsert(prim);
+  MObjectHandleArray& createdNodes = lookup.createdNodes();
+  createdNodes.reserve(createdNodes.size() + objects.size());
+  for(const MObjectHandle& object : objects)
   {
-    TF_DEBUG(ALUSDMAYA_TRANSLATORS).Msg("TranslatorContext::insertItem primPath=%s translatorId=%s to MObject type %s\n", prim.GetPath().GetText(), iter->translatorId().c_str(), object.object().apiTypeStr());
+    if(object.object() != MObject::kNullObj)
+    {
+      createdNodes.push_back(object);
+    }
   }
 }
 
@@ -265,7 +376,7 @@ void TranslatorContext::removeItems(const SdfPath& path)
 {
   TF_DEBUG(ALUSDMAYA_TRANSLATORS).Msg("TranslatorContext::removeItems remove under primPath=%s\n", path.GetText());
   auto it = find(path);
-  if(it != m_primMapping.end() && it->path() == path)
+  if(it != m_primMapping.end())
   {
     TF_DEBUG(ALUSDMAYA_TRANSLATORS).Msg("TranslatorContext::removeItems removing path=%s\n", it->path().GetText());
     MDGModifier modifier1;
@@ -355,6 +466,114 @@ void TranslatorContext::removeItems(const SdfPath& path)
   validatePrims();
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+void TranslatorContext::setNodePoolEnabled(bool enabled)
+{
+  m_nodePoolEnabled = enabled;
+  if(enabled)
+  {
+    return;
+  }
+
+  // any nodes still in the pool were not reused, so delete them along with the transform they were parented under
+  if(m_nodePoolParent.isValid() && m_nodePoolParent.isAlive())
+  {
+    TF_DEBUG(ALUSDMAYA_TRANSLATORS).Msg("TranslatorContext::setNodePoolEnabled deleting %zu unused nodes\n", nodePoolSize());
+    MDagModifier modifier;
+    MStatus status = modifier.deleteNode(m_nodePoolParent.object());
+    status = modifier.doIt();
+    AL_MAYA_CHECK_ERROR2(status, "failed to delete the node pool");
+  }
+  m_nodePoolParent = MObjectHandle();
+  m_nodePool.clear();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool TranslatorContext::releaseToNodePool(const SdfPath& path, const MObject& node, const TfType& translatorType, uint64_t signature)
+{
+  if(!m_nodePoolEnabled || !node.hasFn(MFn::kDagNode))
+  {
+    return false;
+  }
+
+  MStatus status;
+  MDagModifier modifier;
+  if(!m_nodePoolParent.isValid() || !m_nodePoolParent.isAlive())
+  {
+    MObject poolParent = modifier.createNode("transform", MObject::kNullObj, &status);
+    AL_MAYA_CHECK_ERROR_RETURN_VAL(status, false, "failed to create the node pool transform");
+    modifier.renameNode(poolParent, "AL_usdmaya_nodePool");
+    status = modifier.doIt();
+    AL_MAYA_CHECK_ERROR_RETURN_VAL(status, false, "failed to create the node pool transform");
+    MFnDagNode fn(poolParent);
+    fn.findPlug("v", true).setBool(false);
+    m_nodePoolParent = poolParent;
+  }
+
+  status = modifier.reparentNode(node, m_nodePoolParent.object());
+  status = modifier.doIt();
+  AL_MAYA_CHECK_ERROR_RETURN_VAL(status, false, "failed to move node into the node pool");
+
+  // the node no longer belongs to the prim, so make sure it survives the removal of the prim's other nodes
+  auto it = find(path);
+  if(it != m_primMapping.end())
+  {
+    auto& nodes = it->createdNodes();
+    nodes.erase(std::remove_if(nodes.begin(), nodes.end(), [&node](const MObjectHandle& handle) { return handle.objectRef() == node; }), nodes.end());
+  }
+
+  TF_DEBUG(ALUSDMAYA_TRANSLATORS).Msg("TranslatorContext::releaseToNodePool prim=%s signature=%lu\n", path.GetText(), signature);
+  m_nodePool[std::make_pair(translatorType, signature)].emplace_back(node);
+  return true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+MObject TranslatorContext::acquireFromNodePool(const TfType& translatorType, uint64_t signature, const MObject& parent)
+{
+  auto it = m_nodePool.find(std::make_pair(translatorType, signature));
+  if(it == m_nodePool.end())
+  {
+    return MObject::kNullObj;
+  }
+
+  MObjectHandleArray& nodes = it->second;
+  while(!nodes.empty())
+  {
+    MObjectHandle handle = nodes.back();
+    nodes.pop_back();
+    if(!handle.isValid() || !handle.isAlive())
+    {
+      continue;
+    }
+
+    MDagModifier modifier;
+    MStatus status = modifier.reparentNode(handle.object(), parent);
+    status = modifier.doIt();
+    if(status)
+    {
+      TF_DEBUG(ALUSDMAYA_TRANSLATORS).Msg("TranslatorContext::acquireFromNodePool reusing node for signature=%lu\n", signature);
+      if(nodes.empty())
+      {
+        m_nodePool.erase(it);
+      }
+      return handle.object();
+    }
+  }
+  m_nodePool.erase(it);
+  return MObject::kNullObj;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+size_t TranslatorContext::nodePoolSize() const
+{
+  size_t count = 0;
+  for(const auto& entry : m_nodePool)
+  {
+    count += entry.second.size();
+  }
+  return count;
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 MString getNodeName(MObject obj)
 {
@@ -370,19 +589,33 @@ MString getNodeName(MObject obj)
 }
 
 //----------------------------------------------------------------------------------------------------------------------
-MString TranslatorContext::serialise() const
+void TranslatorContext::serialiseExcludedGeometry() const
 {
-  TF_DEBUG(ALUSDMAYA_TRANSLATORS).Msg("TranslatorContext:serialise\n");
   std::ostringstream oss;
   for(auto& path : m_excludedGeometry)
   {
     oss << path.first.GetString() << ",";
   }
-
   m_proxyShape->excludedTranslatedGeometryPlug().setString(MString(oss.str().c_str()));
+}
 
-  oss.str("");
-  oss.clear();
+//----------------------------------------------------------------------------------------------------------------------
+void TranslatorContext::deserialiseExcludedGeometry()
+{
+  SdfPathVector vec = m_proxyShape->getPrimPathsFromCommaJoinedString(m_proxyShape->excludedTranslatedGeometryPlug().asString());
+  for(auto& it : vec)
+  {
+    m_excludedGeometry.emplace(it, it);
+  }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+MString TranslatorContext::serialise() const
+{
+  TF_DEBUG(ALUSDMAYA_TRANSLATORS).Msg("TranslatorContext:serialise\n");
+  serialiseExcludedGeometry();
+
+  std::ostringstream oss;
 
   for(auto it : m_primMapping)
   {
@@ -453,62 +686,122 @@ void TranslatorContext::deserialise(const MString& string)
       lookup.createdNodes().push_back(obj);
     }
 
-    m_primMapping.push_back(lookup);
+    m_primMapping.insert(lookup);
   }
 
-  SdfPathVector vec = m_proxyShape->getPrimPathsFromCommaJoinedString(m_proxyShape->excludedTranslatedGeometryPlug().asString());
-  for(auto& it : vec)
+  deserialiseExcludedGeometry();
+}
+
+namespace {
+// 'ALTC', followed by the layout version of the entries
+const uint32_t kTranslatorContextMagic = 0x43544C41;
+const uint32_t kTranslatorContextVersion = 1;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+MIntArray TranslatorContext::serialiseBinary() const
+{
+  TF_DEBUG(ALUSDMAYA_TRANSLATORS).Msg("TranslatorContext:serialiseBinary\n");
+  serialiseExcludedGeometry();
+
+  // each entry: path | translator id | node | number of created nodes | created nodes | unique key
+  BinaryArchiveWriter writer(kTranslatorContextMagic, kTranslatorContextVersion);
+  writer.writeU32(uint32_t(m_primMapping.size()));
+  for(const auto& it : m_primMapping)
   {
-    m_excludedGeometry.emplace(it, it);
+    writer.writePath(it.path());
+    writer.writeString(it.translatorId());
+    writer.writeNode(getNodeName(it.object()));
+    writer.writeU32(uint32_t(it.createdNodes().size()));
+    for(const auto& created : it.createdNodes())
+    {
+      writer.writeNode(getNodeName(created.object()));
+    }
+    writer.writeU64(it.uniqueKey());
   }
+  return writer.data();
 }
 
 //----------------------------------------------------------------------------------------------------------------------
-void TranslatorContext::preRemoveEntry(const SdfPath& primPath, SdfPathVector& itemsToRemove, bool callPreUnload)
+bool TranslatorContext::deserialiseBinary(const MIntArray& data)
 {
-  TF_DEBUG(ALUSDMAYA_TRANSLATORS).Msg("TranslatorContext::preRemoveEntry primPath=%s\n", primPath.GetText());
+  TF_DEBUG(ALUSDMAYA_TRANSLATORS).Msg("TranslatorContext:deserialiseBinary\n");
+  BinaryArchiveReader reader(data, kTranslatorContextMagic);
+  if(!reader.isValid() || reader.version() != kTranslatorContextVersion)
+  {
+    return false;
+  }
 
-  PrimLookups::iterator end = m_primMapping.end();
-  PrimLookups::iterator range_begin = std::lower_bound(m_primMapping.begin(), end, primPath, value_compare());
-  PrimLookups::iterator range_end = range_begin;
-  for(; range_end != end; ++range_end)
+  std::vector<PrimLookup> lookups;
+  const uint32_t count = reader.readU32();
+  for(uint32_t i = 0; i < count && reader.isValid(); ++i)
   {
-    // due to the joys of sorting, any child prims of this prim being destroyed should appear next to each
-    // other (one would assume); So if compare does not find a match (the value is something other than zero),
-    // we are no longer in the same prim root
-    const SdfPath& childPath = range_end->path();
+    const SdfPath& path = reader.readPath();
+    const std::string& translatorId = reader.readString();
+    MObject obj = reader.readNode();
+    PrimLookup lookup(path, translatorId, obj);
 
-    if(!childPath.HasPrefix(primPath))
+    const uint32_t numCreated = reader.readU32();
+    for(uint32_t j = 0; j < numCreated && reader.isValid(); ++j)
     {
-      break;
+      lookup.createdNodes().push_back(reader.readNode());
     }
+    lookup.setUniqueKey(reader.readU64());
+    lookups.push_back(std::move(lookup));
   }
 
+  if(!reader.isValid())
+  {
+    TF_DEBUG(ALUSDMAYA_TRANSLATORS).Msg("TranslatorContext:deserialiseBinary ignored truncated or corrupt data\n");
+    return false;
+  }
+
+  m_primMapping.reserve(m_primMapping.size() + lookups.size());
+  for(auto& lookup : lookups)
+  {
+    m_primMapping.insert(std::move(lookup));
+  }
+  deserialiseExcludedGeometry();
+  return true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void TranslatorContext::preRemoveEntry(const SdfPath& primPath, SdfPathVector& itemsToRemove, bool callPreUnload)
+{
+  TF_DEBUG(ALUSDMAYA_TRANSLATORS).Msg("TranslatorContext::preRemoveEntry primPath=%s\n", primPath.GetText());
+
+  SdfPathVector subtree;
+  m_primMapping.findSubtree(primPath, subtree);
+
   auto stage = m_proxyShape->usdStage();
 
   // run the preTearDown stage on each prim. We will walk over the prims in the reverse order here (which will guarentee
   // the the itemsToRemove will be ordered such that the child prims will be destroyed before their parents).
-  auto iter = range_end;
-  itemsToRemove.reserve(itemsToRemove.size() + range_end - range_begin);
-  while(iter != range_begin)
+  itemsToRemove.reserve(itemsToRemove.size() + subtree.size());
+  for(auto iter = subtree.rbegin(); iter != subtree.rend(); ++iter)
   {
-    --iter;
-    PrimLookup& node = *iter;
+    const SdfPath& path = *iter;
 
-    if(std::find(itemsToRemove.begin(), itemsToRemove.end(), node.path()) != itemsToRemove.end())
+    if(std::find(itemsToRemove.begin(), itemsToRemove.end(), path) != itemsToRemove.end())
     {
       // Same exact path has already been processed and added to the list of itemsToRemove.
       TF_DEBUG(ALUSDMAYA_TRANSLATORS).Msg("TranslatorContext::preRemoveEntry skipping path thats already in "
                                           "itemsToRemove. primPath=%s\n", primPath.GetText());
+      continue;
     }
-    else
+
+    // a preTearDown may have removed the mapping of a descendant already
+    auto node = find(path);
+    if(node == m_primMapping.end())
     {
-      itemsToRemove.push_back(node.path());
-      auto prim = stage->GetPrimAtPath(node.path());
-      if (prim && callPreUnload)
-      {
-        preUnloadPrim(prim, node.object());
-      }
+      continue;
+    }
+
+    itemsToRemove.push_back(path);
+    auto prim = stage->GetPrimAtPath(path);
+    if (prim && callPreUnload)
+    {
+      preUnloadPrim(prim, node->object());
     }
   }
 }
@@ -527,7 +820,7 @@ void TranslatorContext::removeEntries(const SdfPathVector& itemsToRemove)
   while(iter != itemsToRemove.end())
   {
     auto path = *iter;
-    auto node = std::lower_bound(m_primMapping.begin(), m_primMapping.end(), path, value_compare());
+    auto node = find(path);
     if(node == m_primMapping.end())
     {
       ++iter;
@@ -542,11 +835,7 @@ void TranslatorContext::removeEntries(const SdfPathVector& itemsToRemove)
     }
 
     // The item might already have been removed by a translator...
-    if(node != m_primMapping.end() && node->path() == path)
-    {
-      // remove nodes from map
-      m_primMapping.erase(node);
-    }
+    m_primMapping.erase(path);
 
     if(isInTransformChain)
     {
@@ -593,7 +882,7 @@ void TranslatorContext::updateUniqueKey(const UsdPrim& prim)
   if(translator)
   {
     auto it = find(path);
-    if(it != m_primMapping.end() && it->path() == path)
+    if(it != m_primMapping.end())
     {
       auto key(translator->generateUniqueKey(prim));
       TF_DEBUG(ALUSDMAYA_TRANSLATORS).Msg("TranslatorContext::updateUniqueKey [generateUniqueKey] prim='%s', uniqueKey='%lu', previousUniqueKey='%lu'\n", path.GetText(), key, it->uniqueKey());
@@ -23,15 +23,20 @@
 #include "maya/MObject.h"
 #include "maya/MObjectHandle.h"
 #include "maya/MObjectArray.h"
+#include "maya/MIntArray.h"
 #include "maya/MDGModifier.h"
 #include "pxr/pxr.h"
 #include "pxr/base/tf/refPtr.h"
+#include "pxr/base/tf/type.h"
 #include "pxr/usd/usd/prim.h"
 #include "pxr/base/tf/debug.h"
 #include "AL/usdmaya/DebugCodes.h"
 
+#include <map>
 #include <vector>
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
 #include <mayaUsdUtils/ForwardDeclares.h>
 
 PXR_NAMESPACE_USING_DIRECTIVE
@@ -201,6 +206,19 @@ public:
   AL_USDMAYA_PUBLIC
   void insertItem(const UsdPrim& prim, MObjectHandle object);
 
+  /// \brief  Associates a number of maya nodes with the prim path in one go, which is cheaper than calling
+  ///         insertItem for each of them.
+  /// \param  prim the prim you are currently importing in a translator
+  /// \param  objects the handles to the maya nodes you have created.
+  AL_USDMAYA_PUBLIC
+  void insertItems(const UsdPrim& prim, const MObjectHandleArray& objects);
+
+  /// \brief  Reserves room for a batch of prims that are about to be translated, so that registering them does not
+  ///         repeatedly grow the mapping.
+  /// \param  count the number of prims in the batch
+  void reserveItems(std::size_t count)
+    { m_primMapping.reserve(m_primMapping.size() + count); }
+
   /// \brief  during a variant switch, if we lose a prim, then it's path will be passed into this method, and
   ///         all the maya nodes that were created for it will be nuked.
   /// \param  prim the usd prim that was removed due to a variant switch
@@ -243,6 +261,13 @@ public:
   /// \param  object the handle to the maya node you have created.
   AL_USDMAYA_PUBLIC
   void registerItem(const UsdPrim& prim, MObjectHandle object);
+
+  /// \brief  Internal method.
+  ///         Registers a batch of prims with the maya nodes that represent them, as registerItem does for one prim.
+  /// \param  prims the prims that have been imported
+  /// \param  objects the handles to the maya nodes created for each prim (same size as prims)
+  AL_USDMAYA_PUBLIC
+  void registerItems(const std::vector<UsdPrim>& prims, const MObjectHandleArray& objects);
    
   /// \brief  serialises the content of the translator context to a text string.
   /// \return the translator context serialised into a string
@@ -254,6 +279,19 @@ public:
   AL_USDMAYA_PUBLIC
   void deserialise(const MString& string);
 
+  /// \brief  serialises the content of the translator context to a versioned binary archive, which is much faster to
+  ///         write and read back than the text string for large numbers of translated prims.
+  /// \return the translator context serialised into an int array
+  AL_USDMAYA_PUBLIC
+  MIntArray serialiseBinary() const;
+
+  /// \brief  deserialises a binary archive written by serialiseBinary back into the translator context. All nodes
+  ///         are resolved from their names in a single pass.
+  /// \param  data the archive to deserialise
+  /// \return false if the data is not a valid translator context archive, in which case the context is unchanged
+  AL_USDMAYA_PUBLIC
+  bool deserialiseBinary(const MIntArray& data);
+
   /// \brief  debugging utility to help keep track of prims during a variant switch
   AL_USDMAYA_PUBLIC
   void validatePrims();
@@ -308,6 +346,43 @@ public:
   AL_USDMAYA_PUBLIC
   void updateUniqueKey(const UsdPrim& prim);
 
+  /// \brief  Enables or disables the node pool. Whilst enabled, translators may hand the maya nodes of the prims they
+  ///         tear down to the pool (see releaseToNodePool), so that prims imported later within the same translation
+  ///         (e.g. the same mesh under a different LOD or look variant) can reuse them rather than create new ones.
+  ///         Disabling the pool deletes any nodes that have not been reused.
+  /// \param  enabled true to enable the pool, false to disable it
+  AL_USDMAYA_PUBLIC
+  void setNodePoolEnabled(bool enabled);
+
+  /// \brief  returns true if nodes torn down can currently be handed to the node pool
+  bool isNodePoolEnabled() const
+    { return m_nodePoolEnabled; }
+
+  /// \brief  Moves a maya DAG node created for the prim at the specified path into the node pool, instead of it being
+  ///         deleted when the prim is torn down. The node is removed from the nodes registered against the prim, and
+  ///         re-parented under a hidden transform until it is either reused, or the pool is disabled.
+  /// \param  path the path of the prim being torn down
+  /// \param  node the maya node to move into the pool
+  /// \param  translatorType the translated type of the translator that created the node
+  /// \param  signature the topology signature of the node. Only nodes with matching signatures will be reused.
+  /// \return true if the node was added to the pool, false if the pool is disabled (in which case the node is left
+  ///         alone, and should be removed as normal).
+  AL_USDMAYA_PUBLIC
+  bool releaseToNodePool(const SdfPath& path, const MObject& node, const TfType& translatorType, uint64_t signature);
+
+  /// \brief  Takes a node with a matching translator type and topology signature out of the node pool, and re-parents
+  ///         it under the specified parent.
+  /// \param  translatorType the translated type of the translator requesting the node
+  /// \param  signature the topology signature the node must match
+  /// \param  parent the transform to parent the node under
+  /// \return the node taken from the pool, or a null object if no matching node exists
+  AL_USDMAYA_PUBLIC
+  MObject acquireFromNodePool(const TfType& translatorType, uint64_t signature, const MObject& parent);
+
+  /// \brief  returns the number of nodes currently waiting in the node pool
+  AL_USDMAYA_PUBLIC
+  size_t nodePoolSize() const;
+
   /// \brief  An internal structure used to store a mapping between an SdfPath, the type of prim found at that location,
   ///         the maya transform that may have been created (assuming the translator plugin specifies that it needs
   ///         a parent transform), and any nodes that the translator plugin may have created.
@@ -382,35 +457,131 @@ public:
     MObjectHandleArray m_createdNodes;
   };
 
-  /// a sorted array of prim mappings
-  typedef std::vector<PrimLookup> PrimLookups;
-
-  /// comparison utility (for sorting array of pointers to node references based on their path)
-  struct value_compare
+  /// \brief  The prim mappings, hashed on their path so that insertion, removal and look up take constant time on
+  ///         average. An index of the children of each path is kept alongside the mappings, so that all of the
+  ///         mappings below a prim can be found without visiting every mapping.
+  class PrimLookupTable
   {
-    /// \brief  compare schema node ref to path
-    /// \param  a the node ref pointer on the left of the < operator
-    /// \param  b the sdf path on the right of the < operator
-    /// \return true if a->primPath() < b, false otherwise
-    inline bool operator() (const PrimLookup& a, const SdfPath& b) const
-      { return a.path() < b; }
-
-    /// \brief  compare schema node ref to path
-    /// \param  a the sdf path on the left of the < operator
-    /// \param  b the node ref pointer on the right of the < operator
-    /// \return true if a < b->primPath(), false otherwise
-    inline bool operator() (const SdfPath& a, const PrimLookup& b) const
-      { return a < b.path(); }
-
-    /// compare schema node ref to schema node ref
-    /// \brief  compare schema node ref to path
-    /// \param  a the node ref pointer on the left of the < operator
-    /// \param  b the node ref pointer on the right of the < operator
-    /// \return true if a->primPath() < b->primPath(), false otherwise
-    inline bool operator() (const PrimLookup& a, const PrimLookup& b) const
-      { return a.path() < b.path(); }
+    typedef std::unordered_map<SdfPath, PrimLookup, SdfPath::Hash> Lookups;
+    typedef std::unordered_map<SdfPath, std::unordered_set<SdfPath, SdfPath::Hash>, SdfPath::Hash> Children;
+
+    template<typename BaseIterator, typename Value>
+    class LookupIterator
+    {
+    public:
+      typedef std::forward_iterator_tag iterator_category;
+      typedef Value value_type;
+      typedef std::ptrdiff_t difference_type;
+      typedef Value* pointer;
+      typedef Value& reference;
+
+      LookupIterator() {}
+      LookupIterator(BaseIterator it) : m_it(it) {}
+      template<typename OtherIterator, typename OtherValue>
+      LookupIterator(const LookupIterator<OtherIterator, OtherValue>& other) : m_it(other.base()) {}
+
+      Value& operator*() const
+        { return m_it->second; }
+      Value* operator->() const
+        { return &m_it->second; }
+      LookupIterator& operator++()
+        { ++m_it; return *this; }
+      LookupIterator operator++(int)
+        { LookupIterator temp(*this); ++m_it; return temp; }
+      bool operator==(const LookupIterator& other) const
+        { return m_it == other.m_it; }
+      bool operator!=(const LookupIterator& other) const
+        { return m_it != other.m_it; }
+      const BaseIterator& base() const
+        { return m_it; }
+
+    private:
+      BaseIterator m_it;
+    };
+
+  public:
+    /// iterates over the prim mappings, in no particular order
+    typedef LookupIterator<Lookups::iterator, PrimLookup> iterator;
+    /// iterates over the prim mappings, in no particular order
+    typedef LookupIterator<Lookups::const_iterator, const PrimLookup> const_iterator;
+
+    iterator begin()
+      { return m_lookups.begin(); }
+    iterator end()
+      { return m_lookups.end(); }
+    const_iterator begin() const
+      { return m_lookups.begin(); }
+    const_iterator end() const
+      { return m_lookups.end(); }
+
+    /// \brief  returns the number of prim mappings
+    std::size_t size() const
+      { return m_lookups.size(); }
+
+    /// \brief  returns true if there are no prim mappings
+    bool empty() const
+      { return m_lookups.empty(); }
+
+    /// \brief  removes all prim mappings
+    void clear()
+      { m_lookups.clear(); m_children.clear(); }
+
+    /// \brief  reserves room for the given number of prim mappings, to avoid rehashing while a batch is inserted
+    /// \param  count the total number of prim mappings expected
+    void reserve(std::size_t count)
+      { m_lookups.reserve(count); }
+
+    /// \brief  finds the mapping of a prim
+    /// \param  path the prim path
+    /// \return the mapping, or end() if there is no mapping for that path
+    iterator find(const SdfPath& path)
+      { return m_lookups.find(path); }
+
+    /// \brief  finds the mapping of a prim
+    /// \param  path the prim path
+    /// \return the mapping, or end() if there is no mapping for that path
+    const_iterator find(const SdfPath& path) const
+      { return m_lookups.find(path); }
+
+    /// \brief  adds a prim mapping, unless there already is one for that path
+    /// \param  lookup the mapping to add
+    /// \return the mapping for the path of lookup, and true if lookup was inserted
+    AL_USDMAYA_PUBLIC
+    std::pair<iterator, bool> insert(PrimLookup lookup);
+
+    /// \brief  removes a prim mapping. The mappings of the descendants of that prim are left untouched.
+    /// \param  it the mapping to remove
+    /// \return the mapping that followed the removed one
+    AL_USDMAYA_PUBLIC
+    iterator erase(iterator it);
+
+    /// \brief  removes the mapping of a prim, if there is one
+    /// \param  path the prim path
+    /// \return true if a mapping was removed
+    AL_USDMAYA_PUBLIC
+    bool erase(const SdfPath& path);
+
+    /// \brief  returns the paths of the mappings of a prim and of all of its descendants, sorted so that parents come
+    ///         before their children.
+    /// \param  path the prim path
+    /// \param  paths the returned paths are appended to this array
+    AL_USDMAYA_PUBLIC
+    void findSubtree(const SdfPath& path, SdfPathVector& paths) const;
+
+  private:
+    void link(const SdfPath& path);
+    void unlink(const SdfPath& path);
+    bool isIndexed(const SdfPath& path) const
+      { return m_lookups.count(path) || m_children.count(path); }
+
+    Lookups m_lookups;
+    Children m_children; ///< the children of every indexed path that has some, where a path is indexed if it has a
+                         ///  mapping or any of its descendants has one
   };
 
+  /// the prim mappings
+  typedef PrimLookupTable PrimLookups;
+
   /// \brief  This is used for testing only. Do not call.
   void clearPrimMappings()
     { m_primMapping.clear(); }
@@ -457,41 +628,20 @@ private:
 
   bool isNodeAncestorOf(MObjectHandle ancestorHandle, MObjectHandle objectHandleToTest);
 
+  void serialiseExcludedGeometry() const;
+  void deserialiseExcludedGeometry();
+
   /// \brief test if the prim was translated into any MObject(s), that sits underneath the parent MObject.
   /// \return true if the prim maps to a MObject inside the Maya Dag tree.
   bool isPrimInTransformChain(const SdfPath& path);
 
   inline PrimLookups::iterator find(const SdfPath& path)
-  {
-    PrimLookups::iterator end = m_primMapping.end();
-    PrimLookups::iterator it = std::lower_bound(m_primMapping.begin(), end, path, value_compare());
-    if(it != end)
-    {
-      if(it->path() == path)
-        return it;
-    }
-    return end;
-  }
+    { return m_primMapping.find(path); }
 
   inline PrimLookups::const_iterator find(const SdfPath& path) const
-  {
-    PrimLookups::const_iterator end = m_primMapping.end();
-    PrimLookups::const_iterator it = std::lower_bound(m_primMapping.begin(), end, path, value_compare());
-    if(it != end)
-    {
-      if(it->path() == path)
-        return it;
-    }
-    return end;
-  }
-
-  inline PrimLookups::iterator findLocation(const SdfPath& path)
-  {
-    PrimLookups::iterator end = m_primMapping.end();
-    PrimLookups::iterator it = std::lower_bound(m_primMapping.begin(), end, path, value_compare());
-    return it;
-  }
+    { return m_primMapping.find(path); }
 
+  PrimLookup& findOrInsert(const UsdPrim& prim);
 
   TranslatorContext(nodes::ProxyShape* proxyShape)
     : m_proxyShape(proxyShape), m_primMapping()
@@ -507,6 +657,11 @@ private:
   SdfInstanceMap m_excludedGeometry;
   bool m_isExcludedGeometryDirty;
 
+  // nodes torn down during the current translation that may be reused, keyed by translator type and signature
+  std::map<std::pair<TfType, uint64_t>, MObjectHandleArray> m_nodePool;
+  MObjectHandle m_nodePoolParent;
+  bool m_nodePoolEnabled = false;
+
 public:
   void setForceDefaultRead(bool forceDefaultRead)
     { m_forceDefaultRead = forceDefaultRead; }
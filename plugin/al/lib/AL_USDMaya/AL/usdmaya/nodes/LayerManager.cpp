@@ -19,6 +19,8 @@
 #include "AL/usdmaya/TypeIDs.h"
 #include "AL/usdmaya/nodes/LayerManager.h"
 
+#include "pxr/base/tf/notice.h"
+#include "pxr/base/work/loops.h"
 #include "pxr/usd/sdf/textFileFormat.h"
 #include "pxr/usd/usd/usdaFileFormat.h"
 #include "pxr/usd/usd/usdcFileFormat.h"
@@ -34,6 +36,7 @@
 #include <boost/thread.hpp>
 #include <boost/thread/shared_lock_guard.hpp>
 #include <mutex>
+#include <vector>
 
 namespace {
   // Global mutex protecting _findNode / findOrCreateNode.
@@ -486,6 +489,19 @@ void LayerManager::loadAllLayers()
   std::string identifierVal;
   std::string serializedVal;
   SdfLayerRefPtr layer;
+
+  // the layers are created in the order they are stored, but the serialised data of the layers that have just been
+  // created (i.e. that no stage can be using yet) is parsed in parallel once all of them have been gathered.
+  struct PendingLayer
+  {
+    SdfLayerRefPtr layer;
+    std::string identifier;
+    std::string serialized;
+    bool isNew;
+    bool imported;
+  };
+  std::vector<PendingLayer> pendingLayers;
+
   // We DON'T want to use evaluate num elements, because we don't want to trigger
   // a compute - we want the value(s) as read from the file!
   const unsigned int numElements = allLayersPlug.numElements();
@@ -517,6 +533,7 @@ void LayerManager::loadAllLayers()
 
     bool isAnon = anonymousPlug.asBool(MDGContext::fsNormal, &status);
     AL_MAYA_CHECK_ERROR_CONTINUE(status, errorString);
+    bool isNew = true;
     if(isAnon)
     {
       // Note that the new identifier will not match the old identifier - only the "tag" will be retained
@@ -528,6 +545,7 @@ void LayerManager::loadAllLayers()
       if (layerHandle)
       {
         layer = layerHandle;
+        isNew = false;
       }
       else
       {
@@ -572,27 +590,55 @@ void LayerManager::loadAllLayers()
       }
     }
 
+    pendingLayers.push_back(PendingLayer{layer, identifierVal, std::move(serializedVal), isNew, false});
+  }
+
+  WorkParallelForN(pendingLayers.size(), [&pendingLayers](size_t begin, size_t end)
+  {
+    // These layers have just been created, and are not used by any stage until addLayer is called for them below, so
+    // no stage can be listening to them. Listeners registered for every sender would be run here on a worker thread,
+    // so the notices are blocked (TfNotice::Block only affects the calling thread). Those listeners do not hear about
+    // the import, in the same way that they do not hear about the layer contents being read from disk.
+    TfNotice::Block noticeBlock;
+    for(size_t i = begin; i < end; ++i)
+    {
+      PendingLayer& pending = pendingLayers[i];
+      if(pending.isNew)
+      {
+        pending.imported = pending.layer->ImportFromString(pending.serialized);
+      }
+    }
+  });
+
+  for(PendingLayer& pending : pendingLayers)
+  {
     TF_DEBUG(ALUSDMAYA_LAYERS).Msg(
         "################################################\n"
         "Importing layer from serialised data:\n"
         "old identifier: %s\n"
         "new identifier: %s\n"
         "format: %s\n",
-        identifierVal.c_str(),
-        layer->GetIdentifier().c_str(),
-        layer->GetFileFormat()->GetFormatId().GetText()
+        pending.identifier.c_str(),
+        pending.layer->GetIdentifier().c_str(),
+        pending.layer->GetFileFormat()->GetFormatId().GetText()
         );
 
-    if(!layer->ImportFromString(serializedVal))
+    // layers that already existed may be in use, so are imported here on the main thread
+    if(!pending.isNew)
+    {
+      pending.imported = pending.layer->ImportFromString(pending.serialized);
+    }
+
+    if(!pending.imported)
     {
       TF_DEBUG(ALUSDMAYA_LAYERS).Msg("Import result: failed!\n"
                                     "################################################\n");
-      MGlobal::displayError(MString("Failed to import serialized layer: ") + serializedVal.c_str());
+      MGlobal::displayError(MString("Failed to import serialized layer: ") + pending.serialized.c_str());
       continue;
     }
     TF_DEBUG(ALUSDMAYA_LAYERS).Msg("Import result: success!\n"
                                   "################################################\n");
-    addLayer(layer, identifierVal);
+    addLayer(pending.layer, pending.identifier);
   }
 }
 
@@ -22,12 +22,17 @@
 #include "AL/usdmaya/utils/Utils.h"
 
 #include "maya/MFnMesh.h"
+#include "maya/MGlobal.h"
+#include "maya/MPlugArray.h"
 #include "maya/MTime.h"
 
 #include "pxr/usd/usdGeom/mesh.h"
 
 #include <mayaUsd/nodes/stageData.h>
 
+#include <algorithm>
+#include <cstring>
+
 namespace AL {
 namespace usdmaya {
 namespace nodes {
@@ -69,6 +74,182 @@ MStatus MeshAnimDeformer::initialise()
   return MS::kSuccess;
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+void MeshAnimDeformer::AnimatedAttribute::reset(const UsdAttribute& attribute)
+{
+  query = attribute ? UsdAttributeQuery(attribute) : UsdAttributeQuery();
+  times.clear();
+  samples.clear();
+  hasLastSample = false;
+  if(query.IsValid())
+  {
+    query.GetTimeSamples(&times);
+  }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+const VtArray<GfVec3f>& MeshAnimDeformer::AnimatedAttribute::sample(double time)
+{
+  auto it = samples.find(time);
+  if(it == samples.end())
+  {
+    it = samples.emplace(time, VtArray<GfVec3f>()).first;
+    query.Get(&it->second, time);
+  }
+  return it->second;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void MeshAnimDeformer::AnimatedAttribute::update(float* output, size_t count, double time, bool held, bool force)
+{
+  // as before, only attributes with more than one time sample are considered to be animated
+  if(times.size() < 2)
+  {
+    return;
+  }
+
+  // find the samples that bracket the time
+  auto it = std::lower_bound(times.begin(), times.end(), time);
+  double lower, upper;
+  if(it == times.end())
+  {
+    lower = upper = times.back();
+  }
+  else
+  if(*it == time || it == times.begin())
+  {
+    lower = upper = *it;
+  }
+  else
+  {
+    upper = *it;
+    lower = *(it - 1);
+  }
+  if(held)
+  {
+    upper = lower;
+  }
+
+  // only keep the samples that bracket the current time, so that the cache stays bounded whichever direction
+  // playback (or scrubbing) moves in
+  samples.erase(samples.begin(), samples.lower_bound(lower));
+  samples.erase(samples.upper_bound(upper), samples.end());
+
+  const VtArray<GfVec3f>& lowerValue = sample(lower);
+  const VtArray<GfVec3f>* upperValue = (upper != lower) ? &sample(upper) : nullptr;
+  if(upperValue && upperValue->size() != lowerValue.size())
+  {
+    // USD falls back to held interpolation when the array sizes differ
+    upperValue = nullptr;
+  }
+
+  if(!upperValue)
+  {
+    // the maya buffer still holds this sample from the last evaluation
+    if(!force && hasLastSample && lastSample == lower)
+    {
+      return;
+    }
+    std::memcpy(output, lowerValue.cdata(), sizeof(GfVec3f) * std::min(count, lowerValue.size()));
+    lastSample = lower;
+    hasLastSample = true;
+  }
+  else
+  {
+    // interpolate directly into the maya buffer, rather than into a temporary array that then gets copied
+    const float alpha = float((time - lower) / (upper - lower));
+    const GfVec3f* const a = lowerValue.cdata();
+    const GfVec3f* const b = upperValue->cdata();
+    const size_t n = std::min(count, lowerValue.size());
+    for(size_t i = 0; i < n; ++i, output += 3)
+    {
+      output[0] = a[i][0] + (b[i][0] - a[i][0]) * alpha;
+      output[1] = a[i][1] + (b[i][1] - a[i][1]) * alpha;
+      output[2] = a[i][2] + (b[i][2] - a[i][2]) * alpha;
+    }
+    hasLastSample = false;
+  }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void MeshAnimDeformer::updateQueries(const UsdStageRefPtr& stage)
+{
+  if(!m_queriesDirty && get_pointer(m_queryStage) == get_pointer(stage) && m_queryPath == m_cachePath)
+    return;
+
+  TF_DEBUG(ALUSDMAYA_GEOMETRY_DEFORMER).Msg("MeshAnimDeformer::updateQueries %s\n", m_cachePath.GetText());
+  if(get_pointer(m_queryStage) != get_pointer(stage))
+  {
+    TfNotice::Revoke(m_objectsChanged);
+    TfWeakPtr<MeshAnimDeformer> me(this);
+    m_objectsChanged = TfNotice::Register(me, &MeshAnimDeformer::onObjectsChanged, UsdStageWeakPtr(stage));
+  }
+
+  UsdGeomMesh mesh(stage->GetPrimAtPath(m_cachePath));
+  m_points.reset(mesh ? mesh.GetPointsAttr() : UsdAttribute());
+  m_normals.reset(mesh ? mesh.GetNormalsAttr() : UsdAttribute());
+  m_queryStage = stage;
+  m_queryPath = m_cachePath;
+  m_queriesDirty = false;
+  m_meshDirty = true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void MeshAnimDeformer::onObjectsChanged(const UsdNotice::ObjectsChanged& notice, const UsdStageWeakPtr& sender)
+{
+  if(sender != m_queryStage || m_queryPath.IsEmpty())
+    return;
+
+  bool affected = false;
+  for(const SdfPath& path : notice.GetResyncedPaths())
+  {
+    if(m_queryPath.HasPrefix(path) || path.HasPrefix(m_queryPath))
+    {
+      affected = true;
+      break;
+    }
+  }
+  if(!affected)
+  {
+    for(const SdfPath& path : notice.GetChangedInfoOnlyPaths())
+    {
+      if(path.HasPrefix(m_queryPath))
+      {
+        affected = true;
+        break;
+      }
+    }
+  }
+  if(!affected)
+    return;
+
+  TF_DEBUG(ALUSDMAYA_GEOMETRY_DEFORMER).Msg("MeshAnimDeformer::onObjectsChanged %s\n", m_queryPath.GetText());
+  m_queriesDirty = true;
+
+  // the edit does not dirty any of the inputs, so dirty the output mesh once the edit has completed
+  if(!m_dirtyScheduled.exchange(true))
+  {
+    MFnDependencyNode fn(thisMObject());
+    MGlobal::executeCommandOnIdle(MString("dgdirty \"") + fn.name() + ".outMesh\";", false);
+  }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+MStatus MeshAnimDeformer::setDependentsDirty(const MPlug& plug, MPlugArray& plugArray)
+{
+  if(plug == m_inStageData || plug == m_primPath)
+  {
+    m_queriesDirty = true;
+  }
+  else
+  if(plug == m_inMesh)
+  {
+    // a new input mesh will not contain the points written during the last compute
+    m_meshDirty = true;
+  }
+  return MPxNode::setDependentsDirty(plug, plugArray);
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 MStatus MeshAnimDeformer::compute(const MPlug& plug, MDataBlock& data)
 {
@@ -81,45 +262,34 @@ MStatus MeshAnimDeformer::compute(const MPlug& plug, MDataBlock& data)
   }
 
   MTime inTimeVal = inputTimeValue(data, m_inTime);
-  UsdTimeCode usdTime(inTimeVal.value());
+  const double time = inTimeVal.value();
 
   MDataHandle inputHandle = data.inputValue(m_inMesh, &status);
   MDataHandle outputHandle = data.outputValue(m_outMesh, &status);
 
   MObject obj = inputHandle.asMesh();
 
+  m_dirtyScheduled = false;
+
   UsdStageRefPtr stage = getStage();
   if(stage)
   {
-    UsdPrim prim = stage->GetPrimAtPath(m_cachePath);
-    UsdGeomMesh mesh(prim);
+    updateQueries(stage);
+    const bool held = stage->GetInterpolationType() == UsdInterpolationTypeHeld;
 
     MFnMesh fnMesh(obj);
     float* const ptr = (float*)fnMesh.getRawPoints(&status);
     if(ptr)
     {
-      UsdAttribute points = mesh.GetPointsAttr();
-      if(points.GetNumTimeSamples() > 1)
-      {
-        VtArray<GfVec3f> pointData;
-        points.Get(&pointData, usdTime);
-        const size_t numPoints = pointData.size();
-        std::memcpy(ptr, pointData.cdata(), sizeof(float) * 3 * numPoints);
-      }
+      m_points.update(ptr, fnMesh.numVertices(), time, held, m_meshDirty);
     }
 
     float* const nptr = (float*)fnMesh.getRawNormals(&status);
     if(nptr)
     {
-      UsdAttribute normals = mesh.GetNormalsAttr();
-      if(normals.GetNumTimeSamples() > 1)
-      {
-        VtArray<GfVec3f> normalData;
-        normals.Get(&normalData, usdTime);
-        const size_t numNormals = normalData.size();
-        std::memcpy(nptr, normalData.cdata(), sizeof(float) * 3 * numNormals);
-      }
+      m_normals.update(nptr, fnMesh.numNormals(), time, held, m_meshDirty);
     }
+    m_meshDirty = false;
     outputHandle.set(obj);
   }
   return status;
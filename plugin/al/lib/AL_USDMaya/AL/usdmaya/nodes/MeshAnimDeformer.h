@@ -17,12 +17,20 @@
 #include "AL/maya/utils/NodeHelper.h"
 #include "AL/maya/utils/MayaHelperMacros.h"
 
+#include "pxr/base/tf/notice.h"
+#include "pxr/base/tf/weakBase.h"
+#include "pxr/usd/usd/attributeQuery.h"
+#include "pxr/usd/usd/notice.h"
 #include "pxr/usd/usd/stage.h"
 
 #include "maya/MPxNode.h"
 #include "maya/MNodeMessage.h"
 #include "maya/MObjectHandle.h"
 
+#include <atomic>
+#include <map>
+#include <vector>
+
 PXR_NAMESPACE_USING_DIRECTIVE
 
 namespace AL {
@@ -35,7 +43,8 @@ namespace nodes {
 //----------------------------------------------------------------------------------------------------------------------
 class MeshAnimDeformer
   : public MPxNode,
-    public AL::maya::utils::NodeHelper
+    public AL::maya::utils::NodeHelper,
+    public TfWeakBase
 {
 public:
 
@@ -45,7 +54,7 @@ public:
      {}
 
   inline ~MeshAnimDeformer()
-    { MNodeMessage::removeCallback(m_attributeChanged); }
+    { MNodeMessage::removeCallback(m_attributeChanged); TfNotice::Revoke(m_objectsChanged); }
 
   //--------------------------------------------------------------------------------------------------------------------
   /// Type Info & Registration
@@ -68,11 +77,52 @@ private:
   MStatus connectionBroken(const MPlug& plug, const MPlug& otherPlug, bool asSrc) override;
   static void onAttributeChanged(MNodeMessage::AttributeMessage, MPlug&, MPlug&, void*);
   MStatus compute(const MPlug& plug, MDataBlock& data) override;
+  MStatus setDependentsDirty(const MPlug& plug, MPlugArray& plugArray) override;
   UsdStageRefPtr getStage();
+
+  /// \brief  invalidates the cached queries and samples when the prim (or one of its ancestors) is edited, and
+  ///         dirties the output mesh so that the edit is picked up without waiting for a time change.
+  void onObjectsChanged(const UsdNotice::ObjectsChanged& notice, const UsdStageWeakPtr& sender);
+
+  /// \brief  caches the query and time samples of an animated point or normal attribute, along with the sample values
+  ///         that have been read from USD.
+  struct AnimatedAttribute
+  {
+    /// \brief  re-initialises the query from the specified attribute, and clears the cached samples
+    void reset(const UsdAttribute& attribute);
+
+    /// \brief  writes the value of the attribute at the specified time directly into the maya buffer
+    /// \param  output the maya owned buffer to write into
+    /// \param  count the number of elements in the buffer
+    /// \param  time the time to evaluate the attribute at
+    /// \param  held true if the stage uses held interpolation
+    /// \param  force if false, the write is skipped when the buffer already holds the same (held) sample
+    void update(float* output, size_t count, double time, bool held, bool force);
+
+    /// \brief  returns the sample at the specified time (which must be one of the authored time samples)
+    const VtArray<GfVec3f>& sample(double time);
+
+    UsdAttributeQuery query;
+    std::vector<double> times;
+    std::map<double, VtArray<GfVec3f>> samples;
+    double lastSample = 0;
+    bool hasLastSample = false;
+  };
+
+  void updateQueries(const UsdStageRefPtr& stage);
+
 private:
   SdfPath m_cachePath;
   MObjectHandle proxyShapeHandle;
   MCallbackId m_attributeChanged = 0;
+  AnimatedAttribute m_points;
+  AnimatedAttribute m_normals;
+  UsdStageWeakPtr m_queryStage;
+  SdfPath m_queryPath;
+  TfNotice::Key m_objectsChanged;
+  std::atomic<bool> m_queriesDirty {true};
+  std::atomic<bool> m_dirtyScheduled {false};
+  bool m_meshDirty = true;
 };
 
 //----------------------------------------------------------------------------------------------------------------------
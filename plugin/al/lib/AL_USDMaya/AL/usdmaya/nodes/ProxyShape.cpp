@@ -24,6 +24,7 @@
 #include "maya/MEventMessage.h"
 #include "maya/MFileIO.h"
 #include "maya/MItDependencyNodes.h"
+#include "maya/MFnIntArrayData.h"
 #include "maya/MFnPluginData.h"
 #include "maya/MFnReference.h"
 #include "maya/MGlobal.h"
@@ -34,6 +35,7 @@
 
 #include "AL/maya/utils/Utils.h"
 
+#include "AL/usdmaya/BinaryArchive.h"
 #include "AL/usdmaya/cmds/ProxyShapePostLoadProcess.h"
 #include "AL/usdmaya/CodeTimings.h"
 #include "AL/usdmaya/Global.h"
@@ -53,6 +55,7 @@
 
 #include "AL/usd/transaction/TransactionManager.h"
 
+#include "pxr/base/work/loops.h"
 #include "pxr/usd/ar/resolver.h"
 
 #include "pxr/usd/usdGeom/imageable.h"
@@ -66,6 +69,9 @@
 #include <mayaUsd/nodes/stageData.h>
 #include <mayaUsd/utils/utilFileSystem.h>
 
+#include <memory>
+#include <sstream>
+
 #if defined(WANT_UFE_BUILD)
 #include "ufe/path.h"
 #endif
@@ -83,6 +89,12 @@ void ProxyShape::serialiseTranslatorContext()
   triggerEvent("PreSerialiseContext");
 
   context()->updateUniqueKeys();
+
+  // the binary archive is read in preference to the text serialisation, which is still written so that builds that
+  // predate the archive can open the scene
+  MFnIntArrayData fnData;
+  MObject data = fnData.create(context()->serialiseBinary());
+  serializedTrCtxDataPlug().setValue(data);
   serializedTrCtxPlug().setValue(context()->serialise());
 
   triggerEvent("PostSerialiseContext");
@@ -93,9 +105,14 @@ void ProxyShape::deserialiseTranslatorContext()
 {
   triggerEvent("PreDeserialiseContext");
 
-  MString value;
-  serializedTrCtxPlug().getValue(value);
-  context()->deserialise(value);
+  MObject data;
+  serializedTrCtxDataPlug().getValue(data);
+  if(data.isNull() || !context()->deserialiseBinary(MFnIntArrayData(data).array()))
+  {
+    MString value;
+    serializedTrCtxPlug().getValue(value);
+    context()->deserialise(value);
+  }
 
   triggerEvent("PostDeserialiseContext");
 }
@@ -112,6 +129,7 @@ MObject ProxyShape::m_layers = MObject::kNullObj;
 MObject ProxyShape::m_serializedSessionLayer = MObject::kNullObj;
 MObject ProxyShape::m_sessionLayerName = MObject::kNullObj;
 MObject ProxyShape::m_serializedTrCtx = MObject::kNullObj;
+MObject ProxyShape::m_serializedTrCtxData = MObject::kNullObj;
 MObject ProxyShape::m_unloaded = MObject::kNullObj;
 MObject ProxyShape::m_ambient = MObject::kNullObj;
 MObject ProxyShape::m_diffuse = MObject::kNullObj;
@@ -119,6 +137,7 @@ MObject ProxyShape::m_specular = MObject::kNullObj;
 MObject ProxyShape::m_emission = MObject::kNullObj;
 MObject ProxyShape::m_shininess = MObject::kNullObj;
 MObject ProxyShape::m_serializedRefCounts = MObject::kNullObj;
+MObject ProxyShape::m_serializedRefCountsData = MObject::kNullObj;
 MObject ProxyShape::m_version = MObject::kNullObj;
 MObject ProxyShape::m_transformTranslate = MObject::kNullObj;
 MObject ProxyShape::m_transformRotate = MObject::kNullObj;
@@ -131,6 +150,8 @@ MObject ProxyShape::m_visibleInRefractions = MObject::kNullObj;
 
 //----------------------------------------------------------------------------------------------------------------------
 std::vector<MObjectHandle> ProxyShape::m_unloadedProxyShapes;
+std::vector<MObjectHandle> ProxyShape::m_duplicatedProxyShapes;
+MCallbackId ProxyShape::m_loadDuplicatedCallback = 0;
 int m_stageCacheId;
 //----------------------------------------------------------------------------------------------------------------------
 UsdPrim ProxyShape::getUsdPrim(MDataBlock& dataBlock) const
@@ -224,7 +245,9 @@ void ProxyShape::translatePrimsIntoMaya(
   // content to remove needs to be dealt with first
   // as some nodes might be re-imported and we have
   // to make sure their "old" version is gone before
-  // recreating them.
+  // recreating them. Translators that support it will hand the nodes they tear down to the node pool, so that they
+  // can be reused by the prims imported below (which is common when switching between LOD or look variants).
+  context()->setNodePoolEnabled(true);
   context()->removeEntries(filter.removedPrimSet());
 
   cmds::ProxyShapePostLoadProcess::MObjectToPrim objsToCreate;
@@ -250,6 +273,9 @@ void ProxyShape::translatePrimsIntoMaya(
     cmds::ProxyShapePostLoadProcess::updateSchemaPrims(this, filter.updatablePrimSet());
   }
 
+  // delete any pooled nodes that were not reused
+  context()->setNodePoolEnabled(false);
+
   cleanupTransformRefs();
 
   context()->updatePrimTypes();
@@ -406,9 +432,49 @@ MStatus ProxyShape::preEvaluation(const MDGContext & context, const MEvaluationN
 {
   if( !context.isNormal() )
       return MStatus::kFailure;
+
+#if MAYA_API_VERSION >= 201800
+  // The stage has already been loaded by the time the graph is evaluated (when the file path is set, after a file read,
+  // or after a duplicate), so this only takes an immutable snapshot of it for the computes to read from. Nothing in here
+  // may create or modify nodes.
+  MStatus status;
+  const bool stageDataDirty = evaluationNode.dirtyPlugExists(outStageData(), &status) && status;
+
+  auto snapshot = std::make_shared<EvaluationSnapshot>();
+  snapshot->stage = m_stage;
+  snapshot->path = m_path;
+  {
+    std::lock_guard<std::mutex> guard(m_evaluationMutex);
+    m_evaluationSnapshot = snapshot;
+  }
+
+  if(stageDataDirty)
+  {
+    UsdMayaProxyStageSetNotice(*this).Send();
+  }
+#endif
   return MStatus::kSuccess;
 }
 
+#if MAYA_API_VERSION >= 201800
+//----------------------------------------------------------------------------------------------------------------------
+MStatus ProxyShape::postEvaluation(const MDGContext& context, const MEvaluationNode& evaluationNode, PostEvaluationType evalType)
+{
+  {
+    std::lock_guard<std::mutex> guard(m_evaluationMutex);
+    m_evaluationSnapshot.reset();
+  }
+  return MayaUsdProxyShapeBase::postEvaluation(context, evaluationNode, evalType);
+}
+#endif
+
+//----------------------------------------------------------------------------------------------------------------------
+std::shared_ptr<const ProxyShape::EvaluationSnapshot> ProxyShape::evaluationSnapshot() const
+{
+  std::lock_guard<std::mutex> guard(m_evaluationMutex);
+  return m_evaluationSnapshot;
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 bool ProxyShape::getRenderAttris(UsdImagingGLRenderParams& attribs, const MHWRender::MFrameContext& drawRequest, const MDagPath& objPath)
 {
@@ -484,7 +550,8 @@ bool ProxyShape::getRenderAttris(UsdImagingGLRenderParams& attribs, const MHWRen
 ProxyShape::ProxyShape()
   : MayaUsdProxyShapeBase(), AL::maya::utils::NodeHelper(), AL::event::NodeEvents(&AL::event::EventScheduler::getScheduler()),
     m_context(fileio::translators::TranslatorContext::create(this)),
-    m_translatorManufacture(context())
+    m_translatorManufacture(context()),
+    m_payloadQueue(this)
 {
   TF_DEBUG(ALUSDMAYA_EVALUATION).Msg("ProxyShape::ProxyShape\n");
   m_onSelectionChanged = MEventMessage::addEventCallback(MString("SelectionChanged"), onSelectionChanged, this);
@@ -548,6 +615,7 @@ MStatus ProxyShape::initialise()
     inheritBoolAttr("drawRenderPurpose", kCached | kKeyable | kWritable | kAffectsAppearance | kStorable);
     m_unloaded = addBoolAttr("unloaded", "ul", false, kCached | kKeyable | kWritable | kAffectsAppearance | kStorable);
     m_serializedTrCtx = addStringAttr("serializedTrCtx", "srtc", kReadable|kWritable|kStorable|kHidden);
+    m_serializedTrCtxData = addDataAttr("serializedTrCtxData", "srtd", MFnData::kIntArray, kReadable|kWritable|kStorable|kHidden);
 
     addFrame("USD Timing Information");
     inheritTimeAttr("time", kCached | kConnectable | kReadable | kWritable | kStorable | kAffectsAppearance);
@@ -564,6 +632,7 @@ MStatus ProxyShape::initialise()
     m_shininess = addFloatAttr("shininess", "shi", 5.0f, kReadable | kWritable | kConnectable | kStorable | kAffectsAppearance);
 
     m_serializedRefCounts = addStringAttr("serializedRefCounts", "strcs", kReadable | kWritable | kStorable | kHidden);
+    m_serializedRefCountsData = addDataAttr("serializedRefCountsData", "strcd", MFnData::kIntArray, kReadable | kWritable | kStorable | kHidden);
 
     m_version = addStringAttr(
         "version", "vrs", getVersion(),
@@ -834,9 +903,8 @@ void ProxyShape::onObjectsChanged(UsdNotice::ObjectsChanged const& notice, UsdSt
 
     // If redraw wasn't requested from Maya i.e. external stage modification
     // We need to request redraw on idle, so viewport is updated
-    if (!m_requestedRedraw)
+    if (!m_requestedRedraw.exchange(true))
     {
-      m_requestedRedraw = true;
       MGlobal::executeCommandOnIdle("refresh");
     }
   }
@@ -901,9 +969,8 @@ void ProxyShape::onTransactionNotice(AL::usd::transaction::CloseNotice const &no
   TF_DEBUG(ALUSDMAYA_EVENTS).Msg("ProxyShape::onTransactionNotice - transaction closed - processing changes\n");
 
   processChangedObjects(notice.GetResyncedPaths(), notice.GetChangedInfoOnlyPaths());
-  if (!m_requestedRedraw)
+  if (!m_requestedRedraw.exchange(true))
   {
-    m_requestedRedraw = true;
     MGlobal::executeCommandOnIdle("refresh");
   }
 }
@@ -993,6 +1060,8 @@ void ProxyShape::processChangedObjects(const SdfPathVector& resyncedPaths, const
   // and repopulate those trees.
   if(m_compositionHasChanged)
   {
+    // the resync may load payloads and select prims for every switched prim
+    AL::event::EventBatch batch(*scheduler());
     m_compositionHasChanged = false;
     onPrimResync(m_changedPath, m_variantSwitchedPrims);
     m_variantSwitchedPrims.clear();
@@ -1066,6 +1135,9 @@ void ProxyShape::variantSelectionListener(SdfNotice::LayersDidChange const& noti
 
   const SdfLayerHandleVector stack = m_stage->GetLayerStack();
 
+  // a single edit can switch the variants of many prims, run the coalesced script callbacks once for all of them
+  AL::event::EventBatch batch(*scheduler());
+
 #if USD_VERSION_NUM > 1911
   TF_FOR_ALL(itr, notice.GetChangeListVec())
 #else
@@ -1085,7 +1157,7 @@ void ProxyShape::variantSelectionListener(SdfNotice::LayersDidChange const& noti
         if (it->first == SdfFieldKeys->VariantSelection ||
             it->first == SdfFieldKeys->Active)
         {
-          triggerEvent("PreVariantChangedCB");
+          triggerEvent("PreVariantChanged", path.GetText());
 
           TF_DEBUG(ALUSDMAYA_EVENTS).Msg("ProxyShape::variantSelectionListener oldPath=%s, oldIdentifier=%s, path=%s, layer=%s\n",
                                          entry.oldPath.GetText(),
@@ -1100,7 +1172,7 @@ void ProxyShape::variantSelectionListener(SdfNotice::LayersDidChange const& noti
           m_compositionHasChanged = true;
           onPrePrimChanged(path, m_variantSwitchedPrims);
 
-          triggerEvent("PostVariantChangedCB");
+          triggerEvent("PostVariantChanged", path.GetText());
         }
       }
     }
@@ -1114,6 +1186,9 @@ void ProxyShape::loadStage()
 
   triggerEvent("PreStageLoaded");
 
+  // any payloads still queued were requested against the stage that is about to be replaced
+  m_payloadQueue.cancelAll();
+
   AL_BEGIN_PROFILE_SECTION(LoadStage);
   MDataBlock dataBlock = forceCache();
 
@@ -1399,9 +1474,74 @@ MString ProxyShape::getMayaPathFromUsdPrim(const UsdPrim& usdPrim) const
 void ProxyShape::copyInternalData(MPxNode* srcNode)
 {
   // On duplication, the ProxyShape has a null stage, and m_filePathDirty is
-  // false, even if the file path attribute is set.  We must ensure the next
-  // call to computeOutStageData() calls loadStage().
+  // false, even if the file path attribute is set.  The stage is loaded once
+  // the duplicate (or the file read) has completed, rather than from within
+  // an evaluation of the new node.
   m_filePathDirty = true;
+  if (MFileIO::isReadingFile())
+  {
+    m_unloadedProxyShapes.push_back(MObjectHandle(thisMObject()));
+  }
+  else
+  {
+    // the duplicate command loads the stage as soon as it completes, but copies made any other way are only picked up
+    // when Maya next goes idle
+    m_duplicatedProxyShapes.push_back(MObjectHandle(thisMObject()));
+    if(!m_loadDuplicatedCallback)
+    {
+      m_loadDuplicatedCallback = MEventMessage::addEventCallback("idle", onIdleLoadDuplicated, nullptr);
+    }
+  }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void ProxyShape::onIdleLoadDuplicated(void*)
+{
+  loadDuplicatedProxyShapes();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void ProxyShape::clearDuplicatedProxyShapes()
+{
+  if(m_loadDuplicatedCallback)
+  {
+    MMessage::removeCallback(m_loadDuplicatedCallback);
+    m_loadDuplicatedCallback = 0;
+  }
+  m_duplicatedProxyShapes.clear();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void ProxyShape::loadDuplicatedProxyShapes()
+{
+  if(m_loadDuplicatedCallback)
+  {
+    MMessage::removeCallback(m_loadDuplicatedCallback);
+    m_loadDuplicatedCallback = 0;
+  }
+
+  std::vector<MObjectHandle> duplicated;
+  duplicated.swap(m_duplicatedProxyShapes);
+
+  MFnDependencyNode fn;
+  for(const MObjectHandle& handle : duplicated)
+  {
+    if(!(handle.isValid() && handle.isAlive()))
+    {
+      continue;
+    }
+    fn.setObject(handle.object());
+    if(fn.typeId() != kTypeId)
+    {
+      continue;
+    }
+    ProxyShape* proxy = (ProxyShape*)fn.userNode();
+    if(!proxy->m_stage && proxy->m_filePathDirty)
+    {
+      proxy->m_filePathDirty = false;
+      proxy->loadStage();
+    }
+  }
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -1415,15 +1555,26 @@ MStatus ProxyShape::computeOutStageData(const MPlug& plug, MDataBlock& dataBlock
     return MS::kFailure;
   }
 
-  // make sure a stage is loaded
-  if (!m_stage && m_filePathDirty)
+  // under the evaluation manager the stage has been loaded before the evaluation began, and the notice sent from
+  // preEvaluation
+  const std::shared_ptr<const EvaluationSnapshot> snapshot = evaluationSnapshot();
+  if(snapshot)
+  {
+    usdStageData->stage = snapshot->stage;
+    usdStageData->primPath = snapshot->path;
+  }
+  else
   {
-    m_filePathDirty = false;
-    loadStage();
+    // make sure a stage is loaded
+    if (!m_stage && m_filePathDirty)
+    {
+      m_filePathDirty = false;
+      loadStage();
+    }
+    // Set the output stage data params
+    usdStageData->stage = m_stage;
+    usdStageData->primPath = m_path;
   }
-  // Set the output stage data params
-  usdStageData->stage = m_stage;
-  usdStageData->primPath = m_path;
 
   // set the cached output value, and flush
   MStatus status = outputDataValue(dataBlock, outStageData(), usdStageData);
@@ -1432,7 +1583,10 @@ MStatus ProxyShape::computeOutStageData(const MPlug& plug, MDataBlock& dataBlock
     return MS::kFailure;
   }
 
-  UsdMayaProxyStageSetNotice(*this).Send();
+  if(!snapshot)
+  {
+    UsdMayaProxyStageSetNotice(*this).Send();
+  }
 
   return status;
 }
@@ -1654,17 +1808,25 @@ void ProxyShape::unloadMayaReferences()
 }
 
 
+namespace {
+// 'ALTR', followed by the layout version of the entries
+const uint32_t kTransformRefsMagic = 0x52544C41;
+const uint32_t kTransformRefsVersion = 1;
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 void ProxyShape::serialiseTransformRefs()
 {
   TF_DEBUG(ALUSDMAYA_EVALUATION).Msg("ProxyShape::serialiseTransformRefs\n");
   triggerEvent("PreSerialiseTransformRefs");
 
-  std::ostringstream oss;
-  for(auto iter : m_requiredPaths)
+  // each entry: node | path | required | selected | ref count
+  std::vector<std::pair<MDagPath, TransformReferenceMap::const_iterator>> entries;
+  entries.reserve(m_requiredPaths.size());
+  for(auto iter = m_requiredPaths.cbegin(), end = m_requiredPaths.cend(); iter != end; ++iter)
   {
     MStatus status;
-    MObjectHandle handle(iter.second.node());
+    MObjectHandle handle(iter->second.node());
 
     if(handle.isAlive() && handle.isValid())
     {
@@ -1673,14 +1835,34 @@ void ProxyShape::serialiseTransformRefs()
       {
         MDagPath path;
         fn.getPath(path);
-        oss << path.fullPathName() << " "
-            << iter.first.GetText() << " "
-            << uint32_t(iter.second.required()) << " "
-            << uint32_t(iter.second.selected()) << " "
-            << uint32_t(iter.second.refCount()) << ";";
+        entries.emplace_back(path, iter);
       }
     }
   }
+
+  BinaryArchiveWriter writer(kTransformRefsMagic, kTransformRefsVersion);
+  std::ostringstream oss;
+  writer.writeU32(uint32_t(entries.size()));
+  for(const auto& entry : entries)
+  {
+    writer.writeNode(entry.first.fullPathName());
+    writer.writePath(entry.second->first);
+    writer.writeU32(entry.second->second.required());
+    writer.writeU32(entry.second->second.selected());
+    writer.writeU32(entry.second->second.refCount());
+
+    oss << entry.first.fullPathName() << " "
+        << entry.second->first.GetText() << " "
+        << uint32_t(entry.second->second.required()) << " "
+        << uint32_t(entry.second->second.selected()) << " "
+        << uint32_t(entry.second->second.refCount()) << ";";
+  }
+
+  // the binary archive is read in preference to the text serialisation, which is still written so that builds that
+  // predate the archive can open the scene
+  MFnIntArrayData fnData;
+  MObject data = fnData.create(writer.data());
+  serializedRefCountsDataPlug().setValue(data);
   serializedRefCountsPlug().setString(oss.str().c_str());
 
   triggerEvent("PostSerialiseTransformRefs");
@@ -1689,54 +1871,155 @@ void ProxyShape::serialiseTransformRefs()
 //----------------------------------------------------------------------------------------------------------------------
 void ProxyShape::deserialiseTransformRefs()
 {
-  triggerEvent("PreDeserialiseTransformRefs");
+  deserialiseTransformRefs(std::vector<ProxyShape*>{ this });
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void ProxyShape::deserialiseTransformRefs(const std::vector<ProxyShape*>& proxies)
+{
+  // the plugs have to be read on the main thread, but parsing the archives does not touch Maya, so can run in parallel
+  std::vector<std::vector<int>> archives(proxies.size());
+  for(size_t i = 0, n = proxies.size(); i < n; ++i)
+  {
+    MObject data;
+    proxies[i]->serializedRefCountsDataPlug().getValue(data);
+    if(!data.isNull())
+    {
+      MIntArray ints = MFnIntArrayData(data).array();
+      archives[i].resize(ints.length());
+      if(ints.length())
+        ints.get(archives[i].data());
+    }
+  }
+
+  std::vector<std::unique_ptr<BinaryArchiveReader>> readers(proxies.size());
+  WorkParallelForN(proxies.size(), [&archives, &readers](size_t begin, size_t end)
+  {
+    for(size_t i = begin; i < end; ++i)
+    {
+      if(!archives[i].empty())
+        readers[i].reset(new BinaryArchiveReader(archives[i], kTransformRefsMagic));
+    }
+  });
+
+  std::vector<BinaryArchiveReader*> validReaders;
+  for(auto& reader : readers)
+  {
+    if(reader && reader->isValid() && reader->version() == kTransformRefsVersion)
+      validReaders.push_back(reader.get());
+  }
+  BinaryArchiveReader::resolveNodes(validReaders);
+
+  MFnIntArrayData fnData;
+  MObject emptyData = fnData.create();
+  for(size_t i = 0, n = proxies.size(); i < n; ++i)
+  {
+    ProxyShape* proxy = proxies[i];
+    proxy->triggerEvent("PreDeserialiseTransformRefs");
+    if(!readers[i] || !proxy->deserialiseTransformRefs(*readers[i]))
+    {
+      proxy->deserialiseTransformRefsText();
+    }
+    proxy->serializedRefCountsPlug().setString("");
+    proxy->serializedRefCountsDataPlug().setValue(emptyData);
+    proxy->triggerEvent("PostDeserialiseTransformRefs");
+  }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool ProxyShape::deserialiseTransformRefs(BinaryArchiveReader& reader)
+{
+  if(!reader.isValid() || reader.version() != kTransformRefsVersion)
+  {
+    return false;
+  }
+
+  struct Entry
+  {
+    MObject node;
+    SdfPath path;
+    uint32_t required;
+    uint32_t selected;
+    uint32_t refCounts;
+  };
+  std::vector<Entry> entries;
+  const uint32_t count = reader.readU32();
+  for(uint32_t i = 0; i < count && reader.isValid(); ++i)
+  {
+    Entry entry;
+    entry.node = reader.readNode();
+    entry.path = reader.readPath();
+    entry.required = reader.readU32();
+    entry.selected = reader.readU32();
+    entry.refCounts = reader.readU32();
+    entries.push_back(entry);
+  }
 
+  if(!reader.isValid())
+  {
+    TF_DEBUG(ALUSDMAYA_EVALUATION).Msg("ProxyShape::deserialiseTransformRefs ignored truncated or corrupt data\n");
+    return false;
+  }
+
+  for(const Entry& entry : entries)
+  {
+    if(entry.node.isNull())
+    {
+      continue;
+    }
+    MFnDependencyNode fn(entry.node);
+    Scope* transformNode = dynamic_cast<Scope*>(fn.userNode());
+    m_requiredPaths.emplace(entry.path, TransformReference(entry.node, transformNode, entry.required, entry.selected, entry.refCounts));
+    TF_DEBUG(ALUSDMAYA_EVALUATION).Msg("ProxyShape::deserialiseTransformRefs m_requiredPaths added TransformReference: %s\n", entry.path.GetText());
+  }
+  return true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void ProxyShape::deserialiseTransformRefsText()
+{
   MString str = serializedRefCountsPlug().asString();
   MStringArray strs;
   str.split(';', strs);
 
+  // resolve all of the nodes in one go, rather than building a selection list per entry
+  std::vector<MStringArray> entries;
+  std::vector<MString> nodeNames;
+  entries.reserve(strs.length());
+  nodeNames.reserve(strs.length());
   for(uint32_t i = 0, n = strs.length(); i < n; ++i)
   {
     if(strs[i].length())
     {
       MStringArray tstrs;
       strs[i].split(' ', tstrs);
-      MString nodeName = tstrs[0];
-
-      MSelectionList sl;
-      if(sl.add(nodeName))
+      if(tstrs.length() < 5)
       {
-        MObject node;
-        if(sl.getDependNode(0, node))
-        {
-          MFnDependencyNode fn(node);
-          Scope* transformNode = dynamic_cast<Scope*>(fn.userNode());
-          if(transformNode)
-          {
-            const uint32_t required = tstrs[2].asUnsigned();
-            const uint32_t selected = tstrs[3].asUnsigned();
-            const uint32_t refCounts = tstrs[4].asUnsigned();
-            SdfPath path(tstrs[1].asChar());
-            m_requiredPaths.emplace(path, TransformReference(node, transformNode, required, selected, refCounts));
-            TF_DEBUG(ALUSDMAYA_EVALUATION).Msg("ProxyShape::deserialiseTransformRefs m_requiredPaths added AL_usdmaya_Transform TransformReference: %s\n", path.GetText());
-          }
-          else
-          {
-            const uint32_t required = tstrs[2].asUnsigned();
-            const uint32_t selected = tstrs[3].asUnsigned();
-            const uint32_t refCounts = tstrs[4].asUnsigned();
-            SdfPath path(tstrs[1].asChar());
-            m_requiredPaths.emplace(path, TransformReference(node, nullptr, required, selected, refCounts));
-            TF_DEBUG(ALUSDMAYA_EVALUATION).Msg("ProxyShape::deserialiseTransformRefs m_requiredPaths added TransformReference: %s\n", path.GetText());
-          }
-        }
+        continue;
       }
+      nodeNames.push_back(tstrs[0]);
+      entries.push_back(tstrs);
     }
   }
+  std::vector<MObject> nodes = resolveNodeNames(nodeNames);
 
-  serializedRefCountsPlug().setString("");
-
-  triggerEvent("PostDeserialiseTransformRefs");
+  for(size_t i = 0, n = entries.size(); i < n; ++i)
+  {
+    const MObject& node = nodes[i];
+    if(node.isNull())
+    {
+      continue;
+    }
+    const MStringArray& tstrs = entries[i];
+    MFnDependencyNode fn(node);
+    Scope* transformNode = dynamic_cast<Scope*>(fn.userNode());
+    const uint32_t required = tstrs[2].asUnsigned();
+    const uint32_t selected = tstrs[3].asUnsigned();
+    const uint32_t refCounts = tstrs[4].asUnsigned();
+    SdfPath path(tstrs[1].asChar());
+    m_requiredPaths.emplace(path, TransformReference(node, transformNode, required, selected, refCounts));
+    TF_DEBUG(ALUSDMAYA_EVALUATION).Msg("ProxyShape::deserialiseTransformRefs m_requiredPaths added TransformReference: %s\n", path.GetText());
+  }
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -1813,6 +2096,8 @@ void ProxyShape::registerEvents()
   registerEvent("PostSelectionChanged", AL::event::kUSDMayaEventType);
   registerEvent("PreVariantChanged", AL::event::kUSDMayaEventType);
   registerEvent("PostVariantChanged", AL::event::kUSDMayaEventType);
+  registerEvent("PrePayloadLoaded", AL::event::kUSDMayaEventType);
+  registerEvent("PostPayloadLoaded", AL::event::kUSDMayaEventType);
   registerEvent("PreSerialiseContext", AL::event::kUSDMayaEventType, Global::postSave());
   registerEvent("PostSerialiseContext", AL::event::kUSDMayaEventType, Global::postSave());
   registerEvent("PreDeserialiseContext", AL::event::kUSDMayaEventType, Global::postRead());
@@ -1824,6 +2109,14 @@ void ProxyShape::registerEvents()
   registerEvent("EditTargetChanged", AL::event::kUSDMayaEventType);
   registerEvent("SelectionStarted", AL::event::kUSDMayaEventType);
   registerEvent("SelectionEnded", AL::event::kUSDMayaEventType);
+
+  // These are triggered in bursts (once per prim of a selection, variant switch or payload load), so their script
+  // callbacks are executed once per EventBatch. The Pre/Started events are left alone, since their callbacks are
+  // expected to run before the change is made.
+  setCoalesced("PostSelectionChanged", true);
+  setCoalesced("SelectionEnded", true);
+  setCoalesced("PostVariantChanged", true);
+  setCoalesced("PostPayloadLoaded", true);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -26,7 +26,9 @@
 #include "AL/usdmaya/fileio/translators/TranslatorBase.h"
 #include "AL/usdmaya/fileio/translators/TranslatorContext.h"
 #include "AL/usdmaya/nodes/proxy/LockManager.h"
+#include "AL/usdmaya/nodes/proxy/PayloadLoadQueue.h"
 #include "AL/usdmaya/nodes/proxy/PrimFilter.h"
+#include "AL/usdmaya/nodes/proxy/TransformBatch.h"
 #include "AL/usdmaya/SelectabilityDB.h"
 
 #include "AL/usd/transaction/Notice.h"
@@ -50,6 +52,10 @@
 
 #include <mayaUsd/nodes/proxyShapeBase.h>
 
+#include <atomic>
+#include <memory>
+#include <mutex>
+
 #if defined(WANT_UFE_BUILD)
 #include "ufe/ufe.h"
 
@@ -77,6 +83,9 @@ PXR_NAMESPACE_CLOSE_SCOPE;
 
 namespace AL {
 namespace usdmaya {
+
+class BinaryArchiveReader;
+
 namespace nodes {
 
 class Engine;
@@ -303,9 +312,13 @@ public:
   /// name of serialized session layer (on the LayerManager)
   AL_DECL_ATTRIBUTE(sessionLayerName);
 
-  /// serialised translator context
+  /// serialised translator context (text format, only read for scenes saved before serializedTrCtxData existed, but
+  /// still written so that older builds can open newer scenes)
   AL_DECL_ATTRIBUTE(serializedTrCtx);
 
+  /// serialised translator context, as a binary archive
+  AL_DECL_ATTRIBUTE(serializedTrCtxData);
+
   /// Open the stage unloaded.
   AL_DECL_ATTRIBUTE(unloaded);
 
@@ -324,9 +337,13 @@ public:
   /// material shininess
   AL_DECL_ATTRIBUTE(shininess);
 
-  /// Serialised reference counts to rebuild the transform reference information
+  /// Serialised reference counts to rebuild the transform reference information (text format, only read for scenes
+  /// saved before serializedRefCountsData existed, but still written so that older builds can open newer scenes)
   AL_DECL_ATTRIBUTE(serializedRefCounts);
 
+  /// Serialised reference counts to rebuild the transform reference information, as a binary archive
+  AL_DECL_ATTRIBUTE(serializedRefCountsData);
+
   /// The path list joined by ",", that will be used as a mask when doing UsdStage::OpenMask()
   AL_DECL_ATTRIBUTE(populationMaskIncludePaths);
 
@@ -623,6 +640,17 @@ public:
   inline fileio::translators::TranslatorContextPtr& context()
     { return m_context; }
 
+  /// \brief  returns the batch of Transform node matrices driven by this shape, which are updated to a new time
+  ///         together in a single parallel pass.
+  /// \return the transform batch
+  inline proxy::TransformBatch& transformBatch()
+    { return m_transformBatch; }
+
+  /// \brief  returns the queue of payload loads and unloads that are processed asynchronously on this shape
+  /// \return the payload load queue
+  inline proxy::PayloadLoadQueue& payloadQueue()
+    { return m_payloadQueue; }
+
   //--------------------------------------------------------------------------------------------------------------------
   /// \name   ProxyShape selection
   //--------------------------------------------------------------------------------------------------------------------
@@ -692,6 +720,13 @@ public:
   AL_USDMAYA_PUBLIC
   void deserialiseTransformRefs();
 
+  /// \brief  deserialise the state of the transform ref counts of several proxy shapes after a file has been opened.
+  ///         The archives of all of the proxy shapes are parsed in parallel, and the transform nodes they refer to are
+  ///         resolved through a single selection list.
+  /// \param  proxies the proxy shapes to deserialise
+  AL_USDMAYA_PUBLIC
+  static void deserialiseTransformRefs(const std::vector<ProxyShape*>& proxies);
+
   /// \brief Finds the corresponding translator for each decendant prim that has a corresponding Translator 
   ///        and calls preTearDown.
   /// \param[in] path of the point in the hierarchy that is potentially undergoing structural changes
@@ -731,6 +766,17 @@ public:
     return m_unloadedProxyShapes;
   }
 
+  /// \brief  loads the stages of the proxy shapes that have been duplicated since the last call. This is called once
+  ///         the duplicate command has completed, or when Maya next goes idle for copies made without the duplicate
+  ///         command (e.g. MFnDagNode::duplicate), so that the stage is never loaded from within an evaluation.
+  AL_USDMAYA_PUBLIC
+  static void loadDuplicatedProxyShapes();
+
+  /// \brief  forgets any duplicated proxy shapes still waiting to be loaded, and removes the idle callback that would
+  ///         have loaded them. Called when the plugin is unloaded.
+  AL_USDMAYA_PUBLIC
+  static void clearDuplicatedProxyShapes();
+
   /// \brief This function starts the prim changed process within the proxyshape
   /// \param[in] changePath is point at which the scene is going to be modified.
   inline void primChangedAtPath(const SdfPath& changePath)
@@ -776,9 +822,16 @@ public:
   AL_USDMAYA_PUBLIC
   void loadStage();
 
+  /// \brief  updates the locked state of the translate, rotate, and scale plugs on every transform node
   AL_USDMAYA_PUBLIC
   void constructLockPrims();
 
+  /// \brief  updates the locked state of the transform plugs only for the transform nodes at, or beneath, the
+  ///         specified paths. Used after a change notice, since a lock change can only affect the prim's own subtree.
+  /// \param  rootPaths the paths of the prims whose lock state may have changed
+  AL_USDMAYA_PUBLIC
+  void constructLockPrims(const SdfPathVector& rootPaths);
+
   /// \brief Translates prims at the specified paths, the operation conducted by the translator depends on
   ///        which list you populate.
   /// \param importPaths paths you wish to import
@@ -940,9 +993,18 @@ private:
   /// stage. As a result, it's corresponding transform ref can fail to load.
   void cleanupTransformRefs();
 
+  /// read the transform references from the binary archive, returns false if the archive is not valid
+  bool deserialiseTransformRefs(BinaryArchiveReader& reader);
+
+  /// read the transform references from the text format of older scenes
+  void deserialiseTransformRefsText();
+
   /// insert a new path into the requiredPaths map
   void makeTransformReference(const SdfPath& path, const MObject& node, TransformReason reason);
 
+  /// update the locked state of the plugs on the transform node of a single transform reference
+  void updateLockPrim(const TransformReference& ref);
+
   /// selection can cause multiple transform chains to be removed. To ensure the ref counts are correctly correlated,
   /// we need to make sure we can remove
   void prepSelect();
@@ -957,12 +1019,11 @@ private:
   bool getInternalValue(const MPlug& plug, MDataHandle& dataHandle) override;
   MStatus setDependentsDirty(const MPlug& plugBeingDirtied, MPlugArray& plugs) override;
   bool isBounded() const override;
-  #if MAYA_API_VERSION < 201700
-  MPxNode::SchedulingType schedulingType() const override { return kSerialize; }
-  #else
-  MPxNode::SchedulingType schedulingType() const override { return kSerial; }
-  #endif
+  MPxNode::SchedulingType schedulingType() const override { return kParallel; }
   MStatus preEvaluation(const MDGContext & context, const MEvaluationNode& evaluationNode) override;
+  #if MAYA_API_VERSION >= 201800
+  MStatus postEvaluation(const MDGContext& context, const MEvaluationNode& evaluationNode, PostEvaluationType evalType) override;
+  #endif
   void CacheEmptyBoundingBox(MBoundingBox&) override;
   UsdTimeCode GetOutputTime(MDataBlock) const override;
   void copyInternalData(MPxNode* srcNode) override;
@@ -1050,6 +1111,9 @@ private:
   SdfPathVector m_pathsOrdered;
   AL_USDMAYA_PUBLIC
   static std::vector<MObjectHandle> m_unloadedProxyShapes;
+  static std::vector<MObjectHandle> m_duplicatedProxyShapes;
+  static MCallbackId m_loadDuplicatedCallback;
+  static void onIdleLoadDuplicated(void*);
 
   AL::usdmaya::SelectabilityDB m_selectabilityDB;
   SelectionList m_selectionList;
@@ -1066,6 +1130,7 @@ private:
   SdfPathVector m_excludedGeometry;
   SdfPathVector m_excludedTaggedGeometry;
   proxy::LockManager m_lockManager;
+  proxy::TransformBatch m_transformBatch;
   static MObject m_transformTranslate;
   static MObject m_transformRotate;
   static MObject m_transformScale;
@@ -1075,6 +1140,7 @@ private:
   SdfPath m_path;
   fileio::translators::TranslatorContextPtr m_context;
   fileio::translators::TranslatorManufacture m_translatorManufacture;
+  proxy::PayloadLoadQueue m_payloadQueue;
   SdfPath m_changedPath;
   SdfPathVector m_variantSwitchedPrims;
   SdfLayerHandle m_prevEditTarget;
@@ -1085,7 +1151,18 @@ private:
   bool m_pleaseIgnoreSelection = false;
   bool m_hasChangedSelection = false;
   bool m_filePathDirty = false;
-  bool m_requestedRedraw = false;
+  std::atomic<bool> m_requestedRedraw{false};
+
+  /// the stage and prim path that computes see while the parallel evaluation manager is running. This is taken on the
+  /// main thread in preEvaluation, and released in postEvaluation.
+  struct EvaluationSnapshot
+  {
+    UsdStageRefPtr stage;
+    SdfPath path;
+  };
+  std::shared_ptr<const EvaluationSnapshot> evaluationSnapshot() const;
+  std::shared_ptr<const EvaluationSnapshot> m_evaluationSnapshot;
+  mutable std::mutex m_evaluationMutex;
 };
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -71,6 +71,9 @@ void ProxyShape::onSelectionChanged(void* ptr)
     if(proxy->selectedPaths().empty())
       return;
 
+    // the commands below may select and deselect in two steps, run the coalesced script callbacks once for both
+    AL::event::EventBatch batch(*proxy->scheduler());
+
     auto stage = proxy->getUsdStage();
 
     MSelectionList sl;
@@ -157,6 +160,9 @@ void ProxyShape::onSelectionChanged(void* ptr)
     if(proxy->selectedPaths().empty())
       return;
 
+    // the commands below may select and deselect in two steps, run the coalesced script callbacks once for both
+    AL::event::EventBatch batch(*proxy->scheduler());
+
     MSelectionList sl;
     MGlobal::getActiveSelectionList(sl, false);
 
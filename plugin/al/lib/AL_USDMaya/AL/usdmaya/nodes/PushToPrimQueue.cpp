@@ -0,0 +1,168 @@
+//
+// Copyright 2017 Animal Logic
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "AL/usdmaya/DebugCodes.h"
+#include "AL/usdmaya/nodes/PushToPrimQueue.h"
+#include "AL/usdmaya/nodes/TransformationMatrix.h"
+
+#include "pxr/usd/sdf/changeBlock.h"
+
+#include "maya/MDGMessage.h"
+#include "maya/MEventMessage.h"
+#include "maya/MGlobal.h"
+
+#include <algorithm>
+#include <mutex>
+#include <vector>
+
+namespace AL {
+namespace usdmaya {
+namespace nodes {
+
+namespace {
+std::mutex g_queueMutex;
+std::vector<TransformationMatrix*> g_queue;
+bool g_flushScheduled = false;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+MCallbackId PushToPrimQueue::m_dragRelease = 0;
+MCallbackId PushToPrimQueue::m_timeChange = 0;
+
+//----------------------------------------------------------------------------------------------------------------------
+bool PushToPrimQueue::deferred()
+{
+  return MGlobal::optionVarIntValue("AL_usdmaya_deferPushToPrim") != 0;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void PushToPrimQueue::enqueue(TransformationMatrix* matrix)
+{
+  bool scheduleFlush = false;
+  {
+    std::lock_guard<std::mutex> guard(g_queueMutex);
+    g_queue.push_back(matrix);
+    scheduleFlush = !g_flushScheduled;
+    g_flushScheduled = true;
+  }
+  if(scheduleFlush)
+  {
+    MGlobal::executeCommandOnIdle("AL_usdmaya_ProxyShapeFlushPushToPrim", false);
+  }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void PushToPrimQueue::remove(TransformationMatrix* matrix)
+{
+  std::lock_guard<std::mutex> guard(g_queueMutex);
+  auto it = std::find(g_queue.begin(), g_queue.end(), matrix);
+  if(it != g_queue.end())
+  {
+    g_queue.erase(it);
+  }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void PushToPrimQueue::flush()
+{
+  flush(UsdStageRefPtr());
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void PushToPrimQueue::flush(const UsdStageRefPtr& stage)
+{
+  // take the matrices out of the queue first, so that removing them as they are written back is cheap
+  std::vector<TransformationMatrix*> pending;
+  {
+    std::lock_guard<std::mutex> guard(g_queueMutex);
+    if(stage)
+    {
+      auto it = std::stable_partition(g_queue.begin(), g_queue.end(), [&stage](TransformationMatrix* matrix)
+        { return matrix->prim().GetStage() != stage; });
+      pending.assign(it, g_queue.end());
+      g_queue.erase(it, g_queue.end());
+    }
+    else
+    {
+      pending.swap(g_queue);
+    }
+    g_flushScheduled = !g_queue.empty();
+  }
+
+  if(pending.empty())
+    return;
+
+  TF_DEBUG(ALUSDMAYA_EVALUATION).Msg("PushToPrimQueue::flush %zu transforms\n", pending.size());
+  SdfChangeBlock changeBlock;
+  for(TransformationMatrix* matrix : pending)
+  {
+    matrix->pushPendingToPrim();
+  }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+size_t PushToPrimQueue::size()
+{
+  std::lock_guard<std::mutex> guard(g_queueMutex);
+  return g_queue.size();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void PushToPrimQueue::onFlush(void*)
+{
+  flush();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void PushToPrimQueue::onTimeChanged(MTime&, void*)
+{
+  // the pending values were set at the previous time, so they must be written before the transforms re-evaluate
+  flush();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void PushToPrimQueue::addCallbacks()
+{
+  if(!m_dragRelease)
+  {
+    m_dragRelease = MEventMessage::addEventCallback("DragRelease", onFlush);
+  }
+  if(!m_timeChange)
+  {
+    m_timeChange = MDGMessage::addTimeChangeCallback(onTimeChanged);
+  }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void PushToPrimQueue::removeCallbacks()
+{
+  flush();
+  if(m_dragRelease)
+  {
+    MMessage::removeCallback(m_dragRelease);
+    m_dragRelease = 0;
+  }
+  if(m_timeChange)
+  {
+    MMessage::removeCallback(m_timeChange);
+    m_timeChange = 0;
+  }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+} // nodes
+} // usdmaya
+} // AL
+//----------------------------------------------------------------------------------------------------------------------
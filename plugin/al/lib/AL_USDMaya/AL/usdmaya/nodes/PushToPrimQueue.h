@@ -0,0 +1,94 @@
+//
+// Copyright 2017 Animal Logic
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#pragma once
+
+#include "AL/usdmaya/Api.h"
+
+#include "pxr/usd/usd/stage.h"
+
+#include "maya/MMessage.h"
+#include "maya/MTime.h"
+
+PXR_NAMESPACE_USING_DIRECTIVE
+
+namespace AL {
+namespace usdmaya {
+namespace nodes {
+
+class TransformationMatrix;
+
+//----------------------------------------------------------------------------------------------------------------------
+/// \brief  When the "AL_usdmaya_deferPushToPrim" optionVar is enabled, the edits made to AL_usdmaya_Transform nodes
+///         with pushToPrim enabled are not written back to USD immediately. Instead the modified matrices are gathered
+///         here, and all of them are written back together inside a single SdfChangeBlock when Maya next goes idle,
+///         when a manipulator drag is released, when the time changes, or prior to a file save/export. This means a
+///         drag of many transforms triggers one round of change notices per flush, rather than one per transform.
+///
+///         Scripts that need to read the modified values from the stage straight after setting them can force the
+///         write back with the AL_usdmaya_ProxyShapeFlushPushToPrim command (or by calling flush directly).
+/// \ingroup nodes
+//----------------------------------------------------------------------------------------------------------------------
+class PushToPrimQueue
+{
+public:
+
+  /// \brief  returns true if the write back of transform edits should be deferred until the next flush
+  AL_USDMAYA_PUBLIC
+  static bool deferred();
+
+  /// \brief  adds a matrix with pending edits to the queue, and schedules a flush on idle if needed.
+  /// \param  matrix the matrix that has pending edits
+  AL_USDMAYA_PUBLIC
+  static void enqueue(TransformationMatrix* matrix);
+
+  /// \brief  removes a matrix from the queue without writing its pending edits
+  /// \param  matrix the matrix to remove
+  AL_USDMAYA_PUBLIC
+  static void remove(TransformationMatrix* matrix);
+
+  /// \brief  writes the pending edits of every queued matrix back to USD within a single change block
+  AL_USDMAYA_PUBLIC
+  static void flush();
+
+  /// \brief  writes the pending edits of the queued matrices whose prims are on the specified stage
+  /// \param  stage the stage to flush the edits for
+  AL_USDMAYA_PUBLIC
+  static void flush(const UsdStageRefPtr& stage);
+
+  /// \brief  returns the number of matrices that currently have pending edits
+  AL_USDMAYA_PUBLIC
+  static size_t size();
+
+  /// \brief  registers the maya callbacks that flush the queue (manipulator release, and time change)
+  AL_USDMAYA_PUBLIC
+  static void addCallbacks();
+
+  /// \brief  removes the maya callbacks that flush the queue
+  AL_USDMAYA_PUBLIC
+  static void removeCallbacks();
+
+private:
+  static void onFlush(void*);
+  static void onTimeChanged(MTime& time, void*);
+  static MCallbackId m_dragRelease;
+  static MCallbackId m_timeChange;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+} // nodes
+} // usdmaya
+} // AL
+//----------------------------------------------------------------------------------------------------------------------
@@ -26,21 +26,23 @@
 #include "maya/MGlobal.h"
 #include "maya/MTime.h"
 
+#include <thread>
+
 namespace {
-  // Simple RAII class to ensure boolean gets set to false when done.
-  struct TempBoolLock
+  // Simple RAII class that records which thread is updating the transform, and clears it again when done.
+  struct TempThreadLock
   {
-    TempBoolLock(bool& theVal) : theRef(theVal)
+    TempThreadLock(std::atomic<std::thread::id>& theVal) : theRef(theVal)
     {
-      theRef = true;
+      theRef = std::this_thread::get_id();
     }
 
-    ~TempBoolLock()
+    ~TempThreadLock()
     {
-      theRef = false;
+      theRef = std::thread::id();
     }
 
-    bool& theRef;
+    std::atomic<std::thread::id>& theRef;
   };
 }
 
@@ -77,6 +79,27 @@ Transform::Transform()
 //----------------------------------------------------------------------------------------------------------------------
 Transform::~Transform()
 {
+  if(proxy::TransformBatch* batch = transformBatch())
+  {
+    batch->remove(getTransMatrix());
+  }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+proxy::TransformBatch* Transform::transformBatch() const
+{
+  // A deleted proxy shape stays alive (but not valid) while its deletion can be undone, and it keeps our matrix in its
+  // batch until then, so only check that it has not been destroyed.
+  if(proxyShapeHandle.isAlive())
+  {
+    MFnDependencyNode fn(proxyShapeHandle.object());
+    ProxyShape* proxy = static_cast<ProxyShape*>(fn.userNode());
+    if(proxy)
+    {
+      return &proxy->transformBatch();
+    }
+  }
+  return nullptr;
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -233,12 +256,13 @@ void Transform::updateTransform(MDataBlock& dataBlock)
 
   // It's possible that the calls to inputTimeValue below will ALSO trigger a call to
   // updateTransform; since there's no need to run this twice, we check for this and
-  // abort if we're already in the middle of running.
-  // Note that we don't bother using, say, std::atomic_flag, because multithreaded
-  // collisions here seem unlikely, and the worst case is just that this function runs twice.
-  if (updateTransformInProgress) return;
+  // abort if this thread is already in the middle of running. Under the parallel evaluation
+  // manager a DG pull from another thread may also land here, in which case it waits for
+  // the running update to finish rather than racing it on the transformation matrix.
+  if (m_updatingThread == std::this_thread::get_id()) return;
 
-  TempBoolLock updateTransformLock(updateTransformInProgress);
+  std::lock_guard<std::mutex> updateGuard(m_updateMutex);
+  TempThreadLock updateTransformLock(m_updatingThread);
 
   // compute updated time value
   MTime theTime = (inputTimeValue(dataBlock, m_time) - inputTimeValue(dataBlock, m_timeOffset)) * inputDoubleValue(dataBlock, m_timeScalar);
@@ -246,9 +270,18 @@ void Transform::updateTransform(MDataBlock& dataBlock)
 
   UsdTimeCode usdTime(theTime.as(MTime::uiUnit()));
 
-  // update the transformation matrix to the values at the specified time
+  // update the transformation matrix to the values at the specified time. If we are evaluated at the proxy time, the
+  // proxy shape batch updates us along with every other transform evaluated at that time.
   TransformationMatrix* m = getTransMatrix();
-  m->updateToTime(usdTime);
+  if(proxy::TransformBatch* batch = transformBatch())
+  {
+    const bool batched = inputTimeValue(dataBlock, m_timeOffset) == MTime() && inputDoubleValue(dataBlock, m_timeScalar) == 1.0;
+    batch->updateToTime(m, usdTime, batched);
+  }
+  else
+  {
+    m->updateToTime(usdTime);
+  }
 
   // if translation animation is present, update the translate attribute (or just flag it as clean if no animation exists)
   if(m->hasAnimatedTranslation())
@@ -334,7 +367,15 @@ MStatus Transform::connectionMade(const MPlug& plug, const MPlug& otherPlug, boo
     MFnDependencyNode otherNode(otherPlug.node());
     if (otherNode.typeId() == ProxyShape::kTypeId)
     {
+      if(proxy::TransformBatch* batch = transformBatch())
+      {
+        batch->remove(getTransMatrix());
+      }
       proxyShapeHandle = otherPlug.node();
+      if(proxy::TransformBatch* batch = transformBatch())
+      {
+        batch->insert(getTransMatrix());
+      }
     }
   }
   return MPxTransform::connectionMade(plug, otherPlug, asSrc);
@@ -348,6 +389,10 @@ MStatus Transform::connectionBroken(const MPlug& plug, const MPlug& otherPlug, b
     MFnDependencyNode otherNode(otherPlug.node());
     if (otherNode.typeId() == ProxyShape::kTypeId)
     {
+      if(proxy::TransformBatch* batch = transformBatch())
+      {
+        batch->remove(getTransMatrix());
+      }
       proxyShapeHandle = MObject();
     }
   }
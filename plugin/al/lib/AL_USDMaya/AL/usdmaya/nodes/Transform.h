@@ -24,11 +24,16 @@
 #include "maya/MObjectHandle.h"
 #include "maya/MPxTransform.h"
 
+#include <atomic>
+#include <mutex>
+#include <thread>
+
 namespace AL {
 namespace usdmaya {
 namespace nodes {
 
 class TransformationMatrix;
+namespace proxy { class TransformBatch; }
 
 //----------------------------------------------------------------------------------------------------------------------
 /// \brief  The AL::usdmaya::nodes::Transform node is a custom transform node that allows you to manipulate a USD
@@ -154,7 +159,8 @@ private:
   //--------------------------------------------------------------------------------------------------------------------
   /// Data members
   //--------------------------------------------------------------------------------------------------------------------
-  bool updateTransformInProgress = false;
+  std::mutex m_updateMutex;
+  std::atomic<std::thread::id> m_updatingThread;
 
   //--------------------------------------------------------------------------------------------------------------------
   /// \name Input Attributes
@@ -223,6 +229,11 @@ private:
   /// \brief  access the outTime attribute handle
   /// \return the outTime attribute
 
+  /// \brief  returns the batch of the connected proxy shape, which updates our matrix along with all other transforms
+  ///         at that time.
+  /// \return the batch, or null if no proxy shape is connected, or the proxy shape has been destroyed
+  proxy::TransformBatch* transformBatch() const;
+
   MObjectHandle proxyShapeHandle;
 };
 
@@ -17,6 +17,7 @@
 #include "AL/usdmaya/TypeIDs.h"
 #include "AL/usdmaya/DebugCodes.h"
 #include "AL/usdmaya/nodes/ProxyShape.h"
+#include "AL/usdmaya/nodes/PushToPrimQueue.h"
 #include "AL/usdmaya/nodes/Transform.h"
 #include "AL/usdmaya/nodes/TransformationMatrix.h"
 #include "AL/usdmaya/utils/AttributeType.h"
@@ -117,9 +118,20 @@ TransformationMatrix::TransformationMatrix(const UsdPrim& prim)
   TF_DEBUG(ALUSDMAYA_TRANSFORM_MATRIX).Msg("TransformationMatrix::TransformationMatrix\n");
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+TransformationMatrix::~TransformationMatrix()
+{
+  if(m_pendingPushes)
+  {
+    PushToPrimQueue::remove(this);
+  }
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 void TransformationMatrix::setPrim(const UsdPrim& prim, Scope* transformNode)
 {
+  // any edits still waiting to be written belong to the previous prim
+  pushPendingToPrim();
   m_enableUsdWriteback = false;
   if(prim.IsValid())
   {
@@ -1354,7 +1366,7 @@ MStatus TransformationMatrix::translateTo(const MVector& vector, MSpace::Space s
     //
     if (!vector.isEquivalent(m_translationFromUsd))
     {
-      pushTranslateToPrim();
+      queuePushToPrim(kPendingTranslate);
     }
   }
   return status;
@@ -1406,7 +1418,7 @@ MStatus TransformationMatrix::scaleTo(const MVector& scale, MSpace::Space space)
     // Push new value to prim, but only if it's changing.
     if (!scale.isEquivalent(m_scaleFromUsd))
     {
-      pushScaleToPrim();
+      queuePushToPrim(kPendingScale);
     }
   }
   return status;
@@ -1456,7 +1468,7 @@ MStatus TransformationMatrix::shearTo(const MVector& shear, MSpace::Space space)
     // Push new value to prim, but only if it's changing.
     if (!shear.isEquivalent(m_shearFromUsd))
     {
-      pushShearToPrim();
+      queuePushToPrim(kPendingShear);
     }
   }
   return status;
@@ -1509,7 +1521,7 @@ MStatus TransformationMatrix::setScalePivot(const MPoint& sp, MSpace::Space spac
     // Push new value to prim, but only if it's changing.
     if (!sp.isEquivalent(m_scalePivotFromUsd))
     {
-      pushScalePivotToPrim();
+      queuePushToPrim(kPendingScalePivot);
     }
   }
   return status;
@@ -1553,7 +1565,7 @@ MStatus TransformationMatrix::setScalePivotTranslation(const MVector& sp, MSpace
     // Push new value to prim, but only if it's changing.
     if (!sp.isEquivalent(m_scalePivotTranslationFromUsd))
     {
-      pushScalePivotTranslateToPrim();
+      queuePushToPrim(kPendingScalePivotTranslate);
     }
   }
   return status;
@@ -1606,7 +1618,7 @@ MStatus TransformationMatrix::setRotatePivot(const MPoint& pivot, MSpace::Space
     // Push new value to prim, but only if it's changing.
     if (!pivot.isEquivalent(m_rotatePivotFromUsd))
     {
-      pushRotatePivotToPrim();
+      queuePushToPrim(kPendingRotatePivot);
     }
   }
   return status;
@@ -1650,7 +1662,7 @@ MStatus TransformationMatrix::setRotatePivotTranslation(const MVector &vector, M
     // Push new value to prim, but only if it's changing.
     if (!vector.isEquivalent(m_rotatePivotTranslationFromUsd))
     {
-      pushRotatePivotTranslateToPrim();
+      queuePushToPrim(kPendingRotatePivotTranslate);
     }
   }
   return status;
@@ -1733,7 +1745,7 @@ MStatus TransformationMatrix::rotateTo(const MQuaternion &q, MSpace::Space space
       // Push new value to prim, but only if it's changing.
       if (!MPxTransformationMatrix::rotationValue.isEquivalent(m_rotationFromUsd))
       {
-        pushRotateToPrim();
+        queuePushToPrim(kPendingRotate);
       }
     }
   }
@@ -1768,7 +1780,7 @@ MStatus TransformationMatrix::rotateTo(const MEulerRotation &e, MSpace::Space sp
       // Push new value to prim, but only if it's changing.
       if (!e.isEquivalent(m_rotationFromUsd))
       {
-        pushRotateToPrim();
+        queuePushToPrim(kPendingRotate);
       }
     }
   }
@@ -1821,7 +1833,7 @@ MStatus TransformationMatrix::setRotateOrientation(const MQuaternion &q, MSpace:
     }
     if(m_enableUsdWriteback)
     {
-      pushRotateAxisToPrim();
+      queuePushToPrim(kPendingRotateAxis);
     }
   }
   return status;
@@ -1848,7 +1860,7 @@ MStatus TransformationMatrix::setRotateOrientation(const MEulerRotation& euler,
     }
     if(m_enableUsdWriteback)
     {
-      pushRotateAxisToPrim();
+      queuePushToPrim(kPendingRotateAxis);
     }
   }
   return status;
@@ -2195,6 +2207,52 @@ void TransformationMatrix::pushTransformToPrim()
   }
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+void TransformationMatrix::queuePushToPrim(const uint32_t component)
+{
+  if(!PushToPrimQueue::deferred())
+  {
+    pushComponentsToPrim(component);
+    return;
+  }
+  TF_DEBUG(ALUSDMAYA_TRANSFORM_MATRIX).Msg("TransformationMatrix::queuePushToPrim %x\n", component);
+  if(!m_pendingPushes)
+  {
+    PushToPrimQueue::enqueue(this);
+  }
+  m_pendingPushes |= component;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void TransformationMatrix::pushPendingToPrim()
+{
+  const uint32_t pending = m_pendingPushes;
+  if(!pending)
+    return;
+  m_pendingPushes = 0;
+  PushToPrimQueue::remove(this);
+
+  if(pushToPrimAvailable())
+  {
+    pushComponentsToPrim(pending);
+  }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void TransformationMatrix::pushComponentsToPrim(const uint32_t components)
+{
+  TF_DEBUG(ALUSDMAYA_TRANSFORM_MATRIX).Msg("TransformationMatrix::pushComponentsToPrim %x\n", components);
+  if(components & kPendingTranslate) pushTranslateToPrim();
+  if(components & kPendingScale) pushScaleToPrim();
+  if(components & kPendingShear) pushShearToPrim();
+  if(components & kPendingScalePivot) pushScalePivotToPrim();
+  if(components & kPendingScalePivotTranslate) pushScalePivotTranslateToPrim();
+  if(components & kPendingRotatePivot) pushRotatePivotToPrim();
+  if(components & kPendingRotatePivotTranslate) pushRotatePivotTranslateToPrim();
+  if(components & kPendingRotate) pushRotateToPrim();
+  if(components & kPendingRotateAxis) pushRotateAxisToPrim();
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 void TransformationMatrix::pushToPrim()
 {
@@ -2203,6 +2261,13 @@ void TransformationMatrix::pushToPrim()
     return;
   TF_DEBUG(ALUSDMAYA_TRANSFORM_MATRIX).Msg("TransformationMatrix::pushToPrim\n");
 
+  // everything is written below, so there is no need to flush any queued edits later on
+  if(m_pendingPushes)
+  {
+    m_pendingPushes = 0;
+    PushToPrimQueue::remove(this);
+  }
+
   GfMatrix4d oldMatrix;
   bool oldResetsStack;
   m_xform.GetLocalTransformation(&oldMatrix, &oldResetsStack, getTimeCode());
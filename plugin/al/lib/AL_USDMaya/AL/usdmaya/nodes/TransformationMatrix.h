@@ -151,6 +151,25 @@ class TransformationMatrix
   };
   uint32_t m_flags = kReadAnimatedValues;
 
+  // the components that have been modified in maya, but which have not yet been written back to the prim
+  enum PendingPush
+  {
+    kPendingTranslate = 1 << 0,
+    kPendingScale = 1 << 1,
+    kPendingShear = 1 << 2,
+    kPendingScalePivot = 1 << 3,
+    kPendingScalePivotTranslate = 1 << 4,
+    kPendingRotatePivot = 1 << 5,
+    kPendingRotatePivotTranslate = 1 << 6,
+    kPendingRotate = 1 << 7,
+    kPendingRotateAxis = 1 << 8
+  };
+  uint32_t m_pendingPushes = 0;
+
+  // writes the specified components back to the prim immediately, or queues them up if push to prim is deferred
+  void queuePushToPrim(uint32_t component);
+  void pushComponentsToPrim(uint32_t components);
+
   bool internal_readVector(MVector& result, const UsdGeomXformOp& op) { return readVector(result, op, getTimeCode()); }
   bool internal_readShear(MVector& result, const UsdGeomXformOp& op) { return readShear(result, op, getTimeCode()); }
   bool internal_readPoint(MPoint& result, const UsdGeomXformOp& op) { return readPoint(result, op, getTimeCode()); }
@@ -311,6 +330,14 @@ class TransformationMatrix
   /// \brief  pushes any modifications on the matrix back onto the UsdPrim
   void pushToPrim();
 
+  /// \brief  writes any modifications that have been queued up by the PushToPrimQueue back onto the UsdPrim
+  AL_USDMAYA_PUBLIC
+  void pushPendingToPrim();
+
+  /// \brief  returns true if there are modifications waiting to be written back onto the UsdPrim
+  inline bool hasPendingPushes() const
+    { return m_pendingPushes != 0; }
+
   void notifyProxyShapeOfRedraw();
 
   /// \brief  sets the SRT values from a matrix
@@ -370,6 +397,9 @@ public:
   /// \param  prim the USD prim that this matrix should represent
   TransformationMatrix(const UsdPrim& prim);
 
+  /// \brief  dtor
+  ~TransformationMatrix();
+
   /// \brief  set the prim that this transformation matrix will read/write to.
   /// \param  prim the prim
   /// \param  transformNode the owning transform node
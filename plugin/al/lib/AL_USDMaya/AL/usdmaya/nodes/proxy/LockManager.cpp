@@ -21,224 +21,95 @@ namespace nodes {
 namespace proxy {
 
 //----------------------------------------------------------------------------------------------------------------------
-void LockManager::removeEntries(const SdfPathVector& entries)
+void LockManager::setState(const SdfPath& path, LockState state)
 {
-  auto lockIt = m_lockedPrims.begin();
-  auto lockEnd = m_lockedPrims.end();
-
-  auto unlockIt = m_unlockedPrims.begin();
-  auto unlockEnd = m_unlockedPrims.end();
-
-  for(auto it = entries.begin(), end = entries.end(); lockIt != lockEnd && it != end; ++it)
+  if(state == kInherited)
   {
-    const SdfPath path = *it;
-    lockIt = std::lower_bound(lockIt, lockEnd, path);
-    if(lockIt != lockEnd && *lockIt == path)
+    // don't grow the table just to record the default state
+    auto it = m_lockStates.find(path);
+    if(it != m_lockStates.end() && it->second != kInherited)
     {
-      lockIt = m_lockedPrims.erase(lockIt);
+      it->second = kInherited;
+      --m_numEntries;
     }
+    return;
   }
 
-  for(auto it = entries.begin(), end = entries.end(); unlockIt != unlockEnd && it != end; ++it)
+  LockState& current = m_lockStates[path];
+  if(current == kInherited)
   {
-    const SdfPath path = *it;
-    unlockIt = std::lower_bound(unlockIt, unlockEnd, path);
-    if(unlockIt != unlockEnd && *unlockIt == path)
-    {
-      unlockIt = m_unlockedPrims.erase(unlockIt);
-    }
+    ++m_numEntries;
   }
+  current = state;
 }
 
 //----------------------------------------------------------------------------------------------------------------------
-void LockManager::removeFromRootPath(const SdfPath& path)
+void LockManager::removeEntries(const SdfPathVector& entries)
 {
+  for(const SdfPath& path : entries)
   {
-    // find the start of the entries for this path
-    auto lb = std::lower_bound(m_lockedPrims.begin(), m_lockedPrims.end(), path);
-    auto ub = lb;
-
-    // keep walking forwards until we hit a new branch in the tree
-    while(ub != m_lockedPrims.end())
-    {
-      if(ub->HasPrefix(path))
-      {
-        ++ub;
-      }
-      else
-      {
-        break;
-      }
-    }
-
-    // if we find a valid range, erase the previous entries
-    if(lb != ub)
-    {
-      m_lockedPrims.erase(lb, ub);
-    }
+    setState(path, kInherited);
   }
+}
 
-  // remove all previous prims from m_lockInheritedPrims that are children of the current prim.
-  {
-    // find the start of the entries for this path
-    auto lb = std::lower_bound(m_unlockedPrims.begin(), m_unlockedPrims.end(), path);
-    auto ub = lb;
-
-    // keep walking forwards until we hit a new branch in the tree
-    while(ub != m_unlockedPrims.end())
-    {
-      if(ub->HasPrefix(path))
-      {
-        ++ub;
-      }
-      else
-      {
-        break;
-      }
-    }
+//----------------------------------------------------------------------------------------------------------------------
+void LockManager::removeFromRootPath(const SdfPath& path)
+{
+  auto it = m_lockStates.find(path);
+  if(it == m_lockStates.end())
+    return;
 
-    // if we find a valid range, erase the previous entries
-    if(lb != ub)
+  for(auto child = it, end = it.GetNextSubtree(); child != end; ++child)
+  {
+    if(child->second != kInherited)
     {
-      m_unlockedPrims.erase(lb, ub);
+      --m_numEntries;
     }
   }
+  m_lockStates.erase(it);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 void LockManager::setLocked(const SdfPath& path)
 {
-  auto lockIter = std::lower_bound(m_lockedPrims.begin(), m_lockedPrims.end(), path);
-  if(lockIter != m_lockedPrims.end())
-  {
-    // lock already in the locked array, so return
-    if(*lockIter == path)
-      return;
-  }
-  m_lockedPrims.insert(lockIter, path);
-
-  auto unlockIter = std::lower_bound(m_unlockedPrims.begin(), m_unlockedPrims.end(), path);
-  if(unlockIter != m_unlockedPrims.end())
-  {
-    if(*unlockIter == path)
-    {
-      m_unlockedPrims.erase(unlockIter);
-    }
-  }
+  setState(path, kLocked);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 void LockManager::setUnlocked(const SdfPath& path)
 {
-  auto unlockIter = std::lower_bound(m_unlockedPrims.begin(), m_unlockedPrims.end(), path);
-  if(unlockIter != m_unlockedPrims.end())
-  {
-    // lock already in the locked array, so return
-    if(*unlockIter == path)
-      return;
-  }
-  m_unlockedPrims.insert(unlockIter, path);
-
-  auto lockIter = std::lower_bound(m_lockedPrims.begin(), m_lockedPrims.end(), path);
-  if(lockIter != m_lockedPrims.end())
-  {
-    if(*lockIter == path)
-    {
-      m_lockedPrims.erase(lockIter);
-    }
-  }
+  setState(path, kUnlocked);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 void LockManager::setInherited(const SdfPath& path)
 {
-  if(!m_unlockedPrims.empty())
-  {
-    auto unlockIter = std::lower_bound(m_unlockedPrims.begin(), m_unlockedPrims.end(), path);
-    if(unlockIter != m_unlockedPrims.end())
-    {
-      // lock already in the locked array, so return
-      if(*unlockIter == path)
-      {
-        m_unlockedPrims.erase(unlockIter);
-      }
-    }
-  }
-  if(!m_lockedPrims.empty())
-  {
-    auto lockIter = std::lower_bound(m_lockedPrims.begin(), m_lockedPrims.end(), path);
-    if(lockIter != m_lockedPrims.end())
-    {
-      // lock already in the locked array, so return
-      if(*lockIter == path)
-      {
-        m_lockedPrims.erase(lockIter);
-      }
-    }
-  }
+  setState(path, kInherited);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
-bool LockManager::isLocked(const SdfPath& path) const
+LockManager::LockState LockManager::explicitState(const SdfPath& path) const
 {
-  if(m_lockedPrims.empty()) 
-    return false;
-
-  auto lockIter = std::lower_bound(m_lockedPrims.begin(), m_lockedPrims.end(), path);
-
-  // first check the edge case where this path is in the locked set
-  if(lockIter != m_lockedPrims.end() && *lockIter == path)
-  {
-    return true;
-  }
-
-  // now attempt to see if a parent of this path is in the locked set
-  bool hasLockedParent = false;
-  if(lockIter != m_lockedPrims.begin())
-  {
-    --lockIter;
-    {
-      if(path.HasPrefix(*lockIter))
-      {
-        hasLockedParent = true;
-      }
-    }
-  }
-
-  // now attempt to see if a parent of this path is in the unlocked set
-  bool hasUnlockedParent = false;
-  auto unlockIter = std::lower_bound(m_unlockedPrims.begin(), m_unlockedPrims.end(), path);
+  auto it = m_lockStates.find(path);
+  return it != m_lockStates.end() ? it->second : kInherited;
+}
 
-  // first check the edge case where this path is in the locked set
-  if(unlockIter != m_unlockedPrims.end() && *unlockIter == path)
-  {
+//----------------------------------------------------------------------------------------------------------------------
+bool LockManager::isLocked(const SdfPath& path) const
+{
+  if(!m_numEntries) 
     return false;
-  }
 
-  if(unlockIter != m_unlockedPrims.begin())
+  // walk up towards the root until we find the closest path with an explicit state. If no entry exists at all,
+  // the path is treated as unlocked.
+  for(SdfPath current = path; !current.IsEmpty(); current = current.GetParentPath())
   {
-    --unlockIter;
+    auto it = m_lockStates.find(current);
+    if(it != m_lockStates.end() && it->second != kInherited)
     {
-      if(path.HasPrefix(*unlockIter))
-      {
-        hasUnlockedParent = true;
-      }
+      return it->second == kLocked;
     }
   }
-
-  // if we have entries in both the locked and unlocked set..... 
-  if(hasLockedParent && hasUnlockedParent)
-  {
-    // if the locked path is longer than the unlocked path, the closest parent to path is locked.
-    return (lockIter->GetString().size() >= unlockIter->GetString().size());
-  }
-  else
-  if(hasLockedParent)
-  {
-    return true;
-  }
-
-  // either the parent is unlocked, or no entry exists at all (treat as unlocked).
   return false;
 }
 
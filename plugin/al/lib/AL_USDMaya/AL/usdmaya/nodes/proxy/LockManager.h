@@ -16,6 +16,7 @@
 #pragma once
 
 #include <pxr/usd/sdf/path.h>
+#include <pxr/usd/sdf/pathTable.h>
 
 #include "../../Api.h"
 
@@ -27,10 +28,21 @@ namespace nodes {
 namespace proxy {
 
 //----------------------------------------------------------------------------------------------------------------------
-/// \brief  A class that maintains a list of locked and unlocked prims.
+/// \brief  A class that maintains the lock state of the prims in a stage. Only the prims that explicitly set a locked
+///         or unlocked state are stored, keyed by path within a tree, so any prim without an entry inherits its state
+///         from its nearest ancestor that has one. Entries can be set and removed one at a time (or a whole subtree at
+///         once after a resync), and queries cost one lookup per level of the path being queried.
 //----------------------------------------------------------------------------------------------------------------------
 struct LockManager
 {
+  /// \brief  the lock state stored for a path
+  enum LockState : uint8_t
+  {
+    kInherited, ///< the path takes the lock state of its parent
+    kLocked, ///< the path (and any children that inherit their state) is locked
+    kUnlocked ///< the path (and any children that inherit their state) is unlocked
+  };
+
   /// \brief  removes the specified paths from the locked and unlocked sets
   /// \param  entries the array of entires to remove.
   AL_USDMAYA_PUBLIC
@@ -53,27 +65,6 @@ struct LockManager
   AL_USDMAYA_PUBLIC
   void setUnlocked(const SdfPath& path);
 
-  /// \brief  adds the specified path to the locked prims list. No checking is done by this method to see whether 
-  ///         the path is part of the locked or unlocked sets. The intention for this method is to quickly 
-  ///         build up changes in the set of lock prims, and having done that, later sort them by calling sort()
-  /// \param  path the path to insert into the locked set
-  inline void addLocked(const SdfPath& path)
-    { m_lockedPrims.emplace_back(path); }
-
-  /// \brief  adds the specified path to the unlocked prims list. No checking is done by this method to see whether 
-  ///         the path is part of the locked or unlocked sets. The intention for this method is to quickly 
-  ///         build up changes in the set of lock prims, and having done that, later sort them by calling sort()
-  /// \param  path the path to insert into the unlocked set
-  inline void addUnlocked(const SdfPath& path)
-    { m_unlockedPrims.emplace_back(path); }
-
-  /// \brief  sorts the two sets of locked and unlocked prims for fast lookup
-  inline void sort()
-    {
-      std::sort(m_lockedPrims.begin(), m_lockedPrims.end());
-      std::sort(m_unlockedPrims.begin(), m_unlockedPrims.end());
-    }
-
   /// \brief  Will remove the path from both the locked and unlocked sets. The lock status will now be inherited. 
   /// \param  path the path to set as inherited
   AL_USDMAYA_PUBLIC
@@ -85,9 +76,23 @@ struct LockManager
   AL_USDMAYA_PUBLIC
   bool isLocked(const SdfPath& path) const;
 
+  /// \brief  returns the state explicitly stored for the path, or kInherited if it has no entry
+  /// \param  path the path to query
+  /// \return the lock state stored for the path
+  AL_USDMAYA_PUBLIC
+  LockState explicitState(const SdfPath& path) const;
+
+  /// \brief  returns the number of paths that are explicitly locked or unlocked
+  inline size_t size() const
+    { return m_numEntries; }
+
 private:
-  SdfPathVector m_lockedPrims;
-  SdfPathVector m_unlockedPrims;
+  void setState(const SdfPath& path, LockState state);
+
+  // Inserting a path into the table also inserts its ancestors (with a kInherited state), which keeps each subtree
+  // together so that it can be erased in one go.
+  SdfPathTable<LockState> m_lockStates;
+  size_t m_numEntries = 0;
 };
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,412 @@
+//
+// Copyright 2017 Animal Logic
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "AL/usdmaya/DebugCodes.h"
+#include "AL/usdmaya/nodes/ProxyShape.h"
+#include "AL/usdmaya/nodes/proxy/PayloadLoadQueue.h"
+
+#include "pxr/usd/ar/resolverContextBinder.h"
+#include "pxr/usd/sdf/layerUtils.h"
+#include "pxr/usd/sdf/listOp.h"
+#include "pxr/usd/sdf/payload.h"
+#include "pxr/usd/sdf/primSpec.h"
+#include "pxr/usd/sdf/schema.h"
+
+#include "maya/MTimerMessage.h"
+
+#include <algorithm>
+#include <unordered_set>
+
+namespace AL {
+namespace usdmaya {
+namespace nodes {
+namespace proxy {
+
+namespace {
+// how often (in seconds) the main thread checks for payloads that are ready to be loaded into the stage
+const float kTimerPeriod = 0.1f;
+
+inline bool isOutstanding(const PayloadLoadQueue::State state)
+{
+  return state == PayloadLoadQueue::State::kQueued ||
+         state == PayloadLoadQueue::State::kFetching ||
+         state == PayloadLoadQueue::State::kFetched;
+}
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+PayloadLoadQueue::~PayloadLoadQueue()
+{
+  stopTimer();
+  cancelAll();
+  m_dispatcher.Wait();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void PayloadLoadQueue::enqueue(const UsdStageRefPtr& stage, const SdfPath& path, bool load, double priority)
+{
+  TF_DEBUG(ALUSDMAYA_EVALUATION).Msg("PayloadLoadQueue::enqueue %s %s\n", load ? "load" : "unload", path.GetText());
+
+  RequestPtr request = std::make_shared<Request>();
+  request->stage = stage;
+  request->path = path;
+  request->priority = priority;
+  request->load = load;
+  request->state = load ? State::kQueued : State::kFetched;
+
+  // gather the payload asset paths here, since the prim can only be safely inspected from the main thread
+  UsdPrim prim = stage ? stage->GetPrimAtPath(path) : UsdPrim();
+  if(load && prim)
+  {
+    request->context = stage->GetPathResolverContext();
+    for(const SdfPrimSpecHandle& spec : prim.GetPrimStack())
+    {
+      VtValue value = spec->GetField(SdfFieldKeys->Payload);
+      if(!value.IsHolding<SdfPayloadListOp>())
+        continue;
+
+      SdfPayloadVector payloads;
+      value.UncheckedGet<SdfPayloadListOp>().ApplyOperations(&payloads);
+      for(const SdfPayload& payload : payloads)
+      {
+        // internal payloads refer to the layers that are already open
+        if(!payload.GetAssetPath().empty())
+        {
+          request->assetPaths.push_back(SdfComputeAssetPathRelativeToLayer(spec->GetLayer(), payload.GetAssetPath()));
+        }
+      }
+    }
+  }
+
+  {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    const bool idle = std::none_of(m_requests.begin(), m_requests.end(),
+        [](const RequestPtr& r) { return isOutstanding(r->state); });
+    if(idle)
+    {
+      m_requests.clear();
+    }
+    else
+    {
+      for(const RequestPtr& existing : m_requests)
+      {
+        if(existing->path == path && isOutstanding(existing->state))
+        {
+          if(existing->state != State::kFetching)
+          {
+            existing->layers.clear();
+          }
+          existing->state = State::kCancelled;
+        }
+      }
+    }
+    request->order = m_order++;
+    m_requests.push_back(request);
+  }
+
+  dispatch();
+  startTimer();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool PayloadLoadQueue::cancel(const SdfPath& path)
+{
+  std::lock_guard<std::mutex> guard(m_mutex);
+  bool cancelled = false;
+  for(const RequestPtr& request : m_requests)
+  {
+    if(request->path == path && isOutstanding(request->state))
+    {
+      // a worker thread still owns the layers of a request that is being fetched, and releases them when it finishes
+      if(request->state != State::kFetching)
+      {
+        request->layers.clear();
+      }
+      request->state = State::kCancelled;
+      cancelled = true;
+    }
+  }
+  return cancelled;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void PayloadLoadQueue::cancelAll()
+{
+  std::lock_guard<std::mutex> guard(m_mutex);
+  for(const RequestPtr& request : m_requests)
+  {
+    if(isOutstanding(request->state))
+    {
+      if(request->state != State::kFetching)
+      {
+        request->layers.clear();
+      }
+      request->state = State::kCancelled;
+    }
+  }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void PayloadLoadQueue::dispatch()
+{
+  uint32_t numToStart = 0;
+  {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    const size_t numQueued = std::count_if(m_requests.begin(), m_requests.end(),
+        [](const RequestPtr& r) { return r->state == State::kQueued; });
+    while(m_numWorkers < m_maxConcurrent && numToStart < numQueued)
+    {
+      ++m_numWorkers;
+      ++numToStart;
+    }
+  }
+  for(uint32_t i = 0; i < numToStart; ++i)
+  {
+    m_dispatcher.Run([this]() { fetch(); });
+  }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void PayloadLoadQueue::fetch()
+{
+  for(;;)
+  {
+    RequestPtr request;
+    {
+      std::lock_guard<std::mutex> guard(m_mutex);
+      for(const RequestPtr& candidate : m_requests)
+      {
+        if(candidate->state == State::kQueued &&
+           (!request || candidate->priority < request->priority ||
+            (candidate->priority == request->priority && candidate->order < request->order)))
+        {
+          request = candidate;
+        }
+      }
+      if(!request)
+      {
+        --m_numWorkers;
+        return;
+      }
+      request->state = State::kFetching;
+    }
+
+    openLayers(*request);
+
+    std::lock_guard<std::mutex> guard(m_mutex);
+    if(request->state == State::kFetching)
+    {
+      request->state = State::kFetched;
+    }
+    else
+    {
+      request->layers.clear();
+    }
+  }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void PayloadLoadQueue::openLayers(Request& request)
+{
+  ArResolverContextBinder binder(request.context);
+  std::vector<std::string> pending(request.assetPaths.rbegin(), request.assetPaths.rend());
+  std::unordered_set<std::string> visited;
+  while(!pending.empty() && !isCancelled(request))
+  {
+    const std::string assetPath = pending.back();
+    pending.pop_back();
+    if(!visited.insert(assetPath).second)
+      continue;
+
+    SdfLayerRefPtr layer = SdfLayer::FindOrOpen(assetPath);
+    if(!layer)
+    {
+      TF_DEBUG(ALUSDMAYA_EVALUATION).Msg("PayloadLoadQueue::openLayers failed to open %s\n", assetPath.c_str());
+      continue;
+    }
+
+    const std::vector<std::string> subLayers = layer->GetSubLayerPaths();
+    for(auto it = subLayers.rbegin(); it != subLayers.rend(); ++it)
+    {
+      pending.push_back(SdfComputeAssetPathRelativeToLayer(layer, *it));
+    }
+    request.layers.push_back(layer);
+  }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool PayloadLoadQueue::isCancelled(const Request& request) const
+{
+  std::lock_guard<std::mutex> guard(m_mutex);
+  return request.state == State::kCancelled;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void PayloadLoadQueue::flush(bool wait)
+{
+  if(wait)
+  {
+    m_dispatcher.Wait();
+  }
+
+  std::vector<RequestPtr> ready;
+  {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    for(const RequestPtr& request : m_requests)
+    {
+      if(request->state == State::kFetched)
+      {
+        ready.push_back(request);
+      }
+    }
+  }
+  std::sort(ready.begin(), ready.end(), [](const RequestPtr& a, const RequestPtr& b)
+    { return a->priority < b->priority || (a->priority == b->priority && a->order < b->order); });
+
+  UsdStageRefPtr stage = m_proxy->usdStage();
+  // the script callbacks of PostPayloadLoaded are executed once, after all the payloads of this flush are loaded
+  AL::event::EventBatch batch(*m_proxy->scheduler());
+  for(const RequestPtr& request : ready)
+  {
+    {
+      std::lock_guard<std::mutex> guard(m_mutex);
+      // an earlier event callback may have cancelled this request
+      if(request->state != State::kFetched)
+        continue;
+
+      if(!stage || get_pointer(request->stage) != get_pointer(stage) || !stage->GetPrimAtPath(request->path))
+      {
+        request->layers.clear();
+        request->state = State::kFailed;
+        continue;
+      }
+    }
+
+    TF_DEBUG(ALUSDMAYA_EVALUATION).Msg("PayloadLoadQueue::flush %s %s\n",
+        request->load ? "loading" : "unloading", request->path.GetText());
+
+    m_currentPath = request->path;
+    const std::string pathText = request->path.GetString();
+    m_proxy->triggerEvent("PrePayloadLoaded", pathText.c_str());
+    if(request->load)
+    {
+      stage->Load(request->path);
+    }
+    else
+    {
+      stage->Unload(request->path);
+    }
+    m_proxy->triggerEvent("PostPayloadLoaded", pathText.c_str());
+    m_currentPath = SdfPath();
+
+    std::lock_guard<std::mutex> guard(m_mutex);
+    request->layers.clear();
+    request->state = State::kLoaded;
+  }
+
+  if(!numPending())
+  {
+    stopTimer();
+  }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+PayloadLoadQueue::State PayloadLoadQueue::state(const SdfPath& path) const
+{
+  std::lock_guard<std::mutex> guard(m_mutex);
+  for(auto it = m_requests.rbegin(); it != m_requests.rend(); ++it)
+  {
+    if((*it)->path == path)
+    {
+      return (*it)->state;
+    }
+  }
+  return State::kNone;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void PayloadLoadQueue::progress(size_t& completed, size_t& total) const
+{
+  std::lock_guard<std::mutex> guard(m_mutex);
+  total = m_requests.size();
+  completed = std::count_if(m_requests.begin(), m_requests.end(),
+      [](const RequestPtr& r) { return !isOutstanding(r->state); });
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+size_t PayloadLoadQueue::numPending() const
+{
+  std::lock_guard<std::mutex> guard(m_mutex);
+  return std::count_if(m_requests.begin(), m_requests.end(),
+      [](const RequestPtr& r) { return isOutstanding(r->state); });
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void PayloadLoadQueue::setMaxConcurrent(uint32_t maxConcurrent)
+{
+  {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    m_maxConcurrent = std::max(maxConcurrent, 1u);
+  }
+  dispatch();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+const char* PayloadLoadQueue::stateName(State state)
+{
+  switch(state)
+  {
+  case State::kQueued: return "queued";
+  case State::kFetching: return "fetching";
+  case State::kFetched: return "fetched";
+  case State::kLoaded: return "loaded";
+  case State::kCancelled: return "cancelled";
+  case State::kFailed: return "failed";
+  default: break;
+  }
+  return "none";
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void PayloadLoadQueue::startTimer()
+{
+  if(!m_timer)
+  {
+    m_timer = MTimerMessage::addTimerCallback(kTimerPeriod, onTimer, this);
+  }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void PayloadLoadQueue::stopTimer()
+{
+  if(m_timer)
+  {
+    MMessage::removeCallback(m_timer);
+    m_timer = 0;
+  }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void PayloadLoadQueue::onTimer(float, float, void* clientData)
+{
+  static_cast<PayloadLoadQueue*>(clientData)->flush(false);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+} // proxy
+} // nodes
+} // usdmaya
+} // AL
+//----------------------------------------------------------------------------------------------------------------------
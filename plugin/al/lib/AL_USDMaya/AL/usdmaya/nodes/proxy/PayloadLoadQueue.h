@@ -0,0 +1,175 @@
+//
+// Copyright 2017 Animal Logic
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#pragma once
+
+#include "../../Api.h"
+
+#include "pxr/base/work/dispatcher.h"
+#include "pxr/usd/ar/resolverContext.h"
+#include "pxr/usd/sdf/layer.h"
+#include "pxr/usd/sdf/path.h"
+#include "pxr/usd/usd/stage.h"
+
+#include "maya/MMessage.h"
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+PXR_NAMESPACE_USING_DIRECTIVE
+
+namespace AL {
+namespace usdmaya {
+namespace nodes {
+
+class ProxyShape;
+
+namespace proxy {
+
+//----------------------------------------------------------------------------------------------------------------------
+/// \brief  Queues payload loads and unloads on a proxy shape so that they can be processed without blocking Maya.
+///
+///         The expensive part of loading a payload is reading the layers it references from disk. When a load is
+///         queued, the asset paths of the payloads authored on the prim are gathered, and those layers (along with
+///         their sublayers) are opened on a pool of worker threads, highest priority first, with at most
+///         maxConcurrent() loads being read at any one time. The opened layers are held by the queue until the
+///         payload is loaded into the stage, which happens on the main thread from a timer callback (or from a call
+///         to flush). Since the layers are already open at that point, UsdStage::Load only needs to recompose.
+///
+///         Each payload that is loaded (or unloaded) into the stage is wrapped in the "PrePayloadLoaded" and
+///         "PostPayloadLoaded" events on the proxy shape. The prim path of the payload is passed to script callbacks
+///         as the event payload, and can be queried from C++ callbacks with currentPath().
+//----------------------------------------------------------------------------------------------------------------------
+class PayloadLoadQueue
+{
+public:
+
+  /// \brief  the state of a queued payload request
+  enum class State
+  {
+    kNone,      ///< the path is not in the queue
+    kQueued,    ///< waiting for a worker thread
+    kFetching,  ///< the payload layers are being opened on a worker thread
+    kFetched,   ///< the payload layers are open, and the payload is waiting to be loaded into the stage
+    kLoaded,    ///< the payload has been loaded (or unloaded) into the stage
+    kCancelled, ///< the request was cancelled before it was loaded into the stage
+    kFailed     ///< the prim could not be found when the payload was to be loaded into the stage
+  };
+
+  /// \brief  ctor
+  /// \param  proxy the proxy shape that owns this queue
+  PayloadLoadQueue(ProxyShape* proxy)
+    : m_proxy(proxy) {}
+
+  /// \brief  dtor. Cancels any outstanding requests and waits for the worker threads to finish.
+  AL_USDMAYA_PUBLIC
+  ~PayloadLoadQueue();
+
+  /// \brief  queues a payload load or unload for the specified prim. If the prim already has an outstanding request,
+  ///         that request is replaced.
+  /// \param  stage the stage that contains the prim
+  /// \param  path the path of the prim to load or unload
+  /// \param  load true to load the payload, false to unload it
+  /// \param  priority requests with a lower priority value are processed first (e.g. the distance to the camera)
+  AL_USDMAYA_PUBLIC
+  void enqueue(const UsdStageRefPtr& stage, const SdfPath& path, bool load, double priority = 0);
+
+  /// \brief  cancels the outstanding request for the specified prim
+  /// \param  path the path of the prim
+  /// \return true if the request was cancelled, false if there was no outstanding request for the path
+  AL_USDMAYA_PUBLIC
+  bool cancel(const SdfPath& path);
+
+  /// \brief  cancels all outstanding requests
+  AL_USDMAYA_PUBLIC
+  void cancelAll();
+
+  /// \brief  loads all of the requests that have been fetched into the stage. Must be called from the main thread.
+  /// \param  wait if true, this will block until all outstanding requests have been fetched and loaded.
+  AL_USDMAYA_PUBLIC
+  void flush(bool wait = false);
+
+  /// \brief  returns the state of the most recent request made for the specified path
+  AL_USDMAYA_PUBLIC
+  State state(const SdfPath& path) const;
+
+  /// \brief  returns the number of requests that have completed (loaded, cancelled, or failed), and the total number
+  ///         of requests made since the queue was last idle.
+  AL_USDMAYA_PUBLIC
+  void progress(size_t& completed, size_t& total) const;
+
+  /// \brief  returns the number of requests that have not yet been loaded into the stage
+  AL_USDMAYA_PUBLIC
+  size_t numPending() const;
+
+  /// \brief  sets the maximum number of payloads that can be read on worker threads at the same time
+  AL_USDMAYA_PUBLIC
+  void setMaxConcurrent(uint32_t maxConcurrent);
+
+  /// \brief  returns the maximum number of payloads that can be read on worker threads at the same time
+  inline uint32_t maxConcurrent() const
+    { return m_maxConcurrent; }
+
+  /// \brief  returns the path of the payload that is currently being loaded into the stage. This is only valid
+  ///         during the PrePayloadLoaded and PostPayloadLoaded events.
+  inline const SdfPath& currentPath() const
+    { return m_currentPath; }
+
+  /// \brief  converts a request state to a string
+  AL_USDMAYA_PUBLIC
+  static const char* stateName(State state);
+
+private:
+  struct Request
+  {
+    UsdStageWeakPtr stage;
+    SdfPath path;
+    ArResolverContext context;
+    std::vector<std::string> assetPaths;
+    std::vector<SdfLayerRefPtr> layers;
+    double priority;
+    uint64_t order;
+    State state;
+    bool load;
+  };
+  typedef std::shared_ptr<Request> RequestPtr;
+
+  void dispatch();
+  void fetch();
+  void openLayers(Request& request);
+  bool isCancelled(const Request& request) const;
+  void startTimer();
+  void stopTimer();
+  static void onTimer(float, float, void* clientData);
+
+  ProxyShape* m_proxy;
+  std::vector<RequestPtr> m_requests;
+  mutable std::mutex m_mutex;
+  WorkDispatcher m_dispatcher;
+  SdfPath m_currentPath;
+  MCallbackId m_timer = 0;
+  uint64_t m_order = 0;
+  uint32_t m_maxConcurrent = 4;
+  uint32_t m_numWorkers = 0;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+} // proxy
+} // nodes
+} // usdmaya
+} // AL
+//----------------------------------------------------------------------------------------------------------------------
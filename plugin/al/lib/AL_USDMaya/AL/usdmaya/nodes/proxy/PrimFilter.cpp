@@ -16,111 +16,194 @@
 #include "AL/usdmaya/nodes/ProxyShape.h"
 #include "AL/usdmaya/nodes/proxy/PrimFilter.h"
 #include "AL/usdmaya/fileio/SchemaPrims.h"
+#include "AL/usdmaya/Metadata.h"
+
+#include "pxr/base/work/loops.h"
+
+#include <algorithm>
+#include <map>
 
 namespace AL {
 namespace usdmaya {
 namespace nodes {
 namespace proxy {
 
+namespace {
+
+//----------------------------------------------------------------------------------------------------------------------
+/// \brief  The state of a single prim gathered (in parallel) before it is classified.
+//----------------------------------------------------------------------------------------------------------------------
+struct PrimState
+{
+  std::string existingTranslatorId;
+  std::string assetType;
+  TfToken typeName;
+  size_t translatorIndex = 0;
+  size_t previousIndex = 0;
+  bool previouslyExisted = false;
+  bool active = false;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+/// \brief  The translator info for one combination of prim type and asset type.
+//----------------------------------------------------------------------------------------------------------------------
+struct TranslatorState
+{
+  std::string translatorId;
+  bool supportsUpdate = false;
+  bool requiresParent = false;
+  bool importableByDefault = false;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+/// \brief  reverse ordering of paths, matching the order of the removed prim set
+inline bool reverseOrder(const SdfPath& a, const SdfPath& b)
+  { return b < a; }
+
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 PrimFilter::PrimFilter(
   const SdfPathVector& previousPrims,
   const std::vector<UsdPrim>& newPrimSet,
   PrimFilterInterface* proxy,
   bool forceImport)
-        : m_newPrimSet(newPrimSet), m_transformsToCreate(), m_updatablePrimSet(), m_removedPrimSet()
+        : m_newPrimSet(), m_transformsToCreate(), m_updatablePrimSet(), m_removedPrimSet()
 {
-  // copy over original prims
-  m_removedPrimSet.assign(previousPrims.begin(), previousPrims.end());
-  std::sort(m_removedPrimSet.begin(), m_removedPrimSet.end(),  [](const SdfPath& a, const SdfPath& b){ return b < a; } );
+  // sort the original prims (in reverse order) so that the new prims can be merged against them
+  SdfPathVector previous(previousPrims.begin(), previousPrims.end());
+  std::sort(previous.begin(), previous.end(), reverseOrder);
 
-  for(auto it = m_newPrimSet.begin(); it != m_newPrimSet.end(); )
+  // gather up the state of each new prim. This only reads from the stage and the proxy's prim mappings, so the
+  // prims can be processed in parallel.
+  const size_t numPrims = newPrimSet.size();
+  std::vector<PrimState> states(numPrims);
+  WorkParallelForN(numPrims, [&](size_t begin, size_t end)
   {
-    UsdPrim prim = *it;
-    auto lastIt = it;
-    ++it;
-
-    SdfPath path = prim.GetPath();
-
-    // check previous prim type (if it exists at all?)
-    std::string existingTranslatorId = proxy->getTranslatorIdForPath(path);
-    
-    std::string newTranslatorId = proxy->generateTranslatorId(prim);
+    for(size_t i = begin; i < end; ++i)
+    {
+      const UsdPrim& prim = newPrimSet[i];
+      const SdfPath path = prim.GetPath();
+      PrimState& state = states[i];
+      state.active = prim.IsActive();
+      if(!state.active)
+        continue;
+      state.existingTranslatorId = proxy->getTranslatorIdForPath(path);
+      prim.GetMetadata(Metadata::assetType, &state.assetType);
+      state.typeName = prim.GetTypeName();
+      auto iter = std::lower_bound(previous.begin(), previous.end(), path, reverseOrder);
+      state.previouslyExisted = iter != previous.end() && *iter == path;
+      state.previousIndex = iter - previous.begin();
+    }
+  });
 
-    // inactive prims should be removed
-    if (!prim.IsActive())
+  // The translator id only depends on the prim type and the asset type metadata, so generate it (and look up the
+  // translator info) once for each combination, rather than once for each prim.
+  std::vector<TranslatorState> translators;
+  {
+    std::map<std::pair<TfToken, std::string>, size_t> translatorIndices;
+    for(size_t i = 0; i < numPrims; ++i)
     {
-        it = m_newPrimSet.erase(lastIt);
+      PrimState& state = states[i];
+      if(!state.active)
         continue;
+      auto inserted = translatorIndices.emplace(std::make_pair(state.typeName, state.assetType), translators.size());
+      if(inserted.second)
+      {
+        translators.emplace_back();
+        TranslatorState& translator = translators.back();
+        translator.translatorId = proxy->generateTranslatorId(newPrimSet[i]);
+        proxy->getTranslatorInfo(translator.translatorId, translator.supportsUpdate, translator.requiresParent, translator.importableByDefault);
+      }
+      state.translatorIndex = inserted.first->second;
     }
+  }
+
+  // finally classify each prim. Checking whether a prim is dirty may call into the translators (which may be
+  // implemented in python), so this part remains serial.
+  std::vector<bool> retained(previous.size(), false);
+  for(size_t i = 0; i < numPrims; ++i)
+  {
+    const PrimState& state = states[i];
+
+    // inactive prims should be removed
+    if(!state.active)
+      continue;
+
+    const UsdPrim& prim = newPrimSet[i];
+    const TranslatorState& translator = translators[state.translatorIndex];
+    if(!translator.importableByDefault && !forceImport)
+      continue;
 
-    bool supportsUpdate = false;
-    bool requiresParent = false;
-    bool importableByDefault = false;
-    proxy->getTranslatorInfo(newTranslatorId, supportsUpdate, requiresParent, importableByDefault);
+    bool isNew = true;
+    bool requiresParent = translator.requiresParent;
 
-    if(importableByDefault || forceImport)
+    // if the type remains the same, and the prim existed previously
+    if(state.existingTranslatorId == translator.translatorId && state.previouslyExisted)
     {
-      // if the type remains the same, and the type supports update
-      if(existingTranslatorId == newTranslatorId)
+      if(translator.supportsUpdate)
       {
-        // locate the path and delete from the removed set (we do not want to delete this prim!
-        // Note that m_removedPrimSet is reverse sorted
-        auto iter = std::lower_bound(m_removedPrimSet.begin(), m_removedPrimSet.end(), path, [](const SdfPath& a, const SdfPath& b){ return b < a; } );
-        if(iter != removedPrimSet().end() && *iter == path)
+        // we do not want to delete this prim!
+        retained[state.previousIndex] = true;
+        if(proxy->isPrimDirty(prim))
         {
-          if (supportsUpdate)
-          {
-            m_removedPrimSet.erase(iter);
-            if (proxy->isPrimDirty(prim))
-            {
-              TF_DEBUG(ALUSDMAYA_TRANSLATORS).Msg(
-                  "PrimFilter::PrimFilter %s prim will be updated.\n", path.GetText());
-              m_updatablePrimSet.push_back(prim);
-            }
-            else
-            {
-              TF_DEBUG(ALUSDMAYA_TRANSLATORS).Msg(
-                  "PrimFilter::PrimFilter %s prim remains unchanged.\n", path.GetText());
-            }
-            // supporting update means it's not a new prim,
-            // otherwise we still want the prim to be re-created.
-            it = m_newPrimSet.erase(lastIt);
-
-            // skip creating transforms in this case.
-            requiresParent = false;
-          }
-          else
-          {
-            if (proxy->isPrimDirty(prim))
-            {
-              // prim has been added in "remove prim set", nothing to do here
-              TF_DEBUG(ALUSDMAYA_TRANSLATORS).Msg(
-                    "PrimFilter::PrimFilter %s prim will be removed and recreated.\n", path.GetText());
-            }
-            else
-            {
-              // prim is clean, no need to remove nor recreate
-              TF_DEBUG(ALUSDMAYA_TRANSLATORS).Msg(
-                  "PrimFilter::PrimFilter %s prim remains unchanged.\n", path.GetText());
-
-              m_removedPrimSet.erase(iter);
-              it = m_newPrimSet.erase(lastIt);
-              // skip creating transforms in this case.
-              requiresParent = false;
-            }
-          }
+          TF_DEBUG(ALUSDMAYA_TRANSLATORS).Msg(
+              "PrimFilter::PrimFilter %s prim will be updated.\n", prim.GetPath().GetText());
+          m_updatablePrimSet.push_back(prim);
         }
+        else
+        {
+          TF_DEBUG(ALUSDMAYA_TRANSLATORS).Msg(
+              "PrimFilter::PrimFilter %s prim remains unchanged.\n", prim.GetPath().GetText());
+        }
+        // supporting update means it's not a new prim,
+        // otherwise we still want the prim to be re-created.
+        isNew = false;
+
+        // skip creating transforms in this case.
+        requiresParent = false;
       }
-      // if we need a transform, make a note of it now
-      if(requiresParent)
+      else
       {
-        m_transformsToCreate.push_back(prim);
+        if(proxy->isPrimDirty(prim))
+        {
+          // prim has been added in "remove prim set", nothing to do here
+          TF_DEBUG(ALUSDMAYA_TRANSLATORS).Msg(
+                "PrimFilter::PrimFilter %s prim will be removed and recreated.\n", prim.GetPath().GetText());
+        }
+        else
+        {
+          // prim is clean, no need to remove nor recreate
+          TF_DEBUG(ALUSDMAYA_TRANSLATORS).Msg(
+              "PrimFilter::PrimFilter %s prim remains unchanged.\n", prim.GetPath().GetText());
+
+          retained[state.previousIndex] = true;
+          isNew = false;
+          // skip creating transforms in this case.
+          requiresParent = false;
+        }
       }
     }
-    else
+
+    if(isNew)
+    {
+      m_newPrimSet.push_back(prim);
+    }
+
+    // if we need a transform, make a note of it now
+    if(requiresParent)
+    {
+      m_transformsToCreate.push_back(prim);
+    }
+  }
+
+  // anything that was not retained has been removed (the set remains in reverse order)
+  m_removedPrimSet.reserve(previous.size());
+  for(size_t i = 0, n = previous.size(); i < n; ++i)
+  {
+    if(!retained[i])
     {
-      it = m_newPrimSet.erase(lastIt);
+      m_removedPrimSet.push_back(previous[i]);
     }
   }
 }
@@ -43,6 +43,7 @@ struct PrimFilterInterface
   ///         proxy shape is unaware of the prim (i.e. a variant switch has created it), then false will be returned.
   /// \param  path the path to the prim we are querying
   /// \return the translatorId string, or an empty string if unknown type
+  /// \note   The PrimFilter calls this method from multiple threads at once.
   virtual std::string getTranslatorIdForPath(const SdfPath& path) = 0;
 
   /// \brief  for a specific translator, this method should return whether it supports update, and if that translator requires a
@@ -54,7 +55,11 @@ struct PrimFilterInterface
   /// \return returns false if the translator is unknown, true otherwise
   virtual bool getTranslatorInfo(const std::string& translatorId, bool& supportsUpdate, bool& requiresParent, bool& importableByDefault) = 0;
 
-
+  /// \brief  generates the translator id for the specified prim.
+  /// \param  prim the prim to generate the translator id for
+  /// \return the translator id
+  /// \note   The PrimFilter assumes that the id only depends on the type name and assetType metadata of the prim,
+  ///         and only calls this method once for each combination of the two.
   virtual std::string generateTranslatorId(UsdPrim prim) = 0;
 
   /// \brief  check if a prim is dirty.
@@ -92,7 +92,6 @@ void ProxyShape::processChangedMetaData(const SdfPathVector& resyncedPaths, cons
         m_lockManager.setInherited(path);
       }
     }
-    m_lockManager.sort();
   }
   else
   {
@@ -194,18 +193,16 @@ void ProxyShape::processChangedMetaData(const SdfPathVector& resyncedPaths, cons
         {
           if (lockPropertyToken == Metadata::lockTransform)
           {
-            m_lockManager.addLocked(path);
+            m_lockManager.setLocked(path);
           }
           else
           if (lockPropertyToken == Metadata::lockUnlocked)
           {
-            m_lockManager.addUnlocked(path);
+            m_lockManager.setUnlocked(path);
           }
         }
       }
 
-      m_lockManager.sort();
-
       // sort and merge into previous selectable database
       std::sort(newUnselectables.begin(), newUnselectables.end());
 
@@ -228,9 +225,14 @@ void ProxyShape::processChangedMetaData(const SdfPathVector& resyncedPaths, cons
     }
   }
 
-  // reconstruct the lock prims
+  // update the lock state of the transforms beneath the modified prims
+  if(m_variantSwitchedPrims.empty())
   {
-    constructLockPrims();
+    constructLockPrims(changedOnlyPaths);
+  }
+  else
+  {
+    constructLockPrims(resyncedPaths);
   }
 }
 
@@ -246,45 +248,82 @@ void ProxyShape::constructExcludedPrims()
   }
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+void ProxyShape::updateLockPrim(const TransformReference& ref)
+{
+  Scope* s = ref.getTransformNode();
+  if(!s) 
+  {
+    return;
+  }
+
+  const UsdPrim& prim = s->transform()->prim();
+  if(prim)
+  {
+    bool is_locked = m_lockManager.isLocked(prim.GetPath());
+
+    MObject lockObject = s->thisMObject();
+
+    MPlug t(lockObject, m_transformTranslate);
+    MPlug r(lockObject, m_transformRotate);
+    MPlug s(lockObject, m_transformScale);
+
+    t.setLocked(is_locked);
+    r.setLocked(is_locked);
+    s.setLocked(is_locked);
+
+    if(is_locked)
+    {
+      MFnDependencyNode fn(lockObject);
+      Transform* transformNode = dynamic_cast<Transform*>(fn.userNode());
+      if (transformNode)
+      {
+        MPlug plug(lockObject, Transform::pushToPrim());
+        if(plug.asBool()) plug.setBool(false);
+      }
+    }
+  }
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 void ProxyShape::constructLockPrims()
 {
   TF_DEBUG(ALUSDMAYA_EVALUATION).Msg("ProxyShape::constructLockPrims\n");
 
   // iterate over the 
-  for(auto it : m_requiredPaths)
+  for(auto& it : m_requiredPaths)
+  {
+    updateLockPrim(it.second);
+  }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void ProxyShape::constructLockPrims(const SdfPathVector& rootPaths)
+{
+  TF_DEBUG(ALUSDMAYA_EVALUATION).Msg("ProxyShape::constructLockPrims %zu paths\n", rootPaths.size());
+
+  // a change to the lock state of a prim can only affect the prims beneath it, and since the required paths are
+  // sorted, each of those is a contiguous range in the map.
+  SdfPathVector roots;
+  roots.reserve(rootPaths.size());
+  for(const SdfPath& path : rootPaths)
   {
-    Scope* s = it.second.getTransformNode();
-    if(!s) 
+    roots.emplace_back(path.GetPrimPath());
+  }
+  std::sort(roots.begin(), roots.end());
+  SdfPath previous;
+  for(const SdfPath& root : roots)
+  {
+    // children of a root that has already been processed sort directly after it
+    if(!previous.IsEmpty() && root.HasPrefix(previous))
     {
       continue;
     }
+    previous = root;
 
-    const UsdPrim& prim = s->transform()->prim();
-    if(prim)
+    for(auto it = m_requiredPaths.lower_bound(root), end = m_requiredPaths.end(); it != end && it->first.HasPrefix(root); ++it)
     {
-      bool is_locked = m_lockManager.isLocked(prim.GetPath());
-
-      MObject lockObject = s->thisMObject();
-
-      MPlug t(lockObject, m_transformTranslate);
-      MPlug r(lockObject, m_transformRotate);
-      MPlug s(lockObject, m_transformScale);
-
-      t.setLocked(is_locked);
-      r.setLocked(is_locked);
-      s.setLocked(is_locked);
-
-      if(is_locked)
-      {
-        MFnDependencyNode fn(lockObject);
-        Transform* transformNode = dynamic_cast<Transform*>(fn.userNode());
-        if (transformNode)
-        {
-          MPlug plug(lockObject, Transform::pushToPrim());
-          if(plug.asBool()) plug.setBool(false);
-        }
-      }
+      updateLockPrim(it->second);
     }
   }
 }
@@ -0,0 +1,122 @@
+//
+// Copyright 2017 Animal Logic
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "AL/usdmaya/nodes/proxy/TransformBatch.h"
+#include "AL/usdmaya/nodes/TransformationMatrix.h"
+#include "AL/usdmaya/DebugCodes.h"
+
+#include "pxr/base/work/loops.h"
+
+#include <vector>
+
+namespace AL {
+namespace usdmaya {
+namespace nodes {
+namespace proxy {
+
+//----------------------------------------------------------------------------------------------------------------------
+void TransformBatch::insert(TransformationMatrix* matrix)
+{
+  if(!matrix)
+    return;
+  std::lock_guard<std::mutex> guard(m_mutex);
+  std::shared_ptr<Entry>& entry = m_entries[matrix];
+  if(!entry)
+  {
+    entry = std::make_shared<Entry>();
+    entry->matrix = matrix;
+  }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void TransformBatch::remove(TransformationMatrix* matrix)
+{
+  std::shared_ptr<Entry> entry;
+  {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    auto it = m_entries.find(matrix);
+    if(it == m_entries.end())
+      return;
+    entry = std::move(it->second);
+    m_entries.erase(it);
+  }
+
+  // a pass that gathered this entry before it was removed may still be updating the matrix, so wait for it to finish,
+  // and make sure that it will be skipped from then on
+  std::lock_guard<std::mutex> guard(entry->lock);
+  entry->matrix = nullptr;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void TransformBatch::updateToTime(TransformationMatrix* matrix, const UsdTimeCode& time, bool batched)
+{
+  std::shared_ptr<Entry> entry;
+  std::vector<std::shared_ptr<Entry>> pass;
+  {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    auto it = m_entries.find(matrix);
+    if(it != m_entries.end())
+    {
+      entry = it->second;
+      entry->batched = batched;
+
+      // the first batched compute at a new time gathers up everything else driven by the proxy time
+      if(batched && m_time != time)
+      {
+        m_time = time;
+        pass.reserve(m_entries.size());
+        for(auto& other : m_entries)
+        {
+          if(other.second->batched)
+            pass.push_back(other.second);
+        }
+      }
+    }
+  }
+
+  if(!entry)
+  {
+    matrix->updateToTime(time);
+    return;
+  }
+
+  // The batch lock is not held whilst the pass runs, so a Transform compute stolen by one of the worker threads
+  // cannot deadlock against it. Each matrix is guarded by its own lock, and updateToTime is a no-op for any matrix
+  // that has already been moved to this time. The pass shares ownership of its entries, and skips any whose matrix has
+  // been removed since they were gathered.
+  if(pass.size() > 1)
+  {
+    TF_DEBUG(ALUSDMAYA_EVALUATION).Msg("TransformBatch::updateToTime %f (%zu transforms)\n", time.GetValue(), pass.size());
+    WorkParallelForN(pass.size(), [&pass, &time](size_t begin, size_t end)
+    {
+      for(size_t i = begin; i < end; ++i)
+      {
+        std::lock_guard<std::mutex> guard(pass[i]->lock);
+        if(pass[i]->matrix)
+          pass[i]->matrix->updateToTime(time);
+      }
+    });
+  }
+
+  std::lock_guard<std::mutex> guard(entry->lock);
+  matrix->updateToTime(time);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+} // proxy
+} // nodes
+} // usdmaya
+} // AL
+//----------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,89 @@
+//
+// Copyright 2017 Animal Logic
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#pragma once
+
+#include <pxr/usd/usd/timeCode.h>
+
+#include "../../Api.h"
+
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+PXR_NAMESPACE_USING_DIRECTIVE
+
+namespace AL {
+namespace usdmaya {
+namespace nodes {
+
+class TransformationMatrix;
+
+namespace proxy {
+
+//----------------------------------------------------------------------------------------------------------------------
+/// \brief  Tracks the transformation matrices of the AL_usdmaya_Transform nodes driven by a proxy shape, so that when
+///         the proxy time changes, all of them can be read from USD in a single parallel pass (rather than each
+///         Transform node compute reading its own xform ops in turn). Each Transform compute then simply picks up the
+///         values already stored on its matrix.
+//----------------------------------------------------------------------------------------------------------------------
+class TransformBatch
+{
+public:
+
+  /// \brief  registers a transformation matrix with the batch
+  /// \param  matrix the matrix of a Transform node that has been connected to the proxy shape
+  AL_USDMAYA_PUBLIC
+  void insert(TransformationMatrix* matrix);
+
+  /// \brief  removes a transformation matrix from the batch. This must be called before the matrix is destroyed, and
+  ///         waits for any update of the matrix that a running batch pass has started.
+  /// \param  matrix the matrix to remove
+  AL_USDMAYA_PUBLIC
+  void remove(TransformationMatrix* matrix);
+
+  /// \brief  updates the matrix to the specified time. If the matrix is batched and the time differs from the last
+  ///         batch time, all of the batched matrices are first updated to that time in parallel.
+  /// \param  matrix the matrix to update
+  /// \param  time the time to update the matrix to
+  /// \param  batched true if the matrix is evaluated at the proxy time (i.e. with no time offset or scalar applied),
+  ///         false if the matrix should be updated on its own.
+  AL_USDMAYA_PUBLIC
+  void updateToTime(TransformationMatrix* matrix, const UsdTimeCode& time, bool batched);
+
+  /// \brief  returns the number of matrices registered with the batch
+  inline size_t size() const
+    { std::lock_guard<std::mutex> guard(m_mutex); return m_entries.size(); }
+
+private:
+  /// entries are shared with any batch pass that is running, so that they outlive their removal from the batch. The
+  /// matrix is reset (under the entry lock) once the entry has been removed.
+  struct Entry
+  {
+    TransformationMatrix* matrix;
+    std::mutex lock;
+    bool batched = false;
+  };
+  std::unordered_map<TransformationMatrix*, std::shared_ptr<Entry>> m_entries;
+  mutable std::mutex m_mutex;
+  UsdTimeCode m_time = UsdTimeCode::Default();
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+} // proxy
+} // nodes
+} // usdmaya
+} // AL
+//----------------------------------------------------------------------------------------------------------------------
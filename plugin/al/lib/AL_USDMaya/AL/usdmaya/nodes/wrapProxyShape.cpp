@@ -425,6 +425,68 @@ namespace {
           reason);
       modifier.doIt();
     }
+
+    //------------------------------------------------------------------------------------------------------------------
+    /// \brief  Python-wrappable method to queue asynchronous payload loads (or unloads) on the proxy shape
+    /// \param  proxyShape the ProxyShape to load the payloads on
+    /// \param  paths the prim paths of the payloads to load
+    /// \param  unload if true the payloads will be unloaded rather than loaded
+    /// \param  priority requests with a lower priority value are processed first
+    static void loadPayloadsAsync(ProxyShape& proxyShape, const SdfPathVector& paths, bool unload, double priority)
+    {
+      UsdStageRefPtr stage = proxyShape.usdStage();
+      for(const SdfPath& path : paths)
+      {
+        proxyShape.payloadQueue().enqueue(stage, path, !unload, priority);
+      }
+    }
+
+    //------------------------------------------------------------------------------------------------------------------
+    /// \brief  Python-wrappable method to cancel outstanding payload loads on the proxy shape
+    /// \param  proxyShape the ProxyShape to cancel the payload loads on
+    /// \param  paths the prim paths of the payloads to cancel. If empty, all outstanding requests are cancelled.
+    static void cancelPayloadLoads(ProxyShape& proxyShape, const SdfPathVector& paths)
+    {
+      if(paths.empty())
+      {
+        proxyShape.payloadQueue().cancelAll();
+      }
+      for(const SdfPath& path : paths)
+      {
+        proxyShape.payloadQueue().cancel(path);
+      }
+    }
+
+    //------------------------------------------------------------------------------------------------------------------
+    /// \brief  Python-wrappable method to query the state of a payload request
+    static std::string payloadLoadState(ProxyShape& proxyShape, const SdfPath& path)
+    {
+      return AL::usdmaya::nodes::proxy::PayloadLoadQueue::stateName(proxyShape.payloadQueue().state(path));
+    }
+
+    //------------------------------------------------------------------------------------------------------------------
+    /// \brief  Python-wrappable method to query the progress of the payload queue
+    /// \return a tuple containing the number of completed requests, and the total number of requests
+    static object payloadLoadProgress(ProxyShape& proxyShape)
+    {
+      size_t completed = 0, total = 0;
+      proxyShape.payloadQueue().progress(completed, total);
+      return boost::python::make_tuple(completed, total);
+    }
+
+    //------------------------------------------------------------------------------------------------------------------
+    /// \brief  Python-wrappable method to load the payloads that are ready into the stage
+    static void flushPayloadLoads(ProxyShape& proxyShape, bool wait)
+    {
+      proxyShape.payloadQueue().flush(wait);
+    }
+
+    //------------------------------------------------------------------------------------------------------------------
+    /// \brief  Python-wrappable method to set the number of payloads that can be read at the same time
+    static void setMaxConcurrentPayloadLoads(ProxyShape& proxyShape, uint32_t maxConcurrent)
+    {
+      proxyShape.payloadQueue().setMaxConcurrent(maxConcurrent);
+    }
   };
 }
 
@@ -491,6 +553,24 @@ void wrapProxyShape()
         (boost::python::arg("usdPrim"),
          boost::python::arg("reason")=ProxyShape::kRequested))
     .def("destroyTransformReferences", &ProxyShape::destroyTransformReferences)
+    .def("loadPayloadsAsync", PyProxyShape::loadPayloadsAsync,
+       ("Queue payload loads (or unloads) that are read on worker threads, and loaded into the stage when Maya is idle.\n"
+        "Args:\n"
+        "\tpaths (list of pxr.Sdf.Path): The prim paths of the payloads.\n"
+        "\tunload (bool): Unload the payloads rather than load them.\n"
+        "\tpriority (float): Requests with a lower priority value are processed first.\n"),
+        (boost::python::arg("paths"),
+         boost::python::arg("unload")=false,
+         boost::python::arg("priority")=0.0))
+    .def("cancelPayloadLoads", PyProxyShape::cancelPayloadLoads,
+        (boost::python::arg("paths")=SdfPathVector()))
+    .def("flushPayloadLoads", PyProxyShape::flushPayloadLoads,
+        (boost::python::arg("wait")=false))
+    .def("payloadLoadState", PyProxyShape::payloadLoadState,
+        (boost::python::arg("path")))
+    .def("payloadLoadProgress", PyProxyShape::payloadLoadProgress)
+    .def("setMaxConcurrentPayloadLoads", PyProxyShape::setMaxConcurrentPayloadLoads,
+        (boost::python::arg("maxConcurrent")))
     ;
 
     // Decided NOT to register this using boost::python::to_python_converter,
@@ -23,6 +23,8 @@
 #include <maya/MGlobal.h>
 
 #include <iostream>
+#include <string>
+#include <unordered_map>
 
 namespace AL {
 namespace maya {
@@ -1167,6 +1169,26 @@ static const char* const eventTypeStrings[] =
   "usdmaya"
 };
 
+//----------------------------------------------------------------------------------------------------------------------
+/// \brief  appends text to a string as a quoted python or MEL string literal
+static void appendQuoted(std::string& str, const char* text)
+{
+  str += '"';
+  for(; *text; ++text)
+  {
+    switch(*text)
+    {
+    case '\\': str += "\\\\"; break;
+    case '"': str += "\\\""; break;
+    case '\n': str += "\\n"; break;
+    case '\r': str += "\\r"; break;
+    case '\t': str += "\\t"; break;
+    default: str += *text; break;
+    }
+  }
+  str += '"';
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 class MayaEventSystemBinding
   : public AL::event::EventSystemBinding
@@ -1186,6 +1208,97 @@ public:
     return MGlobal::executeCommand(code, false, true);
   }
 
+  /// python callbacks are compiled into code objects stored in __main__. MEL has no compiled form that keeps the
+  /// semantics of a script executed at global scope, so the source of MEL callbacks is kept and executed as before.
+  /// The payloads of the triggers a callback is executed for are passed in the alEventPayloads python variable (which
+  /// is only set while the callback runs), or the global MEL variable string $alEventPayloads[].
+  uint64_t compileScript(AL::event::CallbackType type, const char* const code) override
+  {
+    const uint64_t handle = m_nextScript;
+    if(type == AL::event::kPython)
+    {
+      if(!m_definedPythonExec)
+      {
+        // restores the caller's own alEventPayloads global (if any) once the callback has finished
+        const char* const definition =
+          "def _alEventExec(handle, payloads):\n"
+          "    g = globals()\n"
+          "    saved = g.get('alEventPayloads', _alEventExec)\n"
+          "    g['alEventPayloads'] = payloads\n"
+          "    try:\n"
+          "        exec(_alEventScripts[handle], g)\n"
+          "    finally:\n"
+          "        if saved is _alEventExec:\n"
+          "            g.pop('alEventPayloads', None)\n"
+          "        else:\n"
+          "            g['alEventPayloads'] = saved\n";
+        if(!MGlobal::executePythonCommand(definition, false, false))
+          return 0;
+        m_definedPythonExec = true;
+      }
+
+      std::string command = "globals().setdefault('_alEventScripts', {})[" + std::to_string(handle) + "] = compile(";
+      appendQuoted(command, code);
+      command += ", '<AL event callback>', 'exec')";
+      if(!MGlobal::executePythonCommand(command.c_str(), false, false))
+        return 0;
+    }
+    else
+    {
+      m_melScripts.emplace(handle, code);
+    }
+    ++m_nextScript;
+    return handle;
+  }
+
+  bool executeCompiledScript(AL::event::CallbackType type, uint64_t handle, const AL::event::EventPayloads& payloads) override
+  {
+    if(type == AL::event::kPython)
+    {
+      std::string command = "_alEventExec(" + std::to_string(handle) + ", [";
+      for(size_t i = 0; i < payloads.size(); ++i)
+      {
+        if(i)
+          command += ", ";
+        appendQuoted(command, payloads[i].c_str());
+      }
+      command += "])";
+      return MGlobal::executePythonCommand(command.c_str(), false, true);
+    }
+
+    const auto it = m_melScripts.find(handle);
+    if(it == m_melScripts.end())
+      return false;
+
+    std::string command = "global string $alEventPayloads[]; clear $alEventPayloads;";
+    if(!payloads.empty())
+    {
+      command += " $alEventPayloads = {";
+      for(size_t i = 0; i < payloads.size(); ++i)
+      {
+        if(i)
+          command += ", ";
+        appendQuoted(command, payloads[i].c_str());
+      }
+      command += "};";
+    }
+    MGlobal::executeCommand(command.c_str(), false, false);
+    return MGlobal::executeCommand(it->second.c_str(), false, true);
+  }
+
+  void releaseCompiledScript(AL::event::CallbackType type, uint64_t handle) override
+  {
+    if(type == AL::event::kPython)
+    {
+      const std::string command = "_alEventScripts.pop(" + std::to_string(handle) + ", None)";
+      MGlobal::executePythonCommand(command.c_str(), false, false);
+    }
+    else
+    {
+      m_melScripts.erase(handle);
+    }
+  }
+
   void writeLog(EventSystemBinding::Type severity, const char* const text) override
   {
     switch(severity)
@@ -1195,6 +1308,11 @@ public:
     case kError: MGlobal::displayError(text); break;
     }
   }
+
+private:
+  std::unordered_map<uint64_t, std::string> m_melScripts;
+  uint64_t m_nextScript = 1;
+  bool m_definedPythonExec = false;
 };
 
 static MayaEventSystemBinding g_eventSystem;
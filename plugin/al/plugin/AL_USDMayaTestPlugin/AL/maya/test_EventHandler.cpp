@@ -282,6 +282,136 @@ TEST(EventDispatcher, triggerEvent2)
   EXPECT_TRUE(info.unregisterCallback(id1));
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+class CompilingEventSystemBinding
+  : public TestEventSystemBinding
+{
+public:
+
+  bool executePython(const char* const code) override
+    { ++m_sourceExecuted; return true; }
+
+  bool executeMEL(const char* const code) override
+    { ++m_sourceExecuted; return true; }
+
+  uint64_t compileScript(CallbackType type, const char* const code) override
+    { return ++m_compiled; }
+
+  bool executeCompiledScript(CallbackType type, uint64_t handle, const EventPayloads& payloads) override
+  {
+    ++m_compiledExecuted;
+    m_lastPayloads = payloads;
+    return true;
+  }
+
+  void releaseCompiledScript(CallbackType type, uint64_t handle) override
+    { ++m_released; }
+
+  uint32_t m_sourceExecuted = 0;
+  uint32_t m_compiled = 0;
+  uint32_t m_compiledExecuted = 0;
+  uint32_t m_released = 0;
+  EventPayloads m_lastPayloads;
+};
+
+TEST(EventDispatcher, compiledScripts)
+{
+  CompilingEventSystemBinding system;
+  {
+    EventDispatcher info(&system, "eventName", 42, kUserSpecifiedEventType, nullptr, 23);
+    info.registerCallback("python", "print('hello')", 1000, true);
+    info.registerCallback("mel", "print \"hello\";", 1001, false);
+
+    // scripts are compiled once, when they are registered
+    EXPECT_EQ(system.m_compiled, 2u);
+
+    info.triggerEvent();
+    info.triggerEvent();
+    EXPECT_EQ(system.m_compiled, 2u);
+    EXPECT_EQ(system.m_compiledExecuted, 4u);
+    EXPECT_EQ(system.m_sourceExecuted, 0u);
+    EXPECT_EQ(system.m_released, 0u);
+  }
+  EXPECT_EQ(system.m_released, 2u);
+}
+
+TEST(EventScheduler, coalescedEvents)
+{
+  CompilingEventSystemBinding system;
+  EventScheduler scheduler(&system);
+  EventId id = scheduler.registerEvent("eventName", kUserSpecifiedEventType);
+  int value;
+  g_value = 0;
+  scheduler.registerCallback(id, "c", func_dispatch2, 1000, &value);
+  scheduler.registerCallback(id, "python", "print(alEventPayloads)", 1001, true);
+
+  auto binder = [](void* userData, const void* callback) { ((func_ptr_type)callback)(userData, g_value + 1); };
+
+  // events that are not coalesced execute their scripts straight away, even within a batch
+  {
+    EventBatch batch(scheduler);
+    scheduler.triggerEvent(id, binder, "a");
+    EXPECT_EQ(system.m_compiledExecuted, 1u);
+  }
+  EXPECT_EQ(g_value, 1);
+  EXPECT_EQ(system.m_compiledExecuted, 1u);
+  ASSERT_EQ(system.m_lastPayloads.size(), 1u);
+  EXPECT_EQ(system.m_lastPayloads[0], "a");
+
+  // coalesced events execute their C++ callbacks straight away, and their scripts once at the end of the batch
+  scheduler.event(id)->setCoalesced(true);
+  {
+    EventBatch batch(scheduler);
+    {
+      EventBatch nested(scheduler);
+      scheduler.triggerEvent(id, binder, "b");
+      scheduler.triggerEvent(id, binder, "c");
+    }
+    scheduler.triggerEvent(id, binder, "d");
+    EXPECT_EQ(g_value, 4);
+    EXPECT_EQ(system.m_compiledExecuted, 1u);
+    EXPECT_TRUE(scheduler.isBatching());
+  }
+  EXPECT_FALSE(scheduler.isBatching());
+  EXPECT_EQ(system.m_compiledExecuted, 2u);
+  EXPECT_EQ(system.m_lastPayloads, EventPayloads({"b", "c", "d"}));
+
+  // a batch in which the event is not triggered executes nothing
+  {
+    EventBatch batch(scheduler);
+  }
+  EXPECT_EQ(system.m_compiledExecuted, 2u);
+
+  // outside of a batch, coalesced events behave as normal
+  scheduler.triggerEvent(id, binder, "e");
+  EXPECT_EQ(system.m_compiledExecuted, 3u);
+  EXPECT_EQ(system.m_lastPayloads, EventPayloads({"e"}));
+  EXPECT_EQ(system.m_sourceExecuted, 0u);
+}
+
+TEST(NodeEvents, setCoalesced)
+{
+  CompilingEventSystemBinding system;
+  EventScheduler scheduler(&system);
+  {
+    NodeEvents node(&scheduler);
+    EXPECT_TRUE(node.registerEvent("eventName", kUserSpecifiedEventType));
+    EXPECT_FALSE(node.setCoalesced("unknownEvent", true));
+    EXPECT_TRUE(node.setCoalesced("eventName", true));
+
+    const EventId id = node.getId("eventName");
+    scheduler.registerCallback(id, "python", "print(alEventPayloads)", 1000, true);
+    {
+      EventBatch batch(scheduler);
+      EXPECT_TRUE(node.triggerEvent("eventName", "a"));
+      EXPECT_TRUE(node.triggerEvent("eventName", "b"));
+      EXPECT_EQ(system.m_compiledExecuted, 0u);
+    }
+    EXPECT_EQ(system.m_compiledExecuted, 1u);
+    EXPECT_EQ(system.m_lastPayloads, EventPayloads({"a", "b"}));
+  }
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 // EventId registerEvent(const char* eventName, const void* associatedData = 0, const CallbackId parentEvent = 0);
 // bool unregisterEvent(EventId eventId);
@@ -1018,6 +1148,51 @@ runEventLookupTest;
 
 )";
 
+static const char* const runScriptCallbackTest =  R"(
+
+proc int runScriptCallbackTest()
+{
+  global int $alEventTestResult;
+  $alEventTestResult = 0;
+
+  file -f -new;
+
+  $proxyTm = `createNode "transform"`;
+  $proxy = `createNode -p $proxyTm "AL_usdmaya_ProxyShape"`;
+
+  string $eventName = "ScriptCallbackEvent";
+  AL_usdmaya_Event $eventName $proxy;
+
+  // MEL callbacks are executed at global scope, so they are free to declare procs of their own
+  string $mel = "global proc int alEventTestProc() { return 7; } global int $alEventTestResult; $alEventTestResult = alEventTestProc();";
+  int $cb[] = `AL_usdmaya_Callback -mne $proxy $eventName "mel" 10000 $mel`;
+
+  // python callbacks are passed their payloads without touching a global of the same name
+  python("alEventPayloads = 42");
+  int $cb2[] = `AL_usdmaya_Callback -pne $proxy $eventName "python" 10001 "alEventTestSeen = len(alEventPayloads)"`;
+
+  AL_usdmaya_TriggerEvent -n $proxy $eventName;
+  AL_usdmaya_TriggerEvent -n $proxy $eventName;
+
+  if($alEventTestResult != 7)
+    return -1;
+  if(`python("alEventTestSeen")` != 0)
+    return -1;
+  if(`python("alEventPayloads")` != 42)
+    return -1;
+
+  AL_usdmaya_DeleteCallbacks $cb;
+  AL_usdmaya_DeleteCallbacks $cb2;
+  delete $proxy;
+  delete $proxyTm;
+
+  return 0;
+}
+
+runScriptCallbackTest;
+
+)";
+
 //----------------------------------------------------------------------------------------------------------------------
 TEST(EventCommands, runBasicNodeEventTest)
 {
@@ -1080,3 +1255,12 @@ TEST(EventCommands, runEventLookupTest)
   EXPECT_TRUE(result == 0);
   MGlobal::executeCommand("undoInfo -st off;");
 }
+
+//----------------------------------------------------------------------------------------------------------------------
+TEST(EventCommands, runScriptCallbackTest)
+{
+  MFileIO::newFile(true);
+  int result = -1;
+  EXPECT_TRUE(MGlobal::executeCommand(runScriptCallbackTest, result, false, true) == MS::kSuccess);
+  EXPECT_TRUE(result == 0);
+}
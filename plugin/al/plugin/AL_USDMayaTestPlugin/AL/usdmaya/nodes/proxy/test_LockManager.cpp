@@ -0,0 +1,79 @@
+//
+// Copyright 2017 Animal Logic
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "test_usdmaya.h"
+#include "AL/usdmaya/nodes/proxy/LockManager.h"
+
+using AL::usdmaya::nodes::proxy::LockManager;
+
+// check that lock states are inherited from the closest ancestor with an explicit state
+TEST(LockManager, inheritance)
+{
+  LockManager manager;
+  EXPECT_FALSE(manager.isLocked(SdfPath("/A/B/C")));
+
+  manager.setLocked(SdfPath("/A"));
+  manager.setUnlocked(SdfPath("/A/B/C"));
+  EXPECT_EQ(2u, manager.size());
+  EXPECT_TRUE(manager.isLocked(SdfPath("/A")));
+  EXPECT_TRUE(manager.isLocked(SdfPath("/A/B")));
+  EXPECT_FALSE(manager.isLocked(SdfPath("/A/B/C")));
+  EXPECT_FALSE(manager.isLocked(SdfPath("/A/B/C/D")));
+  EXPECT_FALSE(manager.isLocked(SdfPath("/AB")));
+  EXPECT_EQ(LockManager::kInherited, manager.explicitState(SdfPath("/A/B")));
+
+  // switching an explicit state replaces the previous one
+  manager.setLocked(SdfPath("/A/B/C"));
+  EXPECT_EQ(2u, manager.size());
+  EXPECT_TRUE(manager.isLocked(SdfPath("/A/B/C/D")));
+
+  manager.setUnlocked(SdfPath("/A/B"));
+  manager.setInherited(SdfPath("/A/B/C"));
+  EXPECT_EQ(2u, manager.size());
+  EXPECT_FALSE(manager.isLocked(SdfPath("/A/B/C/D")));
+  EXPECT_TRUE(manager.isLocked(SdfPath("/A/X")));
+
+  // setting an unknown path as inherited should be a no-op
+  manager.setInherited(SdfPath("/Z/Y"));
+  EXPECT_EQ(2u, manager.size());
+
+  manager.removeEntries({SdfPath("/A/B")});
+  EXPECT_EQ(1u, manager.size());
+  EXPECT_TRUE(manager.isLocked(SdfPath("/A/B/C/D")));
+}
+
+// check that a resync removes the states of a whole subtree, leaving its siblings and ancestors alone
+TEST(LockManager, removeFromRootPath)
+{
+  LockManager manager;
+  manager.setLocked(SdfPath("/A"));
+  manager.setUnlocked(SdfPath("/A/B"));
+  manager.setLocked(SdfPath("/A/B/C"));
+  manager.setUnlocked(SdfPath("/A/BB"));
+
+  manager.removeFromRootPath(SdfPath("/A/B"));
+  EXPECT_EQ(2u, manager.size());
+  EXPECT_TRUE(manager.isLocked(SdfPath("/A/B")));
+  EXPECT_TRUE(manager.isLocked(SdfPath("/A/B/C")));
+  EXPECT_FALSE(manager.isLocked(SdfPath("/A/BB")));
+
+  // re-adding the subtree after the resync
+  manager.setUnlocked(SdfPath("/A/B/C"));
+  EXPECT_FALSE(manager.isLocked(SdfPath("/A/B/C/D")));
+  EXPECT_EQ(3u, manager.size());
+
+  manager.removeFromRootPath(SdfPath("/Q"));
+  EXPECT_EQ(3u, manager.size());
+}
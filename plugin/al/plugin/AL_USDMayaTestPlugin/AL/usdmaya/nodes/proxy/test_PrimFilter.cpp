@@ -29,14 +29,22 @@
 #include "maya/MFileIO.h"
 #include "maya/MStringArray.h"
 
+#include "pxr/base/tf/getenv.h"
 #include "pxr/usd/usd/stage.h"
+#include "pxr/usd/usd/variantSets.h"
+#include "pxr/usd/sdf/primSpec.h"
+#include "pxr/usd/sdf/variantSetSpec.h"
+#include "pxr/usd/sdf/variantSpec.h"
 #include "pxr/usd/sdf/types.h"
 #include "pxr/usd/usd/attribute.h"
 #include "pxr/usd/usdGeom/xform.h"
 #include "pxr/usd/usdGeom/xformCommonAPI.h"
 
 
+#include <algorithm>
+#include <chrono>
 #include <fstream>
+#include <iostream>
 #include <set>
 
 using AL::maya::test::buildTempPath;
@@ -326,3 +334,61 @@ TEST(PrimFilter, removedPaths)
     EXPECT_TRUE(filter.transformsToCreate().empty());
   }
 }
+
+/// Switches a set level variant with many children, the bulk of which is the work done by the PrimFilter prior to any
+/// Maya nodes being modified. The default size only checks the result; set AL_USDMAYA_PRIMFILTER_BENCHMARK_SCALE to
+/// scale the number of children up and print the time taken.
+TEST(PrimFilter, variantSwitchLatency)
+{
+  MFileIO::newFile(true);
+
+  const std::string temp_path = buildTempPath("AL_USDMayaTests_variantSwitchLatency.usda");
+  const int scale = std::max(TfGetenvInt("AL_USDMAYA_PRIMFILTER_BENCHMARK_SCALE", 0), 0);
+  const int numChildren = scale ? 50000 * scale : 200;
+
+  // generate a set with two variants, each containing the same set of child prims (plus one unique prim)
+  {
+    SdfLayerRefPtr layer = SdfLayer::CreateAnonymous(".usda");
+    SdfPrimSpecHandle set = SdfPrimSpec::New(layer, "set", SdfSpecifierDef, "Xform");
+    SdfVariantSetSpecHandle variantSet = SdfVariantSetSpec::New(set, "lod");
+    for(const char* const variant : { "high", "low" })
+    {
+      SdfPrimSpecHandle variantPrim = SdfVariantSpec::New(variantSet, variant)->GetPrimSpec();
+      for(int i = 0; i < numChildren; ++i)
+      {
+        SdfPrimSpec::New(variantPrim, "child" + std::to_string(i), SdfSpecifierDef, "Xform");
+      }
+      SdfPrimSpec::New(variantPrim, variant, SdfSpecifierDef, "Xform");
+    }
+    set->GetVariantSetNameList().Add("lod");
+    set->SetVariantSelection("lod", "high");
+    layer->Export(temp_path);
+  }
+
+  MFnDagNode fn;
+  MObject xform = fn.create("transform");
+  MObject shape = fn.create("AL_usdmaya_ProxyShape", xform);
+  AL::usdmaya::nodes::ProxyShape* proxy = (AL::usdmaya::nodes::ProxyShape*)fn.userNode();
+  proxy->filePathPlug().setString(temp_path.c_str());
+
+  auto stage = proxy->getUsdStage();
+  ASSERT_TRUE(stage);
+  UsdVariantSet variantSet = stage->GetPrimAtPath(SdfPath("/set")).GetVariantSet("lod");
+
+  const auto start = std::chrono::steady_clock::now();
+  variantSet.SetVariantSelection("low");
+  const auto end = std::chrono::steady_clock::now();
+
+  if(scale)
+  {
+    std::cout << "PrimFilter: switching a variant with " << numChildren << " children took "
+              << std::chrono::duration<double, std::milli>(end - start).count() << "ms" << std::endl;
+  }
+
+  EXPECT_TRUE(stage->GetPrimAtPath(SdfPath("/set/low")).IsValid());
+  EXPECT_FALSE(stage->GetPrimAtPath(SdfPath("/set/high")).IsValid());
+  const auto children = stage->GetPrimAtPath(SdfPath("/set")).GetChildren();
+  EXPECT_EQ(size_t(numChildren + 1), size_t(std::distance(children.begin(), children.end())));
+
+  MFileIO::newFile(true);
+}
@@ -0,0 +1,166 @@
+//
+// Copyright 2017 Animal Logic
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "test_usdmaya.h"
+#include "AL/usdmaya/nodes/MeshAnimDeformer.h"
+#include "AL/usdmaya/nodes/ProxyShape.h"
+
+#include "maya/MFileIO.h"
+#include "maya/MFnDagNode.h"
+#include "maya/MFnMesh.h"
+#include "maya/MGlobal.h"
+#include "maya/MPointArray.h"
+#include "maya/MSelectionList.h"
+
+#include "pxr/usd/usdGeom/mesh.h"
+
+using AL::usdmaya::nodes::MeshAnimDeformer;
+using AL::usdmaya::nodes::ProxyShape;
+
+using AL::maya::test::buildTempPath;
+
+namespace {
+
+// the points of a unit quad, offset in y by the specified amount
+VtArray<GfVec3f> quadPoints(float y)
+{
+  VtArray<GfVec3f> points(4);
+  points[0] = GfVec3f(-0.5f, y, 0.5f);
+  points[1] = GfVec3f(0.5f, y, 0.5f);
+  points[2] = GfVec3f(-0.5f, y, -0.5f);
+  points[3] = GfVec3f(0.5f, y, -0.5f);
+  return points;
+}
+
+// evaluates the output mesh of the deformer at the specified frame, and returns the y value of each vertex
+std::vector<float> evaluateHeights(MeshAnimDeformer* deformer, double frame)
+{
+  MGlobal::viewFrame(frame);
+  MObject meshData = deformer->outMeshPlug().asMObject();
+  MFnMesh fnMesh(meshData);
+  MPointArray points;
+  fnMesh.getPoints(points);
+  std::vector<float> heights;
+  for(uint32_t i = 0; i < points.length(); ++i)
+  {
+    heights.push_back(float(points[i].y));
+  }
+  return heights;
+}
+
+void expectHeights(const std::vector<float>& heights, float y)
+{
+  ASSERT_EQ(4u, heights.size());
+  for(float h : heights)
+  {
+    EXPECT_NEAR(y, h, 1e-5f);
+  }
+}
+
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+/// \brief  Drive the deformer across held and interpolated samples, and make sure that editing the points of the
+///         prim replaces the cached samples.
+//----------------------------------------------------------------------------------------------------------------------
+TEST(MeshAnimDeformer, heldInterpolatedAndEditedSamples)
+{
+  MFileIO::newFile(true);
+
+  const std::string temp_path = buildTempPath("AL_USDMayaTests_meshAnimDeformer.usda");
+  {
+    UsdStageRefPtr stage = UsdStage::CreateInMemory();
+    UsdGeomMesh mesh = UsdGeomMesh::Define(stage, SdfPath("/quad"));
+    VtArray<int> counts(1, 4);
+    VtArray<int> indices(4);
+    indices[0] = 0; indices[1] = 1; indices[2] = 3; indices[3] = 2;
+    mesh.GetFaceVertexCountsAttr().Set(counts);
+    mesh.GetFaceVertexIndicesAttr().Set(indices);
+    UsdAttribute points = mesh.GetPointsAttr();
+    points.Set(quadPoints(0.0f), UsdTimeCode(1.0));
+    points.Set(quadPoints(2.0f), UsdTimeCode(3.0));
+    points.Set(quadPoints(6.0f), UsdTimeCode(5.0));
+    stage->Export(temp_path, false);
+  }
+
+  MFnDagNode fnDag;
+  MObject xform = fnDag.create("transform");
+  fnDag.create("AL_usdmaya_ProxyShape", xform);
+  ProxyShape* proxy = (ProxyShape*)fnDag.userNode();
+  proxy->filePathPlug().setString(temp_path.c_str());
+  UsdStageRefPtr stage = proxy->usdStage();
+  ASSERT_TRUE(stage);
+  const MString proxyName = fnDag.name();
+
+  MStringArray plane;
+  MGlobal::executeCommand("polyPlane -sx 1 -sy 1 -ch 1", plane);
+
+  MString deformerName = MGlobal::executeCommandStringResult("createNode \"AL_usdmaya_MeshAnimDeformer\"");
+  MGlobal::executeCommand("setAttr -type \"string\" " + deformerName + ".primPath \"/quad\"");
+  MGlobal::executeCommand("connectAttr time1.outTime " + deformerName + ".inTime");
+  MGlobal::executeCommand("connectAttr " + proxyName + ".outStageData " + deformerName + ".inStageData");
+  MGlobal::executeCommand("connectAttr " + plane[1] + ".output " + deformerName + ".inMesh");
+
+  MSelectionList sl;
+  sl.add(deformerName);
+  MObject deformerNode;
+  sl.getDependNode(0, deformerNode);
+  MFnDependencyNode fnDeformer(deformerNode);
+  MeshAnimDeformer* deformer = (MeshAnimDeformer*)fnDeformer.userNode();
+  ASSERT_TRUE(deformer);
+
+  // linear interpolation between samples, and the authored values at the samples themselves
+  expectHeights(evaluateHeights(deformer, 1.0), 0.0f);
+  expectHeights(evaluateHeights(deformer, 2.0), 1.0f);
+  expectHeights(evaluateHeights(deformer, 3.0), 2.0f);
+  expectHeights(evaluateHeights(deformer, 4.0), 4.0f);
+  expectHeights(evaluateHeights(deformer, 5.0), 6.0f);
+
+  // playing backwards evicts the samples after the current bracket, and reads them again when needed
+  expectHeights(evaluateHeights(deformer, 4.0), 4.0f);
+  expectHeights(evaluateHeights(deformer, 2.0), 1.0f);
+  expectHeights(evaluateHeights(deformer, 1.0), 0.0f);
+  expectHeights(evaluateHeights(deformer, 4.5), 5.0f);
+
+  // times outside of the sample range clamp to the first and last samples
+  expectHeights(evaluateHeights(deformer, 0.0), 0.0f);
+  expectHeights(evaluateHeights(deformer, 7.0), 6.0f);
+
+  // held interpolation keeps the previous sample until the next one is reached
+  stage->SetInterpolationType(UsdInterpolationTypeHeld);
+  expectHeights(evaluateHeights(deformer, 2.0), 0.0f);
+  expectHeights(evaluateHeights(deformer, 3.0), 2.0f);
+  expectHeights(evaluateHeights(deformer, 4.0), 2.0f);
+  expectHeights(evaluateHeights(deformer, 4.5), 2.0f);
+  stage->SetInterpolationType(UsdInterpolationTypeLinear);
+
+  // editing a sample at the current time must show up without a time change
+  expectHeights(evaluateHeights(deformer, 3.0), 2.0f);
+  UsdGeomMesh(stage->GetPrimAtPath(SdfPath("/quad"))).GetPointsAttr().Set(quadPoints(10.0f), UsdTimeCode(3.0));
+  MGlobal::executeCommand("flushIdleQueue");
+  expectHeights(evaluateHeights(deformer, 3.0), 10.0f);
+
+  // and the interpolated values either side of it must use the new sample rather than the cached one
+  expectHeights(evaluateHeights(deformer, 2.0), 5.0f);
+  expectHeights(evaluateHeights(deformer, 4.0), 8.0f);
+
+  // adding a new sample changes the bracketing samples
+  UsdGeomMesh(stage->GetPrimAtPath(SdfPath("/quad"))).GetPointsAttr().Set(quadPoints(20.0f), UsdTimeCode(4.0));
+  MGlobal::executeCommand("flushIdleQueue");
+  expectHeights(evaluateHeights(deformer, 4.0), 20.0f);
+  expectHeights(evaluateHeights(deformer, 4.5), 13.0f);
+
+  MFileIO::newFile(true);
+}
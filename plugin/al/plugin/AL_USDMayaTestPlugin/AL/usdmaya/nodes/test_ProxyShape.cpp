@@ -15,12 +15,14 @@
 //
 #include "test_usdmaya.h"
 #include "AL/maya/test/testHelpers.h"
+#include "AL/usdmaya/BinaryArchive.h"
 #include "AL/usdmaya/nodes/ProxyShape.h"
 #include "AL/usdmaya/nodes/Transform.h"
 #include "AL/usdmaya/nodes/LayerManager.h"
 #include "AL/usdmaya/StageCache.h"
 #include "AL/usdmaya/fileio/translators/TranslatorContext.h"
 
+#include "maya/MFnIntArrayData.h"
 #include "maya/MFnTransform.h"
 #include "maya/MSelectionList.h"
 #include "maya/MGlobal.h"
@@ -32,13 +34,17 @@
 
 #include "pxr/usd/sdf/types.h"
 #include "pxr/usd/usd/attribute.h"
+#include "pxr/usd/usd/payloads.h"
 #include "pxr/usd/usd/stage.h"
 #include "pxr/usd/usd/usdaFileFormat.h"
 #include "pxr/usd/usdGeom/xform.h"
 #include "pxr/usd/usdGeom/xformCommonAPI.h"
 
+#include <algorithm>
 #include <iostream>
 #include <fstream>
+#include <regex>
+#include <sstream>
 
 using AL::maya::test::buildTempPath;
 using AL::maya::test::compareTempPaths;
@@ -1036,6 +1042,262 @@ TEST(ProxyShape, editTargetChangeAndSave)
   }
 }
 
+namespace {
+
+// 'ALTR', the magic number of the transform ref count archives
+const uint32_t kTransformRefsMagic = 0x52544C41;
+
+struct TransformRef
+{
+  std::string node;
+  SdfPath path;
+  uint32_t required;
+  uint32_t selected;
+  uint32_t refCount;
+
+  bool operator == (const TransformRef& other) const
+  {
+    return node == other.node && path == other.path && required == other.required &&
+           selected == other.selected && refCount == other.refCount;
+  }
+};
+
+// serialises the transform refs of the proxy shape, and reads them back from the archive
+std::vector<TransformRef> readTransformRefs(AL::usdmaya::nodes::ProxyShape* proxy, MIntArray* archive = nullptr)
+{
+  proxy->serialiseTransformRefs();
+  MObject data;
+  proxy->serializedRefCountsDataPlug().getValue(data);
+  MIntArray ints = MFnIntArrayData(data).array();
+  if(archive)
+    *archive = ints;
+
+  std::vector<TransformRef> refs;
+  AL::usdmaya::BinaryArchiveReader reader(ints, kTransformRefsMagic);
+  EXPECT_TRUE(reader.isValid());
+  const uint32_t count = reader.readU32();
+  for(uint32_t i = 0; i < count && reader.isValid(); ++i)
+  {
+    TransformRef ref;
+    ref.node = MFnDagNode(reader.readNode()).fullPathName().asChar();
+    ref.path = reader.readPath();
+    ref.required = reader.readU32();
+    ref.selected = reader.readU32();
+    ref.refCount = reader.readU32();
+    refs.push_back(ref);
+  }
+  EXPECT_TRUE(reader.isValid());
+  std::sort(refs.begin(), refs.end(), [](const TransformRef& a, const TransformRef& b) { return a.path < b.path; });
+  return refs;
+}
+
+// the transform refs in the text format of scenes saved before the binary archive existed
+std::string transformRefsText(const std::vector<TransformRef>& refs)
+{
+  std::ostringstream text;
+  for(const TransformRef& ref : refs)
+  {
+    text << ref.node << ' ' << ref.path.GetString() << ' ' << ref.required << ' ' << ref.selected << ' '
+         << ref.refCount << ';';
+  }
+  return text.str();
+}
+
+// creates a proxy shape, selects a prim so that a chain of transforms is created for it, and saves the scene
+std::vector<TransformRef> saveTransformRefsScene(const MString& mayaPath, MString& shapeName, MIntArray& archive)
+{
+  MFileIO::newFile(true);
+
+  const std::string usdPath = buildTempPath("AL_USDMayaTests_transformRefs.usda");
+  {
+    UsdStageRefPtr stage = UsdStage::CreateInMemory();
+    UsdGeomXform::Define(stage, SdfPath("/root"));
+    UsdGeomXform::Define(stage, SdfPath("/root/hip1"));
+    UsdGeomXform::Define(stage, SdfPath("/root/hip1/knee1"));
+    stage->Export(usdPath, false);
+  }
+
+  MFnDagNode fn;
+  MObject xform = fn.create("transform");
+  fn.create("AL_usdmaya_ProxyShape", xform);
+  shapeName = fn.name();
+
+  AL::usdmaya::nodes::ProxyShape* proxy = (AL::usdmaya::nodes::ProxyShape*)fn.userNode();
+  proxy->filePathPlug().setString(usdPath.c_str());
+  EXPECT_TRUE(proxy->getUsdStage());
+
+  MGlobal::executeCommand("AL_usdmaya_ProxyShapeSelect -primPath \"/root/hip1/knee1\" -proxy \"" + shapeName + "\"");
+  EXPECT_TRUE(proxy->isRequiredPath(SdfPath("/root/hip1/knee1")));
+
+  std::vector<TransformRef> refs = readTransformRefs(proxy, &archive);
+  EXPECT_FALSE(refs.empty());
+
+  EXPECT_EQ(MStatus(MS::kSuccess), MFileIO::saveAs(mayaPath));
+  return refs;
+}
+
+// replaces the serialised transform refs of the proxy shape in a maya ascii file
+void rewriteTransformRefs(const MString& mayaPath, const MString& shapeName, const MIntArray* archive, const std::string& text)
+{
+  std::string contents;
+  {
+    std::ifstream file(mayaPath.asChar());
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    contents = buffer.str();
+  }
+  contents = std::regex_replace(contents, std::regex("setAttr[^;]*\"\\.strcd\"[^;]*;"), "");
+  contents = std::regex_replace(contents, std::regex("setAttr[^;]*\"\\.strcs\"[^;]*;"), "");
+
+  std::ostringstream attrs;
+  if(archive)
+  {
+    attrs << "\n\tsetAttr \".strcd\" -type \"Int32Array\" " << archive->length();
+    for(uint32_t i = 0; i < archive->length(); ++i)
+      attrs << ' ' << (*archive)[i];
+    attrs << ';';
+  }
+  if(!text.empty())
+  {
+    attrs << "\n\tsetAttr \".strcs\" -type \"string\" \"" << text << "\";";
+  }
+
+  std::smatch match;
+  const std::string createNode = std::string("createNode AL_usdmaya_ProxyShape -n \"") + shapeName.asChar() + "\"[^;]*;";
+  ASSERT_TRUE(std::regex_search(contents, match, std::regex(createNode)));
+  contents.insert(match.position(0) + match.length(0), attrs.str());
+
+  std::ofstream file(mayaPath.asChar());
+  file << contents;
+}
+
+AL::usdmaya::nodes::ProxyShape* openTransformRefsScene(const MString& mayaPath, const MString& shapeName)
+{
+  EXPECT_EQ(MStatus(MS::kSuccess), MFileIO::open(mayaPath, NULL, true));
+  MSelectionList sl;
+  EXPECT_EQ(MStatus(MS::kSuccess), sl.add(shapeName));
+  MObject shape;
+  EXPECT_EQ(MStatus(MS::kSuccess), sl.getDependNode(0, shape));
+  AL::usdmaya::nodes::ProxyShape* proxy = (AL::usdmaya::nodes::ProxyShape*)MFnDagNode(shape).userNode();
+
+  // the serialised data is only needed until it has been read
+  if(proxy)
+  {
+    MObject data;
+    proxy->serializedRefCountsDataPlug().getValue(data);
+    EXPECT_TRUE(data.isNull() || MFnIntArrayData(data).length() == 0);
+    EXPECT_EQ(MString(), proxy->serializedRefCountsPlug().asString());
+  }
+  return proxy;
+}
+
+} // namespace
+
+// The transform refs are saved as a binary archive, and restored when the scene is opened
+TEST(ProxyShape, transformRefsRoundTrip)
+{
+  const MString mayaPath = buildTempPath("AL_USDMayaTests_transformRefsRoundTrip.ma");
+  MString shapeName;
+  MIntArray archive;
+  const std::vector<TransformRef> refs = saveTransformRefsScene(mayaPath, shapeName, archive);
+  EXPECT_TRUE(AL::usdmaya::isBinaryArchive(archive, kTransformRefsMagic));
+
+  AL::usdmaya::nodes::ProxyShape* proxy = openTransformRefsScene(mayaPath, shapeName);
+  ASSERT_TRUE(proxy);
+  EXPECT_TRUE(proxy->isRequiredPath(SdfPath("/root/hip1/knee1")));
+  EXPECT_FALSE(proxy->findRequiredPath(SdfPath("/root/hip1/knee1")).isNull());
+  EXPECT_EQ(refs, readTransformRefs(proxy));
+}
+
+// The text format is still saved alongside the binary archive, so that builds that predate the archive can open the scene
+TEST(ProxyShape, transformRefsLegacyText)
+{
+  const MString mayaPath = buildTempPath("AL_USDMayaTests_transformRefsLegacyText.ma");
+  MString shapeName;
+  MIntArray archive;
+  const std::vector<TransformRef> refs = saveTransformRefsScene(mayaPath, shapeName, archive);
+
+  std::string contents;
+  {
+    std::ifstream file(mayaPath.asChar());
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    contents = buffer.str();
+  }
+  std::smatch match;
+  ASSERT_TRUE(std::regex_search(contents, match, std::regex("setAttr[^;]*\"\\.strcs\" -type \"string\" \"([^\"]*)\";")));
+  const std::string text = match[1].str();
+  for(const TransformRef& ref : refs)
+  {
+    EXPECT_NE(std::string::npos, text.find(transformRefsText({ ref })));
+  }
+
+  // an older build only reads the text, so drop the archive to check that the text alone restores the same refs
+  rewriteTransformRefs(mayaPath, shapeName, nullptr, text);
+  AL::usdmaya::nodes::ProxyShape* proxy = openTransformRefsScene(mayaPath, shapeName);
+  ASSERT_TRUE(proxy);
+  EXPECT_EQ(refs, readTransformRefs(proxy));
+}
+
+// Scenes saved before the binary archive existed only have the text attribute
+TEST(ProxyShape, transformRefsTextFallback)
+{
+  const MString mayaPath = buildTempPath("AL_USDMayaTests_transformRefsTextFallback.ma");
+  MString shapeName;
+  MIntArray archive;
+  const std::vector<TransformRef> refs = saveTransformRefsScene(mayaPath, shapeName, archive);
+  rewriteTransformRefs(mayaPath, shapeName, nullptr, transformRefsText(refs));
+
+  AL::usdmaya::nodes::ProxyShape* proxy = openTransformRefsScene(mayaPath, shapeName);
+  ASSERT_TRUE(proxy);
+  EXPECT_TRUE(proxy->isRequiredPath(SdfPath("/root/hip1/knee1")));
+  EXPECT_EQ(refs, readTransformRefs(proxy));
+}
+
+// An archive that is corrupt, of the wrong kind, or of an unknown version is ignored in favour of the text attribute
+TEST(ProxyShape, transformRefsCorruptArchive)
+{
+  const MString mayaPath = buildTempPath("AL_USDMayaTests_transformRefsCorruptArchive.ma");
+  MString shapeName;
+  MIntArray archive;
+  const std::vector<TransformRef> refs = saveTransformRefsScene(mayaPath, shapeName, archive);
+  ASSERT_GT(archive.length(), 3u);
+  const std::string text = transformRefsText(refs);
+
+  // a version this build doesn't know about
+  {
+    MIntArray newer(archive);
+    newer[1] = newer[1] + 1;
+    rewriteTransformRefs(mayaPath, shapeName, &newer, text);
+    AL::usdmaya::nodes::ProxyShape* proxy = openTransformRefsScene(mayaPath, shapeName);
+    ASSERT_TRUE(proxy);
+    EXPECT_EQ(refs, readTransformRefs(proxy));
+    EXPECT_EQ(MStatus(MS::kSuccess), MFileIO::saveAs(mayaPath));
+  }
+
+  // data that is not a transform refs archive
+  {
+    MIntArray wrongMagic(archive);
+    wrongMagic[0] = 0;
+    rewriteTransformRefs(mayaPath, shapeName, &wrongMagic, text);
+    AL::usdmaya::nodes::ProxyShape* proxy = openTransformRefsScene(mayaPath, shapeName);
+    ASSERT_TRUE(proxy);
+    EXPECT_EQ(refs, readTransformRefs(proxy));
+    EXPECT_EQ(MStatus(MS::kSuccess), MFileIO::saveAs(mayaPath));
+  }
+
+  // a truncated archive, without a text attribute to fall back to, restores nothing (and must not crash)
+  {
+    MIntArray truncated;
+    for(uint32_t i = 0, n = 3 + (archive.length() - 3) / 2; i < n; ++i)
+      truncated.append(archive[i]);
+    rewriteTransformRefs(mayaPath, shapeName, &truncated, std::string());
+    AL::usdmaya::nodes::ProxyShape* proxy = openTransformRefsScene(mayaPath, shapeName);
+    ASSERT_TRUE(proxy);
+    EXPECT_FALSE(proxy->isRequiredPath(SdfPath("/root/hip1/knee1")));
+  }
+}
+
 // Test translating a Mesh Prim via the command
 TEST(ManualTranslate, importMeshPrim)
 {
@@ -1329,6 +1591,71 @@ TEST(ProxyShape, duplication)
   MFileIO::newFile(true);
 }
 
+// void PayloadLoadQueue::enqueue(const UsdStageRefPtr& stage, const SdfPath& path, bool load, double priority);
+// bool PayloadLoadQueue::cancel(const SdfPath& path);
+// void PayloadLoadQueue::flush(bool wait);
+TEST(ProxyShape, asyncPayloadLoad)
+{
+  MFileIO::newFile(true);
+
+  const std::string payloadPath = buildTempPath("AL_USDMayaTests_asyncPayload.usda");
+  const std::string rootPath = buildTempPath("AL_USDMayaTests_asyncPayloadRoot.usda");
+  {
+    UsdStageRefPtr payloadStage = UsdStage::CreateInMemory();
+    UsdGeomXform::Define(payloadStage, SdfPath("/payload/child"));
+    payloadStage->SetDefaultPrim(payloadStage->GetPrimAtPath(SdfPath("/payload")));
+    payloadStage->Export(payloadPath, false);
+
+    UsdStageRefPtr rootStage = UsdStage::CreateInMemory();
+    rootStage->DefinePrim(SdfPath("/root/a")).GetPayloads().AddPayload(SdfPayload(payloadPath));
+    rootStage->DefinePrim(SdfPath("/root/b")).GetPayloads().AddPayload(SdfPayload(payloadPath));
+    rootStage->Export(rootPath, false);
+  }
+
+  MFnDagNode fn;
+  MObject xform = fn.create("transform");
+  MObject shape = fn.create("AL_usdmaya_ProxyShape", xform);
+  AL::usdmaya::nodes::ProxyShape* proxy = (AL::usdmaya::nodes::ProxyShape*)fn.userNode();
+  proxy->unloadedPlug().setBool(true);
+  proxy->filePathPlug().setString(rootPath.c_str());
+
+  UsdStageRefPtr stage = proxy->getUsdStage();
+  ASSERT_TRUE(stage);
+  EXPECT_FALSE(stage->GetPrimAtPath(SdfPath("/root/a/child")));
+  EXPECT_FALSE(stage->GetPrimAtPath(SdfPath("/root/b/child")));
+
+  using AL::usdmaya::nodes::proxy::PayloadLoadQueue;
+  PayloadLoadQueue& queue = proxy->payloadQueue();
+  queue.setMaxConcurrent(1);
+  queue.enqueue(stage, SdfPath("/root/a"), true, 1.0);
+  queue.enqueue(stage, SdfPath("/root/b"), true, 0.0);
+  EXPECT_TRUE(queue.cancel(SdfPath("/root/a")));
+  queue.flush(true);
+
+  EXPECT_EQ(PayloadLoadQueue::State::kCancelled, queue.state(SdfPath("/root/a")));
+  EXPECT_EQ(PayloadLoadQueue::State::kLoaded, queue.state(SdfPath("/root/b")));
+  EXPECT_EQ(PayloadLoadQueue::State::kNone, queue.state(SdfPath("/root/c")));
+  EXPECT_FALSE(stage->GetPrimAtPath(SdfPath("/root/a/child")));
+  EXPECT_TRUE(stage->GetPrimAtPath(SdfPath("/root/b/child")));
+  EXPECT_EQ(0u, queue.numPending());
+
+  size_t completed = 0, total = 0;
+  queue.progress(completed, total);
+  EXPECT_EQ(2u, completed);
+  EXPECT_EQ(2u, total);
+
+  // unloads are applied on the next flush, in the same way as loads
+  queue.enqueue(stage, SdfPath("/root/b"), false);
+  EXPECT_EQ(PayloadLoadQueue::State::kFetched, queue.state(SdfPath("/root/b")));
+  queue.flush();
+  EXPECT_EQ(PayloadLoadQueue::State::kLoaded, queue.state(SdfPath("/root/b")));
+  EXPECT_FALSE(stage->GetPrimAtPath(SdfPath("/root/b/child")));
+
+  // Clear out the scene to avoid crashing in proxy shape code during idle
+  // redraw.
+  MFileIO::newFile(true);
+}
+
 //
 // funcs that aren't easily testable:
 //
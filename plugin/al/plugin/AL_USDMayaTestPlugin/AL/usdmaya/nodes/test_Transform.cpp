@@ -19,11 +19,14 @@
 #include "AL/usdmaya/nodes/Scope.h"
 #include "AL/usdmaya/nodes/TransformationMatrix.h"
 #include "maya/MAnimControl.h"
+#include "maya/MDagModifier.h"
 #include "maya/MFileIO.h"
 #include "maya/MFnDagNode.h"
 #include "maya/MFnTransform.h"
 #include "maya/MGlobal.h"
+#include "maya/MObjectHandle.h"
 #include "maya/MPlug.h"
+#include "maya/MSelectionList.h"
 #include "maya/MStatus.h"
 #include "maya/MTypes.h"
 
@@ -206,3 +209,188 @@ TEST(Transform, animationWithTransform)
 }
 
 
+
+// Transforms connected to a proxy shape are updated through its batch, and must cope with the proxy shape being
+// disconnected or destroyed before they are.
+TEST(Transform, transformBatch)
+{
+  MStatus status;
+  MFileIO::newFile(true);
+  MGlobal::viewFrame(1);
+
+  int optionVarValue = MGlobal::optionVarIntValue("AL_usdmaya_readAnimatedValues");
+  MGlobal::setOptionVarValue("AL_usdmaya_readAnimatedValues", true);
+
+  MString importCommand = "AL_usdmaya_ProxyShapeImport -f \"" +
+                          MString(AL_USDMAYA_TEST_DATA) +
+                          "/cube_moving_zaxis.usda\"";
+
+  MStringArray cmdResults;
+  status = MGlobal::executeCommand(importCommand, cmdResults, true);
+  ASSERT_TRUE(status == MStatus::kSuccess);
+  MString proxyName = cmdResults[0];
+
+  MString selectCommand = "AL_usdmaya_ProxyShapeSelect -primPath \"/pCube1\" -proxy \"" + proxyName + "\"";
+  cmdResults.clear();
+  status = MGlobal::executeCommand(selectCommand, cmdResults, true);
+  ASSERT_TRUE(status == MStatus::kSuccess);
+  MString xformName = cmdResults[0];
+
+  MSelectionList sel;
+  sel.add(proxyName);
+  sel.add(xformName);
+  MObject proxyNode;
+  MDagPath xformDagPath;
+  sel.getDependNode(0, proxyNode);
+  sel.getDagPath(1, xformDagPath);
+  MFnDagNode proxyMFn(proxyNode, &status);
+  ASSERT_TRUE(status == MStatus::kSuccess);
+  MFnDagNode xformMFn(xformDagPath, &status);
+  ASSERT_TRUE(status == MStatus::kSuccess);
+
+  auto proxy = dynamic_cast<ProxyShape*>(proxyMFn.userNode(&status));
+  ASSERT_TRUE(proxy);
+  EXPECT_EQ(1u, proxy->transformBatch().size());
+
+  // the batched update gives the same values as reading the transform on its own
+  MGlobal::viewFrame(10);
+  EXPECT_FLOAT_EQ(xformMFn.findPlug("translateZ").asDouble(), -6.7904988904413575);
+
+  // disconnecting the transform from the proxy shape removes it from the batch, and it then updates on its own
+  MPlug inStageData = xformMFn.findPlug("inStageData");
+  MDGModifier modifier;
+  modifier.disconnect(inStageData.source(), inStageData);
+  ASSERT_TRUE(modifier.doIt() == MStatus::kSuccess);
+  EXPECT_EQ(0u, proxy->transformBatch().size());
+
+  ASSERT_TRUE(modifier.undoIt() == MStatus::kSuccess);
+  EXPECT_EQ(1u, proxy->transformBatch().size());
+  MGlobal::viewFrame(24);
+  EXPECT_FLOAT_EQ(xformMFn.findPlug("translateZ").asDouble(), -20.0);
+
+  // destroy the proxy shape before the transform, then make sure that evaluating and destroying the transform does not
+  // touch the batch of the destroyed proxy shape
+  MObjectHandle xformHandle(xformDagPath.node());
+  proxy = nullptr;
+  {
+    // the modifier keeps the deleted node alive so that it can be undone
+    MDagModifier deleteProxy;
+    deleteProxy.deleteNode(proxyNode);
+    ASSERT_TRUE(deleteProxy.doIt() == MStatus::kSuccess);
+  }
+  MGlobal::executeCommand("flushUndo");
+
+  if(xformHandle.isValid())
+  {
+    MGlobal::viewFrame(10);
+    MFnDependencyNode(xformHandle.object()).findPlug("translateZ").asDouble();
+  }
+  MFileIO::newFile(true);
+
+  MGlobal::setOptionVarValue("AL_usdmaya_readAnimatedValues", optionVarValue);
+}
+
+// Play back a scene with an AL transform under the parallel evaluation manager, and make sure the values match USD
+// every frame, and that duplicated proxy shapes have their stages loaded before they are evaluated.
+TEST(Transform, parallelEvaluation)
+{
+  MStatus status;
+  MFileIO::newFile(true);
+  MGlobal::viewFrame(1);
+
+  int optionVarValue = MGlobal::optionVarIntValue("AL_usdmaya_readAnimatedValues");
+  MGlobal::setOptionVarValue("AL_usdmaya_readAnimatedValues", true);
+
+  MStringArray evaluationMode;
+  MGlobal::executeCommand("evaluationManager -q -mode", evaluationMode);
+  ASSERT_TRUE(MGlobal::executeCommand("evaluationManager -mode \"parallel\"") == MStatus::kSuccess);
+
+  MString importCommand = "AL_usdmaya_ProxyShapeImport -f \"" +
+                          MString(AL_USDMAYA_TEST_DATA) +
+                          "/cube_moving_zaxis.usda\"";
+
+  MStringArray cmdResults;
+  status = MGlobal::executeCommand(importCommand, cmdResults, true);
+  ASSERT_TRUE(status == MStatus::kSuccess);
+  MString proxyName = cmdResults[0];
+
+  MString selectCommand = "AL_usdmaya_ProxyShapeSelect -primPath \"/pCube1\" -proxy \"" + proxyName + "\"";
+  cmdResults.clear();
+  status = MGlobal::executeCommand(selectCommand, cmdResults, true);
+  ASSERT_TRUE(status == MStatus::kSuccess);
+  MString xformName = cmdResults[0];
+
+  MSelectionList sel;
+  sel.add(proxyName);
+  sel.add(xformName);
+  MObject proxyNode;
+  MDagPath xformDagPath;
+  sel.getDependNode(0, proxyNode);
+  sel.getDagPath(1, xformDagPath);
+  MFnDagNode proxyMFn(proxyNode, &status);
+  ASSERT_TRUE(status == MStatus::kSuccess);
+  MFnDagNode xformMFn(xformDagPath, &status);
+  ASSERT_TRUE(status == MStatus::kSuccess);
+
+  auto proxy = dynamic_cast<ProxyShape*>(proxyMFn.userNode(&status));
+  ASSERT_TRUE(proxy);
+  UsdGeomXformable xformable(proxy->usdStage()->GetPrimAtPath(SdfPath("/pCube1")));
+  ASSERT_TRUE(xformable);
+
+  MStringArray currentMode;
+  MGlobal::executeCommand("evaluationManager -q -mode", currentMode);
+  ASSERT_EQ(1u, currentMode.length());
+  EXPECT_EQ(MString("parallel"), currentMode[0]);
+
+  auto playback = [&xformMFn, &xformable]()
+  {
+    for(int frame = 1; frame <= 24; ++frame)
+    {
+      MGlobal::viewFrame(frame);
+      GfMatrix4d transform;
+      bool resetsXform;
+      xformable.GetLocalTransformation(&transform, &resetsXform, UsdTimeCode(frame));
+      EXPECT_FLOAT_EQ(transform.ExtractTranslation()[2], xformMFn.findPlug("translateZ").asDouble());
+    }
+  };
+
+  { SCOPED_TRACE(""); playback(); }
+
+  // duplicating the proxy shape loads its stage once the duplicate has completed, rather than from the evaluation
+  MSelectionList proxySelection;
+  proxySelection.add(proxyNode);
+  EXPECT_TRUE(MGlobal::setActiveSelectionList(proxySelection));
+  EXPECT_TRUE(MGlobal::executeCommand("duplicate"));
+  MSelectionList duplicated;
+  MGlobal::getActiveSelectionList(duplicated);
+  MDagPath dupPath;
+  ASSERT_TRUE(duplicated.getDagPath(0, dupPath));
+  ASSERT_TRUE(dupPath.extendToShape());
+  auto dupProxy = dynamic_cast<ProxyShape*>(MFnDagNode(dupPath).userNode());
+  ASSERT_TRUE(dupProxy);
+  EXPECT_TRUE(dupProxy->usdStage());
+
+  { SCOPED_TRACE(""); playback(); }
+  EXPECT_TRUE(dupProxy->getUsdStage());
+
+  // a copy made without the duplicate command is loaded when maya next goes idle, which is done by hand here
+  MObject apiCopy = MFnDagNode(dupPath).duplicate();
+  MDagPath apiCopyPath;
+  ASSERT_TRUE(MDagPath::getAPathTo(apiCopy, apiCopyPath));
+  ASSERT_TRUE(apiCopyPath.extendToShape());
+  auto apiCopyProxy = dynamic_cast<ProxyShape*>(MFnDagNode(apiCopyPath).userNode());
+  ASSERT_TRUE(apiCopyProxy);
+  ProxyShape::loadDuplicatedProxyShapes();
+  EXPECT_TRUE(apiCopyProxy->usdStage());
+
+  { SCOPED_TRACE(""); playback(); }
+  EXPECT_TRUE(apiCopyProxy->getUsdStage());
+
+  MFileIO::newFile(true);
+
+  if(evaluationMode.length())
+  {
+    MGlobal::executeCommand("evaluationManager -mode \"" + evaluationMode[0] + "\"");
+  }
+  MGlobal::setOptionVarValue("AL_usdmaya_readAnimatedValues", optionVarValue);
+}
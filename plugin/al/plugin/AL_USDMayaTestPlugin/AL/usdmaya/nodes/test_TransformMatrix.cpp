@@ -1523,3 +1523,57 @@ TEST(Transform, dontWriteToUsdOnSelection)
   EXPECT_EQ(priorContents, postContents);
 }
 
+
+TEST(Transform, deferredPushToPrim)
+{
+  MFileIO::newFile(true);
+
+  const std::string temp_path = buildTempPath("AL_USDMayaTests_transform_deferredPushToPrim.usda");
+  {
+    UsdStageRefPtr stage = UsdStage::CreateInMemory();
+    UsdGeomXform a = UsdGeomXform::Define(stage, SdfPath("/tm"));
+    a.AddTranslateOp(UsdGeomXformOp::PrecisionDouble, TfToken("translate")).Set(GfVec3d(0, 0, 0));
+    stage->Export(temp_path, false);
+  }
+
+  const int previous = MGlobal::optionVarIntValue("AL_usdmaya_deferPushToPrim");
+  MGlobal::setOptionVarValue("AL_usdmaya_deferPushToPrim", true);
+
+  MFnDagNode fn;
+  MObject xform = fn.create("transform");
+  MObject shape = fn.create("AL_usdmaya_ProxyShape", xform);
+
+  AL::usdmaya::nodes::ProxyShape* proxy = (AL::usdmaya::nodes::ProxyShape*)fn.userNode();
+  proxy->filePathPlug().setString(temp_path.c_str());
+  auto stage = proxy->getUsdStage();
+
+  MDagModifier modifier1;
+  MDGModifier modifier2;
+  MObject leafNode = proxy->makeUsdTransforms(stage->GetPrimAtPath(SdfPath("/tm")), modifier1, AL::usdmaya::nodes::ProxyShape::kRequested, &modifier2);
+  EXPECT_EQ(MStatus(MS::kSuccess), modifier1.doIt());
+  EXPECT_EQ(MStatus(MS::kSuccess), modifier2.doIt());
+
+  MFnTransform fnx(leafNode);
+  AL::usdmaya::nodes::Transform* transformNode = (AL::usdmaya::nodes::Transform*)fnx.userNode();
+  transformNode->pushToPrimPlug().setValue(true);
+  transformNode->readAnimatedValuesPlug().setValue(false);
+
+  bool reset;
+  UsdGeomXformOp translate = UsdGeomXform(stage->GetPrimAtPath(SdfPath("/tm"))).GetOrderedXformOps(&reset)[0];
+
+  // the edit is queued up, and the prim is left untouched until the queue is flushed
+  fnx.setTranslation(MVector(1.0, 2.0, 3.0), MSpace::kTransform);
+  GfVec3d t(0, 0, 0);
+  translate.Get(&t);
+  EXPECT_EQ(GfVec3d(0, 0, 0), t);
+  EXPECT_TRUE(transformNode->getTransMatrix()->hasPendingPushes());
+
+  EXPECT_EQ(MStatus(MS::kSuccess), MGlobal::executeCommand("AL_usdmaya_ProxyShapeFlushPushToPrim"));
+  translate.Get(&t);
+  EXPECT_NEAR(1.0, t[0], 1e-5);
+  EXPECT_NEAR(2.0, t[1], 1e-5);
+  EXPECT_NEAR(3.0, t[2], 1e-5);
+  EXPECT_FALSE(transformNode->getTransMatrix()->hasPendingPushes());
+
+  MGlobal::setOptionVarValue("AL_usdmaya_deferPushToPrim", previous);
+}
@@ -64,27 +64,59 @@ TEST(TranslatorContext, PrimLookup)
   EXPECT_TRUE(obj2 == cnref.createdNodes()[0].object());
 }
 
-// bool TranslatorContext::value_compare::operator() (const PrimLookup& a, const SdfPath& b) const
-// bool TranslatorContext::value_compare::operator() (const SdfPath& a, const PrimLookup& b) const
-// bool TranslatorContext::value_compare::operator() (const PrimLookup& a, const PrimLookup& b) const
-TEST(TranslatorContext, value_compare)
+// std::pair<iterator, bool> TranslatorContext::PrimLookupTable::insert(PrimLookup lookup);
+// iterator TranslatorContext::PrimLookupTable::erase(iterator it);
+// bool TranslatorContext::PrimLookupTable::erase(const SdfPath& path);
+// void TranslatorContext::PrimLookupTable::findSubtree(const SdfPath& path, SdfPathVector& paths) const;
+TEST(TranslatorContext, PrimLookupTable)
 {
-  SdfPath path1("/hello/dave");
-  SdfPath path2("/hello/fred");
-
-  AL::usdmaya::fileio::translators::TranslatorContext::PrimLookup aref(path1, TfToken("transform"), MObject());
-  AL::usdmaya::fileio::translators::TranslatorContext::PrimLookup bref(path2, TfToken("transform"), MObject());
-  AL::usdmaya::fileio::translators::TranslatorContext::value_compare compare;
-
-  EXPECT_EQ(compare(aref, path2), path1 < path2);
-  EXPECT_EQ(compare(path1, bref), path1 < path2);
-  EXPECT_EQ(compare(aref, bref), path1 < path2);
-  EXPECT_EQ(compare(path2, aref), path2 < path1);
-  EXPECT_EQ(compare(bref, path1), path2 < path1);
-  EXPECT_EQ(compare(bref, aref), path2 < path1);
+  typedef AL::usdmaya::fileio::translators::TranslatorContext::PrimLookup PrimLookup;
+  AL::usdmaya::fileio::translators::TranslatorContext::PrimLookupTable table;
+
+  const SdfPath paths[] = {
+    SdfPath("/hello/dave"),
+    SdfPath("/hello/fred"),
+    SdfPath("/hello/dave/child"),
+    SdfPath("/hello/dave/child/grandchild"),
+    SdfPath("/hello_world"),
+  };
+  for(const SdfPath& path : paths)
+  {
+    EXPECT_TRUE(table.insert(PrimLookup(path, "transform", MObject())).second);
+  }
+  EXPECT_FALSE(table.insert(PrimLookup(paths[0], "mesh", MObject())).second);
+  EXPECT_EQ(5u, table.size());
+  EXPECT_EQ("transform", table.find(paths[0])->translatorId());
+  EXPECT_TRUE(table.find(SdfPath("/hello")) == table.end());
+
+  // parents are returned before their children, and siblings with a common prefix are not descendants
+  SdfPathVector subtree;
+  table.findSubtree(SdfPath("/hello"), subtree);
+  ASSERT_EQ(4u, subtree.size());
+  EXPECT_EQ(paths[0], subtree[0]);
+  EXPECT_EQ(paths[2], subtree[1]);
+  EXPECT_EQ(paths[3], subtree[2]);
+  EXPECT_EQ(paths[1], subtree[3]);
+
+  // removing a prim leaves the mappings of its descendants in place
+  EXPECT_TRUE(table.erase(paths[2]));
+  EXPECT_FALSE(table.erase(paths[2]));
+  subtree.clear();
+  table.findSubtree(paths[0], subtree);
+  ASSERT_EQ(2u, subtree.size());
+  EXPECT_EQ(paths[0], subtree[0]);
+  EXPECT_EQ(paths[3], subtree[1]);
+
+  for(auto it = table.begin(); it != table.end(); )
+  {
+    it = table.erase(it);
+  }
+  EXPECT_TRUE(table.empty());
+  subtree.clear();
+  table.findSubtree(SdfPath::AbsoluteRootPath(), subtree);
+  EXPECT_TRUE(subtree.empty());
 }
 
-
 // static RefPtr TranslatorContext::create(nodes::ProxyShape* proxyShape);
 // const nodes::ProxyShape* TranslatorContext::getProxyShape() const;
 // UsdStageRefPtr TranslatorContext::getUsdStage() const;
@@ -97,6 +129,8 @@ TEST(TranslatorContext, value_compare)
 // bool TranslatorContext::getMObjects(const UsdPrim& prim, MObjectHandleArray& returned);
 // bool TranslatorContext::getMObjects(const SdfPath& path, MObjectHandleArray& returned);
 // void TranslatorContext::insertItem(const UsdPrim& prim, MObjectHandle object);
+// void TranslatorContext::insertItems(const UsdPrim& prim, const MObjectHandleArray& objects);
+// void TranslatorContext::registerItems(const std::vector<UsdPrim>& prims, const MObjectHandleArray& objects);
 // void TranslatorContext::removeItems(const UsdPrim& prim);
 // void TranslatorContext::removeItems(const SdfPath& path);
 // TfToken TranslatorContext::getTypeForPath(SdfPath path) const
@@ -235,6 +269,62 @@ TEST(TranslatorContext, TranslatorContext)
       context->removeItems(SdfPath("/root/rig"));
     }
 
+    {
+      obj = fnd.create("polyCube");
+      AL::usdmaya::fileio::translators::MObjectHandleArray created;
+      created.push_back(MObjectHandle(obj));
+      created.push_back(MObjectHandle(fnd.create("polyCube")));
+      context->registerItems(std::vector<UsdPrim>(1, prim), AL::usdmaya::fileio::translators::MObjectHandleArray(1, transformHandle));
+      context->insertItems(prim, created);
+      {
+        AL::usdmaya::fileio::translators::MObjectHandleArray handles;
+        context->getMObjects(SdfPath("/root/rig"), handles);
+        ASSERT_EQ(handles.size(), 2u);
+        EXPECT_TRUE(handles[0].object() == obj);
+        EXPECT_TRUE(handles[1].object() == created[1].object());
+      }
+      {
+        MObjectHandle handle;
+        context->getTransform(SdfPath("/root/rig"), handle);
+        EXPECT_TRUE(handle.object() == rigObj);
+      }
+      context->removeItems(SdfPath("/root/rig"));
+    }
+
+    {
+      obj = fnd.create("polyCube");
+      context->registerItem(prim, transformHandle);
+      context->insertItem(prim, obj);
+      context->updateUniqueKeys();
+      const std::size_t uniqueKey = context->getUniqueKeyForPath(SdfPath("/root/rig"));
+      MIntArray data = context->serialiseBinary();
+      context->clearPrimMappings();
+      EXPECT_TRUE(context->deserialiseBinary(data));
+      {
+        AL::usdmaya::fileio::translators::MObjectHandleArray handles;
+        context->getMObjects(SdfPath("/root/rig"), handles);
+        ASSERT_EQ(handles.size(), 1u);
+        EXPECT_TRUE(handles[0].object() == obj);
+      }
+      translatorId = context->getTranslatorIdForPath(SdfPath("/root/rig"));
+      EXPECT_TRUE("schematype:ALMayaReference"  == translatorId);
+      EXPECT_EQ(uniqueKey, context->getUniqueKeyForPath(SdfPath("/root/rig")));
+      {
+        MObjectHandle handle;
+        context->getTransform(SdfPath("/root/rig"), handle);
+        EXPECT_TRUE(handle.object() == rigObj);
+      }
+
+      // truncated data must be rejected without touching the context
+      data.setLength(data.length() - 1);
+      context->clearPrimMappings();
+      EXPECT_FALSE(context->deserialiseBinary(data));
+      EXPECT_FALSE(context->hasEntry(SdfPath("/root/rig"), "schematype:ALMayaReference"));
+      EXPECT_FALSE(context->deserialiseBinary(MIntArray()));
+
+      context->removeItems(SdfPath("/root/rig"));
+    }
+
     {
       obj = fnd.create("polyCube");
       context->registerItem(prim, transformHandle);
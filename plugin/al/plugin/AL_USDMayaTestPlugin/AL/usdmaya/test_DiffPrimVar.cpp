@@ -306,6 +306,63 @@ TEST(DiffPrimVar, diffHoles1)
   sl.clear();
 }
 
+TEST(DiffPrimVar, meshFingerprint)
+{
+  MFileIO::newFile(true);
+  MStringArray result;
+
+  ASSERT_TRUE(MGlobal::executeCommand("polyCube -w 1 -h 1 -d 1 -sx 2 -sy 2 -sz 2 -ax 0 1 0 -cuv 2 -ch 1", result) == MS::kSuccess);
+  ASSERT_TRUE(result.length() == 2);
+  ASSERT_TRUE(MGlobal::executeCommand("delete -ch pCubeShape1") == MS::kSuccess);
+
+  MSelectionList sl;
+  EXPECT_TRUE(sl.add("pCubeShape1")  == MS::kSuccess);
+  MObject obj;
+  sl.getDependNode(0, obj);
+  MFnMesh fn(obj);
+
+  using AL::usdmaya::utils::computeMeshFingerprint;
+  using AL::usdmaya::utils::diffFingerprints;
+  const AL::usdmaya::utils::MeshFingerprint original = computeMeshFingerprint(fn);
+  EXPECT_TRUE(original.valid);
+  EXPECT_EQ(1u, original.uvSets.size());
+
+  // an invalid fingerprint flags everything as changed, an unchanged mesh nothing
+  EXPECT_EQ(uint32_t(AL::usdmaya::utils::kAllComponents), diffFingerprints(AL::usdmaya::utils::MeshFingerprint(), original));
+  EXPECT_EQ(0u, diffFingerprints(original, computeMeshFingerprint(fn)));
+
+  {
+    MPoint p;
+    fn.getPoint(3, p);
+    p.y += 0.5;
+    fn.setPoint(3, p);
+    EXPECT_EQ(uint32_t(AL::usdmaya::utils::kPoints), diffFingerprints(original, computeMeshFingerprint(fn)) & AL::usdmaya::utils::kPoints);
+    EXPECT_EQ(0u, diffFingerprints(original, computeMeshFingerprint(fn)) & AL::usdmaya::utils::kFaceVertexIndices);
+    p.y -= 0.5;
+    fn.setPoint(3, p);
+  }
+
+  {
+    MUintArray invisibleFaces;
+    invisibleFaces.append(2);
+    ASSERT_TRUE(fn.setInvisibleFaces(invisibleFaces) == MS::kSuccess);
+    EXPECT_EQ(uint32_t(AL::usdmaya::utils::kHoleIndices), diffFingerprints(original, computeMeshFingerprint(fn)));
+  }
+
+  {
+    MString uvSet("map1");
+    float u, v;
+    fn.getUV(0, u, v, &uvSet);
+    fn.setUV(0, u + 0.25f, v, &uvSet);
+    const uint32_t diff = diffFingerprints(original, computeMeshFingerprint(fn));
+    EXPECT_EQ(uint32_t(AL::usdmaya::utils::kUvSets), diff & AL::usdmaya::utils::kUvSets);
+    EXPECT_EQ(0u, diff & AL::usdmaya::utils::kColourSets);
+  }
+
+  ASSERT_TRUE(MGlobal::executeCommand("polyColorPerVertex -rgb 1 0 0 -cdo pCube1") == MS::kSuccess);
+  EXPECT_EQ(uint32_t(AL::usdmaya::utils::kColourSets), diffFingerprints(original, computeMeshFingerprint(fn)) & AL::usdmaya::utils::kColourSets);
+}
+
 // test the holes set via the addHoles approach of defining holes via the magical second approach
 TEST(DiffPrimVar, diffCreaseEdges)
 {
@@ -23,6 +23,7 @@
 #include "maya/MIntArray.h"
 #include "maya/MFnMesh.h"
 #include "maya/MFnSet.h"
+#include "maya/MObjectArray.h"
 #include "maya/MFileIO.h"
 #include "maya/MNodeClass.h"
 
@@ -84,7 +85,33 @@ MStatus Mesh::import(const UsdPrim& prim, MObject& parent, MObject& createdObj)
     dagName += "Shape";
   }
 
-  AL::usdmaya::utils::MeshImportContext importContext(mesh, parent, dagName, timeCode);
+  AL::usdmaya::utils::MeshImportContext importContext(mesh, timeCode);
+
+  // If a variant switch has just torn down a mesh with the same topology (e.g. when switching between look variants),
+  // reuse it rather than creating a new one.
+  bool reused = false;
+  if(ctx && ctx->isNodePoolEnabled())
+  {
+    MObject pooled = ctx->acquireFromNodePool(getTranslatedType(), importContext.topologySignature(), parent);
+    if(!pooled.isNull())
+    {
+      reused = importContext.reuseMesh(pooled, dagName);
+      if(reused)
+      {
+        removeFromShadingGroups(pooled);
+      }
+      else
+      {
+        MFnMesh fnPooled(pooled);
+        ctx->releaseToNodePool(prim.GetPath(), pooled, getTranslatedType(), AL::usdmaya::utils::computeTopologySignature(fnPooled));
+      }
+    }
+  }
+  if(!reused)
+  {
+    importContext.createMesh(parent, dagName);
+  }
+
   importContext.applyVertexNormals();
   importContext.applyHoleFaces();
   importContext.applyVertexCreases();
@@ -108,6 +135,16 @@ MStatus Mesh::import(const UsdPrim& prim, MObject& parent, MObject& createdObj)
     ctx->insertItem(prim, createdObj);
   }
 
+  // Edits are written back at the default time, so the imported mesh only matches that if the data is not animated.
+  auto isAnimated = [](const UsdAttribute& attr) { return attr.ValueMightBeTimeVarying(); };
+  if(timeCode.IsDefault() ||
+     !(isAnimated(mesh.GetPointsAttr()) || isAnimated(mesh.GetNormalsAttr()) ||
+       isAnimated(mesh.GetFaceVertexCountsAttr()) || isAnimated(mesh.GetFaceVertexIndicesAttr())))
+  {
+    MFnMesh fnMesh(createdObj);
+    m_fingerprints[prim.GetPath()] = AL::usdmaya::utils::computeMeshFingerprint(fnMesh);
+  }
+
   TfToken vis = mesh.ComputeVisibility(timeCode);
   // if the visibility token is not `invisible` then, make it visible
   DgNodeTranslator::setBool(parent, m_visible, vis != UsdGeomTokens->invisible);
@@ -186,11 +223,38 @@ MStatus Mesh::tearDown(const SdfPath& path)
 {
   TF_DEBUG(ALUSDMAYA_TRANSLATORS).Msg("MeshTranslator::tearDown prim=%s\n", path.GetText());
 
+  // hand the mesh to the node pool, so that a prim with the same topology imported by the same variant switch can
+  // reuse it. If the pool is not enabled, the mesh is deleted along with the prim's other nodes.
+  MObjectHandle obj;
+  if(context()->isNodePoolEnabled() && context()->getMObject(path, obj, MFn::kMesh) && obj.isValid() && obj.isAlive())
+  {
+    MFnMesh fnMesh(obj.object());
+    context()->releaseToNodePool(path, obj.object(), getTranslatedType(), AL::usdmaya::utils::computeTopologySignature(fnMesh));
+  }
+
   context()->removeItems(path);
   context()->removeExcludedGeometry(path);
+  m_fingerprints.erase(path);
   return MS::kSuccess;
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+void Mesh::removeFromShadingGroups(const MObject& shape)
+{
+  MDagPath path;
+  MDagPath::getAPathTo(shape, path);
+  MFnMesh fnMesh(path);
+  MObjectArray sets, components;
+  if(fnMesh.getConnectedSetsAndMembers(path.instanceNumber(), sets, components, true))
+  {
+    for(uint32_t i = 0, n = sets.length(); i < n; ++i)
+    {
+      MFnSet fnSet(sets[i]);
+      fnSet.removeMember(path, components[i]);
+    }
+  }
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 MStatus Mesh::update(const UsdPrim& path)
 {
@@ -233,7 +297,9 @@ MStatus Mesh::preTearDown(UsdPrim& prim)
     AL_MAYA_CHECK_ERROR(status, MString("unable to attach function set to mesh: ") + path.fullPathName());
 
     UsdGeomMesh geomPrim(prim);
-    writeEdits(path, geomPrim, kPerformDiff | kDynamicAttributes);
+    auto fingerprint = m_fingerprints.find(prim.GetPath());
+    writeEdits(path, geomPrim, kPerformDiff | kDynamicAttributes,
+               fingerprint != m_fingerprints.end() ? &fingerprint->second : nullptr);
   }
   else
   {
@@ -244,11 +310,12 @@ MStatus Mesh::preTearDown(UsdPrim& prim)
 }
 
 //----------------------------------------------------------------------------------------------------------------------
-void Mesh::writeEdits(MDagPath& dagPath, UsdGeomMesh& geomPrim, uint32_t options)
+void Mesh::writeEdits(MDagPath& dagPath, UsdGeomMesh& geomPrim, uint32_t options, AL::usdmaya::utils::MeshFingerprint* fingerprint)
 {
   TF_DEBUG(ALUSDMAYA_TRANSLATORS).Msg("MeshTranslator::writing edits to prim='%s'\n", geomPrim.GetPath().GetText());
   UsdTimeCode t = UsdTimeCode::Default();
-  AL::usdmaya::utils::MeshExportContext context(dagPath, geomPrim, t, options & kPerformDiff);
+  AL::usdmaya::utils::MeshExportContext context(dagPath, geomPrim, t, options & kPerformDiff,
+      AL::usdmaya::utils::MeshExportContext::kFull, false, fingerprint);
   if(context)
   {
     context.copyVertexData(t);
@@ -16,6 +16,9 @@
 
 #pragma once
 #include "AL/usdmaya/fileio/translators/TranslatorBase.h"
+#include "AL/usdmaya/utils/DiffPrimVar.h"
+
+#include <unordered_map>
 
 
 namespace AL{
@@ -55,9 +58,15 @@ private:
     kPerformDiff = 1 << 0,
     kDynamicAttributes = 1 << 1
   };
-  void writeEdits(MDagPath& dagPath, UsdGeomMesh& geomPrim, uint32_t options = kDynamicAttributes);
+  void writeEdits(MDagPath& dagPath, UsdGeomMesh& geomPrim, uint32_t options = kDynamicAttributes,
+                  AL::usdmaya::utils::MeshFingerprint* fingerprint = nullptr);
+  /// remove a mesh that is being reused from the shading groups it was previously assigned to
+  static void removeFromShadingGroups(const MObject& shape);
   static MObject m_visible;
 
+  /// the fingerprints of the imported meshes, taken when they last matched their prims
+  std::unordered_map<SdfPath, AL::usdmaya::utils::MeshFingerprint, SdfPath::Hash> m_fingerprints;
+
 };
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -276,6 +276,52 @@ class TestTranslator(unittest.TestCase):
         variantSet.SetVariantSelection("")
         self.assertEqual(len(mc.ls(type='mesh')), 0)
 
+    def testMeshTranslator_variantswitchReusesMesh(self):
+        mc.AL_usdmaya_ProxyShapeImport(file='./testMeshVariants.usda')
+        stage = translatortestutils.getStage()
+        stage.SetEditTarget(stage.GetSessionLayer())
+
+        variantPrim = stage.GetPrimAtPath("/TestVariantSwitch")
+        variantSet = variantPrim.GetVariantSet("MeshVariants")
+        variantSet.SetVariantSelection("ShowMeshAnB")
+
+        mc.AL_usdmaya_TranslatePrim(ip="/TestVariantSwitch/MeshA", fi=True, proxy="AL_usdmaya_Proxy")
+        self.assertEqual(len(mc.ls(type='mesh')), 1)
+        meshUuid = mc.ls(type='mesh', uuid=True)[0]
+
+        # both meshes reference the same sphere, so tearing down MeshA and importing MeshB in the same translation
+        # should reuse the mesh node rather than creating a new one
+        mc.AL_usdmaya_TranslatePrim(tp="/TestVariantSwitch/MeshA", ip="/TestVariantSwitch/MeshB", fi=True, proxy="AL_usdmaya_Proxy")
+        self.assertEqual(len(mc.ls('MeshA')), 0)
+        self.assertEqual(len(mc.ls('MeshB')), 1)
+        self.assertEqual(len(mc.ls(type='mesh')), 1)
+        self.assertEqual(mc.ls(type='mesh', uuid=True)[0], meshUuid)
+        self.assertEqual(len(mc.ls('AL_usdmaya_nodePool')), 0)
+
+        # with nothing to reuse the mesh, it should be deleted
+        mc.AL_usdmaya_TranslatePrim(tp="/TestVariantSwitch/MeshB", proxy="AL_usdmaya_Proxy")
+        self.assertEqual(len(mc.ls(type='mesh')), 0)
+        self.assertEqual(len(mc.ls('AL_usdmaya_nodePool')), 0)
+
+    def testMeshTranslator_reusedMeshUnlocksNormals(self):
+        mc.AL_usdmaya_ProxyShapeImport(file='./testMeshVariants.usda')
+        stage = translatortestutils.getStage()
+        stage.SetEditTarget(stage.GetSessionLayer())
+
+        variantPrim = stage.GetPrimAtPath("/TestVariantSwitch")
+        variantSet = variantPrim.GetVariantSet("MeshVariants")
+        variantSet.SetVariantSelection("ShowMeshAnB")
+
+        mc.AL_usdmaya_TranslatePrim(ip="/TestVariantSwitch/MeshA", fi=True, proxy="AL_usdmaya_Proxy")
+        meshUuid = mc.ls(type='mesh', uuid=True)[0]
+        mc.polyNormalPerVertex('MeshA.vtx[*]', freezeNormal=True)
+        self.assertTrue(all(mc.polyNormalPerVertex('MeshA.vtx[*]', query=True, freezeNormal=True)))
+
+        # MeshB has no authored normals, so it must not inherit the normals locked on the mesh it reuses
+        mc.AL_usdmaya_TranslatePrim(tp="/TestVariantSwitch/MeshA", ip="/TestVariantSwitch/MeshB", fi=True, proxy="AL_usdmaya_Proxy")
+        self.assertEqual(mc.ls(type='mesh', uuid=True)[0], meshUuid)
+        self.assertFalse(any(mc.polyNormalPerVertex('MeshB.vtx[*]', query=True, freezeNormal=True)))
+
     def testNurbsCurve_TranslatorExists(self):
         """
         Test that the NurbsCurve Translator exists
@@ -19,6 +19,9 @@
 #include <mayaUsdUtils/ALHalf.h>
 #include <mayaUsdUtils/SIMD.h>
 
+#include "maya/MArrayDataBuilder.h"
+#include "maya/MArrayDataHandle.h"
+#include "maya/MDataHandle.h"
 #include "maya/MDGModifier.h"
 #include "maya/MFloatArray.h"
 #include "maya/MFloatMatrix.h"
@@ -30,16 +33,307 @@
 #include "maya/MFnNumericAttribute.h"
 #include "maya/MFnNumericData.h"
 #include "maya/MFnTypedAttribute.h"
+#include "maya/MFnUnitAttribute.h"
 #include "maya/MMatrix.h"
 #include "maya/MMatrixArray.h"
 #include "maya/MObjectArray.h"
 
 #include <iostream>
+#include <vector>
 
 namespace AL {
 namespace usdmaya {
 namespace utils {
 
+namespace {
+
+//----------------------------------------------------------------------------------------------------------------------
+/// \brief  reads every element of an array attribute through a single MArrayDataHandle, rather than constructing an
+///         MPlug per element. Fails if the array is sparse, in which case the callers fall back to the element plugs.
+/// \param  plug the array plug to read
+/// \param  values the output values (count * stride in length)
+/// \param  count the number of elements in the array
+/// \param  stride the number of values in each element
+/// \param  get the function that extracts the values from an element data handle
+//----------------------------------------------------------------------------------------------------------------------
+template<typename T, typename Getter>
+MStatus readArrayElements(const MPlug& plug, T* const values, const size_t count, const size_t stride, Getter get)
+{
+  MStatus status;
+  MDataHandle handle = plug.asMDataHandle(&status);
+  if(!status)
+    return status;
+
+  MArrayDataHandle arrayHandle(handle, &status);
+  if(status && arrayHandle.elementCount() != count)
+  {
+    status = MS::kFailure;
+  }
+  for(size_t i = 0; status && i < count; ++i, arrayHandle.next())
+  {
+    const uint32_t index = arrayHandle.elementIndex(&status);
+    if(!status || index >= count)
+    {
+      status = MS::kFailure;
+      break;
+    }
+    MDataHandle element = arrayHandle.inputValue(&status);
+    if(status)
+    {
+      get(element, values + index * stride);
+    }
+  }
+  plug.destructHandle(handle);
+  return status;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+/// \brief  writes the elements [0, count) of an array attribute with a single MArrayDataBuilder, and sets the whole
+///         array back on the plug in one go.
+/// \param  plug the array plug to write
+/// \param  values the input values (count * stride in length)
+/// \param  count the number of elements to write
+/// \param  stride the number of values in each element
+/// \param  set the function that stores the values into an element data handle
+//----------------------------------------------------------------------------------------------------------------------
+template<typename T, typename Setter>
+MStatus writeArrayElements(const MPlug& plug, const T* const values, const size_t count, const size_t stride, Setter set)
+{
+  MStatus status;
+  MDataHandle handle = plug.asMDataHandle(&status);
+  if(!status)
+    return status;
+
+  MArrayDataHandle arrayHandle(handle, &status);
+  if(status)
+  {
+    MArrayDataBuilder builder = arrayHandle.builder(&status);
+    for(size_t i = 0; status && i < count; ++i)
+    {
+      MDataHandle element = builder.addElement(uint32_t(i), &status);
+      if(status)
+      {
+        set(element, values + i * stride);
+      }
+    }
+    if(status)
+    {
+      status = arrayHandle.set(builder);
+    }
+    if(status)
+    {
+      status = const_cast<MPlug&>(plug).setMDataHandle(handle);
+    }
+  }
+  plug.destructHandle(handle);
+  return status;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+/// \brief  describes how to read and write the N values of a numeric element of type T from a data handle
+//----------------------------------------------------------------------------------------------------------------------
+template<typename T, int N> struct NumericElement;
+
+#define AL_NUMERIC_ELEMENT(T, N, TYPE, GET, SET) \
+  template<> struct NumericElement<T, N> { \
+    static constexpr MFnNumericData::Type type = MFnNumericData::TYPE; \
+    static void get(MDataHandle& h, T* const v) { GET; } \
+    static void set(MDataHandle& h, const T* const v) { SET; } \
+  };
+
+AL_NUMERIC_ELEMENT(bool, 1, kBoolean, v[0] = h.asBool(), h.setBool(v[0]))
+AL_NUMERIC_ELEMENT(int8_t, 1, kChar, v[0] = h.asChar(), h.setChar(v[0]))
+AL_NUMERIC_ELEMENT(int16_t, 1, kShort, v[0] = h.asShort(), h.setShort(v[0]))
+AL_NUMERIC_ELEMENT(int32_t, 1, kInt, v[0] = h.asInt(), h.setInt(v[0]))
+AL_NUMERIC_ELEMENT(int64_t, 1, kInt64, v[0] = h.asInt64(), h.setInt64(v[0]))
+AL_NUMERIC_ELEMENT(float, 1, kFloat, v[0] = h.asFloat(), h.setFloat(v[0]))
+AL_NUMERIC_ELEMENT(double, 1, kDouble, v[0] = h.asDouble(), h.setDouble(v[0]))
+AL_NUMERIC_ELEMENT(int32_t, 2, k2Int, const int2& e = h.asInt2(); v[0] = e[0]; v[1] = e[1], h.set2Int(v[0], v[1]))
+AL_NUMERIC_ELEMENT(float, 2, k2Float, const float2& e = h.asFloat2(); v[0] = e[0]; v[1] = e[1], h.set2Float(v[0], v[1]))
+AL_NUMERIC_ELEMENT(double, 2, k2Double, const double2& e = h.asDouble2(); v[0] = e[0]; v[1] = e[1], h.set2Double(v[0], v[1]))
+AL_NUMERIC_ELEMENT(int32_t, 3, k3Int, const int3& e = h.asInt3(); v[0] = e[0]; v[1] = e[1]; v[2] = e[2], h.set3Int(v[0], v[1], v[2]))
+AL_NUMERIC_ELEMENT(float, 3, k3Float, const float3& e = h.asFloat3(); v[0] = e[0]; v[1] = e[1]; v[2] = e[2], h.set3Float(v[0], v[1], v[2]))
+AL_NUMERIC_ELEMENT(double, 3, k3Double, const double3& e = h.asDouble3(); v[0] = e[0]; v[1] = e[1]; v[2] = e[2], h.set3Double(v[0], v[1], v[2]))
+
+#undef AL_NUMERIC_ELEMENT
+
+//----------------------------------------------------------------------------------------------------------------------
+/// \brief  returns true if the plug is an array of numeric elements of the expected type
+//----------------------------------------------------------------------------------------------------------------------
+bool isNumericArray(const MPlug& plug, const MFnNumericData::Type type)
+{
+  MStatus status;
+  MFnNumericAttribute fn(plug.attribute(), &status);
+  if(!status)
+    return false;
+  const MFnNumericData::Type actual = fn.unitType();
+  // kInt and kLong are interchangeable
+  return actual == type || (type == MFnNumericData::kInt && actual == MFnNumericData::kLong);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+/// \brief  bulk reads an array of numeric elements, each of which contains N values of type T
+//----------------------------------------------------------------------------------------------------------------------
+template<typename T, int N>
+MStatus readNumericArray(const MPlug& plug, T* const values, const size_t count)
+{
+  typedef NumericElement<T, N> Element;
+  if(!isNumericArray(plug, Element::type))
+    return MS::kFailure;
+  return readArrayElements(plug, values, count, N, Element::get);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+/// \brief  bulk writes an array of numeric elements, each of which contains N values of type T
+//----------------------------------------------------------------------------------------------------------------------
+template<typename T, int N>
+MStatus writeNumericArray(const MPlug& plug, const T* const values, const size_t count)
+{
+  typedef NumericElement<T, N> Element;
+  if(!isNumericArray(plug, Element::type))
+    return MS::kFailure;
+  return writeArrayElements(plug, values, count, N, Element::set);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+/// \brief  bulk reads an array of half elements (each containing N values) from an array of float elements
+//----------------------------------------------------------------------------------------------------------------------
+template<int N>
+MStatus readHalfArray(const MPlug& plug, GfHalf* const values, const size_t count)
+{
+  std::vector<float> temp(count * N);
+  MStatus status = readNumericArray<float, N>(plug, temp.data(), count);
+  if(status)
+  {
+    const size_t n = count * N, n8 = n & ~0x7ULL;
+    size_t i = 0;
+    for(; i < n8; i += 8)
+    {
+      MayaUsdUtils::float2half_8f(temp.data() + i, values + i);
+    }
+    for(; i < n; ++i)
+    {
+      values[i] = MayaUsdUtils::float2half_1f(temp[i]);
+    }
+  }
+  return status;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+/// \brief  bulk writes an array of float elements (each containing N values) from an array of halfs
+//----------------------------------------------------------------------------------------------------------------------
+template<int N>
+MStatus writeHalfArray(const MPlug& plug, const GfHalf* const values, const size_t count)
+{
+  std::vector<float> temp(count * N);
+  const size_t n = count * N, n8 = n & ~0x7ULL;
+  size_t i = 0;
+  for(; i < n8; i += 8)
+  {
+    MayaUsdUtils::half2float_8f(values + i, temp.data() + i);
+  }
+  for(; i < n; ++i)
+  {
+    temp[i] = MayaUsdUtils::half2float_1f(values[i]);
+  }
+  return writeNumericArray<float, N>(plug, temp.data(), count);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+/// \brief  multiplies a contiguous array of floats by a unit conversion factor
+//----------------------------------------------------------------------------------------------------------------------
+void scaleArray(const float* const input, float* const output, const size_t count, const float scale)
+{
+  size_t i = 0;
+#if AL_UTILS_ENABLE_SIMD
+  const f128 scale128 = splat4f(scale);
+  const size_t count4 = count & ~0x3ULL;
+  for(; i < count4; i += 4)
+  {
+    storeu4f(output + i, mul4f(scale128, loadu4f(input + i)));
+  }
+#endif
+  for(; i < count; ++i)
+  {
+    output[i] = scale * input[i];
+  }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+/// \brief  returns true if the plug is an array of unit elements of the expected type
+//----------------------------------------------------------------------------------------------------------------------
+bool isUnitArray(const MPlug& plug, const MFnUnitAttribute::Type type)
+{
+  MStatus status;
+  MFnUnitAttribute fn(plug.attribute(), &status);
+  return status && fn.unitType() == type;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+/// \brief  bulk reads an array of time, angle, or distance values (in maya's internal units), and then converts them
+///         all to the requested unit.
+//----------------------------------------------------------------------------------------------------------------------
+MStatus readUnitArray(const MPlug& plug, float* const values, const size_t count, const MFnUnitAttribute::Type type,
+                      const float unitConversion)
+{
+  if(!isUnitArray(plug, type))
+    return MS::kFailure;
+
+  MStatus status;
+  switch(type)
+  {
+  case MFnUnitAttribute::kTime:
+    status = readArrayElements(plug, values, count, 1,
+        [](MDataHandle& h, float* const v) { v[0] = float(h.asTime().as(MTime::k6000FPS)); });
+    break;
+  case MFnUnitAttribute::kAngle:
+    status = readArrayElements(plug, values, count, 1,
+        [](MDataHandle& h, float* const v) { v[0] = float(h.asAngle().as(MAngle::internalUnit())); });
+    break;
+  case MFnUnitAttribute::kDistance:
+    status = readArrayElements(plug, values, count, 1,
+        [](MDataHandle& h, float* const v) { v[0] = float(h.asDistance().as(MDistance::internalUnit())); });
+    break;
+  default:
+    return MS::kFailure;
+  }
+  if(status)
+  {
+    scaleArray(values, values, count, unitConversion);
+  }
+  return status;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+/// \brief  converts an array of time, angle, or distance values into maya's internal units, and bulk writes them
+//----------------------------------------------------------------------------------------------------------------------
+MStatus writeUnitArray(const MPlug& plug, const float* const values, const size_t count,
+                       const MFnUnitAttribute::Type type, const float unitConversion)
+{
+  if(!isUnitArray(plug, type))
+    return MS::kFailure;
+
+  std::vector<float> temp(count);
+  scaleArray(values, temp.data(), count, unitConversion);
+  switch(type)
+  {
+  case MFnUnitAttribute::kTime:
+    return writeArrayElements(plug, temp.data(), count, 1,
+        [](MDataHandle& h, const float* const v) { h.set(MTime(v[0], MTime::k6000FPS)); });
+  case MFnUnitAttribute::kAngle:
+    return writeArrayElements(plug, temp.data(), count, 1,
+        [](MDataHandle& h, const float* const v) { h.set(MAngle(v[0], MAngle::internalUnit())); });
+  case MFnUnitAttribute::kDistance:
+    return writeArrayElements(plug, temp.data(), count, 1,
+        [](MDataHandle& h, const float* const v) { h.set(MDistance(v[0], MDistance::internalUnit())); });
+  default:
+    break;
+  }
+  return MS::kFailure;
+}
+
+} // anon
+
 //----------------------------------------------------------------------------------------------------------------------
 MStatus DgNodeHelper::setFloat(const MObject node, const MObject attr, float value)
 {
@@ -172,6 +466,9 @@ MStatus DgNodeHelper::setBoolArray(MObject node, MObject attribute, const bool*
 
   AL_MAYA_CHECK_ERROR(plug.setNumElements(count), "DgNodeHelper: attribute array could not be resized");
 
+  if(writeNumericArray<bool, 1>(plug, values, count))
+    return MS::kSuccess;
+
   for(size_t i = 0; i != count; ++i)
   {
     plug.elementByLogicalIndex(i).setBool(values[i]);
@@ -206,6 +503,9 @@ MStatus DgNodeHelper::setInt8Array(MObject node, MObject attribute, const int8_t
 
   AL_MAYA_CHECK_ERROR(plug.setNumElements(count), "DgNodeHelper: attribute array could not be resized");
 
+  if(writeNumericArray<int8_t, 1>(plug, values, count))
+    return MS::kSuccess;
+
   for(size_t i = 0; i != count; ++i)
   {
     plug.elementByLogicalIndex(i).setChar(values[i]);
@@ -223,6 +523,9 @@ MStatus DgNodeHelper::setInt16Array(MObject node, MObject attribute, const int16
 
   AL_MAYA_CHECK_ERROR(plug.setNumElements(count), "DgNodeHelper: attribute array could not be resized");
 
+  if(writeNumericArray<int16_t, 1>(plug, values, count))
+    return MS::kSuccess;
+
   for(size_t i = 0; i != count; ++i)
   {
     plug.elementByLogicalIndex(i).setShort(values[i]);
@@ -240,6 +543,9 @@ MStatus DgNodeHelper::setInt32Array(MObject node, MObject attribute, const int32
 
   AL_MAYA_CHECK_ERROR(plug.setNumElements(count), "DgNodeHelper: attribute array could not be resized");
 
+  if(writeNumericArray<int32_t, 1>(plug, values, count))
+    return MS::kSuccess;
+
   for(size_t i = 0; i != count; ++i)
   {
     plug.elementByLogicalIndex(i).setValue(values[i]);
@@ -257,6 +563,9 @@ MStatus DgNodeHelper::setInt64Array(MObject node, MObject attribute, const int64
 
   AL_MAYA_CHECK_ERROR(plug.setNumElements(count), "DgNodeHelper: attribute array could not be resized");
 
+  if(writeNumericArray<int64_t, 1>(plug, values, count))
+    return MS::kSuccess;
+
   for(size_t i = 0; i != count; ++i)
   {
     plug.elementByLogicalIndex(i).setInt64(values[i]);
@@ -274,6 +583,9 @@ MStatus DgNodeHelper::setHalfArray(MObject node, MObject attribute, const GfHalf
 
   AL_MAYA_CHECK_ERROR(plug.setNumElements(count), "DgNodeHelper: attribute array could not be resized");
 
+  if(writeHalfArray<1>(plug, values, count))
+    return MS::kSuccess;
+
   size_t count8 = count & ~0x7ULL;
   for(size_t j = 0; j != count8; j += 8)
   {
@@ -336,6 +648,10 @@ MStatus DgNodeHelper::setFloatArray(MObject node, MObject attribute, const float
     else
     {
       AL_MAYA_CHECK_ERROR(plug.setNumElements(count), "DgNodeHelper: attribute array could not be resized");
+
+      if(writeNumericArray<float, 1>(plug, values, count))
+        return MS::kSuccess;
+
       for(size_t i = 0; i != count; ++i)
       {
         plug.elementByLogicalIndex(i).setFloat(values[i]);
@@ -370,6 +686,10 @@ MStatus DgNodeHelper::setDoubleArray(MObject node, MObject attribute, const doub
     else
     {
       AL_MAYA_CHECK_ERROR(plug.setNumElements(count), "DgNodeHelper: attribute array could not be resized");
+
+      if(writeNumericArray<double, 1>(plug, values, count))
+        return MS::kSuccess;
+
       for(size_t i = 0; i != count; ++i)
       {
         plug.elementByLogicalIndex(i).setDouble(values[i]);
@@ -389,6 +709,9 @@ MStatus DgNodeHelper::setVec2Array(MObject node, MObject attribute, const int32_
 
   AL_MAYA_CHECK_ERROR(plug.setNumElements(count), "DgNodeHelper: attribute array could not be resized");
 
+  if(writeNumericArray<int32_t, 2>(plug, values, count))
+    return MS::kSuccess;
+
   for(size_t i = 0, j = 0; i != count; ++i, j += 2)
   {
     auto v = plug.elementByLogicalIndex(i);
@@ -408,6 +731,9 @@ MStatus DgNodeHelper::setVec2Array(MObject node, MObject attribute, const GfHalf
 
   AL_MAYA_CHECK_ERROR(plug.setNumElements(count), "DgNodeHelper: attribute array could not be resized");
 
+  if(writeHalfArray<2>(plug, values, count))
+    return MS::kSuccess;
+
   size_t count4 = count & ~0x3ULL;
   for(size_t i = 0, j = 0; i != count4; i += 4, j += 8)
   {
@@ -460,6 +786,9 @@ MStatus DgNodeHelper::setVec2Array(MObject node, MObject attribute, const float*
 
   AL_MAYA_CHECK_ERROR(plug.setNumElements(count), "DgNodeHelper: attribute array could not be resized");
 
+  if(writeNumericArray<float, 2>(plug, values, count))
+    return MS::kSuccess;
+
   for(size_t i = 0, j = 0; i != count; ++i, j += 2)
   {
     auto v = plug.elementByLogicalIndex(i);
@@ -479,6 +808,9 @@ MStatus DgNodeHelper::setVec2Array(MObject node, MObject attribute, const double
 
   AL_MAYA_CHECK_ERROR(plug.setNumElements(count), "DgNodeHelper: attribute array could not be resized");
 
+  if(writeNumericArray<double, 2>(plug, values, count))
+    return MS::kSuccess;
+
   for(size_t i = 0, j = 0; i != count; ++i, j += 2)
   {
     auto v = plug.elementByLogicalIndex(i);
@@ -497,6 +829,10 @@ MStatus DgNodeHelper::setVec3Array(MObject node, MObject attribute, const int32_
     return MS::kFailure;
 
   AL_MAYA_CHECK_ERROR(plug.setNumElements(count), "DgNodeHelper: attribute array could not be resized");
+
+  if(writeNumericArray<int32_t, 3>(plug, values, count))
+    return MS::kSuccess;
+
   for(size_t i = 0, j = 0; i != count; ++i, j += 3)
   {
     auto v = plug.elementByLogicalIndex(i);
@@ -515,6 +851,10 @@ MStatus DgNodeHelper::setVec3Array(MObject node, MObject attribute, const GfHalf
     return MS::kFailure;
 
   AL_MAYA_CHECK_ERROR(plug.setNumElements(count), "DgNodeHelper: attribute array could not be resized");
+
+  if(writeHalfArray<3>(plug, values, count))
+    return MS::kSuccess;
+
   size_t count8 = count & ~0x7ULL;
   for(size_t i = 0, j = 0; i != count8; i += 8, j += 24)
   {
@@ -558,6 +898,9 @@ MStatus DgNodeHelper::setVec3Array(MObject node, MObject attribute, const float*
 
   AL_MAYA_CHECK_ERROR(plug.setNumElements(count), "DgNodeHelper: attribute array could not be resized");
 
+  if(writeNumericArray<float, 3>(plug, values, count))
+    return MS::kSuccess;
+
   for(size_t i = 0, j = 0; i != count; ++i, j += 3)
   {
     auto v = plug.elementByLogicalIndex(i);
@@ -578,6 +921,9 @@ MStatus DgNodeHelper::setVec3Array(MObject node, MObject attribute, const double
 
   AL_MAYA_CHECK_ERROR(plug.setNumElements(count), "DgNodeHelper: attribute array could not be resized");
 
+  if(writeNumericArray<double, 3>(plug, values, count))
+    return MS::kSuccess;
+
   for(size_t i = 0, j = 0; i != count; ++i, j += 3)
   {
     auto v = plug.elementByLogicalIndex(i);
@@ -842,6 +1188,9 @@ MStatus DgNodeHelper::setTimeArray(MObject node, MObject attribute, const float*
 
   AL_MAYA_CHECK_ERROR(plug.setNumElements(count), "DgNodeHelper: attribute array could not be resized");
 
+  if(writeUnitArray(plug, values, count, MFnUnitAttribute::kTime, unitConversion))
+    return MS::kSuccess;
+
 #if AL_UTILS_ENABLE_SIMD
   const f128 unitConversion128 = splat4f(unitConversion);
   const size_t count4 = count & ~3ULL;
@@ -890,6 +1239,9 @@ MStatus DgNodeHelper::setAngleArray(MObject node, MObject attribute, const float
 
   AL_MAYA_CHECK_ERROR(plug.setNumElements(count), "DgNodeHelper: attribute array could not be resized");
 
+  if(writeUnitArray(plug, values, count, MFnUnitAttribute::kAngle, unitConversion))
+    return MS::kSuccess;
+
 #if AL_UTILS_ENABLE_SIMD
   const f128 unitConversion128 = splat4f(unitConversion);
   const size_t count4 = count & ~3ULL;
@@ -938,6 +1290,9 @@ MStatus DgNodeHelper::setDistanceArray(MObject node, MObject attribute, const fl
 
   AL_MAYA_CHECK_ERROR(plug.setNumElements(count), "DgNodeHelper: attribute array could not be resized");
 
+  if(writeUnitArray(plug, values, count, MFnUnitAttribute::kDistance, unitConversion))
+    return MS::kSuccess;
+
 #if AL_UTILS_ENABLE_SIMD
   const f128 unitConversion128 = splat4f(unitConversion);
   const size_t count4 = count & ~3ULL;
@@ -1216,6 +1571,9 @@ MStatus DgNodeHelper::getBoolArray(MObject node, MObject attribute, bool* const
     return MS::kFailure;
   }
 
+  if(readNumericArray<bool, 1>(plug, values, count))
+    return MS::kSuccess;
+
 #if AL_UTILS_ENABLE_SIMD
   uint32_t count16 = count & ~0xF;
   for(uint32_t i = 0; i < count16; i += 16)
@@ -1268,6 +1626,9 @@ MStatus DgNodeHelper::getInt64Array(MObject node, MObject attribute, int64_t* co
     return MS::kFailure;
   }
 
+  if(readNumericArray<int64_t, 1>(plug, values, count))
+    return MS::kSuccess;
+
 #if AL_UTILS_ENABLE_SIMD
 
 #ifdef __AVX__
@@ -1333,6 +1694,9 @@ MStatus DgNodeHelper::getInt32Array(MObject node, MObject attribute, int32_t* co
     return MS::kFailure;
   }
 
+  if(readNumericArray<int32_t, 1>(plug, values, count))
+    return MS::kSuccess;
+
 #if AL_UTILS_ENABLE_SIMD
 
 #ifdef __AVX__
@@ -1409,6 +1773,9 @@ MStatus DgNodeHelper::getInt8Array(MObject node, MObject attribute, int8_t* cons
     return MS::kFailure;
   }
 
+  if(readNumericArray<int8_t, 1>(plug, values, count))
+    return MS::kSuccess;
+
   for(uint32_t i = 0; i < num; ++i)
   {
     values[i] = plug.elementByLogicalIndex(i).asChar();
@@ -1431,6 +1798,9 @@ MStatus DgNodeHelper::getInt16Array(MObject node, MObject attribute, int16_t* co
     return MS::kFailure;
   }
 
+  if(readNumericArray<int16_t, 1>(plug, values, count))
+    return MS::kSuccess;
+
   for(uint32_t i = 0; i < num; ++i)
   {
     values[i] = plug.elementByLogicalIndex(i).asShort();
@@ -1453,6 +1823,9 @@ MStatus DgNodeHelper::getFloatArray(MObject node, MObject attribute, float* cons
     return MS::kFailure;
   }
 
+  if(readNumericArray<float, 1>(plug, values, count))
+    return MS::kSuccess;
+
 #if AL_UTILS_ENABLE_SIMD
 
 #ifdef __AVX__
@@ -1530,6 +1903,9 @@ MStatus DgNodeHelper::getHalfArray(MObject node, MObject attribute, GfHalf* cons
     return MS::kFailure;
   }
 
+  if(readHalfArray<1>(plug, values, count))
+    return MS::kSuccess;
+
   size_t count8 = count & ~0x7ULL;
   for(uint32_t i = 0; i < count8; i += 8)
   {
@@ -1579,6 +1955,10 @@ MStatus DgNodeHelper::getDoubleArray(MObject node, MObject attribute, double* co
     MGlobal::displayError("array is sized incorrectly");
     return MS::kFailure;
   }
+
+  if(readNumericArray<double, 1>(plug, values, count))
+    return MS::kSuccess;
+
 #if AL_UTILS_ENABLE_SIMD
 
 #ifdef __AVX__
@@ -1657,6 +2037,9 @@ MStatus DgNodeHelper::getVec2Array(MObject node, MObject attribute, double* cons
     return MS::kFailure;
   }
 
+  if(readNumericArray<double, 2>(plug, values, count))
+    return MS::kSuccess;
+
 #if AL_UTILS_ENABLE_SIMD
 
 #ifdef __AVX__
@@ -1714,6 +2097,9 @@ MStatus DgNodeHelper::getVec2Array(MObject node, MObject attribute, float* const
     return MS::kFailure;
   }
 
+  if(readNumericArray<float, 2>(plug, values, count))
+    return MS::kSuccess;
+
 #if AL_UTILS_ENABLE_SIMD
 
 #ifdef __AVX__
@@ -1791,6 +2177,9 @@ MStatus DgNodeHelper::getVec2Array(MObject node, MObject attribute, GfHalf* cons
     return MS::kFailure;
   }
 
+  if(readHalfArray<2>(plug, values, count))
+    return MS::kSuccess;
+
   for(uint32_t i = 0,  j = 0; i < num; ++i, j += 2)
   {
     values[j] = plug.elementByLogicalIndex(i).child(0).asFloat();
@@ -1854,6 +2243,9 @@ MStatus DgNodeHelper::getVec2Array(MObject node, MObject attribute, int32_t* con
     return MS::kFailure;
   }
 
+  if(readNumericArray<int32_t, 2>(plug, values, count))
+    return MS::kSuccess;
+
 #if AL_UTILS_ENABLE_SIMD
 
 #ifdef __AVX__
@@ -1929,6 +2321,9 @@ MStatus DgNodeHelper::getVec3Array(MObject node, MObject attribute, float* const
     return MS::kFailure;
   }
 
+  if(readNumericArray<float, 3>(plug, values, count))
+    return MS::kSuccess;
+
 #if AL_UTILS_ENABLE_SIMD
 
 #ifdef __AVX__
@@ -2075,6 +2470,9 @@ MStatus DgNodeHelper::getVec3Array(MObject node, MObject attribute, double* cons
     return MS::kFailure;
   }
 
+  if(readNumericArray<double, 3>(plug, values, count))
+    return MS::kSuccess;
+
 #if AL_UTILS_ENABLE_SIMD
 
 #ifdef __AVX__
@@ -2179,6 +2577,9 @@ MStatus DgNodeHelper::getVec3Array(MObject node, MObject attribute, GfHalf* cons
     return MS::kFailure;
   }
 
+  if(readHalfArray<3>(plug, values, count))
+    return MS::kSuccess;
+
   size_t count8 = count & ~0x7ULL;
 
   for(uint32_t i = 0, j = 0; i < count8; i += 8, j += 24)
@@ -2253,6 +2654,9 @@ MStatus DgNodeHelper::getVec3Array(MObject node, MObject attribute, int32_t* con
     return MS::kFailure;
   }
 
+  if(readNumericArray<int32_t, 3>(plug, values, count))
+    return MS::kSuccess;
+
 #if AL_UTILS_ENABLE_SIMD
 
 #ifdef __AVX__
@@ -2947,6 +3351,9 @@ MStatus DgNodeHelper::getTimeArray(MObject node, MObject attribute, float* const
     return MS::kFailure;
   }
 
+  if(readUnitArray(plug, values, count, MFnUnitAttribute::kTime, unitConversion))
+    return MS::kSuccess;
+
 #if AL_UTILS_ENABLE_SIMD
 
 #if defined(__AVX__) && ENABLE_SOME_AVX_ROUTINES
@@ -3029,6 +3436,9 @@ MStatus DgNodeHelper::getAngleArray(MObject node, MObject attribute, float* cons
     return MS::kFailure;
   }
 
+  if(readUnitArray(plug, values, count, MFnUnitAttribute::kAngle, unitConversion))
+    return MS::kSuccess;
+
 #if AL_UTILS_ENABLE_SIMD
 
 #if defined(__AVX__) && ENABLE_SOME_AVX_ROUTINES
@@ -3111,6 +3521,9 @@ MStatus DgNodeHelper::getDistanceArray(MObject node, MObject attribute, float* c
     return MS::kFailure;
   }
 
+  if(readUnitArray(plug, values, count, MFnUnitAttribute::kDistance, unitConversion))
+    return MS::kSuccess;
+
 #if AL_UTILS_ENABLE_SIMD
 
 #if defined(__AVX__) && ENABLE_SOME_AVX_ROUTINES
@@ -40,6 +40,10 @@ namespace utils {
 /// \ingroup  mayautils
 /// \brief  Utility class that provides support for setting/getting
 ///         attributes.
+///
+///         The array accessors for scalar, vec2, vec3, time, angle and distance attributes read and write all of the
+///         elements through a single array data handle when the attribute is a numeric (or unit) array, and fall back
+///         to one plug per element when it is not (e.g. when the elements are compounds of individual attributes).
 //----------------------------------------------------------------------------------------------------------------------
 struct DgNodeHelper
 {
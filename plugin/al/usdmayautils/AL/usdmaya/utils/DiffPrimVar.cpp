@@ -17,10 +17,12 @@
 #include <mayaUsdUtils/SIMD.h>
 #include <mayaUsdUtils/DiffCore.h>
 
+#include "maya/MColorArray.h"
 #include "maya/MDoubleArray.h"
 #include "maya/MFloatArray.h"
 #include "maya/MIntArray.h"
 #include "maya/MItMeshPolygon.h"
+#include "maya/MStringArray.h"
 #include "maya/MUintArray.h"
 
 PXR_NAMESPACE_USING_DIRECTIVE
@@ -303,6 +305,149 @@ uint32_t diffFaceVertices(UsdGeomMesh& geom, MFnMesh& mesh, UsdTimeCode timeCode
   return result;
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+template<typename MArray>
+static uint64_t hashMArray(MArray& array, const uint64_t seed = 0)
+{
+  const uint32_t n = array.length();
+  return MayaUsdUtils::hashArray(n ? &array[0] : nullptr, sizeof(array[0]) * n, seed);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+MeshFingerprint computeMeshFingerprint(MFnMesh& mesh, MIntArray& faceCounts, MIntArray& faceConnects)
+{
+  MeshFingerprint fingerprint;
+  MStatus status;
+
+  const float* const points = mesh.getRawPoints(&status);
+  if(!status)
+    return fingerprint;
+  fingerprint.points = MayaUsdUtils::hashArray(points, sizeof(float) * 3 * mesh.numVertices());
+
+  {
+    MIntArray normalCounts, normalIds;
+    mesh.getNormalIds(normalCounts, normalIds);
+    const float* const normals = mesh.getRawNormals(&status);
+    fingerprint.normals = MayaUsdUtils::hashArray(normals, normals ? sizeof(float) * 3 * mesh.numNormals() : 0);
+    fingerprint.normals = hashMArray(normalIds, fingerprint.normals);
+  }
+
+  fingerprint.faceVertexCounts = hashMArray(faceCounts);
+  fingerprint.faceVertexIndices = hashMArray(faceConnects);
+
+  {
+    MUintArray holes = mesh.getInvisibleFaces();
+    fingerprint.holeIndices = hashMArray(holes);
+  }
+
+  {
+    MUintArray ids;
+    MDoubleArray weights;
+    mesh.getCreaseEdges(ids, weights);
+    fingerprint.edgeCreases = hashMArray(weights, hashMArray(ids));
+    ids.clear();
+    weights.clear();
+    mesh.getCreaseVertices(ids, weights);
+    fingerprint.vertexCreases = hashMArray(weights, hashMArray(ids));
+  }
+
+  MStringArray setNames;
+  mesh.getUVSetNames(setNames);
+  fingerprint.uvSets.reserve(setNames.length());
+  for(uint32_t i = 0, n = setNames.length(); i < n; ++i)
+  {
+    MFloatArray u, v;
+    MIntArray uvCounts, uvIds;
+    mesh.getUVs(u, v, &setNames[i]);
+    mesh.getAssignedUVs(uvCounts, uvIds, &setNames[i]);
+    const uint64_t hash = hashMArray(uvIds, hashMArray(uvCounts, hashMArray(v, hashMArray(u))));
+    fingerprint.uvSets.emplace_back(setNames[i].asChar(), hash);
+  }
+
+  setNames.clear();
+  mesh.getColorSetNames(setNames);
+  fingerprint.colourSets.reserve(setNames.length());
+  for(uint32_t i = 0, n = setNames.length(); i < n; ++i)
+  {
+    MColorArray colours;
+    mesh.getFaceVertexColors(colours, &setNames[i]);
+    std::vector<float> rgba(4 * colours.length());
+    if(!rgba.empty())
+    {
+      colours.get((float(*)[4])rgba.data());
+    }
+    const uint64_t representation = mesh.getColorRepresentation(setNames[i]);
+    const uint64_t hash = MayaUsdUtils::hashArray(rgba.data(), sizeof(float) * rgba.size(), representation);
+    fingerprint.colourSets.emplace_back(setNames[i].asChar(), hash);
+  }
+
+  fingerprint.valid = true;
+  return fingerprint;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+MeshFingerprint computeMeshFingerprint(MFnMesh& mesh)
+{
+  MIntArray faceCounts, faceConnects;
+  mesh.getVertices(faceCounts, faceConnects);
+  return computeMeshFingerprint(mesh, faceCounts, faceConnects);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+uint32_t diffFingerprints(const MeshFingerprint& previous, const MeshFingerprint& current)
+{
+  if(!previous.valid || !current.valid)
+  {
+    return kAllComponents;
+  }
+
+  uint32_t result = 0;
+  if(previous.points != current.points)
+  {
+    result |= kPoints;
+  }
+  if(previous.normals != current.normals)
+  {
+    result |= kNormals | kNormalIndices;
+  }
+  if(previous.faceVertexCounts != current.faceVertexCounts)
+  {
+    result |= kFaceVertexCounts;
+  }
+  if(previous.faceVertexIndices != current.faceVertexIndices)
+  {
+    result |= kFaceVertexIndices;
+  }
+  if(previous.holeIndices != current.holeIndices)
+  {
+    result |= kHoleIndices;
+  }
+  if(previous.edgeCreases != current.edgeCreases)
+  {
+    result |= kCreaseIndices | kCreaseWeights | kCreaseLengths;
+  }
+  if(previous.vertexCreases != current.vertexCreases)
+  {
+    result |= kCornerIndices | kCornerSharpness;
+  }
+  if(previous.uvSets != current.uvSets)
+  {
+    result |= kUvSets;
+  }
+  if(previous.colourSets != current.colourSets)
+  {
+    result |= kColourSets;
+  }
+
+  // vertex interpolated normals are compared through the face vertex indices, and the face varying primvars are
+  // laid out by the topology, so a change in topology requires those to be checked as well.
+  if(result & (kFaceVertexCounts | kFaceVertexIndices))
+  {
+    result |= kNormals | kNormalIndices | kUvSets | kColourSets;
+  }
+  return result;
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 ///
 //----------------------------------------------------------------------------------------------------------------------
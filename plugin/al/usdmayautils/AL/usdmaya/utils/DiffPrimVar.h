@@ -23,6 +23,10 @@
 
 #include "pxr/usd/usdGeom/mesh.h"
 
+#include <string>
+#include <utility>
+#include <vector>
+
 PXR_NAMESPACE_USING_DIRECTIVE
 
 namespace AL {
@@ -45,6 +49,8 @@ enum DiffComponents
   kCreaseLengths = 1 << 8, ///< the edge crease lengths
   kCornerIndices = 1 << 9, ///< the vertex creases have changed
   kCornerSharpness = 1 << 10, ///< the vertex crease weights have changed
+  kUvSets = 1 << 11, ///< the uv sets have changed (only reported by diffFingerprints)
+  kColourSets = 1 << 12, ///< the colour sets have changed (only reported by diffFingerprints)
   kAllComponents = 0xFFFFFFFF
 };
 
@@ -61,6 +67,55 @@ uint32_t diffGeom(UsdGeomPointBased& geom, MFnMesh& mesh, UsdTimeCode timeCode,
 AL_USDMAYA_UTILS_PUBLIC
 uint32_t diffFaceVertices(UsdGeomMesh& geom, MFnMesh& mesh, UsdTimeCode timeCode, uint32_t exportMask = kAllComponents);
 
+//----------------------------------------------------------------------------------------------------------------------
+/// \brief  Compact content fingerprints of the components of a maya mesh. A fingerprint taken when the mesh is known
+///         to match its USD prim (after import, or after the mesh has been written to USD) can be compared against a
+///         fingerprint of the current mesh to find the components that may have been modified, so that diffGeom and
+///         diffFaceVertices only need to read the USD data for those components.
+//----------------------------------------------------------------------------------------------------------------------
+struct MeshFingerprint
+{
+  typedef std::vector<std::pair<std::string, uint64_t>> SetFingerprints;
+
+  uint64_t points = 0; ///< the vertex positions
+  uint64_t normals = 0; ///< the normal values and normal indices
+  uint64_t faceVertexCounts = 0; ///< the number of vertices in each face
+  uint64_t faceVertexIndices = 0; ///< the face vertex indices
+  uint64_t holeIndices = 0; ///< the invisible faces
+  uint64_t edgeCreases = 0; ///< the edge crease ids and weights
+  uint64_t vertexCreases = 0; ///< the vertex crease ids and weights
+  SetFingerprints uvSets; ///< the name and fingerprint of the values and indices of each uv set
+  SetFingerprints colourSets; ///< the name and fingerprint of the face vertex colours of each colour set
+  bool valid = false; ///< false if the fingerprint has not been computed
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+/// \brief  computes the fingerprint of a maya mesh
+/// \param  mesh the maya mesh
+/// \param  faceCounts the number of vertices in each face, as returned by MFnMesh::getVertices
+/// \param  faceConnects the face vertex indices, as returned by MFnMesh::getVertices
+/// \return the fingerprint of the mesh
+//----------------------------------------------------------------------------------------------------------------------
+AL_USDMAYA_UTILS_PUBLIC
+MeshFingerprint computeMeshFingerprint(MFnMesh& mesh, MIntArray& faceCounts, MIntArray& faceConnects);
+
+//----------------------------------------------------------------------------------------------------------------------
+/// \brief  computes the fingerprint of a maya mesh
+/// \param  mesh the maya mesh
+/// \return the fingerprint of the mesh
+//----------------------------------------------------------------------------------------------------------------------
+AL_USDMAYA_UTILS_PUBLIC
+MeshFingerprint computeMeshFingerprint(MFnMesh& mesh);
+
+//----------------------------------------------------------------------------------------------------------------------
+/// \brief  compares two fingerprints of a maya mesh
+/// \param  previous the fingerprint of the mesh when it last matched its USD prim
+/// \param  current the fingerprint of the mesh now
+/// \return the DiffComponents that may have changed, or kAllComponents if the previous fingerprint is not valid
+//----------------------------------------------------------------------------------------------------------------------
+AL_USDMAYA_UTILS_PUBLIC
+uint32_t diffFingerprints(const MeshFingerprint& previous, const MeshFingerprint& current);
+
 //----------------------------------------------------------------------------------------------------------------------
 //----------------------------------------------------------------------------------------------------------------------
 class PrimVarDiffEntry
@@ -17,15 +17,19 @@
 #include "AL/usdmaya/utils/MeshUtils.h"
 #include "AL/maya/utils/Utils.h"
 #include "AL/usdmaya/utils/DiffPrimVar.h"
+#include "AL/usdmaya/utils/MeshUtilsKernels.h"
 #include "AL/usdmaya/utils/Utils.h"
 
 #include <mayaUsdUtils/DebugCodes.h>
 #include <mayaUsdUtils/DiffCore.h>
+#include <mayaUsdUtils/SIMDDispatch.h>
 
 #include "pxr/usd/usdUtils/pipeline.h"
 
+#include "maya/MDoubleArray.h"
 #include "maya/MItMeshPolygon.h"
 #include "maya/MGlobal.h"
+#include "maya/MStringArray.h"
 
 #include <iostream>
 
@@ -39,13 +43,35 @@ const TfToken displayColorToken("displayColor");
 const TfToken displayOpacityToken("displayOpacity");
 const TfToken primvarDisplayOpacityToken("primvars:displayOpacity");
 
+namespace {
+
+//----------------------------------------------------------------------------------------------------------------------
+/// \brief  returns the conversion kernels for the best instruction set supported by this machine, selected on first use.
+//----------------------------------------------------------------------------------------------------------------------
+const MeshUtilsKernels& kernels()
+{
+  static const MeshUtilsKernels& table = MayaUsdUtils::selectSimdKernel<const MeshUtilsKernels& (*)()>(
+      &baselineMeshUtilsKernels,
+#if MAYAUSD_SIMD_HAS_AVX2
+      &avx2MeshUtilsKernels,
+#else
+      nullptr,
+#endif
+#if MAYAUSD_SIMD_HAS_AVX512
+      &avx512MeshUtilsKernels
+#else
+      nullptr
+#endif
+      )();
+  return table;
+}
+
+} // anon
+
 //----------------------------------------------------------------------------------------------------------------------
 void floatToDouble(double* output, const float* const input, size_t count)
 {
-  for(size_t i = 0; i < count; ++i)
-  {
-    output[i] = double(input[i]);
-  }
+  kernels().floatToDouble(output, input, count);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -442,6 +468,127 @@ void generateIncrementingIndices(MIntArray& indices, const size_t count)
 #endif
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+static uint64_t hashTopology(const uint32_t numPoints, const MIntArray& counts, const MIntArray& connects)
+{
+  const uint32_t nc = counts.length();
+  const uint32_t ni = connects.length();
+  uint64_t signature = MayaUsdUtils::hashArray(nc ? &counts[0] : nullptr, sizeof(int32_t) * nc, numPoints);
+  return MayaUsdUtils::hashArray(ni ? &connects[0] : nullptr, sizeof(int32_t) * ni, signature);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+uint64_t computeTopologySignature(MFnMesh& fnMesh)
+{
+  MIntArray counts, connects;
+  fnMesh.getVertices(counts, connects);
+  return hashTopology(fnMesh.numVertices(), counts, connects);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+uint64_t MeshImportContext::topologySignature()
+{
+  return hashTopology(points.length(), counts, connects);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void MeshImportContext::createMesh(MObject parentOrOwner, MString dagName)
+{
+  polyShape = fnMesh.create(points.length(), counts.length(), points, counts, connects, parentOrOwner);
+  TfToken orientation;
+  bool leftHanded = (mesh.GetOrientationAttr().Get(&orientation, m_timeCode) && orientation == UsdGeomTokens->leftHanded);
+  fnMesh.findPlug("op", true).setBool(leftHanded);
+  // 
+  if(parentOrOwner.hasFn(MFn::kTransform))
+  {
+    fnMesh.setName(dagName);
+  }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool MeshImportContext::reuseMesh(MObject existingShape, MString dagName)
+{
+  if(!fnMesh.setObject(existingShape) ||
+     fnMesh.numVertices() != int32_t(points.length()) ||
+     fnMesh.numPolygons() != int32_t(counts.length()) ||
+     fnMesh.numFaceVertices() != int32_t(connects.length()))
+  {
+    return false;
+  }
+  polyShape = existingShape;
+
+  // only write the vertices if they have changed, since setting them dirties everything downstream of the mesh
+  MStatus status;
+  const float* const current = fnMesh.getRawPoints(&status);
+  bool pointsChanged = !status || !current;
+  for(uint32_t i = 0, n = points.length(); !pointsChanged && i < n; ++i)
+  {
+    const MFloatPoint& p = points[i];
+    pointsChanged = p.x != current[3 * i] || p.y != current[3 * i + 1] || p.z != current[3 * i + 2];
+  }
+  if(pointsChanged)
+  {
+    fnMesh.setPoints(points, MSpace::kObject);
+  }
+
+  TfToken orientation;
+  bool leftHanded = (mesh.GetOrientationAttr().Get(&orientation, m_timeCode) && orientation == UsdGeomTokens->leftHanded);
+  fnMesh.findPlug("op", true).setBool(leftHanded);
+  fnMesh.setName(dagName);
+
+  // The apply methods only ever add holes, creases, and sets to a mesh, so remove those left over from the prim the
+  // mesh was previously imported from.
+  MUintArray holes = fnMesh.getInvisibleFaces();
+  if(holes.length())
+  {
+    fnMesh.setInvisibleFaces(holes, true);
+  }
+
+  MUintArray creaseIds;
+  MDoubleArray creaseWeights;
+  if(fnMesh.getCreaseEdges(creaseIds, creaseWeights) && creaseIds.length())
+  {
+    for(uint32_t i = 0, n = creaseWeights.length(); i < n; ++i)
+      creaseWeights[i] = 0;
+    fnMesh.setCreaseEdges(creaseIds, creaseWeights);
+  }
+  if(fnMesh.getCreaseVertices(creaseIds, creaseWeights) && creaseIds.length())
+  {
+    for(uint32_t i = 0, n = creaseWeights.length(); i < n; ++i)
+      creaseWeights[i] = 0;
+    fnMesh.setCreaseVertices(creaseIds, creaseWeights);
+  }
+
+  // normals set by the previous prim are locked, so unlock them all to have maya recompute them. If this prim has
+  // normals of its own, applyVertexNormals sets them again.
+  {
+    MIntArray vertices(fnMesh.numVertices());
+    for(uint32_t i = 0, n = vertices.length(); i < n; ++i)
+      vertices[i] = i;
+    fnMesh.unlockVertexNormals(vertices);
+  }
+
+  const MString defaultUvSet("map1");
+  MStringArray setNames;
+  fnMesh.setCurrentUVSetName(defaultUvSet);
+  fnMesh.getUVSetNames(setNames);
+  for(uint32_t i = 0, n = setNames.length(); i < n; ++i)
+  {
+    if(setNames[i] != defaultUvSet)
+    {
+      fnMesh.deleteUVSet(setNames[i]);
+    }
+  }
+  fnMesh.clearUVs(&defaultUvSet);
+
+  fnMesh.getColorSetNames(setNames);
+  for(uint32_t i = 0, n = setNames.length(); i < n; ++i)
+  {
+    fnMesh.deleteColorSet(setNames[i]);
+  }
+  return true;
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 void MeshImportContext::applyHoleFaces()
 {
@@ -1064,7 +1211,8 @@ MeshExportContext::MeshExportContext(
     UsdTimeCode timeCode,
     bool performDiff,
     CompactionLevel compactionLevel,
-    bool reverseNormals)
+    bool reverseNormals,
+    MeshFingerprint* fingerprint)
   : fnMesh(), faceCounts(), faceConnects(), m_timeCode(timeCode), mesh(mesh), compaction(compactionLevel), 
     performDiff(performDiff), reverseNormals(reverseNormals)
 {
@@ -1083,13 +1231,23 @@ MeshExportContext::MeshExportContext(
 
   if(performDiff)
   {
-    diffGeom = utils::diffGeom(mesh, fnMesh, m_timeCode, kAllComponents);
-    diffMesh = diffFaceVertices(mesh, fnMesh, m_timeCode, kAllComponents);
+    // if the mesh has not changed since it last matched the USD data, there is no need to read any of the USD data
+    uint32_t diffMask = kAllComponents;
+    if(fingerprint)
+    {
+      MeshFingerprint current = computeMeshFingerprint(fnMesh, faceCounts, faceConnects);
+      diffMask = diffFingerprints(*fingerprint, current);
+      *fingerprint = std::move(current);
+    }
+    diffGeom = diffMask ? utils::diffGeom(mesh, fnMesh, m_timeCode, diffMask) : 0;
+    diffMesh = diffMask ? diffFaceVertices(mesh, fnMesh, m_timeCode, diffMask) : 0;
+    diffSets = diffMask & (kUvSets | kColourSets);
   }
   else
   {
     diffGeom = kAllComponents;
     diffMesh = kAllComponents;
+    diffSets = kAllComponents;
   }
 }
 
@@ -1167,81 +1325,7 @@ bool isUvSetDataSparse(const int32_t* uvCounts, const uint32_t count)
 //----------------------------------------------------------------------------------------------------------------------
 void zipUVs(const float* u, const float* v, float* uv, const size_t count)
 {
-#if AL_UTILS_ENABLE_SIMD
-# ifdef __AVX2__
-
-  uint32_t uvCount8 = count & ~7U;
-
-  for(uint32_t i = 0; i < uvCount8; i += 8, uv += 16)
-  {
-    const f256 U = loadu8f(u + i);
-    const f256 V = loadu8f(v + i);
-    const f256 uv0 = unpacklo8f(U, V);
-    const f256 uv1 = unpackhi8f(U, V);
-    storeu8f(uv, permute2f128(uv0, uv1, 0x20));
-    storeu8f(uv + 8, permute2f128(uv0, uv1, 0x31));
-  }
-
-  if(count & 0x4)
-  {
-    const f128 U = loadu4f(u + uvCount8);
-    const f128 V = loadu4f(v + uvCount8);
-    storeu4f(uv, unpacklo4f(U, V));
-    storeu4f(uv + 4, unpackhi4f(U, V));
-    uv += 8;
-    uvCount8 += 4;
-  }
-
-  switch(count & 3)
-  {
-  case 3:
-    uv[4] = u[uvCount8 + 2];
-    uv[5] = v[uvCount8 + 2];
-  case 2:
-    uv[2] = u[uvCount8 + 1];
-    uv[3] = v[uvCount8 + 1];
-  case 1:
-    uv[0] = u[uvCount8 + 0];
-    uv[1] = v[uvCount8 + 0];
-  default:
-    break;
-  }
-
-# else
-
-  const uint32_t uvCount4 = count & ~3U;
-
-  for(uint32_t i = 0; i < uvCount4; i += 4, uv += 8)
-  {
-    const f128 U = loadu4f(u + i);
-    const f128 V = loadu4f(v + i);
-    storeu4f(uv, unpacklo4f(U, V));
-    storeu4f(uv + 4, unpackhi4f(U, V));
-  }
-
-  switch(count & 3)
-  {
-  case 3:
-    uv[4] = u[uvCount4 + 2];
-    uv[5] = v[uvCount4 + 2];
-  case 2:
-    uv[2] = u[uvCount4 + 1];
-    uv[3] = v[uvCount4 + 1];
-  case 1:
-    uv[0] = u[uvCount4 + 0];
-    uv[1] = v[uvCount4 + 0];
-  default:
-    break;
-  }
-
-# endif
-#else
-  for(uint32_t i = 0, j = 0; i < count; i++, j += 2)
-  {
-    uv[j] = u[i];
-    uv[j + 1] = v[i];
-  }
-#endif
+  kernels().zipUVs(u, v, uv, count);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -1252,6 +1336,8 @@ void MeshExportContext::copyUvSetData()
   usdmaya::utils::PrimVarDiffReport diff_report;
   if(performDiff)
   {
+    if(!(diffSets & kUvSets))
+      return;
     uvSetNames = usdmaya::utils::hasNewUvSet(mesh, fnMesh, diff_report);
     if(diff_report.empty() && uvSetNames.length() == 0)
       return;
@@ -1481,118 +1567,7 @@ void MeshExportContext::copyUvSetData()
 //----------------------------------------------------------------------------------------------------------------------
 void interleaveIndexedUvData(float* output, const float* u, const float* v, const int32_t* indices, const uint32_t numIndices)
 {
-#if AL_UTILS_ENABLE_SIMD
-
-#if defined(__AVX2__) && ENABLE_SOME_AVX_ROUTINES
-
-  const uint32_t numIndices8 = numIndices & ~7;
-  uint32_t i = 0;
-  for(; i < numIndices8; i += 8, output += 16)
-  {
-    const i256 I = loadu8i(indices + i);
-    const f256 U = i32gather8f(u, I);
-    const f256 V = i32gather8f(v, I);
-    const f256 uv0 = unpacklo8f(U, V);
-    const f256 uv1 = unpackhi8f(U, V);
-    storeu8f(output, permute2f128(uv0, uv1, 0x20));
-    storeu8f(output + 8, permute2f128(uv0, uv1, 0x31));
-  }
-
-  if(numIndices & 0x4)
-  {
-    const i128 I = loadu4i(indices + i);
-    const f128 U = i32gather4f(u, I);
-    const f128 V = i32gather4f(v, I);
-    const f128 uv0 = unpacklo4f(U, V);
-    const f128 uv1 = unpackhi4f(U, V);
-    storeu4f(output, uv0);
-    storeu4f(output + 4, uv1);
-    output += 8;
-    i += 4;
-  }
-
-#else
-
-  const i128 uptr = splat2i64(intptr_t(u));
-  const i128 vptr = splat2i64(intptr_t(v));
-  const i128 mask = set4i(0xFFFFFFFF, 0, 0xFFFFFFFF, 0);
-
-  const uint32_t numIndices4 = numIndices & ~3;
-  uint32_t i = 0;
-  for(; i < numIndices4; i += 4, output += 8)
-  {
-    // load 4 indices
-    const i128 I = loadu4i(indices + i);
-
-    // mask out into 2 pairs of 64 bit indices, and scale values by 4 (using shift)
-    const i128 I02 = lshift64(and4i(mask, I), 2);
-    const i128 I13 = lshift64(and4i(mask, shiftBytesRight(I, 4)), 2);
-
-    // get addresses by adding the base offset
-    const i128 U02 = add2i64(I02, uptr);
-    const i128 U13 = add2i64(I13, uptr);
-    const i128 V02 = add2i64(I02, vptr);
-    const i128 V13 = add2i64(I13, vptr);
-
-    #ifndef __SSE4_1__
-    ALIGN16(float* ptrs[8]);
-    store4i(ptrs    , U02);
-    store4i(ptrs + 2, U13);
-    store4i(ptrs + 4, V02);
-    store4i(ptrs + 6, V13);
-
-    const f128 u0 = load1f(ptrs[0]);
-    const f128 u2 = load1f(ptrs[1]);
-    const f128 u1 = load1f(ptrs[2]);
-    const f128 u3 = load1f(ptrs[3]);
-    const f128 v0 = load1f(ptrs[4]);
-    const f128 v2 = load1f(ptrs[5]);
-    const f128 v1 = load1f(ptrs[6]);
-    const f128 v3 = load1f(ptrs[7]);
-    #else
-    #define extract_float_ptr(reg, index) reinterpret_cast<const float*>(_mm_extract_epi64(reg, index))
-    const f128 u0 = load1f(extract_float_ptr(U02, 0));
-    const f128 u2 = load1f(extract_float_ptr(U02, 1));
-    const f128 u1 = load1f(extract_float_ptr(U13, 0));
-    const f128 u3 = load1f(extract_float_ptr(U13, 1));
-    const f128 v0 = load1f(extract_float_ptr(V02, 0));
-    const f128 v2 = load1f(extract_float_ptr(V02, 1));
-    const f128 v1 = load1f(extract_float_ptr(V13, 0));
-    const f128 v3 = load1f(extract_float_ptr(V13, 1));
-    #undef extract_ptr
-    #endif
-
-    const f128 uv0 = unpacklo4f(u0, v0);
-    const f128 uv1 = unpacklo4f(u1, v1);
-    storeu4f(output, movelh4f(uv0, uv1));
-
-    const f128 uv2 = unpacklo4f(u2, v2);
-    const f128 uv3 = unpacklo4f(u3, v3);
-    storeu4f(output + 4, movelh4f(uv2, uv3));
-  }
-
-#endif
-
-  switch(numIndices & 0x3)
-  {
-  case 3: output[4] = u[indices[i + 2]];
-          output[5] = v[indices[i + 2]];
-  case 2: output[2] = u[indices[i + 1]];
-          output[3] = v[indices[i + 1]];
-  case 1: output[0] = u[indices[i]];
-          output[1] = v[indices[i]];
-  default: break;
-  }
-
-#else
-
-  for(uint32_t i = 0, j = 0; i < numIndices; ++i, j += 2)
-  {
-    output[j] = u[indices[i]];
-    output[j + 1] = v[indices[i]];
-  }
-
-#endif
+  kernels().interleaveIndexedUvData(output, u, v, indices, numIndices);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -1607,6 +1582,8 @@ void MeshExportContext::copyColourSetData()
   usdmaya::utils::PrimVarDiffReport diff_report;
   if(performDiff)
   {
+    if(!(diffSets & kColourSets))
+      return;
     colourSetNames = usdmaya::utils::hasNewColourSet(mesh, fnMesh, diff_report);
     if(diff_report.empty() && colourSetNames.length() == 0)
       return;
@@ -37,6 +37,8 @@ namespace AL {
 namespace usdmaya {
 namespace utils {
 
+struct MeshFingerprint;
+
 /// \brief  a conversion utility that takes an array of floating point data, and converts it into double precision data
 /// \param  output the double precision output
 /// \param  input the input floating point data
@@ -114,6 +116,15 @@ AL_USDMAYA_UTILS_PUBLIC
 void interleaveIndexedUvData(float* output, const float* u, const float* v, const int32_t* indices, const uint32_t numIndices);
 
 
+//----------------------------------------------------------------------------------------------------------------------
+/// \brief  computes a hash of the number of vertices, the face counts, and the face connects of a maya mesh, which
+///         can be used to find meshes that share the same topology.
+/// \param  fnMesh the mesh to compute the signature for
+/// \return the topology signature
+//----------------------------------------------------------------------------------------------------------------------
+AL_USDMAYA_UTILS_PUBLIC
+uint64_t computeTopologySignature(MFnMesh& fnMesh);
+
 //----------------------------------------------------------------------------------------------------------------------
 /// \brief  A class used to import mesh data from Usd into Maya
 //----------------------------------------------------------------------------------------------------------------------
@@ -142,17 +153,40 @@ public:
     : mesh(mesh), m_timeCode(timeCode)
   {
     gatherFaceConnectsAndVertices();
-    polyShape = fnMesh.create(points.length(), counts.length(), points, counts, connects, parentOrOwner);
-    TfToken orientation;
-    bool leftHanded = (mesh.GetOrientationAttr().Get(&orientation, timeCode) && orientation == UsdGeomTokens->leftHanded);
-    fnMesh.findPlug("op", true).setBool(leftHanded);
-    // 
-    if(parentOrOwner.hasFn(MFn::kTransform))
-    {
-      fnMesh.setName(dagName);
-    }
+    createMesh(parentOrOwner, dagName);
   }
 
+  /// \brief  constructs the import context for the specified mesh, and gathers the vertices and face connects without
+  ///         creating the maya mesh. Either createMesh or reuseMesh must be called prior to calling any of the apply
+  ///         methods.
+  /// \param  mesh the usd geometry to import
+  /// \param  timeCode the time code at which to gather the data from USD
+  MeshImportContext(const UsdGeomMesh& mesh, UsdTimeCode timeCode)
+    : mesh(mesh), m_timeCode(timeCode)
+    { gatherFaceConnectsAndVertices(); }
+
+  /// \brief  creates a new maya mesh from the gathered data
+  /// \param  parentOrOwner the maya transform that will be the parent transform of the geometry being imported, 
+  ///         or a mesh data objected created via MFnMeshData.
+  /// \param  dagName the name for the new mesh node
+  AL_USDMAYA_UTILS_PUBLIC
+  void createMesh(MObject parentOrOwner, MString dagName);
+
+  /// \brief  reuses an existing maya mesh shape with the same topology as the gathered data (i.e. one with a matching
+  ///         topologySignature). The vertices are only written if they differ from those on the mesh, and the holes, 
+  ///         creases, uv sets and colour sets are cleared, ready for the apply methods to set them again.
+  /// \param  existingShape the mesh shape to reuse
+  /// \param  dagName the new name for the mesh node
+  /// \return true if the mesh could be reused, false if its topology does not match (in which case createMesh
+  ///         should be called instead)
+  AL_USDMAYA_UTILS_PUBLIC
+  bool reuseMesh(MObject existingShape, MString dagName);
+
+  /// \brief  returns a hash of the number of vertices, the face counts, and the face connects of the gathered data.
+  ///         This matches computeTopologySignature for a maya mesh with the same topology.
+  AL_USDMAYA_UTILS_PUBLIC
+  uint64_t topologySignature();
+
   /// \brief  reads the HoleIndices attribute from the usd geometry, and assigns those values as invisible faces on
   ///         the Maya mesh
   AL_USDMAYA_UTILS_PUBLIC
@@ -208,6 +242,10 @@ public:
   /// \param  timeCode the time where the mesh data should be written
   /// \param  performDiff if true, perform a diff check to ensure only data that has changed gets written into USD
   /// \param  compactionLevel the amount of processing we want to perform when computing interpolation modes
+  /// \param  reverseNormals if true, the normals of 'opposite' meshes are reversed
+  /// \param  fingerprint if performing a diff, an optional fingerprint of the mesh taken when it last matched the
+  ///         USD prim. Only the components whose fingerprint has changed are compared against the USD data. On return
+  ///         it is updated to the fingerprint of the current mesh, on the assumption that all components are copied.
   AL_USDMAYA_UTILS_PUBLIC
   MeshExportContext(
     MDagPath path,
@@ -215,7 +253,8 @@ public:
     UsdTimeCode timeCode,
     bool performDiff = false,
     CompactionLevel compactionLevel = kFull,
-    bool reverseNormals = false);
+    bool reverseNormals = false,
+    MeshFingerprint* fingerprint = nullptr);
 
   /// \brief  returns true if it's ok to continue exporting the data
   operator bool () const
@@ -281,6 +320,7 @@ private:
   UsdGeomMesh& mesh; ///< the usd geometry
   uint32_t diffGeom; ///< the bit flags for standard geom params
   uint32_t diffMesh; ///< the bit flags for mesh params
+  uint32_t diffSets; ///< the bit flags for the uv and colour sets
   CompactionLevel compaction;
   bool valid; ///< true if the function set is ok
   bool performDiff; ///< true if performing a diff on export
@@ -0,0 +1,22 @@
+//
+// Copyright 2020 Autodesk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+// MeshUtils kernels compiled for AVX2, see mayaUsd_add_simd_sources.
+#if !defined(__AVX2__)
+# error "MeshUtilsAVX2.cpp must be compiled with AVX2 enabled"
+#endif
+
+#include "AL/usdmaya/utils/MeshUtilsImpl.h"
@@ -0,0 +1,260 @@
+//
+// Copyright 2017 Animal Logic
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+// Implementation of the MeshUtils conversion kernels. This file is not a public header, it is included by one source
+// file per instruction set, and the #if branches taken below depend on the compiler flags of that source file.
+
+#pragma once
+
+#include "AL/usdmaya/utils/MeshUtilsKernels.h"
+
+#include <mayaUsdUtils/SIMD.h>
+
+namespace AL {
+namespace usdmaya {
+namespace utils {
+namespace {
+
+using namespace MayaUsdUtils;
+
+//----------------------------------------------------------------------------------------------------------------------
+void floatToDouble(double* output, const float* const input, size_t count)
+{
+  size_t i = 0;
+
+#if ENABLE_AVX512_ROUTINES
+
+  for(const size_t count8 = count & ~size_t(7); i < count8; i += 8)
+  {
+    storeu8d(output + i, cvt8f_to_8d(loadu8f(input + i)));
+  }
+
+  if(count & 0x7)
+  {
+    const mask8 m = tailmask8(count);
+    storeu8d(output + i, cvt8f_to_8d(loadu8f(input + i, m)), m);
+  }
+  return;
+
+#elif defined(__AVX2__)
+
+  for(const size_t count4 = count & ~size_t(3); i < count4; i += 4)
+  {
+    storeu4d(output + i, cvt4f_to_4d(loadu4f(input + i)));
+  }
+
+#endif
+
+  for(; i < count; ++i)
+  {
+    output[i] = double(input[i]);
+  }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void zipUVs(const float* u, const float* v, float* uv, const size_t count)
+{
+#if ENABLE_AVX512_ROUTINES
+
+  size_t i = 0;
+  for(const size_t count16 = count & ~size_t(15); i < count16; i += 16, uv += 32)
+  {
+    const f512 U = loadu16f(u + i);
+    const f512 V = loadu16f(v + i);
+    storeu16f(uv, ziplo16f(U, V));
+    storeu16f(uv + 16, ziphi16f(U, V));
+  }
+
+  const size_t remaining = count & 0xF;
+  if(remaining)
+  {
+    const mask16 m = tailmask16(count);
+    const f512 U = loadu16f(u + i, m);
+    const f512 V = loadu16f(v + i, m);
+    storeu16f(uv, ziplo16f(U, V), prefixmask16(remaining * 2));
+    if(remaining > 8)
+      storeu16f(uv + 16, ziphi16f(U, V), prefixmask16(remaining * 2 - 16));
+  }
+
+#elif defined(__AVX2__)
+
+  size_t uvCount8 = count & ~size_t(7);
+
+  for(size_t i = 0; i < uvCount8; i += 8, uv += 16)
+  {
+    const f256 U = loadu8f(u + i);
+    const f256 V = loadu8f(v + i);
+    const f256 uv0 = unpacklo8f(U, V);
+    const f256 uv1 = unpackhi8f(U, V);
+    storeu8f(uv, permute2f128(uv0, uv1, 0x20));
+    storeu8f(uv + 8, permute2f128(uv0, uv1, 0x31));
+  }
+
+  if(count & 0x4)
+  {
+    const f128 U = loadu4f(u + uvCount8);
+    const f128 V = loadu4f(v + uvCount8);
+    storeu4f(uv, unpacklo4f(U, V));
+    storeu4f(uv + 4, unpackhi4f(U, V));
+    uv += 8;
+    uvCount8 += 4;
+  }
+
+  switch(count & 3)
+  {
+  case 3:
+    uv[4] = u[uvCount8 + 2];
+    uv[5] = v[uvCount8 + 2];
+  case 2:
+    uv[2] = u[uvCount8 + 1];
+    uv[3] = v[uvCount8 + 1];
+  case 1:
+    uv[0] = u[uvCount8 + 0];
+    uv[1] = v[uvCount8 + 0];
+  default:
+    break;
+  }
+
+#elif defined(__SSE__)
+
+  const size_t uvCount4 = count & ~size_t(3);
+
+  for(size_t i = 0; i < uvCount4; i += 4, uv += 8)
+  {
+    const f128 U = loadu4f(u + i);
+    const f128 V = loadu4f(v + i);
+    storeu4f(uv, unpacklo4f(U, V));
+    storeu4f(uv + 4, unpackhi4f(U, V));
+  }
+
+  switch(count & 3)
+  {
+  case 3:
+    uv[4] = u[uvCount4 + 2];
+    uv[5] = v[uvCount4 + 2];
+  case 2:
+    uv[2] = u[uvCount4 + 1];
+    uv[3] = v[uvCount4 + 1];
+  case 1:
+    uv[0] = u[uvCount4 + 0];
+    uv[1] = v[uvCount4 + 0];
+  default:
+    break;
+  }
+
+#else
+  for(size_t i = 0, j = 0; i < count; i++, j += 2)
+  {
+    uv[j] = u[i];
+    uv[j + 1] = v[i];
+  }
+#endif
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void interleaveIndexedUvData(float* output, const float* u, const float* v, const int32_t* indices, const uint32_t numIndices)
+{
+#if ENABLE_AVX512_ROUTINES
+
+  uint32_t i = 0;
+  for(const uint32_t numIndices16 = numIndices & ~15U; i < numIndices16; i += 16, output += 32)
+  {
+    const i512 I = loadu16i(indices + i);
+    const f512 U = i32gather16f(u, I);
+    const f512 V = i32gather16f(v, I);
+    storeu16f(output, ziplo16f(U, V));
+    storeu16f(output + 16, ziphi16f(U, V));
+  }
+
+  // the lanes disabled in the mask are neither loaded nor gathered
+  const uint32_t remaining = numIndices & 0xF;
+  if(remaining)
+  {
+    const mask16 m = tailmask16(numIndices);
+    const i512 I = loadu16i(indices + i, m);
+    const f512 U = i32gather16f(u, I, m);
+    const f512 V = i32gather16f(v, I, m);
+    storeu16f(output, ziplo16f(U, V), prefixmask16(remaining * 2));
+    if(remaining > 8)
+      storeu16f(output + 16, ziphi16f(U, V), prefixmask16(remaining * 2 - 16));
+  }
+
+#elif defined(__AVX2__) && ENABLE_SOME_AVX_ROUTINES
+
+  const uint32_t numIndices8 = numIndices & ~7U;
+  uint32_t i = 0;
+  for(; i < numIndices8; i += 8, output += 16)
+  {
+    const i256 I = loadu8i(indices + i);
+    const f256 U = i32gather8f(u, I);
+    const f256 V = i32gather8f(v, I);
+    const f256 uv0 = unpacklo8f(U, V);
+    const f256 uv1 = unpackhi8f(U, V);
+    storeu8f(output, permute2f128(uv0, uv1, 0x20));
+    storeu8f(output + 8, permute2f128(uv0, uv1, 0x31));
+  }
+
+  if(numIndices & 0x4)
+  {
+    const i128 I = loadu4i(indices + i);
+    const f128 U = i32gather4f(u, I);
+    const f128 V = i32gather4f(v, I);
+    const f128 uv0 = unpacklo4f(U, V);
+    const f128 uv1 = unpackhi4f(U, V);
+    storeu4f(output, uv0);
+    storeu4f(output + 4, uv1);
+    output += 8;
+    i += 4;
+  }
+
+  switch(numIndices & 0x3)
+  {
+  case 3: output[4] = u[indices[i + 2]];
+          output[5] = v[indices[i + 2]];
+  case 2: output[2] = u[indices[i + 1]];
+          output[3] = v[indices[i + 1]];
+  case 1: output[0] = u[indices[i]];
+          output[1] = v[indices[i]];
+  default: break;
+  }
+
+#else
+
+  for(uint32_t i = 0, j = 0; i < numIndices; ++i, j += 2)
+  {
+    output[j] = u[indices[i]];
+    output[j + 1] = v[indices[i]];
+  }
+
+#endif
+}
+
+} // anon
+
+//----------------------------------------------------------------------------------------------------------------------
+const MeshUtilsKernels& MAYAUSD_SIMD_NAME(MeshUtilsKernels)()
+{
+  static const MeshUtilsKernels kernels = {
+    &floatToDouble,
+    &zipUVs,
+    &interleaveIndexedUvData
+  };
+  return kernels;
+}
+
+} // utils
+} // usdmaya
+} // AL
@@ -0,0 +1,46 @@
+//
+// Copyright 2020 Autodesk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#pragma once
+
+#include "AL/usdmaya/utils/Api.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace AL {
+namespace usdmaya {
+namespace utils {
+
+//----------------------------------------------------------------------------------------------------------------------
+/// \brief  The SIMD conversion routines of MeshUtils compiled for one instruction set. MeshUtilsImpl.h is compiled once
+///         per instruction set (MeshUtilsBaseline.cpp, MeshUtilsAVX2.cpp, MeshUtilsAVX512.cpp), and MeshUtils.cpp
+///         forwards the public functions to the table matching MayaUsdUtils::activeSimdLevel().
+//----------------------------------------------------------------------------------------------------------------------
+struct MeshUtilsKernels
+{
+  void (*floatToDouble)(double*, const float*, size_t);
+  void (*zipUVs)(const float*, const float*, float*, size_t);
+  void (*interleaveIndexedUvData)(float*, const float*, const float*, const int32_t*, uint32_t);
+};
+
+/// the kernel tables, only those enabled by MAYAUSD_SIMD_HAS_AVX2 / MAYAUSD_SIMD_HAS_AVX512 are compiled
+AL_USDMAYA_UTILS_LOCAL const MeshUtilsKernels& baselineMeshUtilsKernels();
+AL_USDMAYA_UTILS_LOCAL const MeshUtilsKernels& avx2MeshUtilsKernels();
+AL_USDMAYA_UTILS_LOCAL const MeshUtilsKernels& avx512MeshUtilsKernels();
+
+} // utils
+} // usdmaya
+} // AL
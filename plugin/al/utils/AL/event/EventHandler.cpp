@@ -67,12 +67,98 @@ Callback::Callback(const char* const tag, const char* const commandText, uint32_
 //----------------------------------------------------------------------------------------------------------------------
 Callback::~Callback()
 {
+  releaseCompiledScript();
   if(m_functionType != kCFunction)
   {
     delete [] m_callbackString;
   }
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+void Callback::compileScript(EventSystemBinding* system)
+{
+  if(isCCallback() || m_compiledScript || !system)
+    return;
+  const auto type = CallbackType(m_functionType);
+  m_compiledScript = system->compileScript(type, m_callbackString);
+  m_compiler = m_compiledScript ? system : nullptr;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void Callback::releaseCompiledScript()
+{
+  if(m_compiledScript)
+  {
+    m_compiler->releaseCompiledScript(CallbackType(m_functionType), m_compiledScript);
+    m_compiledScript = 0;
+    m_compiler = nullptr;
+  }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void EventDispatcher::executeScript(Callback& callback, const char* const payload)
+{
+  EventPayloads payloads;
+  if(payload && callback.compiledScript())
+  {
+    payloads.emplace_back(payload);
+  }
+  executeScript(callback, payloads);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void EventDispatcher::executeScript(Callback& callback, const EventPayloads& payloads)
+{
+  bool executed;
+  if(callback.compiledScript())
+  {
+    executed = m_system->executeCompiledScript(
+        CallbackType(callback.m_functionType), callback.compiledScript(), payloads);
+  }
+  else
+  {
+    executed = callback.isPythonCallback() ?
+        m_system->executePython(callback.callbackText()) :
+        m_system->executeMEL(callback.callbackText());
+  }
+
+  if(!executed)
+  {
+    m_system->error("The %s callback of event name \"%s\" and tag \"%s\" failed to execute correctly",
+        callback.isPythonCallback() ? "python" : "MEL", m_name.c_str(), callback.tag().c_str());
+  }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void EventDispatcher::deferScriptCallbacks(const char* const payload)
+{
+  m_pending = true;
+  if(payload)
+  {
+    m_pendingPayloads.emplace_back(payload);
+  }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void EventDispatcher::flushBatch()
+{
+  m_batched = false;
+  if(!m_pending)
+    return;
+
+  // take a copy of the payloads, a callback may trigger this event again
+  m_pending = false;
+  const EventPayloads payloads(std::move(m_pendingPayloads));
+  m_pendingPayloads.clear();
+  for(auto& callback : m_callbacks)
+  {
+    if(!callback.isCCallback())
+    {
+      executeScript(callback, payloads);
+    }
+  }
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 Callback EventDispatcher::buildCallbackInternal(
   const char* const tag,
@@ -146,7 +232,8 @@ CallbackId EventDispatcher::registerCallback(
     newId = std::max(newId, it->callbackId());
   }
 
-  m_callbacks.emplace(insertLocation, tag, commandText, weight, isPython, ++newId);
+  auto inserted = m_callbacks.emplace(insertLocation, tag, commandText, weight, isPython, ++newId);
+  inserted->compileScript(m_system);
   return newId;
 }
 
@@ -190,7 +277,8 @@ void EventDispatcher::registerCallback(Callback& info)
       return;
     }
   }
-  m_callbacks.insert(insertLocation, std::move(info));
+  auto inserted = m_callbacks.insert(insertLocation, std::move(info));
+  inserted->compileScript(m_system);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -256,10 +344,48 @@ EventId EventScheduler::registerEvent(const char* eventName, EventType eventType
     }
   }
 
-  m_registeredEvents.emplace(insertLocation, m_system, eventName, unusedId, eventType, associatedData, parentCallback);
+  auto inserted = m_registeredEvents.emplace(insertLocation, m_system, eventName, unusedId, eventType, associatedData, parentCallback);
+  inserted->m_batched = isBatching();
   return unusedId;
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+void EventScheduler::beginBatch()
+{
+  if(m_batchDepth++ == 0)
+  {
+    for(auto& it : m_registeredEvents)
+    {
+      it.m_batched = true;
+    }
+  }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void EventScheduler::endBatch()
+{
+  if(!m_batchDepth || --m_batchDepth)
+    return;
+
+  // the callbacks may register or unregister events, so gather the pending events before executing any of them
+  EventIds pending;
+  for(auto& it : m_registeredEvents)
+  {
+    if(it.m_pending)
+      pending.push_back(it.eventId());
+    else
+      it.m_batched = false;
+  }
+  for(auto eventId : pending)
+  {
+    EventDispatcher* dispatcher = event(eventId);
+    if(dispatcher)
+    {
+      dispatcher->flushBatch();
+    }
+  }
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 bool EventScheduler::unregisterEvent(EventId eventId)
 {
@@ -71,6 +71,9 @@ typedef std::vector<EventId> EventIds;
 /// \ingroup events
 /// \brief  an array of callback IDs
 typedef std::vector<CallbackId> CallbackIds;
+/// \ingroup events
+/// \brief  the payloads passed to a script callback, one per trigger of the event
+typedef std::vector<std::string> EventPayloads;
 
 /// \brief  extracts the event ID from a callback ID
 /// \param  id the callback id from which you wish to extract the event id from
@@ -183,6 +186,29 @@ public:
   /// \return true if executed correctly
   virtual bool executeMEL(const char* const code) = 0;
 
+  /// \brief  override to compile the code of a script callback when it is registered, so that the code does not need
+  ///         to be parsed again each time the callback is triggered.
+  /// \param  type the language of the code (kPython or kMEL)
+  /// \param  code the code to compile
+  /// \return a non-zero handle to the compiled code, or zero if the code was not compiled, in which case it will be
+  ///         executed from source with executePython or executeMEL.
+  virtual uint64_t compileScript(CallbackType type, const char* const code)
+    { return 0; }
+
+  /// \brief  override to execute code returned by compileScript
+  /// \param  type the language of the code (kPython or kMEL)
+  /// \param  handle the handle returned by compileScript
+  /// \param  payloads the payloads of the triggers the callback is run for, to be made available to the script
+  /// \return true if executed correctly
+  virtual bool executeCompiledScript(CallbackType type, uint64_t handle, const EventPayloads& payloads)
+    { return false; }
+
+  /// \brief  override to release code returned by compileScript
+  /// \param  type the language of the code (kPython or kMEL)
+  /// \param  handle the handle returned by compileScript
+  virtual void releaseCompiledScript(CallbackType type, uint64_t handle)
+    {}
+
   /// \brief  override to implement the logging system
   /// \param  severity
   /// \param  text the text to log
@@ -283,10 +309,13 @@ public:
   /// \brief  move ctor
   /// \param  rhs the rvalue to move
   Callback(Callback&& rhs)
-    : m_tag(std::move(rhs.m_tag)), m_userData(rhs.m_userData), m_callbackId(rhs.m_callbackId)
+    : m_tag(std::move(rhs.m_tag)), m_userData(rhs.m_userData), m_callbackId(rhs.m_callbackId),
+      m_compiler(rhs.m_compiler), m_compiledScript(rhs.m_compiledScript)
   {
     m_callback = rhs.m_callback;
     rhs.m_callback = nullptr;
+    rhs.m_compiler = nullptr;
+    rhs.m_compiledScript = 0;
     m_weight = rhs.m_weight;
     m_functionType = rhs.m_functionType;
   }
@@ -296,11 +325,16 @@ public:
   /// \return a reference to this
   Callback& operator = (Callback&& rhs)
     {
+      releaseCompiledScript();
       m_tag = std::move(rhs.m_tag);
       m_userData = rhs.m_userData;
       m_callbackId = rhs.m_callbackId;
       m_callback = rhs.m_callback;
       rhs.m_callback = nullptr;
+      m_compiler = rhs.m_compiler;
+      m_compiledScript = rhs.m_compiledScript;
+      rhs.m_compiler = nullptr;
+      rhs.m_compiledScript = 0;
       m_weight = rhs.m_weight;
       m_functionType = rhs.m_functionType;
       return *this;
@@ -361,10 +395,19 @@ public:
   bool isCCallback() const
     { return m_functionType == kCFunction; }
 
+  /// \returns the handle of the compiled script code, or zero if the script is executed from its source
+  uint64_t compiledScript() const
+    { return m_compiledScript; }
+
 private:
+  void compileScript(EventSystemBinding* system);
+  void releaseCompiledScript();
+
   std::string m_tag;
   void* m_userData;
   CallbackId m_callbackId;
+  EventSystemBinding* m_compiler = nullptr;
+  uint64_t m_compiledScript = 0;
   union
   {
     const void* m_callback;
@@ -419,7 +462,11 @@ public:
       m_associatedData(rhs.m_associatedData),
       m_parentCallback(rhs.m_parentCallback),
       m_eventId(rhs.m_eventId),
-      m_eventType(rhs.m_eventType)
+      m_eventType(rhs.m_eventType),
+      m_pendingPayloads(std::move(rhs.m_pendingPayloads)),
+      m_coalesced(rhs.m_coalesced),
+      m_batched(rhs.m_batched),
+      m_pending(rhs.m_pending)
     {}
 
   /// \brief  move assignment
@@ -434,6 +481,10 @@ public:
       m_parentCallback = rhs.m_parentCallback;
       m_eventId = rhs.m_eventId;
       m_eventType = rhs.m_eventType;
+      m_pendingPayloads = std::move(rhs.m_pendingPayloads);
+      m_coalesced = rhs.m_coalesced;
+      m_batched = rhs.m_batched;
+      m_pending = rhs.m_pending;
       return *this;
     }
 
@@ -574,9 +625,11 @@ public:
   /// }
   /// \endcode
   /// \param  binder a function object that binds the call to the underlying function pointer
+  /// \param  payload an optional text payload made available to script callbacks (see EventBatch)
   template<typename FunctionBinder>
-  void triggerEvent(FunctionBinder binder)
+  void triggerEvent(FunctionBinder binder, const char* const payload = nullptr)
   {
+    const bool deferScripts = m_coalesced && m_batched;
     for(auto& callback : m_callbacks)
     {
       if(callback.isCCallback())
@@ -584,23 +637,15 @@ public:
         binder(callback.userData(), callback.callback());
       }
       else
-      if(callback.isPythonCallback())
-      {
-        if(!m_system->executePython(callback.callbackText()))
-        {
-          m_system->error("The python callback of event name \"%s\" and tag \"%s\" failed to execute correctly",
-              m_name.c_str(), callback.tag().c_str());
-        }
-      }
-      else
+      if(!deferScripts)
       {
-        if(!m_system->executeMEL(callback.callbackText()))
-        {
-          m_system->error("The MEL callback of event name \"%s\" and tag \"%s\" failed to execute correctly",
-              m_name.c_str(), callback.tag().c_str());
-        }
+        executeScript(callback, payload);
       }
     }
+    if(deferScripts)
+    {
+      deferScriptCallbacks(payload);
+    }
   }
 
   /// \brief  a default version of dispatchEvent that assumes a function callback type of
@@ -609,33 +654,22 @@ public:
   /// \endcode
   void triggerEvent()
   {
-    for(auto& callback : m_callbacks)
-    {
-      if(callback.isCCallback())
-      {
-        defaultEventFunction basic = (defaultEventFunction)callback.callback();
-        basic(callback.userData());
-      }
-      else
-      if(callback.isPythonCallback())
-      {
-        if(!m_system->executePython(callback.callbackText()))
-        {
-          m_system->error("The python callback of event name \"%s\" and tag \"%s\" failed to execute correctly",
-              m_name.c_str(), callback.tag().c_str());
-        }
-      }
-      else
-      {
-        if(!m_system->executeMEL(callback.callbackText()))
-        {
-          m_system->error("The MEL callback of event name \"%s\" and tag \"%s\" failed to execute correctly",
-              m_name.c_str(), callback.tag().c_str());
-        }
-      }
-    }
+    triggerEvent([](void* userData, const void* callback) {
+        ((defaultEventFunction)callback)(userData);
+      });
   }
 
+  /// \brief  when set, the script callbacks of this event are not executed straight away when the event is triggered
+  ///         within an EventBatch. They are executed once at the end of the batch instead, with the payloads of all of
+  ///         the triggers. C++ callbacks are always executed straight away.
+  /// \param  coalesced true to coalesce the script callbacks triggered within a batch
+  void setCoalesced(bool coalesced)
+    { m_coalesced = coalesced; }
+
+  /// \brief  returns true if the script callbacks of this event are coalesced within an EventBatch
+  bool coalesced() const
+    { return m_coalesced; }
+
   /// \brief  used to sort the events based on their ID
   /// \param  eventId the event id to compare to
   /// \return true if the event ID of this event  is lower than the comparison event
@@ -671,6 +705,12 @@ public:
     }
 
 private:
+  AL_EVENT_PUBLIC
+  void executeScript(Callback& callback, const char* const payload);
+  void executeScript(Callback& callback, const EventPayloads& payloads);
+  AL_EVENT_PUBLIC
+  void deferScriptCallbacks(const char* const payload);
+  void flushBatch();
   AL_EVENT_PUBLIC
   CallbackId registerCallbackInternal(
     const char* const tag,
@@ -691,6 +731,10 @@ private:
   CallbackId m_parentCallback;
   EventId m_eventId;
   EventType m_eventType;
+  EventPayloads m_pendingPayloads;
+  bool m_coalesced = false; ///< script callbacks are deferred to the end of a batch
+  bool m_batched = false; ///< a batch is in progress
+  bool m_pending = false; ///< the event has been triggered during the batch
 };
 typedef std::vector<EventDispatcher> EventDispatchers;
 
@@ -785,14 +829,15 @@ public:
   /// \brief  dispatches an event using a function binder
   /// \param  eventId the event to dispatch
   /// \param  binder the binder to dispatch the event
+  /// \param  payload an optional text payload made available to script callbacks
   /// \return true if the event is valid
   template<typename FunctionBinder>
-  bool triggerEvent(EventId eventId, FunctionBinder binder)
+  bool triggerEvent(EventId eventId, FunctionBinder binder, const char* const payload = nullptr)
   {
     EventDispatcher* e = event(eventId);
     if(e)
     {
-      e->triggerEvent(binder);
+      e->triggerEvent(binder, payload);
       return true;
     }
     return false;
@@ -1044,10 +1089,59 @@ public:
   void registerHandler(EventType type, CustomEventHandler* handler)
     { m_customHandlers[type] = handler; }
 
+  /// \brief  starts a batch of events. Batches may be nested, the coalesced script callbacks are executed when the
+  ///         outermost batch ends. Prefer the EventBatch scope to calling this directly.
+  AL_EVENT_PUBLIC
+  void beginBatch();
+
+  /// \brief  ends a batch of events, and executes the script callbacks of the coalesced events that have been
+  ///         triggered during the batch, once per callback.
+  AL_EVENT_PUBLIC
+  void endBatch();
+
+  /// \brief  returns true if a batch of events is in progress
+  bool isBatching() const
+    { return m_batchDepth != 0; }
+
 private:
   EventSystemBinding* m_system;
   EventDispatchers m_registeredEvents;
   std::unordered_map<EventType, CustomEventHandler*> m_customHandlers;
+  uint32_t m_batchDepth = 0;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+/// \brief  A scope within which the script callbacks of coalesced events (see EventDispatcher::setCoalesced) are
+///         deferred. When the scope ends, each of these callbacks is executed once with the payloads of every trigger
+///         of its event, rather than once per trigger.
+/// \code
+/// {
+///   AL::event::EventBatch batch;
+///   for(auto& path : paths)
+///     scheduler.triggerEvent(eventId, binder, path.GetText());
+/// } // script callbacks are executed here
+/// \endcode
+/// \ingroup events
+//----------------------------------------------------------------------------------------------------------------------
+class EventBatch
+{
+public:
+
+  /// \brief  ctor, starts the batch
+  /// \param  scheduler the scheduler the events are triggered on
+  explicit EventBatch(EventScheduler& scheduler = EventScheduler::getScheduler())
+    : m_scheduler(scheduler)
+    { m_scheduler.beginBatch(); }
+
+  /// \brief  dtor, ends the batch
+  ~EventBatch()
+    { m_scheduler.endBatch(); }
+
+  EventBatch(const EventBatch&) = delete;
+  EventBatch& operator = (const EventBatch&) = delete;
+
+private:
+  EventScheduler& m_scheduler;
 };
 
 class NodeEvents;
@@ -1074,8 +1168,9 @@ public:
 
   /// \brief  trigger the event of the given name
   /// \param  eventName the name of the event to trigger on this node
+  /// \param  payload an optional text payload made available to script callbacks
   /// \return true if the events triggered correctly
-  bool triggerEvent(const char* const eventName)
+  bool triggerEvent(const char* const eventName, const char* const payload = nullptr)
   {
     auto it = m_events.find(eventName);
     if(it !=  m_events.end())
@@ -1083,7 +1178,7 @@ public:
       return m_scheduler->triggerEvent(it->second,
           [this](void* userData, const void* callback) {
               ((node_dispatch_func)callback)(userData, this);
-          });
+          }, payload);
     }
     return false;
   }
@@ -1135,6 +1230,20 @@ public:
     return id != InvalidEventId;
   }
 
+  /// \brief  sets whether the script callbacks of an event on this node are coalesced within an EventBatch
+  /// \param  eventName the name of the event
+  /// \param  coalesced true to coalesce the script callbacks of the event
+  /// \return true if the event was found
+  bool setCoalesced(const char* const eventName, const bool coalesced)
+  {
+    EventDispatcher* const dispatcher = m_scheduler->event(getId(eventName));
+    if(dispatcher)
+    {
+      dispatcher->setCoalesced(coalesced);
+    }
+    return dispatcher != nullptr;
+  }
+
   /// \brief  unregisters an event from this node
   /// \param  eventName the name of the event to remove
   /// \return true if the event could be removed
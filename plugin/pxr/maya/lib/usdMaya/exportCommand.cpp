@@ -62,6 +62,9 @@ MSyntax UsdMayaExportCommand::createSyntax()
     syntax.addFlag("-shd",
                    UsdMayaJobExportArgsTokens->shadingMode.GetText(),
                    MSyntax::kString);
+    syntax.addFlag("-ssn",
+                   UsdMayaJobExportArgsTokens->shareShadingNetworks.GetText(),
+                   MSyntax::kBoolean);
     syntax.addFlag("-msn",
                    UsdMayaJobExportArgsTokens->materialsScopeName.GetText(),
                    MSyntax::kString);
@@ -124,6 +127,9 @@ MSyntax UsdMayaExportCommand::createSyntax()
     syntax.addFlag("-com",
                    UsdMayaJobExportArgsTokens->compatibility.GetText(),
                    MSyntax::kString);
+    syntax.addFlag("-cfc",
+                   UsdMayaJobExportArgsTokens->clipFrameCount.GetText(),
+                   MSyntax::kLong);
 
     syntax.addFlag("-chr",
                    UsdMayaJobExportArgsTokens->chaser.GetText(),
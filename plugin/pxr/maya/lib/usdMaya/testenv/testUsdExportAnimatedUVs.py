@@ -0,0 +1,89 @@
+#!/pxrpythonsubst
+#
+# Copyright 2020 Pixar
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+from pxr import Gf
+from pxr import Usd
+from pxr import UsdGeom
+
+from maya import cmds
+from maya import standalone
+
+import os
+import unittest
+
+
+class testUsdExportAnimatedUVs(unittest.TestCase):
+
+    @classmethod
+    def setUpClass(cls):
+        standalone.initialize('usd')
+        cmds.loadPlugin('pxrUsd')
+
+        cmds.file(new=True, force=True)
+        plane = cmds.polyPlane(name='AnimatedUVPlane',
+            subdivisionsX=1, subdivisionsY=1)[0]
+
+        # Slide the UVs over time, without changing the topology or the
+        # number of UVs.
+        moveUV = cmds.polyMoveUV(plane + '.map[0:3]', translateU=0.0)[0]
+        cmds.setKeyframe(moveUV, attribute='translateU', time=1, value=0.0)
+        cmds.setKeyframe(moveUV, attribute='translateU', time=3, value=0.5)
+
+        usdFilePath = os.path.abspath('AnimatedUVs.usda')
+        cmds.usdExport(file=usdFilePath, mergeTransformAndShape=True,
+            frameRange=(1, 3))
+
+        cls._stage = Usd.Stage.Open(usdFilePath)
+
+    @classmethod
+    def tearDownClass(cls):
+        standalone.uninitialize()
+
+    def _GetMesh(self):
+        mesh = UsdGeom.Mesh.Get(self._stage, '/AnimatedUVPlane')
+        self.assertTrue(mesh)
+        return mesh
+
+    def testUVsAreWrittenEveryFrame(self):
+        """
+        Tests that animated UVs are sampled on every frame even though the
+        topology of the mesh does not change.
+        """
+        primvar = UsdGeom.PrimvarsAPI(self._GetMesh()).GetPrimvar('st')
+        self.assertTrue(primvar)
+        self.assertEqual(primvar.GetAttr().GetTimeSamples(), [1.0, 2.0, 3.0])
+
+        start = primvar.ComputeFlattened(1.0)
+        end = primvar.ComputeFlattened(3.0)
+        self.assertEqual(len(start), len(end))
+        for startUV, endUV in zip(start, end):
+            self.assertTrue(Gf.IsClose(endUV[0] - startUV[0], 0.5, 1e-5))
+            self.assertTrue(Gf.IsClose(endUV[1], startUV[1], 1e-5))
+
+    def testTopologyIsWrittenOnce(self):
+        """
+        Tests that the unchanged topology is only sampled on the first frame.
+        """
+        mesh = self._GetMesh()
+        self.assertEqual(
+            mesh.GetFaceVertexCountsAttr().GetTimeSamples(), [1.0])
+        self.assertEqual(
+            mesh.GetFaceVertexIndicesAttr().GetTimeSamples(), [1.0])
+
+
+if __name__ == '__main__':
+    unittest.main(verbosity=2)
@@ -0,0 +1,138 @@
+#!/pxrpythonsubst
+#
+# Copyright 2020 Autodesk
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+import os
+import unittest
+
+from maya import cmds
+from maya import standalone
+
+from pxr import Sdf
+from pxr import Usd
+from pxr import UsdGeom
+
+
+class testUsdExportClips(unittest.TestCase):
+
+    @classmethod
+    def setUpClass(cls):
+        standalone.initialize('usd')
+
+        cmds.loadPlugin('pxrUsd', quiet=True)
+
+        cmds.file(new=True, force=True)
+        cmds.polyCube(name='Cube')
+
+        # The translation changes on frames 1 to 4 and on frame 7 only, so
+        # that it holds its value across clips.
+        cmds.setKeyframe('Cube', attribute='translateX', time=1, value=0.0)
+        cmds.setKeyframe('Cube', attribute='translateX', time=4, value=3.0)
+        cmds.keyTangent('Cube', attribute='translateX', inTangentType='linear',
+            outTangentType='linear')
+        cmds.setKeyframe('Cube', attribute='translateY', time=6, value=0.0)
+        cmds.setKeyframe('Cube', attribute='translateY', time=7, value=2.0)
+        cmds.keyTangent('Cube', attribute='translateY', inTangentType='step',
+            outTangentType='step')
+
+        # Animating a point makes the mesh itself animated, which is what
+        # makes its indexed primvars go through the cleanup after the export.
+        cmds.setKeyframe('Cube.vtx[0]', attribute='pntx', time=1, value=0.0)
+        cmds.setKeyframe('Cube.vtx[0]', attribute='pntx', time=10, value=1.0)
+
+    @classmethod
+    def tearDownClass(cls):
+        standalone.uninitialize()
+
+    def _Export(self, fileName, **kwargs):
+        usdFilePath = os.path.abspath(fileName)
+        cmds.usdExport(mergeTransformAndShape=True, shadingMode='none',
+            file=usdFilePath, frameRange=(1, 10), **kwargs)
+
+        stage = Usd.Stage.Open(usdFilePath)
+        self.assertTrue(stage)
+        return stage
+
+    def testExportClips(self):
+        '''
+        A streamed export resolves to the same values as a regular export, with
+        all of the time samples in the clips.
+        '''
+        expected = self._Export('UsdExportClips_NoClips.usda')
+        stage = self._Export('UsdExportClips_Clips.usda', clipFrameCount=3)
+
+        for i in range(4):
+            self.assertTrue(os.path.isfile(
+                os.path.abspath('UsdExportClips_Clips.clip%04d.usdc' % i)))
+        self.assertTrue(os.path.isfile(
+            os.path.abspath('UsdExportClips_Clips.manifest.usdc')))
+
+        clipsAPI = Usd.ClipsAPI(stage.GetPrimAtPath('/Cube'))
+        self.assertEqual(len(clipsAPI.GetClipAssetPaths()), 4)
+
+        layer = stage.GetRootLayer()
+        attrPath = Sdf.Path('/Cube.xformOp:translate')
+        self.assertEqual(layer.GetNumTimeSamplesForPath(attrPath), 0)
+
+        expectedAttr = expected.GetPrimAtPath('/Cube').GetAttribute(
+            'xformOp:translate')
+        attr = stage.GetPrimAtPath('/Cube').GetAttribute('xformOp:translate')
+        for frame in range(1, 11):
+            self.assertEqual(attr.Get(frame), expectedAttr.Get(frame),
+                'frame %d' % frame)
+
+        # The primvars of the animated mesh are cleaned up in the clips, just
+        # like they are in the regular export.
+        expectedSt = UsdGeom.PrimvarsAPI(
+            expected.GetPrimAtPath('/Cube')).GetPrimvar('st')
+        st = UsdGeom.PrimvarsAPI(stage.GetPrimAtPath('/Cube')).GetPrimvar('st')
+        self.assertTrue(st.IsIndexed())
+        self.assertEqual(st.GetUnauthoredValuesIndex(),
+            expectedSt.GetUnauthoredValuesIndex())
+        for frame in range(1, 11):
+            self.assertEqual(st.Get(frame), expectedSt.Get(frame),
+                'frame %d' % frame)
+            self.assertEqual(st.GetIndices(frame),
+                expectedSt.GetIndices(frame), 'frame %d' % frame)
+
+    def testFallbackExportCleansUpPrimvars(self):
+        '''
+        An export that can't stream clips, here because it appends to an
+        existing file, cleans up the primvars of animated meshes just like a
+        regular export.
+        '''
+        expected = self._Export('UsdExportClips_NoClipsPrimvars.usda')
+
+        fileName = 'UsdExportClips_Append.usda'
+        self._Export(fileName)
+        stage = self._Export(fileName, clipFrameCount=3, append=True)
+
+        cubePrim = stage.GetPrimAtPath('/Cube')
+        self.assertFalse(Usd.ClipsAPI(cubePrim).GetClipAssetPaths())
+
+        expectedSt = UsdGeom.PrimvarsAPI(
+            expected.GetPrimAtPath('/Cube')).GetPrimvar('st')
+        st = UsdGeom.PrimvarsAPI(cubePrim).GetPrimvar('st')
+        self.assertTrue(st.IsIndexed())
+        for frame in (1, 10):
+            self.assertEqual(st.Get(frame), expectedSt.Get(frame),
+                'frame %d' % frame)
+            self.assertEqual(st.GetIndices(frame),
+                expectedSt.GetIndices(frame), 'frame %d' % frame)
+
+
+if __name__ == '__main__':
+    unittest.main(verbosity=2)
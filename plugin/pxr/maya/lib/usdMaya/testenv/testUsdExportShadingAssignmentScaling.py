@@ -0,0 +1,158 @@
+#!/pxrpythonsubst
+#
+# Copyright 2020 Pixar
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+"""
+Benchmarks material export as the number of shading engines, and the number
+of instances of each shaded mesh, grows, and checks that every instance ends
+up bound to the right material.
+
+The default sizes are kept small so that this runs quickly as a test. Set
+USD_EXPORT_SHADING_BENCHMARK_SCALE to an integer to multiply them, e.g. 10 to
+export scenes with thousands of shading engines.
+"""
+
+from pxr import Usd
+from pxr import UsdShade
+
+from maya import cmds
+from maya import standalone
+
+import os
+import time
+import unittest
+
+
+SCALE = int(os.environ.get('USD_EXPORT_SHADING_BENCHMARK_SCALE', '1'))
+
+# (number of shading engines, number of instances of each shaded mesh)
+SCENE_SIZES = [
+    (10 * SCALE, 1),
+    (50 * SCALE, 1),
+    (200 * SCALE, 1),
+    (10 * SCALE, 10),
+    (50 * SCALE, 10),
+    (10 * SCALE, 50),
+]
+
+
+class testUsdExportShadingAssignmentScaling(unittest.TestCase):
+
+    @classmethod
+    def setUpClass(cls):
+        standalone.initialize('usd')
+        cmds.loadPlugin('pxrUsd')
+        cls._timings = []
+
+    @classmethod
+    def tearDownClass(cls):
+        print('\nshading export timings (%s)' % (
+            'displayColor, collection based bindings'))
+        print('%16s %10s %10s %12s %12s' % (
+            'shading engines', 'instances', 'prims', 'no shading', 'displayColor'))
+        for numEngines, numInstances, numPrims, baseline, shaded in cls._timings:
+            print('%16d %10d %10d %11.3fs %11.3fs' % (
+                numEngines, numInstances, numPrims, baseline, shaded))
+        standalone.uninitialize()
+
+    def _BuildScene(self, numEngines, numInstances):
+        """
+        Creates one cube per shading engine, instances it numInstances - 1
+        times, and then assigns half of the faces of every instance to the
+        shading engine and the other half to the default shader.
+        """
+        cmds.file(new=True, force=True)
+        world = cmds.group(empty=True, name='World')
+        for i in range(numEngines):
+            cube = cmds.polyCube(name='cube%d' % i)[0]
+            cube = cmds.parent(cube, world)[0]
+
+            shader = cmds.shadingNode('lambert', asShader=True,
+                name='lambert%d' % i)
+            cmds.setAttr(shader + '.color', (i % 7) / 7.0, 0.5, 0.5,
+                type='double3')
+            engine = cmds.sets(renderable=True, noSurfaceShader=True,
+                empty=True, name='lambert%dSG' % i)
+            cmds.connectAttr(shader + '.outColor', engine + '.surfaceShader')
+
+            instances = ['|World|' + cube]
+            for j in range(1, numInstances):
+                instance = cmds.instance(cube, name='cube%d_instance%d' % (i, j))[0]
+                cmds.move(0, 0, 2 * j, instance)
+                instances.append('|World|' + instance)
+
+            for instance in instances:
+                cmds.sets(instance + '.f[0:2]', forceElement=engine)
+                cmds.sets(instance + '.f[3:5]',
+                    forceElement='initialShadingGroup')
+
+    def _Export(self, usdFilePath, shadingMode):
+        start = time.time()
+        cmds.usdExport(file=usdFilePath, mergeTransformAndShape=True,
+            shadingMode=shadingMode, materialsScopeName='Materials',
+            exportCollectionBasedBindings=True,
+            exportMaterialCollections=True,
+            materialCollectionsPath='/World')
+        return time.time() - start
+
+    def _CheckBindings(self, stage, numEngines, numInstances):
+        for i in range(numEngines):
+            names = ['cube%d' % i] + [
+                'cube%d_instance%d' % (i, j) for j in range(1, numInstances)]
+            for name in names:
+                subset = stage.GetPrimAtPath(
+                    '/World/%s/lambert%dSG' % (name, i))
+                self.assertTrue(subset, name)
+                self.assertEqual(
+                    list(subset.GetAttribute('indices').Get()), [0, 1, 2])
+
+            material = UsdShade.Material.Get(stage,
+                '/World/Materials/lambert%dSG' % i)
+            self.assertTrue(material)
+
+            collection = Usd.CollectionAPI(stage.GetPrimAtPath('/World'),
+                'material:lambert%dSG' % i)
+            self.assertTrue(collection)
+            query = collection.ComputeMembershipQuery()
+            for name in names:
+                self.assertTrue(query.IsPathIncluded(
+                    '/World/%s/lambert%dSG' % (name, i)))
+
+    def testScaling(self):
+        """
+        Exports scenes of increasing numbers of shading engines and instances,
+        timing the export with and without materials.
+        """
+        for numEngines, numInstances in SCENE_SIZES:
+            self._BuildScene(numEngines, numInstances)
+
+            baseName = 'ShadingScaling_%d_%d' % (numEngines, numInstances)
+            baseline = self._Export(
+                os.path.abspath(baseName + '_none.usda'), 'none')
+
+            usdFilePath = os.path.abspath(baseName + '.usda')
+            shaded = self._Export(usdFilePath, 'displayColor')
+
+            stage = Usd.Stage.Open(usdFilePath)
+            self.assertTrue(stage)
+            self._CheckBindings(stage, numEngines, numInstances)
+
+            self._timings.append((numEngines, numInstances,
+                numEngines * numInstances, baseline, shaded))
+
+
+if __name__ == '__main__':
+    unittest.main(verbosity=2)
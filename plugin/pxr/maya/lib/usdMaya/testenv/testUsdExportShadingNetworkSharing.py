@@ -0,0 +1,139 @@
+#!/pxrpythonsubst
+#
+# Copyright 2020 Pixar
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+import os
+import unittest
+
+from pxr import Usd
+from pxr import UsdShade
+
+from maya import cmds
+from maya import standalone
+
+
+class testUsdExportShadingNetworkSharing(unittest.TestCase):
+
+    @classmethod
+    def setUpClass(cls):
+        standalone.initialize('usd')
+        cmds.loadPlugin('pxrUsd')
+
+        cmds.file(new=True, force=True)
+        world = cmds.group(empty=True, name='World')
+
+        # The red and blue networks are built twice each, so that each pair
+        # differs only by node names.
+        colors = [
+            ('redA', (1.0, 0.0, 0.0)),
+            ('redB', (1.0, 0.0, 0.0)),
+            ('blueA', (0.0, 0.0, 1.0)),
+            ('blueB', (0.0, 0.0, 1.0)),
+        ]
+        for name, color in colors:
+            cube = cmds.polyCube(name=name + 'Cube')[0]
+            cmds.parent(cube, world)
+
+            shader = cmds.shadingNode('lambert', asShader=True,
+                name=name + 'Lambert')
+            checker = cmds.shadingNode('checker', asTexture=True,
+                name=name + 'Checker')
+            cmds.setAttr(checker + '.color1', color[0], color[1], color[2],
+                type='double3')
+            cmds.connectAttr(checker + '.outColor', shader + '.color')
+
+            engine = cmds.sets(renderable=True, noSurfaceShader=True,
+                empty=True, name=name + 'SG')
+            cmds.connectAttr(shader + '.outColor', engine + '.surfaceShader')
+            cmds.sets('|World|' + cube, forceElement=engine)
+
+        cls._sharedStage = cls._Export('SharedNetworks.usda', True)
+        cls._unsharedStage = cls._Export('UnsharedNetworks.usda', False)
+
+    @classmethod
+    def tearDownClass(cls):
+        standalone.uninitialize()
+
+    @classmethod
+    def _Export(cls, fileName, shareShadingNetworks):
+        usdFilePath = os.path.abspath(fileName)
+        cmds.usdExport(file=usdFilePath, mergeTransformAndShape=True,
+            shadingMode='pxrRis', materialsScopeName='Materials',
+            shareShadingNetworks=shareShadingNetworks)
+        return Usd.Stage.Open(usdFilePath)
+
+    def _GetMaterial(self, stage, name):
+        material = UsdShade.Material.Get(stage,
+            '/World/Materials/%sSG' % name)
+        self.assertTrue(material)
+        return material
+
+    def _GetSurfaceShaderPath(self, material):
+        output = material.GetOutput('ri:surface')
+        self.assertTrue(output)
+        (connectableAPI, outputName, outputType) = output.GetConnectedSource()
+        return connectableAPI.GetPath()
+
+    def testIdenticalNetworksAreShared(self):
+        """
+        Tests that a shading engine whose network is identical to one that was
+        already exported gets a material that references it, and that it
+        still composes the full network.
+        """
+        for first, second in [('redA', 'redB'), ('blueA', 'blueB')]:
+            firstMaterial = self._GetMaterial(self._sharedStage, first)
+            secondMaterial = self._GetMaterial(self._sharedStage, second)
+
+            self.assertFalse(firstMaterial.GetPrim().HasAuthoredReferences())
+            self.assertTrue(secondMaterial.GetPrim().HasAuthoredReferences())
+
+            # The shaders of the second material come from the first one.
+            self.assertEqual(
+                self._GetSurfaceShaderPath(secondMaterial),
+                secondMaterial.GetPath().AppendChild(
+                    first + 'Lambert'))
+
+            cubePrim = self._sharedStage.GetPrimAtPath(
+                '/World/%sCube' % second)
+            boundMaterial = UsdShade.MaterialBindingAPI(
+                cubePrim).ComputeBoundMaterial()[0]
+            self.assertEqual(boundMaterial.GetPath(), secondMaterial.GetPath())
+
+    def testDifferentNetworksAreNotShared(self):
+        """
+        Tests that networks that differ in an attribute value are each
+        exported in full.
+        """
+        redMaterial = self._GetMaterial(self._sharedStage, 'redA')
+        blueMaterial = self._GetMaterial(self._sharedStage, 'blueA')
+        self.assertFalse(redMaterial.GetPrim().HasAuthoredReferences())
+        self.assertFalse(blueMaterial.GetPrim().HasAuthoredReferences())
+
+    def testSharingCanBeDisabled(self):
+        """
+        Tests that every network is exported in full when sharing is
+        disabled.
+        """
+        for name in ['redA', 'redB', 'blueA', 'blueB']:
+            material = self._GetMaterial(self._unsharedStage, name)
+            self.assertFalse(material.GetPrim().HasAuthoredReferences())
+            self.assertEqual(
+                self._GetSurfaceShaderPath(material),
+                material.GetPath().AppendChild(name + 'Lambert'))
+
+
+if __name__ == '__main__':
+    unittest.main(verbosity=2)
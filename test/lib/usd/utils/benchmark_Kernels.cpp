@@ -0,0 +1,635 @@
+#include <mayaUsdUtils/DiffCore.h>
+#include <mayaUsdUtils/MergeIndexedValues.h>
+#include <mayaUsdUtils/SIMDDispatch.h>
+
+#include "AL/usdmaya/utils/MeshUtilsKernels.h"
+
+#include "pxr/pxr.h"
+#include "pxr/base/gf/half.h"
+#include "pxr/base/gf/vec2f.h"
+#include "pxr/base/gf/vec3f.h"
+#include "pxr/base/js/json.h"
+#include "pxr/base/vt/array.h"
+#include "pxr/base/vt/types.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+PXR_NAMESPACE_USING_DIRECTIVE
+
+// Micro-benchmarks of the DiffCore comparisons, the MeshUtils conversion kernels and the merging of indexed primvar
+// values. None of these need Maya. Run with --help for the options; the SIMD level being measured is the one selected
+// at runtime, and can be lowered with MAYAUSD_SIMD_LEVEL=baseline|avx2 to compare instruction sets.
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+const float kEps = 1e-5f;
+
+/// the distributions of the input data
+enum class Distribution
+{
+  kRandom,     ///< uniform random values, compared arrays are identical copies
+  kConstant,   ///< every element has the same value
+  kNearlyEqual ///< constant values perturbed by less than half the comparison tolerance
+};
+
+const char* const kDistributionNames[] = { "random", "constant", "nearlyEqual" };
+
+//----------------------------------------------------------------------------------------------------------------------
+std::vector<float> makeFloats(size_t count, Distribution distribution, std::mt19937& rng)
+{
+  std::vector<float> values(count);
+  std::uniform_real_distribution<float> uniform(0.0f, 1.0f);
+  std::uniform_real_distribution<float> noise(-0.45f * kEps, 0.45f * kEps);
+  for(float& v : values)
+  {
+    switch(distribution)
+    {
+    case Distribution::kRandom: v = uniform(rng); break;
+    case Distribution::kConstant: v = 0.5f; break;
+    case Distribution::kNearlyEqual: v = 0.5f + noise(rng); break;
+    }
+  }
+  return values;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+/// returns an array that compares equal to values within kEps: a copy, unless the values are nearly equal in which
+/// case it is a second independent set of nearly equal values.
+//----------------------------------------------------------------------------------------------------------------------
+std::vector<float> makeMatching(const std::vector<float>& values, Distribution distribution, std::mt19937& rng)
+{
+  if(distribution == Distribution::kNearlyEqual)
+    return makeFloats(values.size(), distribution, rng);
+  return values;
+}
+
+/// a benchmark prepared for one size and distribution. run() is timed, reset() (if any) is not.
+struct Workload
+{
+  std::function<void()> reset;
+  std::function<void()> run;
+  size_t elements = 0;
+  size_t bytes = 0;
+};
+
+/// a kernel to measure. prepare() allocates and fills the inputs of a workload.
+struct Benchmark
+{
+  std::string name;
+  std::function<Workload(size_t count, Distribution distribution, std::mt19937& rng)> prepare;
+};
+
+/// prevents the compiler from discarding the result of a kernel
+volatile size_t g_sink = 0;
+
+//----------------------------------------------------------------------------------------------------------------------
+const AL::usdmaya::utils::MeshUtilsKernels& meshUtilsKernels()
+{
+  static const AL::usdmaya::utils::MeshUtilsKernels& table =
+    MayaUsdUtils::selectSimdKernel<const AL::usdmaya::utils::MeshUtilsKernels& (*)()>(
+      &AL::usdmaya::utils::baselineMeshUtilsKernels,
+#if MAYAUSD_SIMD_HAS_AVX2
+      &AL::usdmaya::utils::avx2MeshUtilsKernels,
+#else
+      nullptr,
+#endif
+#if MAYAUSD_SIMD_HAS_AVX512
+      &AL::usdmaya::utils::avx512MeshUtilsKernels
+#else
+      nullptr
+#endif
+      )();
+  return table;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+/// benchmarks a vecNAreAllTheSame overload on count elements of N components
+//----------------------------------------------------------------------------------------------------------------------
+template<typename T, size_t N>
+Benchmark allTheSame(const char* name, bool (*kernel)(const T*, size_t))
+{
+  return { name, [kernel](size_t count, Distribution distribution, std::mt19937& rng) {
+    const std::vector<float> f = makeFloats(count * N, distribution, rng);
+    auto data = std::make_shared<std::vector<T>>(f.begin(), f.end());
+    Workload w;
+    w.run = [kernel, data, count]() { g_sink = g_sink + kernel(data->data(), count); };
+    w.elements = count;
+    w.bytes = count * N * sizeof(T);
+    return w;
+  }};
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+/// benchmarks a compareArray overload on two arrays of count elements
+//----------------------------------------------------------------------------------------------------------------------
+template<typename A, typename B, typename E>
+Benchmark compare(const char* name, bool (*kernel)(const A*, const B*, size_t, size_t, E))
+{
+  return { name, [kernel](size_t count, Distribution distribution, std::mt19937& rng) {
+    const std::vector<float> f0 = makeFloats(count, distribution, rng);
+    auto a = std::make_shared<std::vector<A>>(f0.begin(), f0.end());
+    // match the values after conversion to A, so that halves are not compared with more precise values
+    const std::vector<float> f1 = makeMatching(std::vector<float>(a->begin(), a->end()), distribution, rng);
+    auto b = std::make_shared<std::vector<B>>(f1.begin(), f1.end());
+    Workload w;
+    w.run = [kernel, a, b, count]() { g_sink = g_sink + kernel(a->data(), b->data(), count, count, E(kEps)); };
+    w.elements = count;
+    w.bytes = count * (sizeof(A) + sizeof(B));
+    return w;
+  }};
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+/// benchmarks an exact compareArray overload on two arrays of count integers
+//----------------------------------------------------------------------------------------------------------------------
+template<typename T>
+Benchmark compareIntegers(const char* name, bool (*kernel)(const T*, const T*, size_t, size_t))
+{
+  return { name, [kernel](size_t count, Distribution distribution, std::mt19937& rng) {
+    auto a = std::make_shared<std::vector<T>>(count);
+    std::uniform_int_distribution<int> uniform(-100, 100);
+    for(T& v : *a)
+      v = (distribution == Distribution::kRandom) ? T(uniform(rng)) : T(7);
+    auto b = std::make_shared<std::vector<T>>(*a);
+    Workload w;
+    w.run = [kernel, a, b, count]() { g_sink = g_sink + kernel(a->data(), b->data(), count, count); };
+    w.elements = count;
+    w.bytes = count * 2 * sizeof(T);
+    return w;
+  }};
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+/// benchmarks mergeEquivalentIndexedValues on count values assigned in order. The copy of the inputs, which the merge
+/// modifies, is not timed.
+//----------------------------------------------------------------------------------------------------------------------
+template<typename T, size_t N>
+Benchmark merge(const char* name)
+{
+  return { name, [](size_t count, Distribution distribution, std::mt19937& rng) {
+    const std::vector<float> f = makeFloats(count * N, distribution, rng);
+
+    struct State { VtArray<T> values, workValues; VtIntArray indices, workIndices; };
+    auto state = std::make_shared<State>();
+    state->values.resize(count);
+    std::memcpy(state->values.data(), f.data(), count * sizeof(T));
+    state->indices.resize(count);
+    for(size_t i = 0; i < count; ++i)
+      state->indices[i] = int(i);
+
+    Workload w;
+    w.reset = [state]() {
+      // the merge swaps its results into the arrays, so sharing the inputs is enough to restore them
+      state->workValues = state->values;
+      state->workIndices = state->indices;
+    };
+    w.run = [state]() {
+      MayaUsdUtils::mergeEquivalentIndexedValues(&state->workValues, &state->workIndices);
+      g_sink = g_sink + state->workValues.size();
+    };
+    w.elements = count;
+    w.bytes = count * (sizeof(T) + sizeof(int));
+    return w;
+  }};
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+std::vector<Benchmark> allBenchmarks()
+{
+  using namespace MayaUsdUtils;
+  std::vector<Benchmark> benchmarks = {
+    allTheSame<float, 2>("vec2AreAllTheSame/float", &vec2AreAllTheSame),
+    allTheSame<float, 3>("vec3AreAllTheSame/float", &vec3AreAllTheSame),
+    allTheSame<float, 4>("vec4AreAllTheSame/float", &vec4AreAllTheSame),
+    allTheSame<double, 2>("vec2AreAllTheSame/double", &vec2AreAllTheSame),
+    allTheSame<double, 3>("vec3AreAllTheSame/double", &vec3AreAllTheSame),
+    allTheSame<double, 4>("vec4AreAllTheSame/double", &vec4AreAllTheSame),
+    compare<float, float, float>("compareArray/float", &compareArray),
+    compare<double, double, double>("compareArray/double", &compareArray),
+    compare<GfHalf, float, float>("compareArray/half-float", &compareArray),
+    compare<GfHalf, double, double>("compareArray/half-double", &compareArray),
+    compare<double, float, float>("compareArray/double-float", &compareArray),
+    compareIntegers<int32_t>("compareArray/int32", &compareArray),
+    compareIntegers<int8_t>("compareArray/int8", &compareArray),
+  };
+
+  benchmarks.push_back({ "compareUvArray", [](size_t count, Distribution distribution, std::mt19937& rng) {
+    auto u = std::make_shared<std::vector<float>>(makeFloats(count, distribution, rng));
+    auto v = std::make_shared<std::vector<float>>(makeFloats(count, distribution, rng));
+    const std::vector<float> u1 = makeMatching(*u, distribution, rng);
+    const std::vector<float> v1 = makeMatching(*v, distribution, rng);
+    auto uv = std::make_shared<std::vector<float>>(count * 2);
+    for(size_t i = 0; i < count; ++i)
+    {
+      (*uv)[2 * i] = u1[i];
+      (*uv)[2 * i + 1] = v1[i];
+    }
+    Workload w;
+    w.run = [u, v, uv, count]() {
+      g_sink = g_sink + MayaUsdUtils::compareUvArray(u->data(), v->data(), uv->data(), count, count, kEps);
+    };
+    w.elements = count;
+    w.bytes = count * 4 * sizeof(float);
+    return w;
+  }});
+
+  benchmarks.push_back({ "compareRGBAArray", [](size_t count, Distribution distribution, std::mt19937& rng) {
+    auto rgba = std::make_shared<std::vector<float>>(makeFloats(count * 4, distribution, rng));
+    if(distribution == Distribution::kRandom)
+      std::fill(rgba->begin(), rgba->end(), 0.25f);
+    Workload w;
+    w.run = [rgba, count]() {
+      const float c = (*rgba)[0];
+      g_sink = g_sink + MayaUsdUtils::compareRGBAArray(c, c, c, c, rgba->data(), count, kEps);
+    };
+    w.elements = count;
+    w.bytes = count * 4 * sizeof(float);
+    return w;
+  }});
+
+  benchmarks.push_back({ "hashArray", [](size_t count, Distribution distribution, std::mt19937& rng) {
+    auto points = std::make_shared<std::vector<float>>(makeFloats(count * 3, distribution, rng));
+    Workload w;
+    w.run = [points]() {
+      g_sink = g_sink + MayaUsdUtils::hashArray(points->data(), points->size() * sizeof(float));
+    };
+    w.elements = count;
+    w.bytes = count * 3 * sizeof(float);
+    return w;
+  }});
+
+  benchmarks.push_back({ "floatToDouble", [](size_t count, Distribution distribution, std::mt19937& rng) {
+    auto input = std::make_shared<std::vector<float>>(makeFloats(count, distribution, rng));
+    auto output = std::make_shared<std::vector<double>>(count);
+    Workload w;
+    w.run = [input, output, count]() { meshUtilsKernels().floatToDouble(output->data(), input->data(), count); };
+    w.elements = count;
+    w.bytes = count * (sizeof(float) + sizeof(double));
+    return w;
+  }});
+
+  benchmarks.push_back({ "zipUVs", [](size_t count, Distribution distribution, std::mt19937& rng) {
+    auto u = std::make_shared<std::vector<float>>(makeFloats(count, distribution, rng));
+    auto v = std::make_shared<std::vector<float>>(makeFloats(count, distribution, rng));
+    auto uv = std::make_shared<std::vector<float>>(count * 2);
+    Workload w;
+    w.run = [u, v, uv, count]() { meshUtilsKernels().zipUVs(u->data(), v->data(), uv->data(), count); };
+    w.elements = count;
+    w.bytes = count * 4 * sizeof(float);
+    return w;
+  }});
+
+  benchmarks.push_back({ "interleaveIndexedUvData", [](size_t count, Distribution distribution, std::mt19937& rng) {
+    // a quarter as many uvs as face vertices, roughly the ratio of a closed quad mesh
+    const size_t numUvs = std::max<size_t>(count / 4, 1);
+    auto u = std::make_shared<std::vector<float>>(makeFloats(numUvs, distribution, rng));
+    auto v = std::make_shared<std::vector<float>>(makeFloats(numUvs, distribution, rng));
+    auto indices = std::make_shared<std::vector<int32_t>>(count);
+    std::uniform_int_distribution<int32_t> uniform(0, int32_t(numUvs - 1));
+    for(size_t i = 0; i < count; ++i)
+      (*indices)[i] = (distribution == Distribution::kRandom) ? uniform(rng) : int32_t(i % numUvs);
+    auto uv = std::make_shared<std::vector<float>>(count * 2);
+    Workload w;
+    w.run = [u, v, indices, uv, count]() {
+      meshUtilsKernels().interleaveIndexedUvData(uv->data(), u->data(), v->data(), indices->data(), uint32_t(count));
+    };
+    w.elements = count;
+    w.bytes = count * (sizeof(int32_t) + 4 * sizeof(float));
+    return w;
+  }});
+
+  benchmarks.push_back(merge<float, 1>("mergeEquivalentIndexedValues/float"));
+  benchmarks.push_back(merge<GfVec2f, 2>("mergeEquivalentIndexedValues/vec2f"));
+  benchmarks.push_back(merge<GfVec3f, 3>("mergeEquivalentIndexedValues/vec3f"));
+  return benchmarks;
+}
+
+/// the measurements of one benchmark, size and distribution
+struct Result
+{
+  std::string kernel;
+  std::string distribution;
+  size_t size = 0;
+  size_t iterations = 0;
+  double minSeconds = 0;
+  double medianSeconds = 0;
+  double elementsPerSecond = 0;
+  double gigabytesPerSecond = 0;
+
+  std::string key() const { return kernel + " " + distribution + " " + std::to_string(size); }
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+/// runs the workload until both minIterations and minSeconds have been reached
+//----------------------------------------------------------------------------------------------------------------------
+Result measure(const Workload& workload, size_t minIterations, double minSeconds)
+{
+  // warm up caches and the selection of the kernels
+  if(workload.reset)
+    workload.reset();
+  workload.run();
+
+  std::vector<double> times;
+  double total = 0;
+  while(times.size() < minIterations || total < minSeconds)
+  {
+    if(workload.reset)
+      workload.reset();
+    const Clock::time_point start = Clock::now();
+    workload.run();
+    const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    times.push_back(seconds);
+    total += seconds;
+  }
+
+  std::sort(times.begin(), times.end());
+  Result result;
+  result.iterations = times.size();
+  result.minSeconds = times.front();
+  result.medianSeconds = times[times.size() / 2];
+  const double seconds = std::max(result.medianSeconds, 1e-12);
+  result.elementsPerSecond = workload.elements / seconds;
+  result.gigabytesPerSecond = workload.bytes / seconds * 1e-9;
+  return result;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+const char* simdLevelName(MayaUsdUtils::SimdLevel level)
+{
+  switch(level)
+  {
+  case MayaUsdUtils::SimdLevel::kAVX512: return "avx512";
+  case MayaUsdUtils::SimdLevel::kAVX2: return "avx2";
+  default: return "baseline";
+  }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+JsValue toJson(const std::vector<Result>& results)
+{
+  JsArray array;
+  for(const Result& r : results)
+  {
+    JsObject object;
+    object["kernel"] = JsValue(r.kernel);
+    object["distribution"] = JsValue(r.distribution);
+    object["size"] = JsValue(int64_t(r.size));
+    object["iterations"] = JsValue(int64_t(r.iterations));
+    object["minSeconds"] = JsValue(r.minSeconds);
+    object["medianSeconds"] = JsValue(r.medianSeconds);
+    object["elementsPerSecond"] = JsValue(r.elementsPerSecond);
+    object["gigabytesPerSecond"] = JsValue(r.gigabytesPerSecond);
+    array.push_back(JsValue(object));
+  }
+
+  JsObject root;
+  root["simdLevel"] = JsValue(std::string(simdLevelName(MayaUsdUtils::activeSimdLevel())));
+  root["results"] = JsValue(array);
+  return JsValue(root);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+double toDouble(const JsValue& value)
+{
+  if(value.IsReal())
+    return value.GetReal();
+  if(value.IsInt())
+    return double(value.GetInt64());
+  return 0;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool readResults(const std::string& path, std::map<std::string, Result>& results)
+{
+  std::ifstream stream(path);
+  if(!stream)
+  {
+    std::cerr << "cannot open " << path << std::endl;
+    return false;
+  }
+  JsParseError error;
+  const JsValue root = JsParseStream(stream, &error);
+  if(!root.IsObject())
+  {
+    std::cerr << "cannot parse " << path << " line " << error.line << ": " << error.reason << std::endl;
+    return false;
+  }
+  const JsObject& object = root.GetJsObject();
+  const auto it = object.find("results");
+  if(it == object.end() || !it->second.IsArray())
+  {
+    std::cerr << path << " has no results" << std::endl;
+    return false;
+  }
+  for(const JsValue& value : it->second.GetJsArray())
+  {
+    if(!value.IsObject())
+      continue;
+    const JsObject& o = value.GetJsObject();
+    Result r;
+    r.kernel = o.count("kernel") ? o.at("kernel").GetString() : std::string();
+    r.distribution = o.count("distribution") ? o.at("distribution").GetString() : std::string();
+    r.size = o.count("size") ? size_t(toDouble(o.at("size"))) : 0;
+    r.elementsPerSecond = o.count("elementsPerSecond") ? toDouble(o.at("elementsPerSecond")) : 0;
+    r.gigabytesPerSecond = o.count("gigabytesPerSecond") ? toDouble(o.at("gigabytesPerSecond")) : 0;
+    results[r.key()] = r;
+  }
+  return true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+/// prints the speed of each result relative to the baseline, and returns the number of regressions, i.e. results
+/// slower than the baseline by more than the tolerance.
+//----------------------------------------------------------------------------------------------------------------------
+size_t compareResults(const std::vector<Result>& results, const std::map<std::string, Result>& baseline,
+                      double tolerance)
+{
+  size_t regressions = 0;
+  std::printf("\n%-40s %-12s %10s %10s %s\n", "kernel", "distribution", "size", "speedup", "");
+  for(const Result& r : results)
+  {
+    const auto it = baseline.find(r.key());
+    if(it == baseline.end() || it->second.elementsPerSecond <= 0)
+    {
+      std::printf("%-40s %-12s %10zu %10s\n", r.kernel.c_str(), r.distribution.c_str(), r.size, "new");
+      continue;
+    }
+    const double ratio = r.elementsPerSecond / it->second.elementsPerSecond;
+    const bool regressed = ratio < 1.0 - tolerance;
+    regressions += regressed;
+    std::printf("%-40s %-12s %10zu %9.2fx %s\n", r.kernel.c_str(), r.distribution.c_str(), r.size, ratio,
+                regressed ? "REGRESSION" : "");
+  }
+  return regressions;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+template<typename T>
+std::vector<T> splitList(const std::string& list, const std::function<T(const std::string&)>& convert)
+{
+  std::vector<T> values;
+  std::stringstream stream(list);
+  std::string item;
+  while(std::getline(stream, item, ','))
+  {
+    if(!item.empty())
+      values.push_back(convert(item));
+  }
+  return values;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void printUsage(const char* program)
+{
+  std::printf(
+    "usage: %s [options]\n"
+    "  --sizes N,N,...             number of elements per kernel call (default 1000,100000,1000000)\n"
+    "  --distributions D,D,...     random, constant, nearlyEqual (default all)\n"
+    "  --filter TEXT               only run the kernels whose name contains TEXT\n"
+    "  --min-time SECONDS          minimum time spent measuring each case (default 0.25)\n"
+    "  --min-iterations N          minimum number of timed calls of each case (default 5)\n"
+    "  --output FILE               write the results as JSON to FILE\n"
+    "  --compare FILE              compare against the JSON results in FILE, exit with 1 on regressions\n"
+    "  --tolerance FRACTION        slowdown allowed by --compare before reporting a regression (default 0.1)\n"
+    "  --quick                     small sizes and a single iteration, to check the benchmarks run\n"
+    "The SIMD level measured may be lowered with MAYAUSD_SIMD_LEVEL=baseline|avx2|avx512.\n",
+    program);
+}
+
+} // anon
+
+//----------------------------------------------------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+  std::vector<size_t> sizes = { 1000, 100000, 1000000 };
+  std::vector<Distribution> distributions = {
+    Distribution::kRandom, Distribution::kConstant, Distribution::kNearlyEqual };
+  std::string filter;
+  std::string outputPath;
+  std::string comparePath;
+  double minSeconds = 0.25;
+  size_t minIterations = 5;
+  double tolerance = 0.1;
+
+  for(int i = 1; i < argc; ++i)
+  {
+    const std::string arg = argv[i];
+    const bool hasValue = i + 1 < argc;
+    if(arg == "--help" || arg == "-h")
+    {
+      printUsage(argv[0]);
+      return 0;
+    }
+    else if(arg == "--quick")
+    {
+      sizes = { 1000 };
+      minSeconds = 0;
+      minIterations = 1;
+    }
+    else if(arg == "--sizes" && hasValue)
+    {
+      sizes = splitList<size_t>(argv[++i], [](const std::string& s) { return size_t(std::stoull(s)); });
+    }
+    else if(arg == "--distributions" && hasValue)
+    {
+      distributions.clear();
+      for(const std::string& name : splitList<std::string>(argv[++i], [](const std::string& s) { return s; }))
+      {
+        const auto it = std::find(std::begin(kDistributionNames), std::end(kDistributionNames), name);
+        if(it == std::end(kDistributionNames))
+        {
+          std::cerr << "unknown distribution " << name << std::endl;
+          return 2;
+        }
+        distributions.push_back(Distribution(it - std::begin(kDistributionNames)));
+      }
+    }
+    else if(arg == "--filter" && hasValue)
+      filter = argv[++i];
+    else if(arg == "--min-time" && hasValue)
+      minSeconds = std::atof(argv[++i]);
+    else if(arg == "--min-iterations" && hasValue)
+      minIterations = std::max(1, std::atoi(argv[++i]));
+    else if(arg == "--output" && hasValue)
+      outputPath = argv[++i];
+    else if(arg == "--compare" && hasValue)
+      comparePath = argv[++i];
+    else if(arg == "--tolerance" && hasValue)
+      tolerance = std::atof(argv[++i]);
+    else
+    {
+      std::cerr << "unknown or incomplete option " << arg << std::endl;
+      printUsage(argv[0]);
+      return 2;
+    }
+  }
+
+  std::map<std::string, Result> baseline;
+  if(!comparePath.empty() && !readResults(comparePath, baseline))
+    return 2;
+
+  std::printf("simd level: %s (hardware %s)\n", simdLevelName(MayaUsdUtils::activeSimdLevel()),
+              simdLevelName(MayaUsdUtils::hardwareSimdLevel()));
+  std::printf("%-40s %-12s %10s %10s %14s %10s\n", "kernel", "distribution", "size", "median us", "elements/s",
+              "GB/s");
+
+  std::vector<Result> results;
+  std::mt19937 rng(12345);
+  for(const Benchmark& benchmark : allBenchmarks())
+  {
+    if(!filter.empty() && benchmark.name.find(filter) == std::string::npos)
+      continue;
+    for(const Distribution distribution : distributions)
+    {
+      for(const size_t size : sizes)
+      {
+        const Workload workload = benchmark.prepare(size, distribution, rng);
+        Result result = measure(workload, minIterations, minSeconds);
+        result.kernel = benchmark.name;
+        result.distribution = kDistributionNames[int(distribution)];
+        result.size = size;
+        std::printf("%-40s %-12s %10zu %10.2f %14.4g %10.3f\n", result.kernel.c_str(), result.distribution.c_str(),
+                    size, result.medianSeconds * 1e6, result.elementsPerSecond, result.gigabytesPerSecond);
+        results.push_back(result);
+      }
+    }
+  }
+
+  if(!outputPath.empty())
+  {
+    std::ofstream stream(outputPath);
+    if(!stream)
+    {
+      std::cerr << "cannot write " << outputPath << std::endl;
+      return 2;
+    }
+    JsWriteToStream(toJson(results), stream);
+    stream << std::endl;
+  }
+
+  if(!comparePath.empty())
+  {
+    const size_t regressions = compareResults(results, baseline, tolerance);
+    if(regressions)
+    {
+      std::printf("%zu regression(s) beyond %.0f%%\n", regressions, tolerance * 100);
+      return 1;
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,137 @@
+#!/usr/bin/env python
+#
+# Copyright 2020 Autodesk
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+'''
+Checks that the object files compiled for AVX2 or AVX-512 (see
+mayaUsd_add_simd_sources) don't define weak symbols with VEX or EVEX encoded
+instructions outside of the instruction set namespaces.
+
+The linker keeps a single copy of each weak symbol (inline functions and
+template instantiations) for the whole binary. If it keeps the copy compiled
+for AVX2, then the code calling it from the baseline sources crashes on the
+CPUs that the runtime dispatch was meant to support.
+
+usage: checkSimdSymbols.py [--nm <nm>] [--objdump <objdump>] <object files>
+
+Only the object files with AVX2 or AVX512 in their name are checked. The
+object files may also be given as CMake lists, e.g. from $<TARGET_OBJECTS>.
+'''
+
+from __future__ import print_function
+
+import argparse
+import re
+import subprocess
+import sys
+
+# The symbols that may use the instruction set, see MAYAUSD_SIMD_TARGET.
+_ISA_NAMESPACE = re.compile(r'\b(avx2|avx512)::')
+
+_ISA_OBJECT = re.compile(r'AVX(2|512)[^/\\]*$')
+
+# Function headers and instructions of "objdump -d -w".
+_FUNCTION = re.compile(r'^[0-9a-f]+ <(.+)>:$')
+_INSTRUCTION = re.compile(r'^\s*[0-9a-f]+:\t([0-9a-f ]+)\t(.*)$')
+
+# Prefixes that may precede a VEX or EVEX prefix in 64 bit mode.
+_SEGMENT_PREFIXES = ('26', '2e', '36', '3e', '64', '65', '67')
+
+# In 64 bit mode, c4 and c5 always start a VEX prefix, and 62 an EVEX prefix.
+_VEX_PREFIXES = ('c4', 'c5', '62')
+
+
+def _run(args):
+    output = subprocess.check_output(args)
+    if not isinstance(output, str):
+        output = output.decode('utf-8', 'replace')
+    return output.splitlines()
+
+
+def _weakSymbols(nm, objectFile):
+    '''Returns the mangled and demangled names of the weak symbols defined by
+    objectFile.'''
+    mangled = _run([nm, '--defined-only', objectFile])
+    demangled = _run([nm, '--defined-only', '-C', objectFile])
+    symbols = {}
+    for line, demangledLine in zip(mangled, demangled):
+        fields = line.split(None, 2)
+        if len(fields) == 3 and fields[1] in ('W', 'V'):
+            symbols[fields[2]] = demangledLine.split(None, 2)[2]
+    return symbols
+
+
+def _isVex(rawBytes):
+    for byte in rawBytes.split():
+        if byte not in _SEGMENT_PREFIXES:
+            return byte in _VEX_PREFIXES
+    return False
+
+
+def _vexInstructions(objdump, objectFile):
+    '''Returns the first VEX or EVEX encoded instruction of each function
+    in objectFile.'''
+    found = {}
+    function = None
+    for line in _run([objdump, '-d', '-w', objectFile]):
+        match = _FUNCTION.match(line)
+        if match:
+            function = match.group(1)
+            continue
+        match = _INSTRUCTION.match(line)
+        if match and function and function not in found and \
+                _isVex(match.group(1)):
+            found[function] = match.group(2).strip()
+    return found
+
+
+def main(argv):
+    parser = argparse.ArgumentParser(
+        description=__doc__.strip().splitlines()[0])
+    parser.add_argument('--nm', default='nm')
+    parser.add_argument('--objdump', default='objdump')
+    parser.add_argument('objects', nargs='*')
+    args = parser.parse_args(argv)
+
+    errors = 0
+    checked = 0
+    objectFiles = [f for arg in args.objects for f in arg.split(';') if f]
+    for objectFile in objectFiles:
+        if not _ISA_OBJECT.search(objectFile):
+            continue
+        checked += 1
+
+        weakSymbols = _weakSymbols(args.nm, objectFile)
+        vexInstructions = _vexInstructions(args.objdump, objectFile)
+        for symbol, demangled in sorted(weakSymbols.items()):
+            if _ISA_NAMESPACE.search(demangled) or \
+                    symbol not in vexInstructions:
+                continue
+            print('%s: weak symbol %s uses %s' % (
+                objectFile, demangled, vexInstructions[symbol]))
+            errors += 1
+
+    if not checked:
+        print('no AVX2 or AVX-512 object files to check')
+        return 1
+
+    print('checked %d object files, found %d weak symbols with VEX '
+          'instructions' % (checked, errors))
+    return 1 if errors else 0
+
+
+if __name__ == '__main__':
+    sys.exit(main(sys.argv[1:]))
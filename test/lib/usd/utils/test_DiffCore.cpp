@@ -513,3 +513,34 @@ TEST(DiffCore, compareUvArray)
   u[22] -= 1.0f;
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+TEST(DiffCore, hashArray)
+{
+  std::vector<uint8_t> a(203);
+  for(auto& value : a)
+  {
+    value = uint8_t(rand());
+  }
+
+  // the same data gives the same hash, whatever its alignment
+  const uint64_t hash = MayaUsdUtils::hashArray(a.data() + 1, 201);
+  std::vector<uint8_t> b(a.begin() + 1, a.end() - 1);
+  EXPECT_EQ(hash, MayaUsdUtils::hashArray(b.data(), b.size()));
+
+  // the size and seed are part of the hash
+  EXPECT_NE(hash, MayaUsdUtils::hashArray(b.data(), b.size() - 1));
+  EXPECT_NE(hash, MayaUsdUtils::hashArray(b.data(), b.size(), 1));
+  EXPECT_NE(MayaUsdUtils::hashArray(nullptr, 0), MayaUsdUtils::hashArray(nullptr, 0, 1));
+
+  // a change to any bit, within the SIMD blocks or in the remaining words and bytes, changes the hash
+  for(size_t i = 0; i < b.size(); ++i)
+  {
+    for(int bit = 0; bit < 8; ++bit)
+    {
+      b[i] ^= uint8_t(1 << bit);
+      EXPECT_NE(hash, MayaUsdUtils::hashArray(b.data(), b.size()));
+      b[i] ^= uint8_t(1 << bit);
+    }
+  }
+  EXPECT_EQ(hash, MayaUsdUtils::hashArray(b.data(), b.size()));
+}